@@ -4,10 +4,13 @@ set(_CPPUTEST_DISCOVERY_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/_CppUTestDiscovery.cmak
 
 option(CPPUTEST_TESTS_DETAILED "Run discovered tests individually")
 option(CPPUTEST_JUNIT_REPORT "Output JUnit test reports")
+set(CPPUTEST_TESTS_BATCH_SIZE 0 CACHE STRING
+    "Run discovered tests in batches of about this many tests per process (0 to disable)"
+)
 
 function(cpputest_discover_tests target)
     set(options JUNIT)
-    set(oneValueArgs DETAILED)
+    set(oneValueArgs DETAILED BATCH_SIZE)
     set(multiValueArgs EXTRA_ARGS)
     cmake_parse_arguments(
         ""
@@ -55,6 +58,15 @@ function(cpputest_discover_tests target)
         set(_DETAILED ${CPPUTEST_TESTS_DETAILED})
     endif()
 
+    if(NOT DEFINED _BATCH_SIZE)
+        set(_BATCH_SIZE ${CPPUTEST_TESTS_BATCH_SIZE})
+    endif()
+    if(NOT _BATCH_SIZE MATCHES "^[0-9]+$")
+        message(FATAL_ERROR
+            "BATCH_SIZE of \"${target}\" must be a number, not \"${_BATCH_SIZE}\""
+        )
+    endif()
+
     if(_JUNIT OR CPPUTEST_JUNIT_REPORT)
         list(APPEND _EXTRA_ARGS -ojunit)
     endif()
@@ -82,6 +94,7 @@ function(cpputest_discover_tests target)
         COMMAND
             "${CMAKE_COMMAND}"
             -D "TESTS_DETAILED:BOOL=${_DETAILED}"
+            -D "TESTS_BATCH_SIZE=${_BATCH_SIZE}"
             -D "EXECUTABLE=$<TARGET_FILE:${target}>"
             -D "EMULATOR=${emulator}"
             -D "ARGS=${_EXTRA_ARGS}"
@@ -21,6 +21,21 @@ if(NOT EXISTS "${EXECUTABLE}")
     )
 endif()
 
+# Discovery runs after every link. Skip it when the executable and the
+# discovery settings are the same as for the existing file.
+file(SHA256 "${EXECUTABLE}" executable_hash)
+string(SHA256 discovery_key
+    "${executable_hash};${EXECUTABLE};${EMULATOR};${ARGS};${TESTS_DETAILED};${TESTS_BATCH_SIZE}"
+)
+set(discovery_stamp "# CppUTest discovery ${discovery_key}")
+if(EXISTS "${CTEST_FILE}")
+    file(STRINGS "${CTEST_FILE}" previous_stamp LIMIT_COUNT 1)
+    if(previous_stamp STREQUAL discovery_stamp)
+        return()
+    endif()
+endif()
+set(script "${discovery_stamp}\n")
+
 macro(add_test_to_script TEST_NAME TEST_LOCATION SELECT_ARG)
     add_command(
         add_test
@@ -64,7 +79,78 @@ string(CONCAT LL_LINE_REGEX
     "\n"
 )
 string(REGEX MATCHALL "[^\n]+\n" discovered_test_lines "${discovered_tests}")
-if(TESTS_DETAILED)
+if(TESTS_BATCH_SIZE GREATER 0)
+    # Whole groups are packed into a batch until it holds about
+    # TESTS_BATCH_SIZE tests. Larger groups are split by test name.
+    # Groups are never mixed with names, as -sg and -sn filters combine.
+    get_filename_component(executable_name "${EXECUTABLE}" NAME_WE)
+    foreach(line IN LISTS discovered_test_lines)
+        string(REGEX MATCH "${LL_LINE_REGEX}" __unused "${line}")
+        set(group "${CMAKE_MATCH_1}")
+        if(NOT DEFINED _${group}_tests)
+            file(TO_CMAKE_PATH "${CMAKE_MATCH_3}" test_file)
+            set(_${group}_location "${test_file}:${CMAKE_MATCH_4}")
+            list(APPEND groups_seen "${group}")
+        endif()
+        list(APPEND _${group}_tests "${CMAKE_MATCH_2}")
+    endforeach()
+
+    set(batch_number 0)
+    set(batch_args "")
+    set(batch_size 0)
+    macro(add_batch_to_script)
+        if(batch_args)
+            math(EXPR batch_number "${batch_number} + 1")
+            add_command(
+                add_test
+                "${executable_name}.batch${batch_number}"
+                ${EMULATOR}
+                "${EXECUTABLE}"
+                ${ARGS}
+                ${batch_args}
+            )
+            add_command(
+                set_tests_properties
+                "${executable_name}.batch${batch_number}"
+                PROPERTIES
+                DEF_SOURCE_LINE
+                "${batch_location}"
+            )
+            set(batch_args "")
+            set(batch_size 0)
+        endif()
+    endmacro()
+
+    foreach(group IN LISTS groups_seen)
+        list(LENGTH _${group}_tests group_size)
+        if(group_size GREATER TESTS_BATCH_SIZE)
+            add_batch_to_script()
+            foreach(test_name IN LISTS _${group}_tests)
+                if(NOT batch_args)
+                    set(batch_args -sg "${group}")
+                    set(batch_location "${_${group}_location}")
+                endif()
+                list(APPEND batch_args -sn "${test_name}")
+                math(EXPR batch_size "${batch_size} + 1")
+                if(NOT batch_size LESS TESTS_BATCH_SIZE)
+                    add_batch_to_script()
+                endif()
+            endforeach()
+            add_batch_to_script()
+        else()
+            math(EXPR new_batch_size "${batch_size} + ${group_size}")
+            if(new_batch_size GREATER TESTS_BATCH_SIZE)
+                add_batch_to_script()
+            endif()
+            if(NOT batch_args)
+                set(batch_location "${_${group}_location}")
+            endif()
+            list(APPEND batch_args -sg "${group}")
+            math(EXPR batch_size "${batch_size} + ${group_size}")
+        endif()
+    endforeach()
+    add_batch_to_script()
+elseif(TESTS_DETAILED)
     foreach(line IN LISTS discovered_test_lines)
         string(REGEX MATCH "${LL_LINE_REGEX}" __unused "${line}")
         set(test_name "${CMAKE_MATCH_1}.${CMAKE_MATCH_2}")
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_Benchmark_h
+#define D_Benchmark_h
+
+#include "StandardCLibrary.h"
+
+#define BENCHMARK_MAXIMUM_SAMPLES 30
+
+struct BenchmarkResult
+{
+    size_t iterations;
+    size_t samples;
+    double sampleNanosecondsPerOperation[BENCHMARK_MAXIMUM_SAMPLES];
+    double nanosecondsPerOperation;
+    double minNanosecondsPerOperation;
+    double confidenceInterval;
+};
+
+class BenchmarkOperation
+{
+public:
+    virtual ~BenchmarkOperation();
+    virtual void run(size_t iterations)=0;
+};
+
+template <typename T>
+class BenchmarkMethod : public BenchmarkOperation
+{
+public:
+    BenchmarkMethod(T* object, void (T::*method)()) : object_(object), method_(method)
+    {
+    }
+
+    virtual void run(size_t iterations) CPPUTEST_OVERRIDE
+    {
+        for (size_t i = 0; i < iterations; i++)
+            (object_->*method_)();
+    }
+
+private:
+    T* object_;
+    void (T::*method_)();
+};
+
+/*
+ * Measures a benchmark. The iterations per sample are calibrated until a
+ * sample takes at least sampleTimeInMicros, which also warms up the code.
+ * The result is the mean time per operation over the samples with the
+ * half width of its 95% confidence interval. When the clock does not advance
+ * during calibration (e.g. no time source on the platform), the benchmark is
+ * unmeasurable and the result has no iterations and no samples.
+ */
+class BenchmarkRunner
+{
+public:
+    static BenchmarkResult measure(BenchmarkOperation& operation, unsigned long sampleTimeInMicros, size_t sampleCount);
+    static void run(BenchmarkOperation& operation);
+
+    static const unsigned long defaultSampleTimeInMicros = 10000;
+    static const size_t defaultSampleCount = 10;
+};
+
+extern const volatile void* cpputestBenchmarkSink;
+
+/*
+ * Makes the compiler believe the value is used, so that the code computing
+ * it is not optimized away.
+ */
+template <typename T>
+inline void cpputestDoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ __volatile__("" : : "g"(&value) : "memory");
+#else
+    cpputestBenchmarkSink = &value;
+#endif
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_BenchmarkBaseline_h
+#define D_BenchmarkBaseline_h
+
+#include "SimpleString.h"
+
+struct BenchmarkResult;
+class TestOutput;
+
+/*
+ * The ns/op samples of every benchmark of a run, by "group.name". A baseline
+ * is written to and read from a text file with one benchmark per line. Two
+ * runs are compared with the Mann-Whitney U test: a benchmark regressed when
+ * its samples are significantly slower (z above 1.96) and its median slowed
+ * down by more than the given fraction. Benchmarks of the baseline that did
+ * not run are listed, but are no regression, as a run may be filtered.
+ *
+ * Samples are added while the benchmark is running, so the memory comes from
+ * PlatformSpecificMalloc and is not reported as a leak of the benchmark.
+ */
+class BenchmarkBaseline
+{
+public:
+    BenchmarkBaseline();
+    virtual ~BenchmarkBaseline();
+
+    virtual void addResult(const SimpleString& name, const BenchmarkResult& result);
+    virtual void addSample(const SimpleString& name, double nanosecondsPerOperation);
+    virtual size_t size() const;
+
+    virtual bool read(const SimpleString& fileName);
+    virtual bool write(const SimpleString& fileName) const;
+    virtual size_t compare(const BenchmarkBaseline& baseline, TestOutput& output, double maximumSlowdown) const;
+
+    static double mannWhitneyZ(const double* samples, size_t count, const double* baselineSamples, size_t baselineCount);
+
+private:
+    struct Entry
+    {
+        char* name;
+        double* samples;
+        size_t count;
+        size_t capacity;
+        Entry* next;
+    };
+
+    Entry* first_;
+    Entry* last_;
+    size_t size_;
+
+    Entry* findEntry(const SimpleString& name) const;
+    Entry* findOrCreateEntry(const SimpleString& name);
+    void parseLine(const SimpleString& line);
+
+    BenchmarkBaseline(const BenchmarkBaseline&);
+    BenchmarkBaseline& operator=(const BenchmarkBaseline&);
+};
+
+#endif
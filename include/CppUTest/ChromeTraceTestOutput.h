@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_ChromeTraceTestOutput_h
+#define D_ChromeTraceTestOutput_h
+
+#include "TestOutput.h"
+#include "SimpleString.h"
+#include "PlatformSpecificFunctions_c.h"
+
+/*
+ * Writes the test run in the Chrome trace-event format, to be loaded in
+ * chrome://tracing or Perfetto. Groups, tests and the phases of a test
+ * (plugins, setup, body, teardown) become nested duration slices.
+ *
+ * Events are written as they complete and the file is flushed after every
+ * test and group, so the file is a JSON array that grows during the run;
+ * viewers accept it even when the run crashed before the closing bracket.
+ * Phases of tests run in a separate process (-p) are written by the child
+ * process on a track of their own.
+ */
+class ChromeTraceTestOutput : public TestOutput
+{
+public:
+    ChromeTraceTestOutput(const SimpleString& fileName = "cpputest_trace.json");
+    virtual ~ChromeTraceTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+    /* Writes to cpputest_trace_<package>.json instead, like the JUnit outputs use the package in their file names */
+    void setPackageName(const SimpleString& package);
+
+    virtual void printTestsStarted() CPPUTEST_OVERRIDE;
+    virtual void printTestsEnded(const TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseStarted(const char* phase) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseEnded(const char* phase) CPPUTEST_OVERRIDE;
+
+    virtual void printBuffer(const char*) CPPUTEST_OVERRIDE;
+    virtual void flush() CPPUTEST_OVERRIDE;
+
+    enum Track { TESTS_TRACK = 1, SEPARATE_PROCESS_TRACK = 2 };
+
+protected:
+    virtual void openFile(const char* mode);
+    virtual void writeToFile(const SimpleString& buffer);
+    virtual void closeFile();
+
+    virtual void writeTrackName(Track track, const char* name);
+    virtual void writeSlice(const SimpleString& name, const char* category, unsigned long startTime, Track track);
+    virtual SimpleString encodeJsonText(const SimpleString& text);
+
+private:
+    enum { MAXIMUM_PHASE_DEPTH = 8 };
+
+    SimpleString fileName_;
+    PlatformSpecificFile file_;
+
+    SimpleString groupName_;
+    unsigned long groupStartTime_;
+    bool groupRanTests_;
+    SimpleString testName_;
+    unsigned long testStartTime_;
+    bool testRunsInSeparateProcess_;
+
+    const char* phases_[MAXIMUM_PHASE_DEPTH];
+    unsigned long phaseStartTimes_[MAXIMUM_PHASE_DEPTH];
+    int phaseDepth_;
+};
+
+#endif
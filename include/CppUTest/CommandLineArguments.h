@@ -49,17 +49,34 @@ public:
     bool isListingTestGroupAndCaseNames() const;
     bool isListingTestLocations() const;
     bool isRunIgnored() const;
+    bool isRunningBenchmarks() const;
     size_t getRepeatCount() const;
     bool isShuffling() const;
     bool isReversing() const;
     bool isCrashingOnFail() const;
     bool isRethrowingExceptions() const;
+    bool isFailFast() const;
+    bool isRunningFailedTestsFirst() const;
+    const SimpleString& getFailedTestsFile() const;
+    unsigned int getTimeout() const;
+    bool isReportingStatistics() const;
+    size_t getUnstablePercentage() const;
+    bool isSavingBenchmarkBaseline() const;
+    const SimpleString& getSaveBaselineFile() const;
+    bool isComparingBenchmarkBaseline() const;
+    const SimpleString& getCompareBaselineFile() const;
+    size_t getMaximumSlowdownPercentage() const;
     size_t getShuffleSeed() const;
     const TestFilter* getGroupFilters() const;
     const TestFilter* getNameFilters() const;
     bool isJUnitOutput() const;
+    bool isJUnitSingleFileOutput() const;
     bool isEclipseOutput() const;
     bool isTeamCityOutput() const;
+    bool isChromeTraceOutput() const;
+    bool isResultLogOutput() const;
+    bool isTapOutput() const;
+    bool isJsonLinesOutput() const;
     bool runTestsInSeperateProcess() const;
     const SimpleString& getPackageName() const;
     const char* usage() const;
@@ -69,7 +86,7 @@ private:
 
     enum OutputType
     {
-        OUTPUT_ECLIPSE, OUTPUT_JUNIT, OUTPUT_TEAMCITY
+        OUTPUT_ECLIPSE, OUTPUT_JUNIT, OUTPUT_JUNIT_SINGLE_FILE, OUTPUT_TEAMCITY, OUTPUT_CHROMETRACE, OUTPUT_RESULT_LOG, OUTPUT_TAP, OUTPUT_JSON_LINES
     };
 
     int ac_;
@@ -84,17 +101,27 @@ private:
     bool listTestGroupAndCaseNames_;
     bool listTestLocations_;
     bool runIgnored_;
+    bool runBenchmarks_;
     bool reversing_;
     bool crashOnFail_;
     bool rethrowExceptions_;
+    bool failFast_;
+    bool runFailedTestsFirst_;
     bool shuffling_;
     bool shufflingPreSeeded_;
     size_t repeat_;
     size_t shuffleSeed_;
+    unsigned int timeout_;
+    bool reportStatistics_;
+    size_t unstablePercentage_;
+    size_t maximumSlowdownPercentage_;
     TestFilter* groupFilters_;
     TestFilter* nameFilters_;
     OutputType outputType_;
     SimpleString packageName_;
+    SimpleString failedTestsFile_;
+    SimpleString saveBaselineFile_;
+    SimpleString compareBaselineFile_;
 
     SimpleString getParameterField(int ac, const char *const *av, int& i, const SimpleString& parameterName);
     void setRepeatCount(int ac, const char *const *av, int& index);
@@ -111,6 +138,11 @@ private:
     void addTestToRunBasedOnVerboseOutput(int ac, const char *const *av, int& index, const char* parameterName);
     bool setOutputType(int ac, const char *const *av, int& index);
     void setPackageName(int ac, const char *const *av, int& index);
+    bool setFailedTestsFirst(const SimpleString& argument);
+    bool setTimeout(const SimpleString& argument);
+    bool setStatistics(const SimpleString& argument);
+    bool setBaselineFile(const SimpleString& argument, const SimpleString& option, SimpleString& file);
+    bool setMaximumSlowdown(const SimpleString& argument);
 
     CommandLineArguments(const CommandLineArguments&);
     CommandLineArguments& operator=(const CommandLineArguments&);
@@ -34,6 +34,7 @@
 #include "TestFilter.h"
 
 class TestRegistry;
+class BenchmarkBaseline;
 
 #define DEF_PLUGIN_MEM_LEAK "MemoryLeakPlugin"
 #define DEF_PLUGIN_SET_POINTER "SetPointerPlugin"
@@ -52,6 +53,11 @@ public:
 protected:
     virtual TestOutput* createTeamCityOutput();
     virtual TestOutput* createJUnitOutput(const SimpleString& packageName);
+    virtual TestOutput* createJUnitSingleFileOutput(const SimpleString& packageName);
+    virtual TestOutput* createChromeTraceOutput(const SimpleString& packageName);
+    virtual TestOutput* createResultLogOutput();
+    virtual TestOutput* createTapOutput();
+    virtual TestOutput* createJsonLinesOutput();
     virtual TestOutput* createConsoleOutput();
     virtual TestOutput* createCompositeOutput(TestOutput* outputOne, TestOutput* outputTwo);
 
@@ -63,6 +69,10 @@ private:
     bool parseArguments(TestPlugin*);
     int runAllTests();
     void initializeTestRun();
+    void readFailedTests(SimpleStringCollection& failedTests);
+    void writeFailedTests(const SimpleString& failedTests);
+    void saveBenchmarkBaseline(const BenchmarkBaseline& benchmarks);
+    size_t compareBenchmarkBaseline(const BenchmarkBaseline& benchmarks);
 };
 
 #endif
@@ -171,6 +171,30 @@
  #endif
 #endif
 
+/*
+ * Hardware performance counters via perf_event_open, used by the
+ * PerformanceCounterPlugin. Linux only.
+ */
+#ifndef CPPUTEST_HAVE_PERF_EVENT
+  #if defined(__linux__) && CPPUTEST_USE_STD_C_LIB
+    #define CPPUTEST_HAVE_PERF_EVENT 1
+  #else
+    #define CPPUTEST_HAVE_PERF_EVENT 0
+  #endif
+#endif
+
+/*
+ * Per-process resource usage via getrusage, used by the
+ * ResourceUsagePlugin.
+ */
+#ifndef CPPUTEST_HAVE_GETRUSAGE
+  #if (defined(__unix__) || defined(__APPLE__)) && CPPUTEST_USE_STD_C_LIB
+    #define CPPUTEST_HAVE_GETRUSAGE 1
+  #else
+    #define CPPUTEST_HAVE_GETRUSAGE 0
+  #endif
+#endif
+
 #ifdef __cplusplus
   /*
    * Detection of run-time type information (RTTI) presence. Since it's a
@@ -52,6 +52,7 @@ public:
     virtual void print(long) CPPUTEST_OVERRIDE;
     virtual void print(size_t) CPPUTEST_OVERRIDE;
     virtual void printFailure(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value) CPPUTEST_OVERRIDE;
 
     virtual void flush() CPPUTEST_OVERRIDE;
 
@@ -75,7 +76,56 @@ protected:
     virtual SimpleString encodeXmlText(const SimpleString& textbody);
     virtual SimpleString encodeFileName(const SimpleString& fileName);
     virtual void writeFailure(JUnitTestCaseResultNode* node);
+    virtual void writeTestCaseProperties(JUnitTestCaseResultNode* node);
     virtual void writeFileEnding();
 };
 
+/*
+ * Streams all groups into one <testsuites> document, cpputest.xml (or
+ * cpputest_<package>.xml), instead of writing a file per group. Every
+ * testcase is written when its test ends, through a fixed size write
+ * buffer, so memory use does not grow with the size of a group. The
+ * price is that <testsuite> elements carry no totals; JUnit consumers
+ * count the testcases themselves.
+ */
+class JUnitSingleFileTestOutput : public JUnitTestOutput
+{
+public:
+    JUnitSingleFileTestOutput();
+    virtual ~JUnitSingleFileTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+    virtual void printTestsStarted() CPPUTEST_OVERRIDE;
+    virtual void printTestsEnded(const TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+
+    virtual void printFailure(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value) CPPUTEST_OVERRIDE;
+
+    virtual SimpleString createSingleFileName();
+
+protected:
+    virtual void writeToFile(const SimpleString& buffer) CPPUTEST_OVERRIDE;
+    virtual void closeFile() CPPUTEST_OVERRIDE;
+    virtual void flushWriteBuffer();
+    virtual void writeStdOutput();
+
+private:
+    enum { WRITE_BUFFER_SIZE = 4096 };
+    char writeBuffer_[WRITE_BUFFER_SIZE];
+    size_t writeBufferUsed_;
+    bool fileIsOpen_;
+
+    SimpleString group_;
+    SimpleString testName_;
+    SimpleString testFile_;
+    size_t testLineNumber_;
+    bool testIgnored_;
+    size_t checkCountBeforeTest_;
+    SimpleString testFailure_;
+    SimpleString testProperties_;
+};
+
 #endif
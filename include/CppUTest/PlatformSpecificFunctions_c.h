@@ -48,13 +48,23 @@ extern void (*PlatformSpecificRestoreJumpBuffer)(void);
 
 /* Time operations */
 extern unsigned long (*GetPlatformSpecificTimeInMillis)(void);
+extern unsigned long (*GetPlatformSpecificTimeInMicros)(void);
 extern const char* (*GetPlatformSpecificTimeString)(void);
 
+/*
+ * Once the given number of seconds passed, writes message to the standard output and ends the
+ * process with a failure. This happens asynchronously (e.g. in a signal handler), so the message
+ * must stay valid while the watchdog is armed. The failure is not recorded in the TestResult, so
+ * only a test run in a separate process is reported as failed. 0 seconds cancels it.
+ */
+extern void (*PlatformSpecificSetWatchdog)(unsigned int seconds, const char* message);
+
 /* String operations */
 extern int (*PlatformSpecificVSNprintf)(char *str, size_t size, const char* format, va_list va_args_list);
 
 /* Misc */
 extern double (*PlatformSpecificFabs)(double d);
+extern double (*PlatformSpecificSqrt)(double d);
 extern int (*PlatformSpecificIsNan)(double d);
 extern int (*PlatformSpecificIsInf)(double d);
 extern int (*PlatformSpecificAtExit)(void(*func)(void));
@@ -66,7 +76,9 @@ extern PlatformSpecificFile PlatformSpecificStdOut;
 
 extern PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag);
 extern void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file);
+extern char* (*PlatformSpecificFGets)(char* str, int size, PlatformSpecificFile file);
 extern void (*PlatformSpecificFClose)(PlatformSpecificFile file);
+extern void (*PlatformSpecificFFlush)(PlatformSpecificFile file);
 
 extern void (*PlatformSpecificFlush)(void);
 
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef D_ResultLogTestOutput_h
+#define D_ResultLogTestOutput_h
+
+#include "TestOutput.h"
+#include "TestResult.h"
+#include "SimpleString.h"
+#include "PlatformSpecificFunctions_c.h"
+
+/*
+ * Records the test run in a compact, append-only log, to be rendered later
+ * as console, JUnit or TeamCity output (see ResultLogReader and the
+ * CppUTestResultLogConverter tool).
+ *
+ * The log starts with a signature line followed by records of a type
+ * character, a payload length and the payload. Numbers are ZeroFreeNumbers
+ * (never containing a zero byte), so records can be written with the normal
+ * string functions. Group and file names are written once and referred to
+ * by number. Records are buffered, consecutive output is written as one
+ * record, and the buffer is written out and flushed after every group and
+ * failure, so a run that crashes leaves a log that can be read up to the
+ * last group it finished or failure it found.
+ * The file stays open except while a test runs in a separate process.
+ */
+class ResultLogTestOutput : public TestOutput
+{
+public:
+    ResultLogTestOutput(const SimpleString& fileName = "cpputest_results.log");
+    virtual ~ResultLogTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+    virtual void printTestsStarted() CPPUTEST_OVERRIDE;
+    virtual void printTestsEnded(const TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseStarted(const char* phase) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseEnded(const char* phase) CPPUTEST_OVERRIDE;
+
+    virtual void printFailure(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value) CPPUTEST_OVERRIDE;
+
+    virtual void printBuffer(const char*) CPPUTEST_OVERRIDE;
+    virtual void flush() CPPUTEST_OVERRIDE;
+
+    enum RecordType {
+        STRING = 'S', TESTS_STARTED = 'B', GROUP_STARTED = 'G', TEST_STARTED = 'T', OUTPUT = 'O',
+        PROPERTY = 'P', FAILURE = 'F', TEST_ENDED = 'E', GROUP_ENDED = 'g', TESTS_ENDED = 'Z'
+    };
+
+    static const char* signature();
+
+protected:
+    virtual void openFile(const char* mode);
+    virtual void writeToFile(const SimpleString& buffer);
+    virtual void closeFile();
+
+    virtual void writeRecord(RecordType type, const SimpleString& payload);
+    void writePendingOutput();
+    void writeBufferedRecords();
+    virtual SimpleString encodeCounts(const TestResult& result);
+    virtual unsigned long internString(const SimpleString& text);
+    unsigned long timeSinceStart();
+
+private:
+    SimpleString fileName_;
+    PlatformSpecificFile file_;
+    unsigned long startTime_;
+
+    SimpleStringIndex strings_;
+
+    enum { BUFFER_SIZE = 4096 };
+    char buffer_[BUFFER_SIZE];
+    size_t bufferedLength_;
+    SimpleString pendingOutput_;
+
+    bool testRunsInSeparateProcess_;
+    int phaseDepth_;
+
+    ResultLogTestOutput(const ResultLogTestOutput&);
+    ResultLogTestOutput& operator=(const ResultLogTestOutput&);
+};
+
+class ReplayedUtestShell;
+
+/*
+ * The outputs take their durations from the TestResult, so the result of a
+ * replayed log reads the recorded time instead of the clock.
+ */
+class ReplayedTestResult : public TestResult
+{
+public:
+    ReplayedTestResult(TestOutput& output);
+
+    void setTimeInMillis(unsigned long time);
+
+protected:
+    virtual size_t getTimeInMillis() const CPPUTEST_OVERRIDE;
+
+private:
+    unsigned long timeInMillis_;
+};
+
+/*
+ * Reads a log written by ResultLogTestOutput and replays it into a
+ * TestOutput, with the recorded counts and durations. A log that ends in the
+ * middle of a run is replayed as far as it goes.
+ */
+class ResultLogReader
+{
+public:
+    ResultLogReader(TestOutput& output);
+    virtual ~ResultLogReader();
+
+    virtual bool replayFile(const char* fileName);
+    virtual void replay(const char* data);
+    virtual void finish();
+
+    bool isValid() const;
+    bool isComplete() const;
+    const TestResult& getResult() const;
+
+protected:
+    virtual void replayRecord(char type, const char* payload, const char* end);
+
+private:
+    ReplayedTestResult result_;
+    SimpleString pending_;
+    bool signatureRead_;
+    bool valid_;
+    bool complete_;
+
+    SimpleStringIndex strings_;
+
+    ReplayedUtestShell* currentGroup_;
+    ReplayedUtestShell* currentTest_;
+    bool testsStarted_;
+    bool testInProgress_;
+
+    SimpleString stringWithId(unsigned long id) const;
+    bool readCounts(const char*& payload, const char* end);
+    void finishIncompleteRun();
+
+    ResultLogReader(const ResultLogReader&);
+    ResultLogReader& operator=(const ResultLogReader&);
+};
+
+#endif
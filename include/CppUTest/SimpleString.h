@@ -103,6 +103,11 @@ public:
     static const char* StrStr(const char* s1, const char* s2);
     static char ToLower(char ch);
     static int MemCmp(const void* s1, const void *s2, size_t n);
+
+    /* FNV-1a, for the hash tables of names. Passing a previous result continues that hash. */
+    static const size_t hashStart = 2166136261u;
+    static size_t Hash(const char* str, size_t hash = hashStart);
+    static size_t Hash(const char* str, size_t length, size_t hash);
     static char* allocStringBuffer(size_t size, const char* file, size_t line);
     static void deallocStringBuffer(char* str, size_t size, const char* file, size_t line);
 private:
@@ -153,6 +158,37 @@ private:
     SimpleStringCollection(SimpleStringCollection&);
 };
 
+/*
+ * Distinct strings, numbered in the order they were added, with a hashed
+ * lookup of the number of a string.
+ */
+class SimpleStringIndex
+{
+public:
+    SimpleStringIndex();
+    ~SimpleStringIndex();
+
+    size_t add(const SimpleString& string);
+    size_t find(const SimpleString& string) const;
+    void clear();
+
+    size_t size() const;
+    const SimpleString& operator[](size_t index) const;
+
+private:
+    SimpleString* strings_;
+    size_t size_;
+    size_t capacity_;
+    size_t* buckets_;
+    size_t bucketMask_;
+
+    size_t* findBucket(const SimpleString& string) const;
+    void grow();
+
+    void operator =(SimpleStringIndex&);
+    SimpleStringIndex(SimpleStringIndex&);
+};
+
 class GlobalSimpleStringAllocatorStash
 {
 public:
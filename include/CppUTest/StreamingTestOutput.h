@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef D_StreamingTestOutput_h
+#define D_StreamingTestOutput_h
+
+#include "TestOutput.h"
+#include "SimpleString.h"
+
+/*
+ * Base of the outputs that write one record to stdout per test as it ends,
+ * for tools that read the output while the run goes on. Records are
+ * formatted straight into the console buffer. Only failures and text
+ * printed by a test are kept until the test ends.
+ *
+ * A failure in the child process of -p cannot reach the record of its
+ * parent, so it is written as a record of its own.
+ */
+class StreamingTestOutput : public ConsoleTestOutput
+{
+public:
+    explicit StreamingTestOutput();
+    virtual ~StreamingTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+    virtual void printTestsStarted() CPPUTEST_OVERRIDE;
+    virtual void printTestsEnded(const TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentGroupEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseStarted(const char* phase) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseEnded(const char* phase) CPPUTEST_OVERRIDE;
+
+    virtual void printFailure(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value) CPPUTEST_OVERRIDE;
+    virtual void printBuffer(const char* s) CPPUTEST_OVERRIDE;
+
+protected:
+    virtual void writeTestsStarted() = 0;
+    virtual void writeTestRecord() = 0;
+    virtual void writeTestsEnded(const TestResult& result) = 0;
+    virtual void writeFailureRecord(const TestFailure& failure) = 0;
+    virtual void writeOutputRecord(const char* text) = 0;
+
+    void write(const char* text);
+    void writeNumber(size_t number);
+    void writeQuoted(const char* text);
+    void writeTestName();
+
+    bool isInsideTest() const;
+
+    const UtestShell* test_;
+    size_t testNumber_;
+    size_t duration_;
+    size_t checks_;
+    size_t failureCount_;
+    SimpleString failureFile_;
+    size_t failureLine_;
+    SimpleString failureMessage_;
+    SimpleString output_;
+
+private:
+    size_t checksBeforeTest_;
+    int phaseDepth_;
+
+    bool isInsideChildProcess() const;
+};
+
+/*
+ * Test Anything Protocol, version 13. Every test gets a YAML block with its
+ * location, duration, checks and failure. The plan comes at the end.
+ */
+class TapTestOutput : public StreamingTestOutput
+{
+public:
+    explicit TapTestOutput();
+    virtual ~TapTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+protected:
+    virtual void writeTestsStarted() CPPUTEST_OVERRIDE;
+    virtual void writeTestRecord() CPPUTEST_OVERRIDE;
+    virtual void writeTestsEnded(const TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void writeFailureRecord(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void writeOutputRecord(const char* text) CPPUTEST_OVERRIDE;
+};
+
+/*
+ * JSON Lines: a "test" object per test, "failure" and "output" objects for
+ * what happens outside of a test record and a "summary" object at the end.
+ */
+class JsonLinesTestOutput : public StreamingTestOutput
+{
+public:
+    explicit JsonLinesTestOutput();
+    virtual ~JsonLinesTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+protected:
+    virtual void writeTestsStarted() CPPUTEST_OVERRIDE;
+    virtual void writeTestRecord() CPPUTEST_OVERRIDE;
+    virtual void writeTestsEnded(const TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void writeFailureRecord(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void writeOutputRecord(const char* text) CPPUTEST_OVERRIDE;
+
+private:
+    void writeField(const char* name, const char* value);
+    void writeField(const char* name, size_t value);
+};
+
+#endif
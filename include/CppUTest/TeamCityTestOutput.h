@@ -16,6 +16,7 @@ public:
     virtual void printCurrentGroupEnded(const TestResult& res) CPPUTEST_OVERRIDE;
 
     virtual void printFailure(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value) CPPUTEST_OVERRIDE;
 
 protected:
 
@@ -50,7 +50,12 @@ public:
     bool operator!=(const TestFilter& filter) const;
 
     SimpleString asString() const;
+
+    static bool isGlob(const char* filter);
+    static bool globMatch(const char* pattern, const char* name, bool strict);
 private:
+    friend class TestFilterMatcher;
+
     SimpleString filter_;
     bool strictMatching_;
     bool invertMatching_;
@@ -59,5 +64,80 @@ private:
 
 SimpleString StringFrom(const TestFilter& filter);
 
+/*
+ * A list of TestFilters compiled into one matcher. Substring filters share an
+ * Aho-Corasick automaton and strict filters a hash set, so matching a name
+ * costs one pass over its characters however many filters there are. Glob
+ * filters are matched one by one. match() returns true when any filter of
+ * the list matches, or when there are no filters at all.
+ */
+class TestFilterMatcher
+{
+public:
+    TestFilterMatcher();
+    explicit TestFilterMatcher(const TestFilter* filters);
+    ~TestFilterMatcher();
+
+    void compile(const TestFilter* filters);
+    void clear();
+
+    bool match(const char* name) const;
+
+private:
+    enum { MATCH_INCLUDE = 1, MATCH_EXCLUDE = 2 };
+
+    struct Glob
+    {
+        const char* pattern;
+        bool strict;
+        bool invert;
+    };
+
+    char* addPattern(const SimpleString& pattern);
+    void addSubstring(const char* pattern, unsigned char flag);
+    void addExact(const char* pattern, unsigned char flag);
+    void buildFailureLinks();
+
+    size_t findEdge(size_t node, unsigned char ch) const;
+    void addEdge(size_t node, unsigned char ch, size_t target);
+    size_t* findExactBucket(const char* name) const;
+
+    bool matchExact(const char* name) const;
+    bool matchSubstrings(const char* name) const;
+    bool matchGlobs(const char* name) const;
+
+    bool hasFilters_;
+
+    char* patterns_;
+    size_t patternsSize_;
+
+    size_t nodeCount_;
+    unsigned char* nodeFlags_;
+    size_t* nodeFail_;
+    size_t* nodeOutput_;
+    size_t* nodeFirstChild_;
+    size_t* nodeNextSibling_;
+    unsigned char* nodeChar_;
+    size_t* edgeKeys_;
+    size_t* edgeTargets_;
+    size_t edgeMask_;
+    size_t excludeSubstringCount_;
+    mutable size_t* seen_;
+    mutable size_t generation_;
+
+    const char** exactNames_;
+    unsigned char* exactFlags_;
+    size_t exactCount_;
+    size_t* exactBuckets_;
+    size_t exactMask_;
+    size_t excludeExactCount_;
+
+    Glob* globs_;
+    size_t globCount_;
+
+    TestFilterMatcher(const TestFilterMatcher&);
+    TestFilterMatcher& operator=(const TestFilterMatcher&);
+};
+
 #endif
 
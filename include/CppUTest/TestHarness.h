@@ -43,4 +43,5 @@
 #include "TestFailure.h"
 #include "TestPlugin.h"
 #include "MemoryLeakWarningPlugin.h"
+#include "Benchmark.h"
 #endif
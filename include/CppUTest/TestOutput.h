@@ -42,6 +42,7 @@
 class UtestShell;
 class TestFailure;
 class TestResult;
+struct BenchmarkResult;
 
 class TestOutput
 {
@@ -58,6 +59,8 @@ public:
     virtual void printCurrentTestEnded(const TestResult& res);
     virtual void printCurrentGroupStarted(const UtestShell& test);
     virtual void printCurrentGroupEnded(const TestResult& res);
+    virtual void printCurrentTestPhaseStarted(const char* phase);
+    virtual void printCurrentTestPhaseEnded(const char* phase);
 
     virtual void verbose(VerbosityLevel level);
     virtual void color();
@@ -67,6 +70,8 @@ public:
     virtual void print(size_t);
     virtual void printDouble(double);
     virtual void printFailure(const TestFailure& failure);
+    virtual void printBenchmark(const UtestShell& test, const BenchmarkResult& result);
+    virtual void printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value);
     virtual void printTestRun(size_t number, size_t total);
     virtual void setProgressIndicator(const char*);
 
@@ -114,17 +119,37 @@ TestOutput& operator<<(TestOutput&, long);
 class ConsoleTestOutput: public TestOutput
 {
 public:
-    explicit ConsoleTestOutput()
-    {
-    }
-    virtual ~ConsoleTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE
-    {
-    }
+    explicit ConsoleTestOutput();
+    virtual ~ConsoleTestOutput() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+    virtual void printTestsEnded(const TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseStarted(const char* phase) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseEnded(const char* phase) CPPUTEST_OVERRIDE;
+    virtual void printFailure(const TestFailure& failure) CPPUTEST_OVERRIDE;
 
     virtual void printBuffer(const char* s) CPPUTEST_OVERRIDE;
     virtual void flush() CPPUTEST_OVERRIDE;
 
+    /*
+     * Output is collected and handed to stdout when the buffer is full, when a test
+     * phase starts and at least every flush interval. 0 writes every fragment directly.
+     * Failures and tests that may end the process (-p, --timeout) are flushed right away.
+     */
+    virtual void setFlushIntervalInMillis(unsigned long interval);
+
+protected:
+    virtual void writeBufferedOutput();
+    void flushWhenTheTestMayEndTheProcess(const UtestShell& test);
+
 private:
+    enum { OUTPUT_BUFFER_SIZE = 8192 };
+    char buffer_[OUTPUT_BUFFER_SIZE];
+    size_t bufferUsed_;
+    unsigned long flushIntervalInMillis_;
+    unsigned long lastFlushTime_;
+    bool currentTestMayEndTheProcess_;
+
     ConsoleTestOutput(const ConsoleTestOutput&);
     ConsoleTestOutput& operator=(const ConsoleTestOutput&);
 };
@@ -187,6 +212,8 @@ public:
     virtual void printCurrentTestEnded(const TestResult& res) CPPUTEST_OVERRIDE;
     virtual void printCurrentGroupStarted(const UtestShell& test) CPPUTEST_OVERRIDE;
     virtual void printCurrentGroupEnded(const TestResult& res) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseStarted(const char* phase) CPPUTEST_OVERRIDE;
+    virtual void printCurrentTestPhaseEnded(const char* phase) CPPUTEST_OVERRIDE;
 
     virtual void verbose(VerbosityLevel level) CPPUTEST_OVERRIDE;
     virtual void color() CPPUTEST_OVERRIDE;
@@ -196,6 +223,8 @@ public:
     virtual void print(size_t) CPPUTEST_OVERRIDE;
     virtual void printDouble(double) CPPUTEST_OVERRIDE;
     virtual void printFailure(const TestFailure& failure) CPPUTEST_OVERRIDE;
+    virtual void printBenchmark(const UtestShell& test, const BenchmarkResult& result) CPPUTEST_OVERRIDE;
+    virtual void printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value) CPPUTEST_OVERRIDE;
     virtual void setProgressIndicator(const char*) CPPUTEST_OVERRIDE;
 
     virtual void printVeryVerbose(const char*) CPPUTEST_OVERRIDE;
@@ -53,8 +53,17 @@ public:
         return false;
     }
 
+    /*
+     * Called once after all tests of a run are done, including all its -r repetitions. With -p the
+     * test actions run in the separate processes, so whatever they collected is not seen here.
+     */
+    virtual void postRunAction(TestResult&)
+    {
+    }
+
     virtual void runAllPreTestAction(UtestShell&, TestResult&);
     virtual void runAllPostTestAction(UtestShell&, TestResult&);
+    virtual void runAllPostRunAction(TestResult&);
     virtual bool parseAllArguments(int ac, const char *const *av, int index);
     virtual bool parseAllArguments(int ac, char** av, int index);
 
@@ -116,6 +125,7 @@ public:
 
     virtual void runAllPreTestAction(UtestShell& test, TestResult& result) CPPUTEST_OVERRIDE;
     virtual void runAllPostTestAction(UtestShell& test, TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void runAllPostRunAction(TestResult& result) CPPUTEST_OVERRIDE;
 
     static NullTestPlugin* instance();
 };
@@ -40,6 +40,72 @@
 class UtestShell;
 class TestResult;
 class TestPlugin;
+class TestGroupTimeout;
+
+/*
+ * Contiguous snapshot of the registered tests, built once after registration.
+ * Groups are interned in order of first appearance, so listing, lookup and
+ * grouping are linear in the number of tests instead of walking the chain
+ * (and comparing strings) for every test. The index keeps its own copy of the
+ * names, so renaming a test later does not leave it pointing at a stale name.
+ */
+class TestRegistryIndex
+{
+public:
+    TestRegistryIndex();
+    ~TestRegistryIndex();
+
+    void build(UtestShell* firstTest);
+    void clear();
+    bool isBuilt() const;
+
+    size_t count() const;
+    UtestShell* get(size_t index) const;
+    bool isFirstWithGroupAndName(size_t index) const;
+
+    size_t countGroups() const;
+    const char* getGroupName(size_t groupIndex) const;
+
+    UtestShell* findTestWithName(const char* name) const;
+    UtestShell* findTestWithGroup(const char* group) const;
+    size_t indexOf(const char* group, const char* name) const;
+
+private:
+    struct Entry
+    {
+        UtestShell* test;
+        const char* name;
+        size_t group;
+        bool firstWithGroupAndName;
+    };
+
+    static bool equal(const char* s1, const char* s2);
+
+    const char* copyName(const char* name);
+    void add(UtestShell* test, const char* group, const char* name);
+    size_t* findGroupBucket(const char* group) const;
+    size_t* findNameBucket(const char* name) const;
+    size_t* findGroupAndNameBucket(size_t group, const char* name) const;
+
+    bool built_;
+    Entry* entries_;
+    size_t count_;
+
+    char* names_;
+    char* namesEnd_;
+
+    const char** groupNames_;
+    size_t* groupFirstTest_;
+    size_t groupCount_;
+
+    size_t* groupBuckets_;
+    size_t* nameBuckets_;
+    size_t* groupAndNameBuckets_;
+    size_t bucketMask_;
+
+    TestRegistryIndex(const TestRegistryIndex&);
+    TestRegistryIndex& operator=(const TestRegistryIndex&);
+};
 
 class TestRegistry
 {
@@ -53,6 +119,7 @@ public:
     virtual void runAllTests(TestResult& result);
     virtual void shuffleTests(size_t seed);
     virtual void reverseTests();
+    virtual void moveTestsToFront(SimpleStringCollection& groupDotNames);
     virtual void listTestGroupNames(TestResult& result);
     virtual void listTestGroupAndCaseNames(TestResult& result);
     virtual void listTestLocations(TestResult& result);
@@ -77,20 +144,32 @@ public:
     virtual void setRunTestsInSeperateProcess();
     int getCurrentRepetition();
     void setRunIgnored();
+    void setRunBenchmarks();
+    void setFailFast();
+    void setTimeout(unsigned int seconds);
+    virtual void addGroupTimeout(TestGroupTimeout* groupTimeout);
 
 private:
 
     bool testShouldRun(UtestShell* test, TestResult& result);
     bool endOfGroup(UtestShell* test);
+    unsigned int getTimeoutFor(UtestShell* test);
+    TestRegistryIndex& getIndex();
+    void invalidateIndex();
 
     UtestShell * tests_;
-    const TestFilter* nameFilters_;
-    const TestFilter* groupFilters_;
+    TestRegistryIndex index_;
+    TestFilterMatcher nameMatcher_;
+    TestFilterMatcher groupMatcher_;
     TestPlugin* firstPlugin_;
     static TestRegistry* currentRegistry_;
     bool runInSeperateProcess_;
     int currentRepetition_;
     bool runIgnored_;
+    bool runBenchmarks_;
+    bool failFast_;
+    unsigned int timeout_;
+    TestGroupTimeout* groupTimeouts_;
 };
 
 #endif
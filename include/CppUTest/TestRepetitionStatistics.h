@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_TestRepetitionStatistics_h
+#define D_TestRepetitionStatistics_h
+
+#include "StandardCLibrary.h"
+
+class UtestShell;
+class TestOutput;
+
+struct TestRepetitionSummary
+{
+    size_t samples;
+    size_t min;
+    size_t median;
+    size_t p95;
+    size_t p99;
+    size_t max;
+    double mean;
+    double coefficientOfVariation;
+};
+
+/*
+ * Collects the execution time of every test in microseconds over the
+ * repetitions of -r, so that slow and unstable tests stand out. Percentiles
+ * use the nearest rank and the coefficient of variation is the standard
+ * deviation over the mean.
+ */
+class TestRepetitionStatistics
+{
+public:
+    TestRepetitionStatistics();
+    virtual ~TestRepetitionStatistics();
+
+    virtual void addSample(UtestShell* test, size_t microseconds);
+    virtual bool getSummary(UtestShell* test, TestRepetitionSummary& summary) const;
+    virtual void print(TestOutput& output, UtestShell* tests, double unstableCoefficientOfVariation) const;
+
+private:
+    struct Entry
+    {
+        UtestShell* test;
+        size_t* samples;
+        size_t count;
+        size_t capacity;
+    };
+
+    Entry* entries_;
+    size_t entryCount_;
+    size_t bucketMask_;
+
+    Entry* findEntry(UtestShell* test) const;
+    void grow();
+
+    TestRepetitionStatistics(const TestRepetitionStatistics&);
+    TestRepetitionStatistics& operator=(const TestRepetitionStatistics&);
+};
+
+#endif
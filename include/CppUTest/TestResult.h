@@ -37,6 +37,7 @@
 class TestFailure;
 class TestOutput;
 class UtestShell;
+struct BenchmarkResult;
 
 class TestResult
 {
@@ -51,6 +52,8 @@ public:
     virtual void currentGroupEnded(UtestShell* test);
     virtual void currentTestStarted(UtestShell* test);
     virtual void currentTestEnded(UtestShell* test);
+    virtual void currentTestPhaseStarted(const char* phase);
+    virtual void currentTestPhaseEnded(const char* phase);
 
     virtual void countTest();
     virtual void countRun();
@@ -58,6 +61,8 @@ public:
     virtual void countFilteredOut();
     virtual void countIgnored();
     virtual void addFailure(const TestFailure& failure);
+    virtual void addBenchmarkResult(const UtestShell& test, const BenchmarkResult& result);
+    virtual void addTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value);
     virtual void print(const char* text);
     virtual void printVeryVerbose(const char* text);
 
@@ -96,6 +101,10 @@ public:
 
     size_t getCurrentTestTotalExecutionTime() const;
     size_t getCurrentGroupTotalExecutionTime() const;
+
+protected:
+    virtual size_t getTimeInMillis() const;
+
 private:
 
     TestOutput& output_;
@@ -37,7 +37,9 @@ class TestResult;
 class TestPlugin;
 class TestFailure;
 class TestFilter;
+class TestFilterMatcher;
 class TestTerminator;
+struct BenchmarkResult;
 
 extern bool doubles_equal(double d1, double d2, double threshold);
 
@@ -119,6 +121,7 @@ public:
     virtual size_t countTests();
 
     bool shouldRun(const TestFilter* groupFilters, const TestFilter* nameFilters) const;
+    bool shouldRun(const TestFilterMatcher& groupMatcher, const TestFilterMatcher& nameMatcher) const;
     const SimpleString getName() const;
     const SimpleString getGroup() const;
     virtual SimpleString getFormattedName() const;
@@ -152,11 +155,15 @@ public:
     virtual void print(const char *text, const char *fileName, size_t lineNumber);
     virtual void print(const SimpleString & text, const char *fileName, size_t lineNumber);
     virtual void printVeryVerbose(const char* text);
+    virtual void testPhaseStarted(const char* phase);
+    virtual void testPhaseEnded(const char* phase);
 
     void setFileName(const char *fileName);
     void setLineNumber(size_t lineNumber);
     void setGroupName(const char *groupName);
     void setTestName(const char *testName);
+    const char* getGroupCharString() const;
+    const char* getNameCharString() const;
 
     static void crash();
     static void setCrashMethod(void (*crashme)());
@@ -165,7 +172,11 @@ public:
     virtual bool isRunInSeperateProcess() const;
     virtual void setRunInSeperateProcess();
 
+    unsigned int getTimeout() const;
+    void setTimeout(unsigned int seconds);
+
     virtual void setRunIgnored();
+    virtual void setRunBenchmarks();
 
     virtual Utest* createTest();
     virtual void destroyTest(Utest* test);
@@ -177,6 +188,7 @@ public:
     virtual void failWith(const TestFailure& failure, const TestTerminator& terminator);
 
     virtual void addFailure(const TestFailure& failure);
+    virtual void addBenchmarkResult(const BenchmarkResult& result);
 
 protected:
     UtestShell();
@@ -192,6 +204,7 @@ private:
     UtestShell *next_;
     bool isRunAsSeperateProcess_;
     bool hasFailed_;
+    unsigned int timeout_;
 
     void setTestResult(TestResult* result);
     void setCurrentTest(UtestShell* test);
@@ -293,6 +306,29 @@ private:
 
 };
 
+//////////////////// BenchmarkTest
+
+class BenchmarkUtestShell : public UtestShell
+{
+public:
+    BenchmarkUtestShell();
+    virtual ~BenchmarkUtestShell() CPPUTEST_DESTRUCTOR_OVERRIDE;
+    explicit BenchmarkUtestShell(const char* groupName, const char* testName,
+            const char* fileName, size_t lineNumber);
+    virtual bool willRun() const CPPUTEST_OVERRIDE;
+    virtual void setRunBenchmarks() CPPUTEST_OVERRIDE;
+protected:
+    virtual SimpleString getMacroName() const CPPUTEST_OVERRIDE;
+    virtual void runOneTest(TestPlugin* plugin, TestResult& result) CPPUTEST_OVERRIDE;
+private:
+
+    BenchmarkUtestShell(const BenchmarkUtestShell&);
+    BenchmarkUtestShell& operator=(const BenchmarkUtestShell&);
+
+    bool runBenchmarks_;
+
+};
+
 //////////////////// UtestShellPointerArray
 
 class UtestShellPointerArray
@@ -334,4 +370,33 @@ private:
 
 };
 
+//////////////////// TestGroupTimeout
+
+class TestGroupTimeout
+{
+public:
+    TestGroupTimeout(const char* groupName, unsigned int seconds);
+    virtual ~TestGroupTimeout();
+
+    const char* getGroup() const;
+    unsigned int getTimeout() const;
+
+    TestGroupTimeout* getNext() const;
+    TestGroupTimeout* addGroupTimeout(TestGroupTimeout* groupTimeout);
+
+private:
+    const char* group_;
+    unsigned int seconds_;
+    TestGroupTimeout* next_;
+
+    TestGroupTimeout(const TestGroupTimeout&);
+    TestGroupTimeout& operator=(const TestGroupTimeout&);
+};
+
+class TestGroupTimeoutInstaller : public TestGroupTimeout
+{
+public:
+    explicit TestGroupTimeoutInstaller(const char* groupName, unsigned int seconds);
+};
+
 #endif
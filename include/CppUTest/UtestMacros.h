@@ -49,6 +49,13 @@
 #define TEST_GROUP(testGroup) \
   TEST_GROUP_BASE(testGroup, Utest)
 
+/*
+ * Limits how long each test of the group may take, overriding --timeout.
+ * Use it at file scope, next to the TEST_GROUP.
+ */
+#define TEST_GROUP_TIMEOUT(testGroup, seconds) \
+  static TestGroupTimeoutInstaller TEST_GROUP_TIMEOUT_##testGroup##_Installer(#testGroup, seconds)
+
 #define TEST_SETUP() \
   virtual void setup() CPPUTEST_OVERRIDE
 
@@ -83,6 +90,25 @@
    static TestInstaller TEST_##testGroup##testName##_Installer(IGNORE##testGroup##_##testName##_TestShell_instance, #testGroup, #testName, __FILE__,__LINE__); \
     void IGNORE##testGroup##_##testName##_Test::testBody ()
 
+#define BENCHMARK(testGroup, testName)\
+  /* External declarations for strict compilers */ \
+  class BENCHMARK_##testGroup##_##testName##_TestShell; \
+  extern BENCHMARK_##testGroup##_##testName##_TestShell BENCHMARK_##testGroup##_##testName##_TestShell_instance; \
+  \
+  class BENCHMARK_##testGroup##_##testName##_Test : public TEST_GROUP_##CppUTestGroup##testGroup \
+{ public: BENCHMARK_##testGroup##_##testName##_Test () : TEST_GROUP_##CppUTestGroup##testGroup () {} \
+  public: void testBody() CPPUTEST_OVERRIDE { \
+      BenchmarkMethod<BENCHMARK_##testGroup##_##testName##_Test> benchmark(this, &BENCHMARK_##testGroup##_##testName##_Test::benchmarkBody); \
+      BenchmarkRunner::run(benchmark); } \
+  void benchmarkBody(); }; \
+  class BENCHMARK_##testGroup##_##testName##_TestShell : public BenchmarkUtestShell { \
+      virtual Utest* createTest() CPPUTEST_OVERRIDE { return new BENCHMARK_##testGroup##_##testName##_Test; } \
+  } BENCHMARK_##testGroup##_##testName##_TestShell_instance; \
+  static TestInstaller BENCHMARK_##testGroup##_##testName##_Installer(BENCHMARK_##testGroup##_##testName##_TestShell_instance, #testGroup, #testName, __FILE__,__LINE__); \
+    void BENCHMARK_##testGroup##_##testName##_Test::benchmarkBody()
+
+#define BENCHMARK_DO_NOT_OPTIMIZE(value) cpputestDoNotOptimize(value)
+
 #define IMPORT_TEST_GROUP(testGroup) \
   extern int externTestGroup##testGroup;\
   extern int* p##testGroup; \
@@ -60,6 +60,8 @@ public:
     virtual MockActualCall& withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value)=0;
     virtual MockActualCall& withOutputParameter(const SimpleString& name, void* output)=0;
     virtual MockActualCall& withOutputParameterOfType(const SimpleString& typeName, const SimpleString& name, void* output)=0;
+    /* For MockTypedFunction; the defaults ignore the typed arguments and return no typed value */
+    virtual MockActualCall& withArguments(const MockTypedValue& arguments);
 
     virtual MockActualCall& withBoolParameter(const SimpleString& name, bool value)=0;
     virtual MockActualCall& withIntParameter(const SimpleString& name, int value)=0;
@@ -77,6 +79,7 @@ public:
 
     virtual bool hasReturnValue()=0;
     virtual MockNamedValue returnValue()=0;
+    virtual const MockTypedValue* returnTypedValue();
 
     virtual bool returnBoolValueOrDefault(bool default_value)=0;
     virtual bool returnBoolValue()=0;
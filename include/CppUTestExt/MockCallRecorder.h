@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_MockCallRecorder_h
+#define D_MockCallRecorder_h
+
+#include "CppUTestExt/MockNamedValue.h"
+#include "CppUTest/PlatformSpecificFunctions_c.h"
+
+class MockSupport;
+
+/*
+ * MockCallRecorder writes the calls made on the mocks to a compact file, so that a
+ * run against the real collaborators (or a hand written test) can be replayed later as
+ * expectations (see MockCallReplayer and MockSupport::recordCalls).
+ *
+ * The file uses the layout of the result log: a signature line followed by records of
+ * a type character, a payload length and the payload. Numbers are ZeroFreeNumbers, so they
+ * never contain a zero byte. Scope, function and parameter names are written once and
+ * referred to by number. Strings are followed by a terminator that the replayer turns
+ * into a '\0', so their values can be used where they are. Long longs, doubles and
+ * memory buffers are written as two hex digits per byte, in the byte order of the
+ * recording machine.
+ *
+ * A call is written when it is complete, that is when the next call on its scope is
+ * made or the expectations are checked. Calls that failed are not written. Values that
+ * cannot be recorded (objects, output parameters and typed arguments) are replayed as
+ * ignored parameters. So are pointers and function pointers: they are addresses of the
+ * recording process, which differ in the process that replays the recording. The
+ * return value is the one of the matching expectation or else the default the mocked
+ * function handed out (e.g. with returnIntValueOrDefault); a returned pointer is not
+ * replayed.
+ */
+class MockCallRecorder
+{
+public:
+    MockCallRecorder(const SimpleString& fileName = "cpputest_mock_calls.rec");
+    virtual ~MockCallRecorder();
+
+    virtual SimpleString encodeParameter(const MockNamedValue& parameter);
+    virtual SimpleString encodeNotRecordedParameter(const SimpleString& name);
+    virtual SimpleString encodeReturnValue(const MockNamedValue& returnValue);
+    /* returnValue is encoded with encodeReturnValue, or empty when the call returned nothing */
+    virtual void recordCall(MockSymbol scope, MockSymbol functionName, const SimpleString& parameters, unsigned int parameterCount,
+                            const SimpleString& returnValue);
+
+    enum RecordType { STRING = 'S', CALL = 'C' };
+
+    enum ValueType {
+        BOOL = 'b', INT = 'i', UNSIGNED_INT = 'u', LONG_INT = 'l', UNSIGNED_LONG_INT = 'k', LONG_LONG_INT = 'x',
+        UNSIGNED_LONG_LONG_INT = 'y', DOUBLE = 'd', STRING_VALUE = 's', MEMORY_BUFFER = 'm', NOT_RECORDED = 'o'
+    };
+
+    static const char* signature();
+
+protected:
+    virtual void openFile(const char* mode);
+    virtual void writeToFile(const SimpleString& buffer);
+    virtual void closeFile();
+
+    virtual void writeRecord(RecordType type, const SimpleString& payload);
+    virtual SimpleString encodeValue(const MockNamedValue& value);
+    virtual unsigned long internSymbol(MockSymbol symbol);
+
+private:
+    SimpleString fileName_;
+    PlatformSpecificFile file_;
+    bool signatureWritten_;
+
+    unsigned long* stringIds_;
+    MockSymbol stringIdCapacity_;
+    unsigned long stringCount_;
+
+    MockCallRecorder(const MockCallRecorder&);
+    MockCallRecorder& operator=(const MockCallRecorder&);
+};
+
+struct MockRecordedValue;
+
+/*
+ * MockCallReplayer reads a file written by MockCallRecorder and adds its calls as
+ * expectations, in the recorded order, to a MockSupport and its scopes. The scopes in
+ * the recording are put in strict order.
+ *
+ * The file is read into one buffer and decoded where it is: string and memory buffer
+ * values of the expectations point into that buffer, so the replayer needs to live as
+ * long as the expectations. MockSupport::expectRecordedCalls takes care of that.
+ */
+class MockCallReplayer
+{
+public:
+    MockCallReplayer();
+    virtual ~MockCallReplayer();
+
+    virtual bool readFile(const char* fileName);
+    virtual void read(const char* data);
+    virtual bool expectRecordedCalls(MockSupport& support);
+
+    MockCallReplayer* next() const;
+    void setNext(MockCallReplayer* next);
+
+protected:
+    virtual bool replayCall(MockSupport& support, char*& position, const char* end);
+
+private:
+    char* buffer_;
+    size_t size_;
+    size_t capacity_;
+    bool decoded_;
+
+    const char** strings_;
+    unsigned long stringCount_;
+    unsigned long stringCapacity_;
+
+    MockCallReplayer* next_;
+
+    void addString(const char* text);
+    bool decodeValue(char*& position, const char* end, MockRecordedValue& value);
+
+    MockCallReplayer(const MockCallReplayer&);
+    MockCallReplayer& operator=(const MockCallReplayer&);
+};
+
+#endif
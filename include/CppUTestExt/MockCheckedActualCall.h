@@ -30,6 +30,9 @@
 
 #include "CppUTestExt/MockActualCall.h"
 #include "CppUTestExt/MockExpectedCallsList.h"
+#include "CppUTestExt/MockStatistics.h"
+
+class MockCallRecorder;
 
 class MockCheckedActualCall : public MockActualCall
 {
@@ -38,6 +41,7 @@ public:
     virtual ~MockCheckedActualCall() CPPUTEST_DESTRUCTOR_OVERRIDE;
 
     virtual MockActualCall& withName(const SimpleString& name) CPPUTEST_OVERRIDE;
+    MockActualCall& withNameSymbol(MockSymbol name);
     virtual MockActualCall& withCallOrder(unsigned int) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withBoolParameter(const SimpleString& name, bool value) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withIntParameter(const SimpleString& name, int value) CPPUTEST_OVERRIDE;
@@ -55,9 +59,11 @@ public:
     virtual MockActualCall& withParameterOfType(const SimpleString& type, const SimpleString& name, const void* value) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withOutputParameter(const SimpleString& name, void* output) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withOutputParameterOfType(const SimpleString& type, const SimpleString& name, void* output) CPPUTEST_OVERRIDE;
+    virtual MockActualCall& withArguments(const MockTypedValue& arguments) CPPUTEST_OVERRIDE;
 
     virtual bool hasReturnValue() CPPUTEST_OVERRIDE;
     virtual MockNamedValue returnValue() CPPUTEST_OVERRIDE;
+    virtual const MockTypedValue* returnTypedValue() CPPUTEST_OVERRIDE;
 
     virtual bool returnBoolValueOrDefault(bool default_value) CPPUTEST_OVERRIDE;
     virtual bool returnBoolValue() CPPUTEST_OVERRIDE;
@@ -104,6 +110,13 @@ public:
     virtual void checkExpectations();
 
     virtual void setMockFailureReporter(MockFailureReporter* reporter);
+    virtual void reset(unsigned int callOrder, MockFailureReporter* reporter);
+
+    virtual void recordTo(MockCallRecorder* recorder, MockSymbol scope, MockSymbol functionName);
+    virtual void finishRecording();
+
+    /* The call is added to the statistics when it is reset or deleted, i.e. when it is done */
+    virtual void collectStatisticsIn(MockStatistics* statistics);
 protected:
     void setName(const SimpleString& name);
     SimpleString getName() const;
@@ -124,7 +137,7 @@ protected:
     virtual void setState(ActualCallState state);
 
 private:
-    SimpleString functionName_;
+    MockSymbol functionName_;
     unsigned int callOrder_;
     MockFailureReporter* reporter_;
 
@@ -135,24 +148,55 @@ private:
     MockExpectedCallsList potentiallyMatchingExpectations_;
     const MockExpectedCallsList& allExpectations_;
 
-    class MockOutputParametersListNode
+    struct MockOutputParameter
     {
-    public:
-        SimpleString name_;
-        SimpleString type_;
+        MockSymbol name_;
+        MockSymbol type_;
         void* ptr_;
+    };
 
-        MockOutputParametersListNode* next_;
-        MockOutputParametersListNode(const SimpleString& name, const SimpleString& type, void* ptr)
-            : name_(name), type_(type), ptr_(ptr), next_(NULLPTR) {}
+    /*
+     * The first chunk is stored inline, so calls with a few output parameters
+     * don't allocate. Further chunks are kept when the call is reset.
+     */
+    struct MockOutputParameterChunk
+    {
+        enum { SIZE = 4 };
+        MockOutputParameter parameters_[SIZE];
+        MockOutputParameterChunk* next_;
     };
 
-    MockOutputParametersListNode* outputParameterExpectations_;
+    MockOutputParameterChunk outputParameterExpectations_;
+    unsigned int outputParameterCount_;
+
+    MockCallRecorder* recorder_;
+    MockSymbol recordedScope_;
+    MockSymbol recordedFunctionName_;
+    SimpleString recordedParameters_;
+    unsigned int recordedParameterCount_;
+    SimpleString recordedReturnValue_;
+
+    void recordParameter(const SimpleString& encodedParameter);
+    void recordDefaultReturnValue(const MockNamedValue& value);
+
+    MockStatistics* statistics_;
+    MockFunctionStatistics callStatistics_;
+
+    unsigned long* matchingTimeCounter();
+    unsigned long* copyingTimeCounter();
+    void countScannedExpectations();
+    void finishStatistics();
 
     virtual void addOutputParameter(const SimpleString& name, const SimpleString& type, void* ptr);
+    virtual void addOutputParameter(MockSymbol name, MockSymbol type, void* ptr);
     void cleanUpOutputParameterList();
 };
 
+/*
+ * MockActualCallTrace keeps the traced calls as fixed size events and only formats them
+ * when the trace output is asked for. With a maximum number of events, the oldest events
+ * are dropped once it is reached, so tracing can stay on during long runs.
+ */
 class MockActualCallTrace : public MockActualCall
 {
 public:
@@ -160,6 +204,7 @@ public:
     virtual ~MockActualCallTrace() CPPUTEST_DESTRUCTOR_OVERRIDE;
 
     virtual MockActualCall& withName(const SimpleString& name) CPPUTEST_OVERRIDE;
+    MockActualCall& withNameSymbol(MockSymbol name);
     virtual MockActualCall& withCallOrder(unsigned int) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withBoolParameter(const SimpleString& name, bool value) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withIntParameter(const SimpleString& name, int value) CPPUTEST_OVERRIDE;
@@ -177,9 +222,11 @@ public:
     virtual MockActualCall& withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withOutputParameter(const SimpleString& name, void* output) CPPUTEST_OVERRIDE;
     virtual MockActualCall& withOutputParameterOfType(const SimpleString& typeName, const SimpleString& name, void* output) CPPUTEST_OVERRIDE;
+    virtual MockActualCall& withArguments(const MockTypedValue& arguments) CPPUTEST_OVERRIDE;
 
     virtual bool hasReturnValue() CPPUTEST_OVERRIDE;
     virtual MockNamedValue returnValue() CPPUTEST_OVERRIDE;
+    virtual const MockTypedValue* returnTypedValue() CPPUTEST_OVERRIDE;
 
     virtual bool returnBoolValueOrDefault(bool default_value) CPPUTEST_OVERRIDE;
     virtual bool returnBoolValue() CPPUTEST_OVERRIDE;
@@ -221,15 +268,37 @@ public:
 
     const char* getTraceOutput();
     void clear();
+    void setMaximumEvents(unsigned int maximumEvents);
     static MockActualCallTrace& instance();
+    /* Kept when the instance is cleared, so a limit set once holds for the rest of the run */
+    static void setInstanceMaximumEvents(unsigned int maximumEvents);
     static void clearInstance();
 
 private:
-    SimpleString traceBuffer_;
+    struct TraceEvent;
+
+    TraceEvent* events_;
+    unsigned int capacity_;
+    unsigned int first_;
+    unsigned int count_;
+    unsigned int maximumEvents_;
+    unsigned long droppedEvents_;
+
+    char* output_;
+    size_t outputSize_;
+    size_t outputCapacity_;
 
     static MockActualCallTrace* instance_;
+    static unsigned int instanceMaximumEvents_;
+
+    TraceEvent& addEvent(int kind, MockSymbol name, MockSymbol type);
+    TraceEvent& addParameter(const SimpleString& name, MockSymbol type);
+    void releaseEventData(TraceEvent& event);
+    void formatEvent(const TraceEvent& event);
+    void appendOutput(const SimpleString& text);
 
-    void addParameterName(const SimpleString& name);
+    MockActualCallTrace(const MockActualCallTrace&);
+    MockActualCallTrace& operator=(const MockActualCallTrace&);
 };
 
 class MockIgnoredActualCall: public MockActualCall
@@ -253,9 +322,11 @@ public:
     virtual MockActualCall& withParameterOfType(const SimpleString&, const SimpleString&, const void*) CPPUTEST_OVERRIDE { return *this; }
     virtual MockActualCall& withOutputParameter(const SimpleString&, void*) CPPUTEST_OVERRIDE { return *this; }
     virtual MockActualCall& withOutputParameterOfType(const SimpleString&, const SimpleString&, void*) CPPUTEST_OVERRIDE { return *this; }
+    virtual MockActualCall& withArguments(const MockTypedValue&) CPPUTEST_OVERRIDE { return *this; }
 
     virtual bool hasReturnValue() CPPUTEST_OVERRIDE { return false; }
     virtual MockNamedValue returnValue() CPPUTEST_OVERRIDE { return MockNamedValue(""); }
+    virtual const MockTypedValue* returnTypedValue() CPPUTEST_OVERRIDE { return NULLPTR; }
 
     virtual bool returnBoolValueOrDefault(bool value) CPPUTEST_OVERRIDE { return value; }
     virtual bool returnBoolValue() CPPUTEST_OVERRIDE { return false; }
@@ -57,9 +57,11 @@ public:
     virtual MockExpectedCall& withFunctionPointerParameter(const SimpleString& name, void (*value)()) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& withMemoryBufferParameter(const SimpleString& name, const unsigned char* value, size_t size) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value) CPPUTEST_OVERRIDE;
+    virtual MockExpectedCall& withParameterSequenceOfType(const SimpleString& typeName, const SimpleString& name, const void* values) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& withOutputParameterReturning(const SimpleString& name, const void* value, size_t size) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& withOutputParameterOfTypeReturning(const SimpleString& typeName, const SimpleString& name, const void* value) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& withUnmodifiedOutputParameter(const SimpleString& name) CPPUTEST_OVERRIDE;
+    virtual MockExpectedCall& withArguments(const MockTypedValue& arguments) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& ignoreOtherParameters() CPPUTEST_OVERRIDE;
 
     virtual MockExpectedCall& andReturnValue(bool value) CPPUTEST_OVERRIDE;
@@ -74,6 +76,7 @@ public:
     virtual MockExpectedCall& andReturnValue(void* value) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& andReturnValue(const void* value) CPPUTEST_OVERRIDE;
     virtual MockExpectedCall& andReturnValue(void (*value)()) CPPUTEST_OVERRIDE;
+    virtual MockExpectedCall& andReturnTypedValue(const MockTypedValue& value) CPPUTEST_OVERRIDE;
 
     virtual MockNamedValue returnValue();
 
@@ -81,6 +84,7 @@ public:
 
     virtual MockNamedValue getInputParameter(const SimpleString& name);
     virtual MockNamedValue getOutputParameter(const SimpleString& name);
+    virtual MockNamedValue getOutputParameter(MockSymbol name);
     virtual SimpleString getInputParameterType(const SimpleString& name);
     virtual SimpleString getInputParameterValueString(const SimpleString& name);
 
@@ -88,6 +92,8 @@ public:
     virtual bool hasInputParameter(const MockNamedValue& parameter);
     virtual bool hasOutputParameterWithName(const SimpleString& name);
     virtual bool hasOutputParameter(const MockNamedValue& parameter);
+    virtual bool hasArguments(const MockTypedValue& arguments);
+    virtual const MockTypedValue* getTypedReturnValue() const;
     virtual bool relatesTo(const SimpleString& functionName);
     virtual bool relatesToObject(const void* objectPtr) const;
 
@@ -100,7 +106,10 @@ public:
 
     virtual void callWasMade(unsigned int callOrder);
     virtual void inputParameterWasPassed(const SimpleString& name);
+    virtual void inputParameterWasPassed(MockSymbol name);
     virtual void outputParameterWasPassed(const SimpleString& name);
+    virtual void outputParameterWasPassed(MockSymbol name);
+    virtual void argumentsWerePassed();
     virtual void finalizeActualCallMatch();
     virtual void wasPassedToObject();
     virtual void resetActualCallMatchingState();
@@ -111,13 +120,15 @@ public:
     enum { NO_EXPECTED_CALL_ORDER = 0 };
 
     virtual unsigned int getActualCallsFulfilled() const;
+    MockSymbol getFunctionNameSymbol() const;
+    MockExpectedCall& withNameSymbol(MockSymbol name);
 
 protected:
     void setName(const SimpleString& name);
     SimpleString getName() const;
 
 private:
-    SimpleString functionName_;
+    MockSymbol functionName_;
 
     class MockExpectedFunctionParameter : public MockNamedValue
     {
@@ -132,6 +143,10 @@ private:
 
     MockExpectedFunctionParameter* item(MockNamedValueListNode* node);
 
+    struct MockParameterSequence;
+    MockParameterSequence* parameterSequences_;
+    void moveParameterSequencesTo(unsigned int index);
+
     bool ignoreOtherParameters_;
     bool isActualCallMatchFinalized_;
     unsigned int initialExpectedCallOrder_;
@@ -140,6 +155,9 @@ private:
     MockNamedValueList* inputParameters_;
     MockNamedValueList* outputParameters_;
     MockNamedValue returnValue_;
+    MockTypedValue* arguments_;
+    bool argumentsMatchActualCall_;
+    MockTypedValue* typedReturnValue_;
     void* objectPtr_;
     bool isSpecificObjectExpected_;
     bool wasPassedToObject_;
@@ -169,9 +187,11 @@ public:
     virtual MockExpectedCall& withFunctionPointerParameter(const SimpleString& , void(*)()) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& withMemoryBufferParameter(const SimpleString&, const unsigned char*, size_t) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& withParameterOfType(const SimpleString&, const SimpleString&, const void*) CPPUTEST_OVERRIDE { return *this; }
+    virtual MockExpectedCall& withParameterSequenceOfType(const SimpleString&, const SimpleString&, const void*) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& withOutputParameterReturning(const SimpleString&, const void*, size_t) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& withOutputParameterOfTypeReturning(const SimpleString&, const SimpleString&, const void*) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& withUnmodifiedOutputParameter(const SimpleString&) CPPUTEST_OVERRIDE { return *this; }
+    virtual MockExpectedCall& withArguments(const MockTypedValue&) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& ignoreOtherParameters() CPPUTEST_OVERRIDE { return *this;}
 
     virtual MockExpectedCall& andReturnValue(bool) CPPUTEST_OVERRIDE { return *this; }
@@ -186,6 +206,7 @@ public:
     virtual MockExpectedCall& andReturnValue(void*) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& andReturnValue(const void*) CPPUTEST_OVERRIDE { return *this; }
     virtual MockExpectedCall& andReturnValue(void (*)()) CPPUTEST_OVERRIDE { return *this; }
+    virtual MockExpectedCall& andReturnTypedValue(const MockTypedValue&) CPPUTEST_OVERRIDE { return *this; }
 
     virtual MockExpectedCall& onObject(void*) CPPUTEST_OVERRIDE { return *this; }
 
@@ -31,6 +31,7 @@
 #include "CppUTest/CppUTestConfig.h"
 
 class MockNamedValue;
+class MockTypedValue;
 
 extern SimpleString StringFrom(const MockNamedValue& parameter);
 
@@ -58,9 +59,27 @@ public:
     MockExpectedCall& withParameter(const SimpleString& name, void (*value)()) { return withFunctionPointerParameter(name, value); }
     MockExpectedCall& withParameter(const SimpleString& name, const unsigned char* value, size_t size) { return withMemoryBufferParameter(name, value, size); }
     virtual MockExpectedCall& withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value)=0;
+
+    /*
+     * Parameter sequences give every expected call its own value: call i is expected with values[i].
+     * The array is not copied and must hold as many values as calls are expected. The type name
+     * is the one of the element type ("int", "double", "const char*", ...); the default
+     * implementation ignores the sequence.
+     */
+    MockExpectedCall& withParameterSequence(const SimpleString& name, const int* values) { return withParameterSequenceOfType("int", name, values); }
+    MockExpectedCall& withParameterSequence(const SimpleString& name, const unsigned int* values) { return withParameterSequenceOfType("unsigned int", name, values); }
+    MockExpectedCall& withParameterSequence(const SimpleString& name, const long int* values) { return withParameterSequenceOfType("long int", name, values); }
+    MockExpectedCall& withParameterSequence(const SimpleString& name, const unsigned long int* values) { return withParameterSequenceOfType("unsigned long int", name, values); }
+    MockExpectedCall& withParameterSequence(const SimpleString& name, const double* values) { return withParameterSequenceOfType("double", name, values); }
+    MockExpectedCall& withParameterSequence(const SimpleString& name, const char* const* values) { return withParameterSequenceOfType("const char*", name, values); }
+    MockExpectedCall& withParameterSequence(const SimpleString& name, const void* const* values) { return withParameterSequenceOfType("const void*", name, values); }
+    virtual MockExpectedCall& withParameterSequenceOfType(const SimpleString& typeName, const SimpleString& name, const void* values);
+
     virtual MockExpectedCall& withOutputParameterReturning(const SimpleString& name, const void* value, size_t size)=0;
     virtual MockExpectedCall& withOutputParameterOfTypeReturning(const SimpleString& typeName, const SimpleString& name, const void* value)=0;
     virtual MockExpectedCall& withUnmodifiedOutputParameter(const SimpleString& name)=0;
+    /* For MockTypedFunction; the defaults ignore the typed arguments and return value */
+    virtual MockExpectedCall& withArguments(const MockTypedValue& arguments);
     virtual MockExpectedCall& ignoreOtherParameters()=0;
 
     virtual MockExpectedCall& withBoolParameter(const SimpleString& name, bool value)=0;
@@ -89,6 +108,7 @@ public:
     virtual MockExpectedCall& andReturnValue(void* value)=0;
     virtual MockExpectedCall& andReturnValue(const void* value)=0;
     virtual MockExpectedCall& andReturnValue(void (*value)())=0;
+    virtual MockExpectedCall& andReturnTypedValue(const MockTypedValue& value);
 
     virtual MockExpectedCall& onObject(void* objectPtr)=0;
 };
@@ -28,8 +28,11 @@
 #ifndef D_MockExpectedCallsList_h
 #define D_MockExpectedCallsList_h
 
+#include "CppUTestExt/MockSymbolTable.h"
+
 class MockCheckedExpectedCall;
 class MockNamedValue;
+class MockTypedValue;
 
 class MockExpectedCallsList
 {
@@ -38,6 +41,7 @@ public:
     MockExpectedCallsList();
     virtual ~MockExpectedCallsList();
     virtual void deleteAllExpectationsAndClearList();
+    virtual void removeAllExpectations();
 
     virtual unsigned int size() const;
     virtual unsigned int amountOfActualCallsFulfilledFor(const SimpleString& name) const;
@@ -46,6 +50,8 @@ public:
     virtual bool hasFinalizedMatchingExpectations() const;
     virtual bool hasUnmatchingExpectationsBecauseOfMissingParameters() const;
     virtual bool hasExpectationWithName(const SimpleString& name) const;
+    bool hasExpectationWithSymbol(MockSymbol name) const;
+    bool hasExpectationThatCanMatchSymbol(MockSymbol name) const;
     virtual bool hasCallsOutOfOrder() const;
     virtual bool isEmpty() const;
 
@@ -55,12 +61,15 @@ public:
 
     virtual void onlyKeepOutOfOrderExpectations();
     virtual void addPotentiallyMatchingExpectations(const MockExpectedCallsList& list);
+    virtual void addPotentiallyMatchingExpectationsRelatedTo(const SimpleString& name, const MockExpectedCallsList& list);
+    void addPotentiallyMatchingExpectationsRelatedToSymbol(MockSymbol name, const MockExpectedCallsList& list);
 
     virtual void onlyKeepExpectationsRelatedTo(const SimpleString& name);
     virtual void onlyKeepExpectationsWithInputParameter(const MockNamedValue& parameter);
     virtual void onlyKeepExpectationsWithInputParameterName(const SimpleString& name);
     virtual void onlyKeepExpectationsWithOutputParameter(const MockNamedValue& parameter);
     virtual void onlyKeepExpectationsWithOutputParameterName(const SimpleString& name);
+    virtual void onlyKeepExpectationsWithArguments(const MockTypedValue& arguments);
     virtual void onlyKeepExpectationsOnObject(const void* objectPtr);
     virtual void onlyKeepUnmatchingExpectations();
 
@@ -70,8 +79,9 @@ public:
 
     virtual void resetActualCallMatchingState();
     virtual void wasPassedToObject();
-    virtual void parameterWasPassed(const SimpleString& parameterName);
-    virtual void outputParameterWasPassed(const SimpleString& parameterName);
+    virtual void parameterWasPassed(MockSymbol parameterName);
+    virtual void outputParameterWasPassed(MockSymbol parameterName);
+    virtual void argumentsWerePassed();
 
     virtual SimpleString unfulfilledCallsToString(const SimpleString& linePrefix = "") const;
     virtual SimpleString fulfilledCallsToString(const SimpleString& linePrefix = "") const;
@@ -87,12 +97,37 @@ protected:
         MockCheckedExpectedCall* expectedCall_;
 
         MockExpectedCallsListNode* next_;
+        MockExpectedCallsListNode* nextWithSameName_;
         MockExpectedCallsListNode(MockCheckedExpectedCall* expectedCall)
-            : expectedCall_(expectedCall), next_(NULLPTR) {}
+            : expectedCall_(expectedCall), next_(NULLPTR), nextWithSameName_(NULLPTR) {}
     };
 
 private:
+    /*
+     * Index from function name to the nodes with that name, in expectation
+     * order. It is built on the first lookup by name, kept up to date when
+     * expectations are added and dropped when nodes are removed.
+     */
+    struct NameIndexEntry;
+    struct NameIndex;
+
+    NameIndexEntry* findNameIndexEntry(MockSymbol name) const;
+    void addToNameIndex(MockExpectedCallsListNode* node) const;
+    void clearNameIndex() const;
+
+    /*
+     * Removed nodes are kept for reuse, so a list that is refilled for every
+     * actual call stops allocating once it has seen its largest size.
+     */
+    MockExpectedCallsListNode* createNode(MockCheckedExpectedCall* call);
+    void releaseNode(MockExpectedCallsListNode* node);
+    void deleteUnusedNodes();
+
     MockExpectedCallsListNode* head_;
+    MockExpectedCallsListNode* tail_;
+    MockExpectedCallsListNode* unusedNodes_;
+
+    mutable NameIndex* nameIndex_;
 
     MockExpectedCallsList(const MockExpectedCallsList&);
 };
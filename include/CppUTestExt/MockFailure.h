@@ -34,6 +34,7 @@
 class MockExpectedCallsList;
 class MockCheckedActualCall;
 class MockNamedValue;
+class MockTypedValue;
 class MockFailure;
 
 class MockFailureReporter
@@ -84,6 +85,12 @@ public:
     MockUnexpectedInputParameterFailure(UtestShell* test, const SimpleString& functionName, const MockNamedValue& parameter, const MockExpectedCallsList& expectations);
 };
 
+class MockUnexpectedArgumentsFailure : public MockFailure
+{
+public:
+    MockUnexpectedArgumentsFailure(UtestShell* test, const SimpleString& functionName, const MockTypedValue& arguments, const MockExpectedCallsList& expectations);
+};
+
 class MockUnexpectedOutputParameterFailure : public MockFailure
 {
 public:
@@ -29,6 +29,7 @@
 #define D_MockNamedValue_h
 
 #include "CppUTest/CppUTestConfig.h"
+#include "CppUTestExt/MockSymbolTable.h"
 
 /*
  * MockNamedValueComparator is an interface that needs to be used when creating Comparators.
@@ -89,6 +90,24 @@ private:
     copyFunction copier_;
 };
 
+/*
+ * MockTypedValue is the interface behind the typed mock layer (see MockTypedFunction.h).
+ * It holds a complete argument list (or a return value) unboxed, and can only be compared
+ * with values of the same signature.
+ */
+
+class MockTypedValue
+{
+public:
+    MockTypedValue() {}
+    virtual ~MockTypedValue() {}
+
+    virtual const void* signature() const=0;
+    virtual bool equals(const MockTypedValue& other) const=0;
+    virtual SimpleString toString() const=0;
+    virtual MockTypedValue* clone() const=0;
+};
+
 /*
  * MockNamedValue is the generic value class used. It encapsulates basic types and can use them "as if one"
  * Also it enables other types by putting object pointers. They can be compared with comparators.
@@ -132,6 +151,9 @@ public:
     virtual SimpleString getName() const;
     virtual SimpleString getType() const;
 
+    MockSymbol getNameSymbol() const;
+    MockSymbol getTypeSymbol() const;
+
     virtual bool getBoolValue() const;
     virtual int getIntValue() const;
     virtual unsigned int getUnsignedIntValue() const;
@@ -159,8 +181,8 @@ public:
 
     static const double defaultDoubleTolerance;
 private:
-    SimpleString name_;
-    SimpleString type_;
+    MockSymbol nameSymbol_;
+    MockSymbol typeSymbol_;
     union {
         bool boolValue_;
         int intValue_;
@@ -221,6 +243,7 @@ public:
     void clear();
 
     MockNamedValue* getValueByName(const SimpleString& name);
+    MockNamedValue* getValueBySymbol(MockSymbol name);
 
 private:
     MockNamedValueListNode* head_;
@@ -228,13 +251,16 @@ private:
 
 /*
  * MockParameterComparatorRepository is a class which stores comparators and copiers which can be used for comparing non-native types
- *
+ * They are kept in a small hash table with one entry per type, keyed on the interned type name.
  */
 
 struct MockNamedValueComparatorsAndCopiersRepositoryNode;
 class MockNamedValueComparatorsAndCopiersRepository
 {
-    MockNamedValueComparatorsAndCopiersRepositoryNode* head_;
+    MockSymbolBucketTable<MockNamedValueComparatorsAndCopiersRepositoryNode> nodes_;
+
+    MockNamedValueComparatorsAndCopiersRepositoryNode* findNode(MockSymbol type) const;
+    MockNamedValueComparatorsAndCopiersRepositoryNode* findOrCreateNode(MockSymbol type);
 public:
     MockNamedValueComparatorsAndCopiersRepository();
     virtual ~MockNamedValueComparatorsAndCopiersRepository();
@@ -245,6 +271,9 @@ public:
     virtual MockNamedValueComparator* getComparatorForType(const SimpleString& name);
     virtual MockNamedValueCopier* getCopierForType(const SimpleString& name);
 
+    MockNamedValueComparator* getComparatorForSymbol(MockSymbol type) const;
+    MockNamedValueCopier* getCopierForSymbol(MockSymbol type) const;
+
     void clear();
 };
 
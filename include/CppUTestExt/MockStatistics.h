@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_MockStatistics_h
+#define D_MockStatistics_h
+
+#include "CppUTestExt/MockSymbolTable.h"
+
+/*
+ * The cost of one mocked function: how often it was called, how many expectations were
+ * looked at to match those calls, the time spent matching them and copying their output
+ * parameters (matching time does not include the copying) and how many of the calls failed.
+ */
+struct MockFunctionStatistics
+{
+    MockFunctionStatistics();
+
+    unsigned long calls;
+    unsigned long expectationsScanned;
+    unsigned long matchingTimeInMicros;
+    unsigned long copyingTimeInMicros;
+    unsigned long failures;
+};
+
+/*
+ * MockStatistics adds up the cost of the actual calls per function, including its scope
+ * ("scope::function"). It is filled by MockSupport::collectStatistics (or the -pmockstats
+ * argument of MockSupportPlugin) and its report lists the most expensive functions first,
+ * which are the mocked interfaces worth optimising or replacing with a fake.
+ */
+class MockStatistics
+{
+public:
+    MockStatistics();
+    virtual ~MockStatistics();
+
+    virtual void addCall(MockSymbol functionName, const MockFunctionStatistics& call);
+    MockFunctionStatistics getStatisticsFor(MockSymbol functionName) const;
+    MockFunctionStatistics getStatisticsFor(const SimpleString& functionName) const;
+
+    virtual SimpleString report() const;
+    void clear();
+
+private:
+    MockFunctionStatistics* functions_;
+    MockSymbol capacity_;
+
+    MockStatistics(const MockStatistics&);
+    MockStatistics& operator=(const MockStatistics&);
+};
+
+#endif
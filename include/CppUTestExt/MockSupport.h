@@ -32,6 +32,7 @@
 #include "CppUTestExt/MockCheckedActualCall.h"
 #include "CppUTestExt/MockCheckedExpectedCall.h"
 #include "CppUTestExt/MockExpectedCallsList.h"
+#include "CppUTestExt/MockCallRecorder.h"
 
 class UtestShell;
 class MockSupport;
@@ -39,6 +40,24 @@ class MockSupport;
 /* This allows access to "the global" mocking support for easier testing */
 MockSupport& mock(const SimpleString& mockName = "", MockFailureReporter* failureReporterForThisCall = NULLPTR);
 
+/*
+ * MockScope is a handle to one scope of the global mocking support. It can be kept across calls
+ * (e.g. as a static in a driver mock) and only looks the scope up again after it was cleared.
+ * scope() behaves the same as mock("scope").
+ */
+class MockScope
+{
+public:
+    MockScope(const SimpleString& mockName);
+
+    MockSupport& operator()(MockFailureReporter* failureReporterForThisCall = NULLPTR);
+
+private:
+    MockSymbol mockName_;
+    MockSupport* support_;
+    unsigned int scopesGeneration_;
+};
+
 class MockSupport
 {
 public:
@@ -93,8 +112,18 @@ public:
     MockNamedValue getData(const SimpleString& name);
 
     MockSupport* getMockSupportScope(const SimpleString& name);
+    MockSupport* getMockSupportScope(MockSymbol name);
 
     const char* getTraceOutput();
+    /* Keeps only the last maximumEvents traced names and parameters, 0 keeps all of them. The limit is kept by clear(). */
+    void setTraceLimit(unsigned int maximumEvents);
+
+    /*
+     * Adds the calls recorded in the file as expectations (see MockCallReplayer). The recording
+     * is kept until the mock is cleared. Returns false when the file could not be read completely.
+     */
+    virtual bool expectRecordedCalls(const SimpleString& fileName);
+
     /*
      * The following functions are recursively through the lower MockSupports scopes
      * This means, if you do mock().disable() it will disable *all* mocking scopes, including mock("myScope").
@@ -103,6 +132,14 @@ public:
     virtual void disable();
     virtual void enable();
     virtual void tracing(bool enabled);
+    /*
+     * With acceptAllCalls, calls that no expectation can match are accepted (also when other calls
+     * are ignored) and recorded with their parameters and the default return values handed out, so
+     * a recording can be made from a run without any expectations.
+     */
+    virtual void recordCalls(MockCallRecorder* recorder, bool acceptAllCalls = false);
+    /* The statistics need to be kept until the mock is cleared, clear() stops collecting them */
+    virtual void collectStatistics(MockStatistics* statistics);
     virtual void ignoreOtherCalls();
 
     virtual void checkExpectations();
@@ -141,11 +178,24 @@ private:
     bool ignoreOtherCalls_;
     bool enabled_;
     MockCheckedActualCall *lastActualFunctionCall_;
+    MockCheckedActualCall *unusedActualCall_;
     MockNamedValueComparatorsAndCopiersRepository comparatorsAndCopiersRepository_;
     MockNamedValueList data_;
     const SimpleString mockName_;
 
+    struct ScopeEntry;
+    struct ScopeTable;
+    ScopeTable* scopes_;
+    ScopeEntry* firstScope() const;
+    void deleteAllScopes();
+
     bool tracing_;
+    MockCallRecorder* recorder_;
+    bool recordingAllCalls_;
+    MockCallReplayer* replayers_;
+    void deleteAllReplayers();
+
+    MockStatistics* statistics_;
 
     void checkExpectationsOfLastActualCall();
     bool wasLastActualCallFulfilled();
@@ -154,13 +204,10 @@ private:
 
     MockNamedValue* retrieveDataFromStore(const SimpleString& name);
 
-    MockSupport* getMockSupport(MockNamedValueListNode* node);
-
-    bool callIsIgnored(const SimpleString& functionName);
+    bool callIsIgnored(MockSymbol functionName);
+    void expectCallToRecord(MockSymbol scopeFunctionName);
+    void releaseLastActualCall();
     bool hasCallsOutOfOrder();
-
-    SimpleString appendScopeToName(const SimpleString& functionName);
-
 };
 
 #endif
@@ -30,6 +30,7 @@
 
 #include "CppUTest/TestPlugin.h"
 #include "CppUTestExt/MockNamedValue.h"
+#include "CppUTestExt/MockStatistics.h"
 
 class MockSupportPlugin : public TestPlugin
 {
@@ -39,13 +40,24 @@ public:
 
     virtual void preTestAction(UtestShell&, TestResult&) CPPUTEST_OVERRIDE;
     virtual void postTestAction(UtestShell&, TestResult&) CPPUTEST_OVERRIDE;
+    virtual void postRunAction(TestResult&) CPPUTEST_OVERRIDE;
+    virtual bool parseArguments(int ac, const char *const *av, int index) CPPUTEST_OVERRIDE;
 
     virtual void installComparator(const SimpleString& name, MockNamedValueComparator& comparator);
     virtual void installCopier(const SimpleString& name, MockNamedValueCopier& copier);
 
+    /*
+     * Collects the statistics of all mocked functions and prints them at the end of the run (also done
+     * by -pmockstats). With -p the mocked calls are made in the separate processes and are not reported.
+     */
+    virtual void collectStatistics(bool enabled = true);
+    const MockStatistics& getStatistics() const;
+
     void clear();
 private:
     MockNamedValueComparatorsAndCopiersRepository repository_;
+    bool collectingStatistics_;
+    MockStatistics statistics_;
 };
 
 #endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockSymbolTable_h
+#define D_MockSymbolTable_h
+
+#include "CppUTest/CppUTestConfig.h"
+
+/*
+ * MockSymbolTable interns the function, parameter and type names used by the mocking framework.
+ * Every distinct name gets a small integer (a MockSymbol) the first time it is seen, so matching
+ * can compare integers instead of strings. Symbols stay valid for the rest of the program, so
+ * the table is not emptied by mock().clear() and only freed at exit. It grows with every distinct
+ * name, which is bounded by the names in the tests unless they make up names at run time.
+ * Running out of memory fails the current test.
+ */
+
+typedef unsigned int MockSymbol;
+
+class MockSymbolTable
+{
+public:
+    enum BuiltinSymbol
+    {
+        EMPTY = 0,
+        TYPE_BOOL,
+        TYPE_INT,
+        TYPE_UNSIGNED_INT,
+        TYPE_LONG_INT,
+        TYPE_UNSIGNED_LONG_INT,
+        TYPE_LONG_LONG_INT,
+        TYPE_UNSIGNED_LONG_LONG_INT,
+        TYPE_DOUBLE,
+        TYPE_VOID_POINTER,
+        TYPE_CONST_VOID_POINTER,
+        TYPE_FUNCTION_POINTER,
+        TYPE_CONST_CHAR_POINTER,
+        TYPE_CONST_UNSIGNED_CHAR_POINTER,
+        BUILTIN_SYMBOL_COUNT
+    };
+
+    static MockSymbol symbolFor(const char* name);
+    static MockSymbol symbolFor(const SimpleString& name);
+    static MockSymbol symbolFor(const SimpleString& scope, const SimpleString& name);
+
+    static const char* nameOf(MockSymbol symbol);
+    static MockSymbol size();
+};
+
+/*
+ * MockSymbolBucketTable finds entries by MockSymbol in a fixed amount of buckets, chained
+ * through the entries' nextInBucket_ (an entry also has a MockSymbol name_). The table owns
+ * its entries.
+ *
+ * The buckets are part of the table and never grow, so a table is allocated with a single
+ * new (or none at all). Mocks are called from within memory allocators, which often only
+ * restore operator new, so the mocking framework cannot rely on anything else while it is
+ * called. The tables hold a few names per mock (functions, scopes, types), for which a
+ * fixed amount of buckets is plenty.
+ */
+template <typename Entry, unsigned int BUCKET_COUNT = 32>
+class MockSymbolBucketTable
+{
+public:
+    MockSymbolBucketTable()
+    {
+        for (unsigned int i = 0; i < BUCKET_COUNT; i++)
+            buckets_[i] = NULLPTR;
+    }
+
+    ~MockSymbolBucketTable()
+    {
+        clear();
+    }
+
+    Entry* find(MockSymbol name) const
+    {
+        for (Entry* entry = buckets_[name % BUCKET_COUNT]; entry; entry = entry->nextInBucket_)
+            if (entry->name_ == name) return entry;
+        return NULLPTR;
+    }
+
+    Entry* add(Entry* entry)
+    {
+        Entry*& bucket = buckets_[entry->name_ % BUCKET_COUNT];
+        entry->nextInBucket_ = bucket;
+        bucket = entry;
+        return entry;
+    }
+
+    void clear()
+    {
+        for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+            while (buckets_[i]) {
+                Entry* next = buckets_[i]->nextInBucket_;
+                delete buckets_[i];
+                buckets_[i] = next;
+            }
+        }
+    }
+
+    unsigned int bucketCount() const
+    {
+        return BUCKET_COUNT;
+    }
+
+    Entry* firstInBucket(unsigned int bucket) const
+    {
+        return buckets_[bucket];
+    }
+
+private:
+    Entry* buckets_[BUCKET_COUNT];
+
+    MockSymbolBucketTable(const MockSymbolBucketTable&);
+    MockSymbolBucketTable& operator=(const MockSymbolBucketTable&);
+};
+
+#endif
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef D_MockTypedFunction_h
+#define D_MockTypedFunction_h
+
+#include "CppUTestExt/MockSupport.h"
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+
+/*
+ * MockTypedFunction is a statically typed front end for MockSupport. The arguments of a call are
+ * kept as one typed tuple and compared with MockTypedComparator, instead of being boxed into a
+ * named MockNamedValue per parameter. Matching, call counting, ordering and failure reporting are
+ * still done by MockSupport, so typed and untyped expectations can be mixed freely.
+ *
+ *     static MockTypedFunction<int(int, const char*)> mockOpen("open");
+ *
+ *     mockOpen.expectOneCall().with(3, "r").andReturn(5);
+ *     int open(int fd, const char* mode) { return mockOpen(fd, mode); }
+ *
+ * Specialize MockTypedComparator for types that have no operator==. StringFrom is only used for
+ * failure messages; values of types without one are shown as "(no StringFrom)".
+ *
+ * A function returning a const reference returns a reference to a copy of the value given to
+ * andReturn, which lives as long as the expectation. A function returning a non-const reference
+ * needs an lvalue in andReturn and returns a reference to it. Calling a function that returns a
+ * reference without a return value fails the test, as there is nothing to refer to.
+ */
+
+template <typename T>
+struct MockTypedStorage { typedef T Type; };
+template <typename T>
+struct MockTypedStorage<const T> { typedef typename MockTypedStorage<T>::Type Type; };
+template <typename T>
+struct MockTypedStorage<T&> { typedef typename MockTypedStorage<T>::Type Type; };
+template <typename T>
+struct MockTypedStorage<T&&> { typedef typename MockTypedStorage<T>::Type Type; };
+
+template <typename T>
+class MockTypedHasStringFrom
+{
+    template <typename U>
+    static char check(decltype(StringFrom(*(const U*) NULLPTR))*);
+    template <typename U>
+    static long check(...);
+public:
+    static const bool value = sizeof(check<T>(NULLPTR)) == sizeof(char);
+};
+
+template <typename T, bool = MockTypedHasStringFrom<T>::value>
+struct MockTypedStringFrom
+{
+    static SimpleString of(const T& value) { return StringFrom(value); }
+};
+
+template <typename T>
+struct MockTypedStringFrom<T, false>
+{
+    static SimpleString of(const T&) { return "(no StringFrom)"; }
+};
+
+template <typename T>
+struct MockTypedComparator
+{
+    static bool isEqual(const T& value1, const T& value2) { return value1 == value2; }
+    static SimpleString valueToString(const T& value) { return MockTypedStringFrom<T>::of(value); }
+};
+
+template <>
+struct MockTypedComparator<const char*>
+{
+    static bool isEqual(const char* value1, const char* value2)
+    {
+        if (value1 == NULLPTR || value2 == NULLPTR)
+            return value1 == value2;
+        return SimpleString::StrCmp(value1, value2) == 0;
+    }
+    static SimpleString valueToString(const char* value) { return StringFromOrNull(value); }
+};
+
+template <>
+struct MockTypedComparator<double>
+{
+    static bool isEqual(double value1, double value2) { return doubles_equal(value1, value2, MockNamedValue::defaultDoubleTolerance); }
+    static SimpleString valueToString(double value) { return StringFrom(value); }
+};
+
+template <typename... Ts>
+class MockValueTuple;
+
+template <>
+class MockValueTuple<>
+{
+public:
+    MockValueTuple() {}
+
+    bool isEqual(const MockValueTuple&) const { return true; }
+    void appendTo(SimpleString&, bool) const {}
+};
+
+template <typename T, typename... Ts>
+class MockValueTuple<T, Ts...>
+{
+public:
+    MockValueTuple(const T& head, const Ts&... tail) : head_(head), tail_(tail...) {}
+
+    const T& head() const { return head_; }
+
+    bool isEqual(const MockValueTuple& other) const
+    {
+        return MockTypedComparator<T>::isEqual(head_, other.head_) && tail_.isEqual(other.tail_);
+    }
+
+    void appendTo(SimpleString& str, bool first) const
+    {
+        if (!first) str += ", ";
+        str += MockTypedComparator<T>::valueToString(head_);
+        tail_.appendTo(str, false);
+    }
+
+private:
+    T head_;
+    MockValueTuple<Ts...> tail_;
+};
+
+template <typename... Ts>
+class MockTypedValues : public MockTypedValue
+{
+public:
+    MockTypedValues(const Ts&... values) : values_(values...) {}
+
+    static const void* signatureId()
+    {
+        static const char id = 0;
+        return &id;
+    }
+
+    const MockValueTuple<Ts...>& values() const { return values_; }
+
+    virtual const void* signature() const CPPUTEST_OVERRIDE { return signatureId(); }
+    virtual bool equals(const MockTypedValue& other) const CPPUTEST_OVERRIDE
+    {
+        return values_.isEqual(static_cast<const MockTypedValues&>(other).values_);
+    }
+    virtual SimpleString toString() const CPPUTEST_OVERRIDE
+    {
+        SimpleString str;
+        values_.appendTo(str, true);
+        return str;
+    }
+    virtual MockTypedValue* clone() const CPPUTEST_OVERRIDE { return new MockTypedValues(*this); }
+
+private:
+    MockValueTuple<Ts...> values_;
+};
+
+template <typename R>
+struct MockTypedReturn
+{
+    typedef typename MockTypedStorage<R>::Type Type;
+    typedef MockTypedValues<Type> Stored;
+
+    static Stored store(const Type& value) { return Stored(value); }
+
+    static Type from(const MockTypedValue* value)
+    {
+        if (value && value->signature() == Stored::signatureId())
+            return static_cast<const Stored*>(value)->values().head();
+        return Type();
+    }
+};
+
+template <typename T>
+struct MockTypedReturn<const T&>
+{
+    typedef typename MockTypedStorage<T>::Type Type;
+    typedef MockTypedValues<Type> Stored;
+
+    static Stored store(const Type& value) { return Stored(value); }
+
+    static const T& from(const MockTypedValue* value)
+    {
+        if (!value || value->signature() != Stored::signatureId())
+            FAIL("mocked function returning a reference was called without a return value");
+        return static_cast<const Stored*>(value)->values().head();
+    }
+};
+
+template <typename T>
+struct MockTypedReturn<T&>
+{
+    typedef MockTypedValues<T*> Stored;
+
+    static Stored store(T& value) { return Stored(&value); }
+
+    static Stored store(const T&)
+    {
+        static_assert(sizeof(T) == 0, "a mocked function returning a non-const reference needs a non-const lvalue in andReturn");
+        return Stored(NULLPTR);
+    }
+
+    static T& from(const MockTypedValue* value)
+    {
+        if (!value || value->signature() != Stored::signatureId())
+            FAIL("mocked function returning a reference was called without a return value");
+        return *static_cast<const Stored*>(value)->values().head();
+    }
+};
+
+template <>
+struct MockTypedReturn<void>
+{
+    static void from(const MockTypedValue*) {}
+};
+
+template <typename R, typename... Args>
+class MockTypedExpectation
+{
+public:
+    typedef MockTypedValues<typename MockTypedStorage<Args>::Type...> Arguments;
+
+    MockTypedExpectation(MockExpectedCall& call) : call_(call) {}
+
+    MockTypedExpectation& with(const typename MockTypedStorage<Args>::Type&... args)
+    {
+        call_.withArguments(Arguments(args...));
+        return *this;
+    }
+
+    MockTypedExpectation& withAnyArguments()
+    {
+        call_.ignoreOtherParameters();
+        return *this;
+    }
+
+    MockTypedExpectation& withCallOrder(unsigned int callOrder)
+    {
+        call_.withCallOrder(callOrder);
+        return *this;
+    }
+
+    template <typename V>
+    MockTypedExpectation& andReturn(V& value)
+    {
+        call_.andReturnTypedValue(MockTypedReturn<R>::store(value));
+        return *this;
+    }
+
+    template <typename V>
+    MockTypedExpectation& andReturn(const V& value)
+    {
+        call_.andReturnTypedValue(MockTypedReturn<R>::store(value));
+        return *this;
+    }
+
+private:
+    MockExpectedCall& call_;
+};
+
+template <typename Signature>
+class MockTypedFunction;
+
+template <typename R, typename... Args>
+class MockTypedFunction<R(Args...)>
+{
+public:
+    typedef MockTypedExpectation<R, Args...> Expectation;
+
+    MockTypedFunction(const SimpleString& name, const SimpleString& scope = "") : name_(name), scope_(scope) {}
+
+    Expectation expectOneCall() { return Expectation(mock(scope_).expectOneCall(name_)); }
+    Expectation expectNCalls(unsigned int amount) { return Expectation(mock(scope_).expectNCalls(amount, name_)); }
+    void expectNoCall() { mock(scope_).expectNoCall(name_); }
+
+    R operator()(Args... args)
+    {
+        MockActualCall& call = mock(scope_).actualCall(name_);
+        if (sizeof...(Args) > 0)
+            call.withArguments(typename Expectation::Arguments(args...));
+        return MockTypedReturn<R>::from(call.returnTypedValue());
+    }
+
+private:
+    SimpleString name_;
+    SimpleString scope_;
+};
+
+#endif
+
+#endif
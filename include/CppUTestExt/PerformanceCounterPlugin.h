@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_PerformanceCounterPlugin_h
+#define D_PerformanceCounterPlugin_h
+
+#include "CppUTest/TestPlugin.h"
+
+/*
+ * Counts hardware events (cycles, instructions, cache misses, ...) of every
+ * test and adds them as test properties, so they end up in the verbose
+ * output, the JUnit properties and the TeamCity statistics. Counters that
+ * cannot be opened (no perf_event_open, no permission, no such hardware
+ * event) are left out; when none can be opened the plugin does nothing.
+ *
+ * The counters are opened once, as one group, so they count the same
+ * instructions, and the counts are scaled by the share of the test the
+ * group was on the hardware when the kernel had to multiplex it.
+ * A test run in a separate process (-p) opens its own group in that
+ * process. Its properties are then printed by the console outputs of that
+ * process only; they do not reach the JUnit output of the runner.
+ */
+class PerformanceCounterPlugin : public TestPlugin
+{
+public:
+    enum Counter
+    {
+        CYCLES, INSTRUCTIONS, BRANCH_MISSES, L1D_LOAD_MISSES, LLC_LOAD_MISSES, PAGE_FAULTS,
+        NUMBER_OF_COUNTERS
+    };
+
+    PerformanceCounterPlugin(const SimpleString& name = "PerformanceCounterPlugin");
+    virtual ~PerformanceCounterPlugin() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+    virtual void preTestAction(UtestShell& test, TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void postTestAction(UtestShell& test, TestResult& result) CPPUTEST_OVERRIDE;
+
+    static const char* getCounterName(Counter counter);
+
+protected:
+    /* Opens the group leader when groupLeader is -1, a member of its group otherwise */
+    virtual int openCounter(Counter counter, int groupLeader);
+    virtual void startCounters(int groupLeader);
+    virtual void stopCounters(int groupLeader);
+    /* Reads the counts in the order the counters were opened, and the time the group was enabled and running */
+    virtual bool readCounters(int groupLeader, cpputest_ulonglong values[], int numberOfValues,
+                              cpputest_ulonglong& timeEnabled, cpputest_ulonglong& timeRunning);
+    virtual void closeCounter(int handle);
+    void closeCounters();
+
+private:
+    bool opened_;
+    int groupLeader_;
+    int handles_[NUMBER_OF_COUNTERS];
+    Counter members_[NUMBER_OF_COUNTERS];
+    int numberOfMembers_;
+    cpputest_ulonglong timeEnabled_;
+    cpputest_ulonglong timeRunning_;
+
+    void openCounters();
+};
+
+#endif
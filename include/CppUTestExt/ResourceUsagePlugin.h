@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef D_ResourceUsagePlugin_h
+#define D_ResourceUsagePlugin_h
+
+#include "CppUTest/TestPlugin.h"
+
+struct ResourceUsage
+{
+    ResourceUsage();
+
+    unsigned long userTimeInMicros;
+    unsigned long systemTimeInMicros;
+    unsigned long maximumResidentSetInKilobytes;
+    unsigned long residentSetInKilobytes;
+    unsigned long minorPageFaults;
+    unsigned long majorPageFaults;
+    unsigned long voluntaryContextSwitches;
+    unsigned long involuntaryContextSwitches;
+};
+
+/*
+ * Samples the resource usage of the process before and after every test and
+ * adds the differences as test properties: CPU time, resident set growth,
+ * page faults and context switches. Limits turn outliers into failures:
+ *
+ *   -pcpulimit=<ms>       user plus system CPU time
+ *   -prsslimit=<kB>       growth of the maximum resident set
+ *   -pfaultlimit=<n>      minor plus major page faults
+ *   -pswitchlimit=<n>     voluntary plus involuntary context switches
+ *
+ * A limit that is not a number is rejected as an unknown argument.
+ *
+ * CPU time includes background threads started by the test, which the
+ * wall-clock test duration does not show. A test run in a separate process
+ * (-p) is sampled and checked in that process, so its properties are only
+ * printed by the console outputs of that process and do not reach the
+ * JUnit output of the runner.
+ */
+class ResourceUsagePlugin : public TestPlugin
+{
+public:
+    enum Limit
+    {
+        CPU_TIME_IN_MILLIS, RESIDENT_SET_GROWTH_IN_KILOBYTES, PAGE_FAULTS, CONTEXT_SWITCHES,
+        NUMBER_OF_LIMITS
+    };
+
+    ResourceUsagePlugin(const SimpleString& name = "ResourceUsagePlugin");
+    virtual ~ResourceUsagePlugin() CPPUTEST_DESTRUCTOR_OVERRIDE;
+
+    virtual void preTestAction(UtestShell& test, TestResult& result) CPPUTEST_OVERRIDE;
+    virtual void postTestAction(UtestShell& test, TestResult& result) CPPUTEST_OVERRIDE;
+    virtual bool parseArguments(int ac, const char *const *av, int index) CPPUTEST_OVERRIDE;
+
+    void setLimit(Limit limit, unsigned long value);
+    unsigned long getLimit(Limit limit) const;
+
+protected:
+    virtual bool sampleResourceUsage(ResourceUsage& usage);
+
+private:
+    void addProperties(UtestShell& test, TestResult& result, const ResourceUsage& after);
+    void checkLimit(UtestShell& test, TestResult& result, Limit limit, unsigned long used);
+
+    ResourceUsage before_;
+    bool sampled_;
+    unsigned long limits_[NUMBER_OF_LIMITS];
+};
+
+#endif
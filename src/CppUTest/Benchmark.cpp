@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/Benchmark.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+const volatile void* cpputestBenchmarkSink = NULLPTR;
+
+BenchmarkOperation::~BenchmarkOperation()
+{
+}
+
+static const size_t maximumIterations = ((size_t) 1) << 30;
+
+/* Calibration steps (a factor 10 each) after which a clock that still reads 0 is considered not to advance */
+static const int unmeasurableCalibrationSteps = 7;
+
+/* Two-sided 95% quantiles of Student's t distribution for 1 to 30 degrees of freedom */
+static const double studentT95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static unsigned long timeIterations(BenchmarkOperation& operation, size_t iterations)
+{
+    unsigned long start = GetPlatformSpecificTimeInMicros();
+    operation.run(iterations);
+    return GetPlatformSpecificTimeInMicros() - start;
+}
+
+static size_t calibrateIterations(BenchmarkOperation& operation, unsigned long sampleTimeInMicros)
+{
+    size_t iterations = 1;
+    int stepsWithoutTime = 0;
+    unsigned long elapsed = timeIterations(operation, iterations);
+    while (elapsed < sampleTimeInMicros && iterations < maximumIterations) {
+        if (elapsed == 0 && ++stepsWithoutTime > unmeasurableCalibrationSteps)
+            return 0;
+        size_t factor = 10;
+        if (elapsed > 0) {
+            double needed = 1.2 * (double) sampleTimeInMicros / (double) elapsed;
+            factor = (needed < 2.0) ? 2 : (needed > 10.0) ? 10 : (size_t) needed + 1;
+        }
+        iterations = (iterations > maximumIterations / factor) ? maximumIterations : iterations * factor;
+        elapsed = timeIterations(operation, iterations);
+    }
+    return iterations;
+}
+
+BenchmarkResult BenchmarkRunner::measure(BenchmarkOperation& operation, unsigned long sampleTimeInMicros, size_t sampleCount)
+{
+    BenchmarkResult result;
+    result.iterations = calibrateIterations(operation, sampleTimeInMicros);
+    result.samples = (sampleCount > 0) ? sampleCount : 1;
+    if (result.iterations == 0) {
+        result.samples = 0;
+        result.nanosecondsPerOperation = 0.0;
+        result.minNanosecondsPerOperation = 0.0;
+        result.confidenceInterval = 0.0;
+        return result;
+    }
+    if (result.samples > BENCHMARK_MAXIMUM_SAMPLES) result.samples = BENCHMARK_MAXIMUM_SAMPLES;
+
+    double* nanosecondsPerOperation = result.sampleNanosecondsPerOperation;
+    double sum = 0.0;
+    for (size_t i = 0; i < result.samples; i++) {
+        nanosecondsPerOperation[i] = (double) timeIterations(operation, result.iterations) * 1000.0 / (double) result.iterations;
+        sum += nanosecondsPerOperation[i];
+    }
+
+    result.nanosecondsPerOperation = sum / (double) result.samples;
+    result.minNanosecondsPerOperation = nanosecondsPerOperation[0];
+    double squaredDeviations = 0.0;
+    for (size_t i = 0; i < result.samples; i++) {
+        double deviation = nanosecondsPerOperation[i] - result.nanosecondsPerOperation;
+        squaredDeviations += deviation * deviation;
+        if (nanosecondsPerOperation[i] < result.minNanosecondsPerOperation)
+            result.minNanosecondsPerOperation = nanosecondsPerOperation[i];
+    }
+
+    result.confidenceInterval = 0.0;
+    if (result.samples > 1) {
+        size_t degreesOfFreedom = result.samples - 1;
+        double t = (degreesOfFreedom <= 30) ? studentT95[degreesOfFreedom - 1] : 1.96;
+        double standardDeviation = PlatformSpecificSqrt(squaredDeviations / (double) degreesOfFreedom);
+        result.confidenceInterval = t * standardDeviation / PlatformSpecificSqrt((double) result.samples);
+    }
+    return result;
+}
+
+void BenchmarkRunner::run(BenchmarkOperation& operation)
+{
+    UtestShell::getCurrent()->addBenchmarkResult(measure(operation, defaultSampleTimeInMicros, defaultSampleCount));
+}
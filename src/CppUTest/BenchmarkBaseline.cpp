@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/BenchmarkBaseline.h"
+#include "CppUTest/TestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+static const double significantZ = 1.96;
+
+static void sortSamples(double* samples, size_t count)
+{
+    for (size_t gap = count / 2; gap > 0; gap /= 2) {
+        for (size_t i = gap; i < count; i++) {
+            double sample = samples[i];
+            size_t j = i;
+            for (; j >= gap && samples[j - gap] > sample; j -= gap)
+                samples[j] = samples[j - gap];
+            samples[j] = sample;
+        }
+    }
+}
+
+static double median(const double* samples, size_t count)
+{
+    double* sorted = new double[count];
+    for (size_t i = 0; i < count; i++)
+        sorted[i] = samples[i];
+    sortSamples(sorted, count);
+    double result = (count % 2) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    delete [] sorted;
+    return result;
+}
+
+static bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static const char* parseNanoseconds(const char* str, double& value)
+{
+    value = 0.0;
+    for (; isDigit(*str); str++)
+        value = value * 10.0 + (*str - '0');
+    if (*str == '.') {
+        double scale = 0.1;
+        for (str++; isDigit(*str); str++, scale /= 10.0)
+            value += (*str - '0') * scale;
+    }
+    return str;
+}
+
+BenchmarkBaseline::BenchmarkBaseline() : first_(NULLPTR), last_(NULLPTR), size_(0)
+{
+}
+
+BenchmarkBaseline::~BenchmarkBaseline()
+{
+    while (first_) {
+        Entry* next = first_->next;
+        PlatformSpecificFree(first_->samples);
+        PlatformSpecificFree(first_->name);
+        PlatformSpecificFree(first_);
+        first_ = next;
+    }
+}
+
+BenchmarkBaseline::Entry* BenchmarkBaseline::findEntry(const SimpleString& name) const
+{
+    for (Entry* entry = first_; entry; entry = entry->next)
+        if (SimpleString::StrCmp(entry->name, name.asCharString()) == 0) return entry;
+    return NULLPTR;
+}
+
+BenchmarkBaseline::Entry* BenchmarkBaseline::findOrCreateEntry(const SimpleString& name)
+{
+    Entry* entry = findEntry(name);
+    if (entry) return entry;
+
+    entry = (Entry*) PlatformSpecificMalloc(sizeof(Entry));
+    entry->name = (char*) PlatformSpecificMalloc(name.size() + 1);
+    PlatformSpecificMemCpy(entry->name, name.asCharString(), name.size() + 1);
+    entry->samples = NULLPTR;
+    entry->count = 0;
+    entry->capacity = 0;
+    entry->next = NULLPTR;
+
+    if (last_) last_->next = entry;
+    else first_ = entry;
+    last_ = entry;
+    size_++;
+    return entry;
+}
+
+void BenchmarkBaseline::addSample(const SimpleString& name, double nanosecondsPerOperation)
+{
+    Entry* entry = findOrCreateEntry(name);
+    if (entry->count == entry->capacity) {
+        entry->capacity = (entry->capacity) ? entry->capacity * 2 : 16;
+        entry->samples = (double*) PlatformSpecificRealloc(entry->samples, entry->capacity * sizeof(double));
+    }
+    entry->samples[entry->count++] = nanosecondsPerOperation;
+}
+
+void BenchmarkBaseline::addResult(const SimpleString& name, const BenchmarkResult& result)
+{
+    for (size_t i = 0; i < result.samples; i++)
+        addSample(name, result.sampleNanosecondsPerOperation[i]);
+}
+
+size_t BenchmarkBaseline::size() const
+{
+    return size_;
+}
+
+void BenchmarkBaseline::parseLine(const SimpleString& line)
+{
+    if (line.size() == 0 || line.startsWith("#")) return;
+
+    size_t nameEnd = line.find(' ');
+    if (nameEnd == SimpleString::npos) return;
+
+    SimpleString name = line.subString(0, nameEnd);
+    const char* str = line.asCharString() + nameEnd;
+    while (*str) {
+        while (*str == ' ') str++;
+        if (!isDigit(*str)) break;
+
+        double nanosecondsPerOperation;
+        str = parseNanoseconds(str, nanosecondsPerOperation);
+        addSample(name, nanosecondsPerOperation);
+    }
+}
+
+bool BenchmarkBaseline::read(const SimpleString& fileName)
+{
+    PlatformSpecificFile file = PlatformSpecificFOpen(fileName.asCharString(), "r");
+    if (file == NULLPTR) return false;
+
+    SimpleString line;
+    char buffer[256];
+    while (PlatformSpecificFGets(buffer, (int) sizeof(buffer), file) != NULLPTR) {
+        line += buffer;
+        if (!line.endsWith("\n")) continue;
+
+        parseLine(line.subString(0, line.size() - 1));
+        line = "";
+    }
+    parseLine(line);
+    PlatformSpecificFClose(file);
+    return true;
+}
+
+bool BenchmarkBaseline::write(const SimpleString& fileName) const
+{
+    PlatformSpecificFile file = PlatformSpecificFOpen(fileName.asCharString(), "w");
+    if (file == NULLPTR) return false;
+
+    PlatformSpecificFPuts("# CppUTest benchmark baseline: group.name followed by the ns/op of every sample\n", file);
+    for (Entry* entry = first_; entry; entry = entry->next) {
+        SimpleString line(entry->name);
+        for (size_t i = 0; i < entry->count; i++)
+            line += StringFromFormat(" %.3f", entry->samples[i]);
+        line += "\n";
+        PlatformSpecificFPuts(line.asCharString(), file);
+    }
+    PlatformSpecificFClose(file);
+    return true;
+}
+
+double BenchmarkBaseline::mannWhitneyZ(const double* samples, size_t count, const double* baselineSamples, size_t baselineCount)
+{
+    size_t total = count + baselineCount;
+    if (count == 0 || baselineCount == 0) return 0.0;
+
+    double* combined = new double[total];
+    for (size_t i = 0; i < count; i++)
+        combined[i] = samples[i];
+    for (size_t i = 0; i < baselineCount; i++)
+        combined[count + i] = baselineSamples[i];
+    sortSamples(combined, total);
+
+    double rankSum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        size_t below = 0;
+        size_t equal = 0;
+        for (size_t j = 0; j < total; j++) {
+            if (combined[j] < samples[i]) below++;
+            else if (combined[j] == samples[i]) equal++;
+        }
+        rankSum += (double) below + ((double) equal + 1.0) / 2.0;
+    }
+
+    double ties = 0.0;
+    for (size_t i = 0; i < total; ) {
+        size_t j = i;
+        while (j < total && combined[j] == combined[i]) j++;
+        double t = (double) (j - i);
+        ties += t * t * t - t;
+        i = j;
+    }
+    delete [] combined;
+
+    double n1 = (double) count;
+    double n2 = (double) baselineCount;
+    double n = n1 + n2;
+    double u = rankSum - n1 * (n1 + 1.0) / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+    if (variance <= 0.0) return 0.0;
+
+    return (u - n1 * n2 / 2.0) / PlatformSpecificSqrt(variance);
+}
+
+size_t BenchmarkBaseline::compare(const BenchmarkBaseline& baseline, TestOutput& output, double maximumSlowdown) const
+{
+    size_t regressions = 0;
+
+    output.print("\nBenchmarks compared to the baseline (median ns/op):\n");
+    for (Entry* entry = first_; entry; entry = entry->next) {
+        output.print(entry->name);
+
+        Entry* baselineEntry = baseline.findEntry(entry->name);
+        double now = median(entry->samples, entry->count);
+        if (baselineEntry == NULLPTR || baselineEntry->count == 0) {
+            output.print(StringFromFormat(": now %.2f, not in the baseline\n", now).asCharString());
+            continue;
+        }
+
+        double before = median(baselineEntry->samples, baselineEntry->count);
+        double delta = (before > 0.0) ? (now - before) / before : 0.0;
+        double z = mannWhitneyZ(entry->samples, entry->count, baselineEntry->samples, baselineEntry->count);
+        bool regressed = z > significantZ && delta > maximumSlowdown;
+        if (regressed) regressions++;
+
+        output.print(StringFromFormat(": baseline %.2f, now %.2f, delta %+.1f%%, z %.2f%s\n",
+            before, now, delta * 100.0, z, regressed ? " - regression" : "").asCharString());
+    }
+
+    for (Entry* baselineEntry = baseline.first_; baselineEntry; baselineEntry = baselineEntry->next) {
+        if (findEntry(baselineEntry->name) != NULLPTR || baselineEntry->count == 0) continue;
+        output.print(baselineEntry->name);
+        output.print(StringFromFormat(": baseline %.2f, not run\n", median(baselineEntry->samples, baselineEntry->count)).asCharString());
+    }
+    output.print(StringFromFormat("%d benchmark regressions (significantly slower by more than %.1f%%)\n",
+        (int) regressions, maximumSlowdown * 100.0).asCharString());
+    return regressions;
+}
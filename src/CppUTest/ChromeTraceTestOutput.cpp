@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/ChromeTraceTestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+ChromeTraceTestOutput::ChromeTraceTestOutput(const SimpleString& fileName)
+    : fileName_(fileName), file_(NULLPTR), groupStartTime_(0), groupRanTests_(false), testStartTime_(0), testRunsInSeparateProcess_(false), phaseDepth_(0)
+{
+}
+
+ChromeTraceTestOutput::~ChromeTraceTestOutput()
+{
+    closeFile();
+}
+
+void ChromeTraceTestOutput::setPackageName(const SimpleString& package)
+{
+    if (package.isEmpty()) return;
+
+    static const char* const forbiddenCharacters = "/\\?%*:|\"<>";
+    SimpleString name = package;
+    for (const char* sym = forbiddenCharacters; *sym; ++sym)
+        name.replace(*sym, '_');
+    fileName_ = SimpleString("cpputest_trace_") + name + ".json";
+}
+
+void ChromeTraceTestOutput::printTestsStarted()
+{
+    openFile("w");
+    writeToFile("[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CppUTest\"}}");
+    writeTrackName(TESTS_TRACK, "tests");
+    writeTrackName(SEPARATE_PROCESS_TRACK, "separate processes");
+}
+
+void ChromeTraceTestOutput::printTestsEnded(const TestResult& /*result*/)
+{
+    writeToFile("\n]\n");
+    closeFile();
+}
+
+void ChromeTraceTestOutput::printCurrentGroupStarted(const UtestShell& test)
+{
+    groupName_ = test.getGroup();
+    groupStartTime_ = GetPlatformSpecificTimeInMicros();
+    groupRanTests_ = false;
+}
+
+void ChromeTraceTestOutput::printCurrentGroupEnded(const TestResult& /*res*/)
+{
+    if (groupRanTests_) writeSlice(groupName_, "group", groupStartTime_, TESTS_TRACK);
+    flush();
+}
+
+void ChromeTraceTestOutput::printCurrentTestStarted(const UtestShell& test)
+{
+    testName_ = test.getFormattedName();
+    testRunsInSeparateProcess_ = test.isRunInSeperateProcess();
+    groupRanTests_ = true;
+    phaseDepth_ = 0;
+
+    /* The child process appends to the file itself, so nothing may be left buffered when it forks */
+    if (testRunsInSeparateProcess_) closeFile();
+
+    testStartTime_ = GetPlatformSpecificTimeInMicros();
+}
+
+void ChromeTraceTestOutput::printCurrentTestEnded(const TestResult& /*res*/)
+{
+    writeSlice(testName_, "test", testStartTime_, TESTS_TRACK);
+    flush();
+}
+
+void ChromeTraceTestOutput::printCurrentTestPhaseStarted(const char* phase)
+{
+    if (phaseDepth_ == MAXIMUM_PHASE_DEPTH) return;
+
+    phases_[phaseDepth_] = phase;
+    phaseStartTimes_[phaseDepth_] = GetPlatformSpecificTimeInMicros();
+    phaseDepth_++;
+}
+
+void ChromeTraceTestOutput::printCurrentTestPhaseEnded(const char* phase)
+{
+    int depth = phaseDepth_;
+    while (depth > 0 && SimpleString(phases_[depth - 1]) != phase)
+        depth--;
+    if (depth == 0) return;
+
+    phaseDepth_ = depth - 1;
+    writeSlice(phase, "phase", phaseStartTimes_[phaseDepth_], testRunsInSeparateProcess_ ? SEPARATE_PROCESS_TRACK : TESTS_TRACK);
+
+    if (testRunsInSeparateProcess_ && phaseDepth_ == 0) closeFile();
+}
+
+void ChromeTraceTestOutput::printBuffer(const char*)
+{
+}
+
+void ChromeTraceTestOutput::flush()
+{
+    if (file_) PlatformSpecificFFlush(file_);
+}
+
+void ChromeTraceTestOutput::writeTrackName(Track track, const char* name)
+{
+    writeToFile(StringFromFormat(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", (int) track, name));
+}
+
+void ChromeTraceTestOutput::writeSlice(const SimpleString& name, const char* category, unsigned long startTime, Track track)
+{
+    unsigned long duration = GetPlatformSpecificTimeInMicros() - startTime;
+    writeToFile(StringFromFormat(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":%d}",
+                                 encodeJsonText(name).asCharString(), category, startTime, duration, (int) track));
+}
+
+SimpleString ChromeTraceTestOutput::encodeJsonText(const SimpleString& text)
+{
+    SimpleString buf = text;
+    buf.replace("\\", "\\\\");
+    buf.replace("\"", "\\\"");
+    buf.replace("\n", "\\n");
+    buf.replace("\r", "\\r");
+    buf.replace("\t", "\\t");
+    return buf;
+}
+
+void ChromeTraceTestOutput::openFile(const char* mode)
+{
+    file_ = PlatformSpecificFOpen(fileName_.asCharString(), mode);
+}
+
+void ChromeTraceTestOutput::writeToFile(const SimpleString& buffer)
+{
+    if (file_ == NULLPTR) openFile("a");
+    if (file_ == NULLPTR) return;
+    PlatformSpecificFPuts(buffer.asCharString(), file_);
+}
+
+void ChromeTraceTestOutput::closeFile()
+{
+    if (file_ == NULLPTR) return;
+    PlatformSpecificFClose(file_);
+    file_ = NULLPTR;
+}
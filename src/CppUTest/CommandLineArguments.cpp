@@ -31,9 +31,9 @@
 
 CommandLineArguments::CommandLineArguments(int ac, const char *const *av) :
     ac_(ac), av_(av), needHelp_(false), verbose_(false), veryVerbose_(false), color_(false), runTestsAsSeperateProcess_(false),
-    listTestGroupNames_(false), listTestGroupAndCaseNames_(false), listTestLocations_(false), runIgnored_(false), reversing_(false),
-    crashOnFail_(false), rethrowExceptions_(true), shuffling_(false), shufflingPreSeeded_(false), repeat_(1), shuffleSeed_(0),
-    groupFilters_(NULLPTR), nameFilters_(NULLPTR), outputType_(OUTPUT_ECLIPSE)
+    listTestGroupNames_(false), listTestGroupAndCaseNames_(false), listTestLocations_(false), runIgnored_(false), runBenchmarks_(false), reversing_(false),
+    crashOnFail_(false), rethrowExceptions_(true), failFast_(false), runFailedTestsFirst_(false), shuffling_(false), shufflingPreSeeded_(false), repeat_(1), shuffleSeed_(0), timeout_(0), reportStatistics_(false), unstablePercentage_(0), maximumSlowdownPercentage_(10),
+    groupFilters_(NULLPTR), nameFilters_(NULLPTR), outputType_(OUTPUT_ECLIPSE), failedTestsFile_("cpputest_failed_tests.txt")
 {
 }
 
@@ -72,6 +72,14 @@ bool CommandLineArguments::parse(TestPlugin* plugin)
         else if (argument == "-ri") runIgnored_ = true;
         else if (argument == "-f") crashOnFail_ = true;
         else if ((argument == "-e") || (argument == "-ci")) rethrowExceptions_ = false;
+        else if (argument == "--fail-fast") failFast_ = true;
+        else if (argument == "--benchmarks") runBenchmarks_ = true;
+        else if (argument.startsWith("--failed-first")) correctParameters = setFailedTestsFirst(argument);
+        else if (argument.startsWith("--timeout=")) correctParameters = setTimeout(argument);
+        else if (argument.startsWith("--stats")) correctParameters = setStatistics(argument);
+        else if (argument.startsWith("--save-baseline=")) correctParameters = setBaselineFile(argument, "--save-baseline=", saveBaselineFile_);
+        else if (argument.startsWith("--compare-baseline=")) correctParameters = setBaselineFile(argument, "--compare-baseline=", compareBaselineFile_);
+        else if (argument.startsWith("--max-slowdown=")) correctParameters = setMaximumSlowdown(argument);
         else if (argument.startsWith("-r")) setRepeatCount(ac_, av_, i);
         else if (argument.startsWith("-g")) addGroupFilter(ac_, av_, i);
         else if (argument.startsWith("-t")) correctParameters = addGroupDotNameFilter(ac_, av_, i, "-t", false, false);
@@ -88,6 +96,7 @@ bool CommandLineArguments::parse(TestPlugin* plugin)
         else if (argument.startsWith("-s")) correctParameters = setShuffle(ac_, av_, i);
         else if (argument.startsWith("TEST(")) addTestToRunBasedOnVerboseOutput(ac_, av_, i, "TEST(");
         else if (argument.startsWith("IGNORE_TEST(")) addTestToRunBasedOnVerboseOutput(ac_, av_, i, "IGNORE_TEST(");
+        else if (argument.startsWith("BENCHMARK(")) addTestToRunBasedOnVerboseOutput(ac_, av_, i, "BENCHMARK(");
         else if (argument.startsWith("-o")) correctParameters = setOutputType(ac_, av_, i);
         else if (argument.startsWith("-p")) correctParameters = plugin->parseAllArguments(ac_, av_, i);
         else if (argument.startsWith("-k")) setPackageName(ac_, av_, i);
@@ -106,7 +115,9 @@ const char* CommandLineArguments::usage() const
            "usage [-h] [-v] [-vv] [-c] [-p] [-lg] [-ln] [-ll] [-ri] [-r[<#>]] [-f] [-e] [-ci]\n"
            "      [-g|sg|xg|xsg <groupName>]... [-n|sn|xn|xsn <testName>]... [-t|st|xt|xst <groupName>.<testName>]...\n"
            "      [-b] [-s [<seed>]] [\"[IGNORE_]TEST(<groupName>, <testName>)\"]...\n"
-           "      [-o{normal|eclipse|junit|teamcity}] [-k <packageName>]\n";
+           "      [-o{normal|eclipse|junit|junitsingle|teamcity|chrometrace|resultlog|tap|jsonl}] [-k <packageName>]\n"
+           "      [--fail-fast] [--failed-first[=<file>]] [--timeout=<seconds>] [--stats[=<cv%>]]\n"
+           "      [--benchmarks] [--save-baseline=<file>] [--compare-baseline=<file>] [--max-slowdown=<percent>]\n";
 }
 
 const char* CommandLineArguments::help() const
@@ -130,7 +141,12 @@ const char* CommandLineArguments::help() const
       "  -oeclipse         - equivalent to -onormal\n"
       "  -oteamcity        - output to xml files (as the name suggests, for TeamCity)\n"
       "  -ojunit           - output to JUnit ant plugin style xml files (for CI systems)\n"
-      "  -k <packageName>  - add a package name in JUnit output (for classification in CI systems)\n"
+      "  -ojunitsingle     - stream the JUnit xml of all groups into one file, cpputest[_<packageName>].xml\n"
+      "  -ochrometrace     - also write a Chrome trace-event file of the test run, cpputest_trace[_<packageName>].json\n"
+      "  -oresultlog       - also record the results in cpputest_results.log, to be converted by CppUTestResultLogConverter\n"
+      "  -otap             - output in the Test Anything Protocol, one record per test as it ends\n"
+      "  -ojsonl           - output JSON Lines, one object per test as it ends\n"
+      "  -k <packageName>  - add a package name in JUnit output and trace file names (for classification in CI systems)\n"
       "\n"
       "\n"
       "Options that control which tests are run:\n"
@@ -149,6 +165,7 @@ const char* CommandLineArguments::help() const
       "  \"[IGNORE_]TEST(<group>, <name>)\"\n"
       "                    - only run tests whose group and name exactly match <group> and <name>\n"
       "                      (this can be used to copy-paste output from the -v option on the command line)\n"
+      "  <group> and <name> may contain the wildcards * (any characters) and ? (one character)\n"
       "\n"
       "Options that control how the tests are run:\n"
       "  -p                - run tests in a separate process\n"
@@ -158,7 +175,29 @@ const char* CommandLineArguments::help() const
       "  -ri               - run ignored tests as if they are not ignored\n"
       "  -f                - Cause the tests to crash on failure (to allow the test to be debugged if necessary)\n"
       "  -e                - do not rethrow unexpected exceptions on failure\n"
-      "  -ci               - continuous integration mode (equivalent to -e)\n";
+      "  -ci               - continuous integration mode (equivalent to -e)\n"
+      "  --fail-fast       - stop the test run at the first failing test\n"
+      "  --failed-first[=<file>]\n"
+      "                    - run the tests that failed in the previous run first, and record the\n"
+      "                      failing tests of this run (in cpputest_failed_tests.txt by default).\n"
+      "                      Runs without it write no file, so the first run with it reorders nothing\n"
+      "  --timeout=<seconds>\n"
+      "                    - fail a test that runs longer than <seconds>. With -p the test process is killed\n"
+      "                      and the test reported as failed. Without -p only the test name is printed and\n"
+      "                      the run aborts, so the outputs do not record the failure and the remaining tests\n"
+      "                      do not run. TEST_GROUP_TIMEOUT overrides it\n"
+      "  --stats[=<cv%>]   - print min, median, p95, p99 and the coefficient of variation of each test's\n"
+      "                      execution time over the -r repetitions, flagging tests whose coefficient of\n"
+      "                      variation is above <cv%> as unstable\n"
+      "  --benchmarks      - run the BENCHMARK tests (which are otherwise ignored) and print their timings\n"
+      "  --save-baseline=<file>\n"
+      "                    - run the benchmarks and write their samples to <file> (not with -p)\n"
+      "  --compare-baseline=<file>\n"
+      "                    - run the benchmarks and compare them to the baseline in <file>. A benchmark that is\n"
+      "                      significantly slower (Mann-Whitney U test) by more than the maximum slowdown fails the run.\n"
+      "                      Benchmarks of the baseline that did not run are listed. Not with -p\n"
+      "  --max-slowdown=<percent>\n"
+      "                    - the slowdown of the median that --compare-baseline accepts (10% by default)\n";
 }
 
 bool CommandLineArguments::needHelp() const
@@ -201,6 +240,11 @@ bool CommandLineArguments::isRunIgnored() const
     return runIgnored_;
 }
 
+bool CommandLineArguments::isRunningBenchmarks() const
+{
+    return runBenchmarks_;
+}
+
 bool CommandLineArguments::runTestsInSeperateProcess() const
 {
     return runTestsAsSeperateProcess_;
@@ -227,6 +271,61 @@ bool CommandLineArguments::isRethrowingExceptions() const
     return rethrowExceptions_;
 }
 
+bool CommandLineArguments::isFailFast() const
+{
+    return failFast_;
+}
+
+bool CommandLineArguments::isRunningFailedTestsFirst() const
+{
+    return runFailedTestsFirst_;
+}
+
+const SimpleString& CommandLineArguments::getFailedTestsFile() const
+{
+    return failedTestsFile_;
+}
+
+unsigned int CommandLineArguments::getTimeout() const
+{
+    return timeout_;
+}
+
+bool CommandLineArguments::isReportingStatistics() const
+{
+    return reportStatistics_;
+}
+
+size_t CommandLineArguments::getUnstablePercentage() const
+{
+    return unstablePercentage_;
+}
+
+bool CommandLineArguments::isSavingBenchmarkBaseline() const
+{
+    return saveBaselineFile_.size() > 0;
+}
+
+const SimpleString& CommandLineArguments::getSaveBaselineFile() const
+{
+    return saveBaselineFile_;
+}
+
+bool CommandLineArguments::isComparingBenchmarkBaseline() const
+{
+    return compareBaselineFile_.size() > 0;
+}
+
+const SimpleString& CommandLineArguments::getCompareBaselineFile() const
+{
+    return compareBaselineFile_;
+}
+
+size_t CommandLineArguments::getMaximumSlowdownPercentage() const
+{
+    return maximumSlowdownPercentage_;
+}
+
 bool CommandLineArguments::isShuffling() const
 {
     return shuffling_;
@@ -396,6 +495,52 @@ void CommandLineArguments::setPackageName(int ac, const char *const *av, int& i)
     packageName_ = packageName;
 }
 
+bool CommandLineArguments::setFailedTestsFirst(const SimpleString& argument)
+{
+    const SimpleString option("--failed-first");
+    if (argument.size() > option.size()) {
+        if (argument.at(option.size()) != '=') return false;
+        if (argument.size() > option.size() + 1)
+            failedTestsFile_ = argument.subString(option.size() + 1);
+    }
+    runFailedTestsFirst_ = true;
+    return true;
+}
+
+bool CommandLineArguments::setTimeout(const SimpleString& argument)
+{
+    SimpleString seconds = argument.subString(SimpleString("--timeout=").size());
+    timeout_ = SimpleString::AtoU(seconds.asCharString());
+    return timeout_ > 0;
+}
+
+bool CommandLineArguments::setStatistics(const SimpleString& argument)
+{
+    const SimpleString option("--stats");
+    if (argument.size() > option.size()) {
+        if (argument.at(option.size()) != '=') return false;
+        unstablePercentage_ = SimpleString::AtoU(argument.subString(option.size() + 1).asCharString());
+        if (unstablePercentage_ == 0) return false;
+    }
+    reportStatistics_ = true;
+    return true;
+}
+
+bool CommandLineArguments::setBaselineFile(const SimpleString& argument, const SimpleString& option, SimpleString& file)
+{
+    file = argument.subString(option.size());
+    runBenchmarks_ = true;
+    return file.size() > 0;
+}
+
+bool CommandLineArguments::setMaximumSlowdown(const SimpleString& argument)
+{
+    SimpleString percentage = argument.subString(SimpleString("--max-slowdown=").size());
+    if (percentage.size() == 0 || percentage.at(0) < '0' || percentage.at(0) > '9') return false;
+    maximumSlowdownPercentage_ = SimpleString::AtoU(percentage.asCharString());
+    return true;
+}
+
 bool CommandLineArguments::setOutputType(int ac, const char *const *av, int& i)
 {
     SimpleString outputType = getParameterField(ac, av, i, "-o");
@@ -409,10 +554,30 @@ bool CommandLineArguments::setOutputType(int ac, const char *const *av, int& i)
         outputType_ = OUTPUT_JUNIT;
         return true;
     }
+    if (outputType == "junitsingle") {
+        outputType_ = OUTPUT_JUNIT_SINGLE_FILE;
+        return true;
+    }
     if (outputType == "teamcity") {
         outputType_ = OUTPUT_TEAMCITY;
         return true;
     }
+    if (outputType == "chrometrace") {
+        outputType_ = OUTPUT_CHROMETRACE;
+        return true;
+    }
+    if (outputType == "resultlog") {
+        outputType_ = OUTPUT_RESULT_LOG;
+        return true;
+    }
+    if (outputType == "tap") {
+        outputType_ = OUTPUT_TAP;
+        return true;
+    }
+    if (outputType == "jsonl") {
+        outputType_ = OUTPUT_JSON_LINES;
+        return true;
+    }
 
     return false;
 }
@@ -427,11 +592,36 @@ bool CommandLineArguments::isJUnitOutput() const
     return outputType_ == OUTPUT_JUNIT;
 }
 
+bool CommandLineArguments::isJUnitSingleFileOutput() const
+{
+    return outputType_ == OUTPUT_JUNIT_SINGLE_FILE;
+}
+
 bool CommandLineArguments::isTeamCityOutput() const
 {
     return outputType_ == OUTPUT_TEAMCITY;
 }
 
+bool CommandLineArguments::isChromeTraceOutput() const
+{
+    return outputType_ == OUTPUT_CHROMETRACE;
+}
+
+bool CommandLineArguments::isResultLogOutput() const
+{
+    return outputType_ == OUTPUT_RESULT_LOG;
+}
+
+bool CommandLineArguments::isTapOutput() const
+{
+    return outputType_ == OUTPUT_TAP;
+}
+
+bool CommandLineArguments::isJsonLinesOutput() const
+{
+    return outputType_ == OUTPUT_JSON_LINES;
+}
+
 const SimpleString& CommandLineArguments::getPackageName() const
 {
     return packageName_;
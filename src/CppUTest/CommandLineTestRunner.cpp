@@ -30,7 +30,97 @@
 #include "CppUTest/TestOutput.h"
 #include "CppUTest/JUnitTestOutput.h"
 #include "CppUTest/TeamCityTestOutput.h"
+#include "CppUTest/ChromeTraceTestOutput.h"
+#include "CppUTest/ResultLogTestOutput.h"
+#include "CppUTest/StreamingTestOutput.h"
 #include "CppUTest/TestRegistry.h"
+#include "CppUTest/TestRepetitionStatistics.h"
+#include "CppUTest/BenchmarkBaseline.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+/*
+ * Collects "group.name" of every failing test, one per line. Tests of the
+ * previous failed list that never got to run (because of --fail-fast) are
+ * kept, so they are not forgotten. When given statistics, it also adds the
+ * execution time of every test to them, timed with the microsecond clock,
+ * and when given a baseline, the samples of every benchmark.
+ */
+class CommandLineTestResult : public TestResult
+{
+public:
+    CommandLineTestResult(TestOutput& output, SimpleStringCollection& previouslyFailed, TestRepetitionStatistics* statistics, BenchmarkBaseline* benchmarks)
+        : TestResult(output), previouslyFailedHasRun_(NULLPTR), failureCountAtTestStart_(0), testStartTimeInMicros_(0), statistics_(statistics), benchmarks_(benchmarks)
+    {
+        for (size_t i = 0; i < previouslyFailed.size(); i++)
+            previouslyFailed_.add(previouslyFailed[i]);
+
+        previouslyFailedHasRun_ = new bool[previouslyFailed_.size() + 1];
+        for (size_t i = 0; i < previouslyFailed_.size(); i++)
+            previouslyFailedHasRun_[i] = false;
+    }
+
+    virtual ~CommandLineTestResult() CPPUTEST_DESTRUCTOR_OVERRIDE
+    {
+        delete [] previouslyFailedHasRun_;
+    }
+
+    virtual void currentTestStarted(UtestShell* test) CPPUTEST_OVERRIDE
+    {
+        TestResult::currentTestStarted(test);
+        failureCountAtTestStart_ = getFailureCount();
+        if (statistics_) testStartTimeInMicros_ = GetPlatformSpecificTimeInMicros();
+
+        if (previouslyFailed_.size() == 0) return;
+
+        size_t previouslyFailedIndex = previouslyFailed_.find(groupDotNameOf(test));
+        if (previouslyFailedIndex != SimpleString::npos) previouslyFailedHasRun_[previouslyFailedIndex] = true;
+    }
+
+    virtual void currentTestEnded(UtestShell* test) CPPUTEST_OVERRIDE
+    {
+        if (getFailureCount() > failureCountAtTestStart_) {
+            failedTests_ += groupDotNameOf(test);
+            failedTests_ += "\n";
+        }
+        TestResult::currentTestEnded(test);
+        if (statistics_) statistics_->addSample(test, (size_t) (GetPlatformSpecificTimeInMicros() - testStartTimeInMicros_));
+    }
+
+    virtual void addBenchmarkResult(const UtestShell& test, const BenchmarkResult& result) CPPUTEST_OVERRIDE
+    {
+        TestResult::addBenchmarkResult(test, result);
+        if (benchmarks_) benchmarks_->addResult(test.getGroup() + "." + test.getName(), result);
+    }
+
+    SimpleString getFailedTests()
+    {
+        SimpleString failedTests = failedTests_;
+        for (size_t i = 0; i < previouslyFailed_.size(); i++) {
+            if (!previouslyFailedHasRun_[i]) {
+                failedTests += previouslyFailed_[i];
+                failedTests += "\n";
+            }
+        }
+        return failedTests;
+    }
+
+private:
+    static SimpleString groupDotNameOf(UtestShell* test)
+    {
+        return test->getGroup() + "." + test->getName();
+    }
+
+    SimpleStringIndex previouslyFailed_;
+    bool* previouslyFailedHasRun_;
+    size_t failureCountAtTestStart_;
+    unsigned long testStartTimeInMicros_;
+    SimpleString failedTests_;
+    TestRepetitionStatistics* statistics_;
+    BenchmarkBaseline* benchmarks_;
+
+    CommandLineTestResult(const CommandLineTestResult&);
+    CommandLineTestResult& operator=(const CommandLineTestResult&);
+};
 
 int CommandLineTestRunner::RunAllTests(int ac, char** av)
 {
@@ -66,6 +156,14 @@ CommandLineTestRunner::CommandLineTestRunner(int ac, const char *const *av, Test
 
 CommandLineTestRunner::~CommandLineTestRunner()
 {
+    /*
+     * The registry outlives the runner and keeps the filters compiled into
+     * its matchers, allocated while leak detection is on. Dropping them here
+     * frees those tables before RunAllTests prints its final leak report.
+     * The matchers copy the filters, so they never point into arguments_.
+     */
+    registry_->setGroupFilters(NULLPTR);
+    registry_->setNameFilters(NULLPTR);
     delete arguments_;
     delete output_;
 }
@@ -94,6 +192,9 @@ void CommandLineTestRunner::initializeTestRun()
     if (arguments_->isColor()) output_->color();
     if (arguments_->runTestsInSeperateProcess()) registry_->setRunTestsInSeperateProcess();
     if (arguments_->isRunIgnored()) registry_->setRunIgnored();
+    if (arguments_->isRunningBenchmarks()) registry_->setRunBenchmarks();
+    if (arguments_->isFailFast()) registry_->setFailFast();
+    if (arguments_->getTimeout() > 0) registry_->setTimeout(arguments_->getTimeout());
     if (arguments_->isCrashingOnFail()) UtestShell::setCrashOnFail();
 
     UtestShell::setRethrowExceptions( arguments_->isRethrowingExceptions() );
@@ -131,6 +232,18 @@ int CommandLineTestRunner::runAllTests()
     if (arguments_->isReversing())
         registry_->reverseTests();
 
+    TestRepetitionStatistics statistics;
+    BenchmarkBaseline benchmarks;
+    bool recordingBenchmarks = arguments_->isSavingBenchmarkBaseline() || arguments_->isComparingBenchmarkBaseline();
+    if (recordingBenchmarks && arguments_->runTestsInSeperateProcess()) {
+        output_->print("\n--save-baseline and --compare-baseline cannot be used with -p, "
+                       "as the benchmark results would stay in the separate processes\n");
+        return 1;
+    }
+    SimpleStringCollection previouslyFailedTests;
+    if (arguments_->isRunningFailedTestsFirst())
+        readFailedTests(previouslyFailedTests);
+
     if (arguments_->isShuffling())
     {
         output_->print("Test order shuffling enabled with seed: ");
@@ -142,17 +255,90 @@ int CommandLineTestRunner::runAllTests()
         if (arguments_->isShuffling())
             registry_->shuffleTests(arguments_->getShuffleSeed());
 
+        if (arguments_->isRunningFailedTestsFirst())
+            registry_->moveTestsToFront(previouslyFailedTests);
+
         output_->printTestRun(loopCount, repeatCount);
-        TestResult tr(*output_);
+        CommandLineTestResult tr(*output_, previouslyFailedTests, arguments_->isReportingStatistics() ? &statistics : NULLPTR,
+                                 recordingBenchmarks ? &benchmarks : NULLPTR);
         registry_->runAllTests(tr);
         failedTestCount += tr.getFailureCount();
         if (tr.isFailure()) {
             failedExecutionCount++;
         }
+
+        /* Only --failed-first writes the file, so plain runs leave no file behind */
+        if (arguments_->isRunningFailedTestsFirst())
+            writeFailedTests(tr.getFailedTests());
+
+        if (arguments_->isFailFast() && tr.getFailureCount() > 0)
+            break;
     }
+
+    TestResult runResult(*output_);
+    registry_->getFirstPlugin()->runAllPostRunAction(runResult);
+
+    if (arguments_->isReportingStatistics())
+        statistics.print(*output_, registry_->getFirstTest(), (double) arguments_->getUnstablePercentage() / 100.0);
+
+    if (arguments_->isSavingBenchmarkBaseline())
+        saveBenchmarkBaseline(benchmarks);
+
+    if (arguments_->isComparingBenchmarkBaseline())
+        failedTestCount += compareBenchmarkBaseline(benchmarks);
+
     return (int) (failedTestCount != 0 ? failedTestCount : failedExecutionCount);
 }
 
+void CommandLineTestRunner::readFailedTests(SimpleStringCollection& failedTests)
+{
+    PlatformSpecificFile file = PlatformSpecificFOpen(arguments_->getFailedTestsFile().asCharString(), "r");
+    if (file == NULLPTR) return;
+
+    SimpleString contents;
+    char buffer[256];
+    while (PlatformSpecificFGets(buffer, (int) sizeof(buffer), file) != NULLPTR)
+        contents += buffer;
+    PlatformSpecificFClose(file);
+
+    if (contents.size() == 0) return;
+
+    contents.split("\n", failedTests);
+    for (size_t i = 0; i < failedTests.size(); i++)
+        if (failedTests[i].endsWith("\n"))
+            failedTests[i] = failedTests[i].subString(0, failedTests[i].size() - 1);
+}
+
+void CommandLineTestRunner::writeFailedTests(const SimpleString& failedTests)
+{
+    PlatformSpecificFile file = PlatformSpecificFOpen(arguments_->getFailedTestsFile().asCharString(), "w");
+    if (file == NULLPTR) return;
+
+    PlatformSpecificFPuts(failedTests.asCharString(), file);
+    PlatformSpecificFClose(file);
+}
+
+void CommandLineTestRunner::saveBenchmarkBaseline(const BenchmarkBaseline& benchmarks)
+{
+    if (!benchmarks.write(arguments_->getSaveBaselineFile())) {
+        output_->print("\nCould not write the benchmark baseline ");
+        output_->print(arguments_->getSaveBaselineFile().asCharString());
+        output_->print("\n");
+    }
+}
+
+size_t CommandLineTestRunner::compareBenchmarkBaseline(const BenchmarkBaseline& benchmarks)
+{
+    BenchmarkBaseline baseline;
+    if (!baseline.read(arguments_->getCompareBaselineFile())) {
+        output_->print("\nCould not read the benchmark baseline ");
+        output_->print(arguments_->getCompareBaselineFile().asCharString());
+        output_->print("\n");
+        return 1;
+    }
+    return benchmarks.compare(baseline, *output_, (double) arguments_->getMaximumSlowdownPercentage() / 100.0);
+}
+
 TestOutput* CommandLineTestRunner::createTeamCityOutput()
 {
     return new TeamCityTestOutput;
@@ -167,6 +353,39 @@ TestOutput* CommandLineTestRunner::createJUnitOutput(const SimpleString& package
     return junitOutput;
 }
 
+TestOutput* CommandLineTestRunner::createJUnitSingleFileOutput(const SimpleString& packageName)
+{
+    JUnitSingleFileTestOutput* junitOutput = new JUnitSingleFileTestOutput;
+    if (junitOutput != NULLPTR) {
+      junitOutput->setPackageName(packageName);
+    }
+    return junitOutput;
+}
+
+TestOutput* CommandLineTestRunner::createChromeTraceOutput(const SimpleString& packageName)
+{
+    ChromeTraceTestOutput* traceOutput = new ChromeTraceTestOutput;
+    if (traceOutput != NULLPTR) {
+      traceOutput->setPackageName(packageName);
+    }
+    return traceOutput;
+}
+
+TestOutput* CommandLineTestRunner::createResultLogOutput()
+{
+    return new ResultLogTestOutput;
+}
+
+TestOutput* CommandLineTestRunner::createTapOutput()
+{
+    return new TapTestOutput;
+}
+
+TestOutput* CommandLineTestRunner::createJsonLinesOutput()
+{
+    return new JsonLinesTestOutput;
+}
+
 TestOutput* CommandLineTestRunner::createConsoleOutput()
 {
     return new ConsoleTestOutput;
@@ -192,8 +411,20 @@ bool CommandLineTestRunner::parseArguments(TestPlugin* plugin)
     output_= createJUnitOutput(arguments_->getPackageName());
     if (arguments_->isVerbose() || arguments_->isVeryVerbose())
       output_ = createCompositeOutput(output_, createConsoleOutput());
+  } else if (arguments_->isJUnitSingleFileOutput()) {
+    output_= createJUnitSingleFileOutput(arguments_->getPackageName());
+    if (arguments_->isVerbose() || arguments_->isVeryVerbose())
+      output_ = createCompositeOutput(output_, createConsoleOutput());
   } else if (arguments_->isTeamCityOutput()) {
     output_ = createTeamCityOutput();
+  } else if (arguments_->isChromeTraceOutput()) {
+    output_ = createCompositeOutput(createChromeTraceOutput(arguments_->getPackageName()), createConsoleOutput());
+  } else if (arguments_->isResultLogOutput()) {
+    output_ = createCompositeOutput(createResultLogOutput(), createConsoleOutput());
+  } else if (arguments_->isTapOutput()) {
+    output_ = createTapOutput();
+  } else if (arguments_->isJsonLinesOutput()) {
+    output_ = createJsonLinesOutput();
   } else
     output_ = createConsoleOutput();
   return true;
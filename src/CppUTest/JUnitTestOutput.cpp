@@ -45,6 +45,7 @@ struct JUnitTestCaseResultNode
     SimpleString file_;
     size_t lineNumber_;
     size_t checkCount_;
+    SimpleString properties_;
     JUnitTestCaseResultNode* next_;
 };
 
@@ -233,6 +234,7 @@ void JUnitTestOutput::writeTestCases()
 
         impl_->results_.totalCheckCount_ = cur->checkCount_;
 
+        writeTestCaseProperties(cur);
         if (cur->failure_) {
             writeFailure(cur);
         }
@@ -255,6 +257,14 @@ void JUnitTestOutput::writeFailure(JUnitTestCaseResultNode* node)
     writeToFile("</failure>\n");
 }
 
+void JUnitTestOutput::writeTestCaseProperties(JUnitTestCaseResultNode* node)
+{
+    if (node->properties_.isEmpty()) return;
+
+    writeToFile("<properties>\n");
+    writeToFile(node->properties_);
+    writeToFile("</properties>\n");
+}
 
 void JUnitTestOutput::writeFileEnding()
 {
@@ -309,6 +319,14 @@ void JUnitTestOutput::printFailure(const TestFailure& failure)
     }
 }
 
+void JUnitTestOutput::printTestProperty(const UtestShell&, const SimpleString& name, const SimpleString& value)
+{
+    if (impl_->results_.tail_ == NULLPTR) return;
+
+    impl_->results_.tail_->properties_ += StringFromFormat("<property name=\"%s\" value=\"%s\"/>\n",
+        encodeXmlText(name).asCharString(), encodeXmlText(value).asCharString());
+}
+
 void JUnitTestOutput::openFileForWrite(const SimpleString& fileName)
 {
     impl_->file_ = PlatformSpecificFOpen(fileName.asCharString(), "w");
@@ -323,3 +341,145 @@ void JUnitTestOutput::closeFile()
 {
     PlatformSpecificFClose(impl_->file_);
 }
+
+JUnitSingleFileTestOutput::JUnitSingleFileTestOutput()
+    : writeBufferUsed_(0), fileIsOpen_(false), testLineNumber_(0), testIgnored_(false), checkCountBeforeTest_(0)
+{
+}
+
+JUnitSingleFileTestOutput::~JUnitSingleFileTestOutput()
+{
+    if (fileIsOpen_) closeFile();
+}
+
+SimpleString JUnitSingleFileTestOutput::createSingleFileName()
+{
+    SimpleString fileName = "cpputest";
+    if (!impl_->package_.isEmpty()) {
+        fileName += "_";
+        fileName += impl_->package_;
+    }
+    return encodeFileName(fileName) + ".xml";
+}
+
+void JUnitSingleFileTestOutput::printTestsStarted()
+{
+    openFileForWrite(createSingleFileName());
+    fileIsOpen_ = true;
+    checkCountBeforeTest_ = 0;
+    writeXmlHeader();
+    writeToFile("<testsuites>\n");
+}
+
+void JUnitSingleFileTestOutput::printTestsEnded(const TestResult& /*result*/)
+{
+    writeToFile("</testsuites>\n");
+    closeFile();
+}
+
+void JUnitSingleFileTestOutput::printCurrentGroupStarted(const UtestShell& test)
+{
+    group_ = test.getGroup();
+    writeToFile(StringFromFormat("<testsuite hostname=\"localhost\" name=\"%s\" timestamp=\"%s\">\n",
+                                 encodeXmlText(group_).asCharString(), GetPlatformSpecificTimeString()));
+}
+
+void JUnitSingleFileTestOutput::printCurrentGroupEnded(const TestResult& /*res*/)
+{
+    writeStdOutput();
+    writeToFile("</testsuite>\n");
+}
+
+void JUnitSingleFileTestOutput::printCurrentTestStarted(const UtestShell& test)
+{
+    testName_ = test.getName();
+    testFile_ = test.getFile();
+    testLineNumber_ = test.getLineNumber();
+    testIgnored_ = !test.willRun();
+    testFailure_ = "";
+    testProperties_ = "";
+}
+
+void JUnitSingleFileTestOutput::printCurrentTestEnded(const TestResult& result)
+{
+    size_t execTime = result.getCurrentTestTotalExecutionTime();
+    writeToFile(StringFromFormat(
+            "<testcase classname=\"%s%s%s\" name=\"%s\" assertions=\"%d\" time=\"%d.%03d\" file=\"%s\" line=\"%d\">\n",
+            impl_->package_.asCharString(),
+            impl_->package_.isEmpty() ? "" : ".",
+            encodeXmlText(group_).asCharString(),
+            encodeXmlText(testName_).asCharString(),
+            (int) (result.getCheckCount() - checkCountBeforeTest_),
+            (int) (execTime / 1000), (int) (execTime % 1000),
+            encodeXmlText(testFile_).asCharString(),
+            (int) testLineNumber_));
+    checkCountBeforeTest_ = result.getCheckCount();
+
+    if (!testProperties_.isEmpty()) {
+        writeToFile("<properties>\n");
+        writeToFile(testProperties_);
+        writeToFile("</properties>\n");
+    }
+    if (!testFailure_.isEmpty())
+        writeToFile(testFailure_);
+    else if (testIgnored_)
+        writeToFile("<skipped />\n");
+    writeStdOutput();
+    writeToFile("</testcase>\n");
+}
+
+void JUnitSingleFileTestOutput::printFailure(const TestFailure& failure)
+{
+    if (!testFailure_.isEmpty()) return;
+
+    testFailure_ = StringFromFormat("<failure message=\"%s:%d: %s\" type=\"AssertionFailedError\">\n</failure>\n",
+                                    failure.getFileName().asCharString(),
+                                    (int) failure.getFailureLineNumber(),
+                                    encodeXmlText(failure.getMessage()).asCharString());
+}
+
+void JUnitSingleFileTestOutput::printTestProperty(const UtestShell&, const SimpleString& name, const SimpleString& value)
+{
+    testProperties_ += StringFromFormat("<property name=\"%s\" value=\"%s\"/>\n",
+        encodeXmlText(name).asCharString(), encodeXmlText(value).asCharString());
+}
+
+void JUnitSingleFileTestOutput::writeStdOutput()
+{
+    if (impl_->stdOutput_.isEmpty()) return;
+
+    writeToFile("<system-out>");
+    writeToFile(encodeXmlText(impl_->stdOutput_));
+    writeToFile("</system-out>\n");
+    impl_->stdOutput_ = "";
+}
+
+void JUnitSingleFileTestOutput::writeToFile(const SimpleString& buffer)
+{
+    size_t length = buffer.size();
+    if (writeBufferUsed_ + length >= WRITE_BUFFER_SIZE) flushWriteBuffer();
+
+    if (length >= WRITE_BUFFER_SIZE) {
+        JUnitTestOutput::writeToFile(buffer);
+        return;
+    }
+
+    PlatformSpecificMemCpy(writeBuffer_ + writeBufferUsed_, buffer.asCharString(), length);
+    writeBufferUsed_ += length;
+}
+
+void JUnitSingleFileTestOutput::flushWriteBuffer()
+{
+    if (writeBufferUsed_ == 0) return;
+
+    writeBuffer_[writeBufferUsed_] = '\0';
+    PlatformSpecificFPuts(writeBuffer_, impl_->file_);
+    writeBufferUsed_ = 0;
+}
+
+void JUnitSingleFileTestOutput::closeFile()
+{
+    flushWriteBuffer();
+    JUnitTestOutput::closeFile();
+    fileIsOpen_ = false;
+}
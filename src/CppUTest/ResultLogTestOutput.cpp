@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/ResultLogTestOutput.h"
+#include "CppUTest/ZeroFreeNumber.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+static SimpleString encodeText(const SimpleString& text)
+{
+    return ZeroFreeNumber::encode((unsigned long) text.size()) + text;
+}
+
+static SimpleString textFrom(const char* position, size_t length)
+{
+    char* buffer = SimpleString::allocStringBuffer(length + 1, __FILE__, __LINE__);
+    PlatformSpecificMemCpy(buffer, position, length);
+    buffer[length] = '\0';
+    SimpleString text(buffer);
+    SimpleString::deallocStringBuffer(buffer, length + 1, __FILE__, __LINE__);
+    return text;
+}
+
+static bool decodeText(const char*& position, const char* end, SimpleString& text)
+{
+    unsigned long length;
+    if (!ZeroFreeNumber::decode(position, end, length) || length > (unsigned long) (end - position)) return false;
+
+    text = textFrom(position, length);
+    position += length;
+    return true;
+}
+
+ResultLogTestOutput::ResultLogTestOutput(const SimpleString& fileName)
+    : fileName_(fileName), file_(NULLPTR), startTime_(0), bufferedLength_(0), testRunsInSeparateProcess_(false), phaseDepth_(0)
+{
+    buffer_[0] = '\0';
+}
+
+ResultLogTestOutput::~ResultLogTestOutput()
+{
+    closeFile();
+}
+
+const char* ResultLogTestOutput::signature()
+{
+    return "CppUTest result log 1\n";
+}
+
+void ResultLogTestOutput::printTestsStarted()
+{
+    startTime_ = GetPlatformSpecificTimeInMillis();
+    strings_.clear();
+    openFile("wb");
+    writeToFile(signature());
+    writeRecord(TESTS_STARTED, "");
+    flush();
+}
+
+void ResultLogTestOutput::printTestsEnded(const TestResult& result)
+{
+    writeRecord(TESTS_ENDED, ZeroFreeNumber::encode(timeSinceStart()) + encodeCounts(result));
+    flush();
+    closeFile();
+}
+
+void ResultLogTestOutput::printCurrentGroupStarted(const UtestShell& test)
+{
+    writeRecord(GROUP_STARTED, ZeroFreeNumber::encode(timeSinceStart()) + ZeroFreeNumber::encode(internString(test.getGroup())));
+}
+
+void ResultLogTestOutput::printCurrentGroupEnded(const TestResult& res)
+{
+    writeRecord(GROUP_ENDED, ZeroFreeNumber::encode(timeSinceStart()) + encodeCounts(res));
+    flush();
+}
+
+void ResultLogTestOutput::printCurrentTestStarted(const UtestShell& test)
+{
+    unsigned long group = internString(test.getGroup());
+    unsigned long file = internString(test.getFile());
+    writeRecord(TEST_STARTED, ZeroFreeNumber::encode(timeSinceStart()) + ZeroFreeNumber::encode(group) + encodeText(test.getName()) +
+                              ZeroFreeNumber::encode(file) + ZeroFreeNumber::encode((unsigned long) test.getLineNumber()) + ZeroFreeNumber::encode(test.willRun() ? 1 : 0));
+
+    /* The child process appends to the file itself, so nothing may be left buffered when it forks */
+    testRunsInSeparateProcess_ = test.isRunInSeperateProcess();
+    phaseDepth_ = 0;
+    if (testRunsInSeparateProcess_) {
+        flush();
+        closeFile();
+    }
+}
+
+void ResultLogTestOutput::printCurrentTestEnded(const TestResult& res)
+{
+    writeRecord(TEST_ENDED, ZeroFreeNumber::encode(timeSinceStart()) + encodeCounts(res));
+}
+
+void ResultLogTestOutput::printCurrentTestPhaseStarted(const char*)
+{
+    phaseDepth_++;
+}
+
+void ResultLogTestOutput::printCurrentTestPhaseEnded(const char*)
+{
+    if (phaseDepth_ > 0) phaseDepth_--;
+    if (testRunsInSeparateProcess_ && phaseDepth_ == 0) {
+        flush();
+        closeFile();
+    }
+}
+
+/*
+ * Failures may be written by the child process of -p, which cannot add to
+ * the string table of its parent, so their names are written out in full.
+ */
+void ResultLogTestOutput::printFailure(const TestFailure& failure)
+{
+    writeRecord(FAILURE, encodeText(failure.getTestName()) + encodeText(failure.getTestNameOnly()) +
+                         encodeText(failure.getTestFileName()) + ZeroFreeNumber::encode((unsigned long) failure.getTestLineNumber()) +
+                         encodeText(failure.getFileName()) + ZeroFreeNumber::encode((unsigned long) failure.getFailureLineNumber()) +
+                         encodeText(failure.getMessage()));
+    flush();
+}
+
+void ResultLogTestOutput::printTestProperty(const UtestShell&, const SimpleString& name, const SimpleString& value)
+{
+    writeRecord(PROPERTY, encodeText(name) + encodeText(value));
+}
+
+void ResultLogTestOutput::printBuffer(const char* s)
+{
+    pendingOutput_ += s;
+}
+
+void ResultLogTestOutput::flush()
+{
+    writePendingOutput();
+    writeBufferedRecords();
+    if (file_) PlatformSpecificFFlush(file_);
+}
+
+void ResultLogTestOutput::writeRecord(RecordType type, const SimpleString& payload)
+{
+    if (type != OUTPUT) writePendingOutput();
+
+    char typeText[2] = { (char) type, '\0' };
+    SimpleString record = SimpleString(typeText) + ZeroFreeNumber::encode((unsigned long) payload.size()) + payload;
+    if (bufferedLength_ + record.size() >= BUFFER_SIZE) writeBufferedRecords();
+    if (record.size() >= BUFFER_SIZE) {
+        writeToFile(record);
+        return;
+    }
+    PlatformSpecificMemCpy(buffer_ + bufferedLength_, record.asCharString(), record.size() + 1);
+    bufferedLength_ += record.size();
+}
+
+void ResultLogTestOutput::writePendingOutput()
+{
+    if (pendingOutput_.isEmpty()) return;
+
+    SimpleString output = pendingOutput_;
+    pendingOutput_ = "";
+    writeRecord(OUTPUT, encodeText(output));
+}
+
+void ResultLogTestOutput::writeBufferedRecords()
+{
+    if (bufferedLength_ == 0) return;
+
+    writeToFile(buffer_);
+    bufferedLength_ = 0;
+    buffer_[0] = '\0';
+}
+
+SimpleString ResultLogTestOutput::encodeCounts(const TestResult& result)
+{
+    return ZeroFreeNumber::encode((unsigned long) result.getTestCount()) + ZeroFreeNumber::encode((unsigned long) result.getRunCount()) +
+           ZeroFreeNumber::encode((unsigned long) result.getCheckCount()) + ZeroFreeNumber::encode((unsigned long) result.getIgnoredCount()) +
+           ZeroFreeNumber::encode((unsigned long) result.getFilteredOutCount());
+}
+
+unsigned long ResultLogTestOutput::internString(const SimpleString& text)
+{
+    size_t id = strings_.find(text);
+    if (id == SimpleString::npos) {
+        id = strings_.add(text);
+        writeRecord(STRING, text);
+    }
+    return (unsigned long) id;
+}
+
+unsigned long ResultLogTestOutput::timeSinceStart()
+{
+    return GetPlatformSpecificTimeInMillis() - startTime_;
+}
+
+void ResultLogTestOutput::openFile(const char* mode)
+{
+    file_ = PlatformSpecificFOpen(fileName_.asCharString(), mode);
+}
+
+void ResultLogTestOutput::writeToFile(const SimpleString& buffer)
+{
+    if (file_ == NULLPTR) openFile("ab");
+    if (file_ == NULLPTR) return;
+    PlatformSpecificFPuts(buffer.asCharString(), file_);
+}
+
+void ResultLogTestOutput::closeFile()
+{
+    if (file_ == NULLPTR) return;
+    PlatformSpecificFClose(file_);
+    file_ = NULLPTR;
+}
+
+/*
+ * The names are members of a base class, so they exist before the UtestShell
+ * that points at them is constructed.
+ */
+struct ReplayedTestNames
+{
+    ReplayedTestNames(const SimpleString& group, const SimpleString& name, const SimpleString& file)
+        : replayedGroup_(group), replayedName_(name), replayedFile_(file)
+    {
+    }
+
+    SimpleString replayedGroup_;
+    SimpleString replayedName_;
+    SimpleString replayedFile_;
+};
+
+class ReplayedUtestShell : private ReplayedTestNames, public UtestShell
+{
+public:
+    ReplayedUtestShell(const SimpleString& group, const SimpleString& name, const SimpleString& file, size_t lineNumber, bool willRun)
+        : ReplayedTestNames(group, name, file),
+          UtestShell(replayedGroup_.asCharString(), replayedName_.asCharString(), replayedFile_.asCharString(), lineNumber),
+          willRun_(willRun)
+    {
+    }
+
+    virtual bool willRun() const CPPUTEST_OVERRIDE
+    {
+        return willRun_;
+    }
+
+private:
+    bool willRun_;
+};
+
+/*
+ * Failures keep the formatted test name they were written with, as the group
+ * of a failure is not recorded separately.
+ */
+class ReplayedTestFailure : public TestFailure
+{
+public:
+    ReplayedTestFailure(UtestShell* test, const SimpleString& testName, const SimpleString& fileName, size_t lineNumber, const SimpleString& message)
+        : TestFailure(test, fileName.asCharString(), lineNumber, message)
+    {
+        testName_ = testName;
+    }
+};
+
+ReplayedTestResult::ReplayedTestResult(TestOutput& output)
+    : TestResult(output), timeInMillis_(0)
+{
+}
+
+void ReplayedTestResult::setTimeInMillis(unsigned long time)
+{
+    timeInMillis_ = time;
+}
+
+size_t ReplayedTestResult::getTimeInMillis() const
+{
+    return (size_t) timeInMillis_;
+}
+
+ResultLogReader::ResultLogReader(TestOutput& output)
+    : result_(output), signatureRead_(false), valid_(true), complete_(false), currentGroup_(NULLPTR), currentTest_(NULLPTR), testsStarted_(false), testInProgress_(false)
+{
+}
+
+ResultLogReader::~ResultLogReader()
+{
+    delete currentGroup_;
+    delete currentTest_;
+}
+
+bool ResultLogReader::isValid() const
+{
+    return valid_;
+}
+
+bool ResultLogReader::isComplete() const
+{
+    return complete_;
+}
+
+const TestResult& ResultLogReader::getResult() const
+{
+    return result_;
+}
+
+bool ResultLogReader::replayFile(const char* fileName)
+{
+    PlatformSpecificFile file = PlatformSpecificFOpen(fileName, "rb");
+    if (file == NULLPTR) {
+        valid_ = false;
+        return false;
+    }
+
+    char chunk[4096];
+    while (valid_ && PlatformSpecificFGets(chunk, sizeof(chunk), file) != NULLPTR)
+        replay(chunk);
+    PlatformSpecificFClose(file);
+
+    finish();
+    return valid_ && complete_;
+}
+
+void ResultLogReader::replay(const char* data)
+{
+    if (!valid_) return;
+    pending_ += data;
+
+    const char* position = pending_.asCharString();
+    const char* end = position + pending_.size();
+
+    if (!signatureRead_) {
+        SimpleString signature = ResultLogTestOutput::signature();
+        if (pending_.size() < signature.size()) {
+            valid_ = signature.startsWith(pending_);
+            return;
+        }
+        if (!pending_.startsWith(signature)) {
+            valid_ = false;
+            return;
+        }
+        signatureRead_ = true;
+        position += signature.size();
+    }
+
+    while (position < end) {
+        const char* payload = position + 1;
+        unsigned long length;
+        if (!ZeroFreeNumber::decode(payload, end, length) || length > (unsigned long) (end - payload)) break;
+
+        replayRecord(*position, payload, payload + length);
+        position = payload + length;
+    }
+
+    pending_ = SimpleString(position);
+}
+
+void ResultLogReader::finish()
+{
+    if (!valid_ || complete_ || !testsStarted_) return;
+
+    finishIncompleteRun();
+}
+
+/*
+ * A log without an end is left by a run that crashed. The test that was
+ * running gets the blame, and groups and run are ended so that the outputs
+ * still write what they collected.
+ */
+void ResultLogReader::finishIncompleteRun()
+{
+    if (testInProgress_) {
+        result_.addFailure(TestFailure(currentTest_, "The result log ends during this test, the test run did not finish"));
+        result_.currentTestEnded(currentTest_);
+        testInProgress_ = false;
+    }
+    if (currentGroup_) {
+        result_.currentGroupEnded(currentGroup_);
+        delete currentGroup_;
+        currentGroup_ = NULLPTR;
+    }
+    result_.testsEnded();
+}
+
+void ResultLogReader::replayRecord(char type, const char* payload, const char* end)
+{
+    unsigned long time, group, file, line, willRun, testLine;
+    SimpleString name, value, testName, testFile, failureFile;
+
+    switch (type) {
+    case ResultLogTestOutput::STRING:
+        strings_.add(textFrom(payload, (size_t) (end - payload)));
+        break;
+    case ResultLogTestOutput::TESTS_STARTED:
+        result_.setTimeInMillis(0);
+        result_.testsStarted();
+        testsStarted_ = true;
+        break;
+    case ResultLogTestOutput::GROUP_STARTED:
+        if (!ZeroFreeNumber::decode(payload, end, time) || !ZeroFreeNumber::decode(payload, end, group)) break;
+        result_.setTimeInMillis(time);
+        delete currentGroup_;
+        currentGroup_ = new ReplayedUtestShell(stringWithId(group), "", "", 0, true);
+        result_.currentGroupStarted(currentGroup_);
+        break;
+    case ResultLogTestOutput::TEST_STARTED:
+        if (!ZeroFreeNumber::decode(payload, end, time) || !ZeroFreeNumber::decode(payload, end, group) || !decodeText(payload, end, name) ||
+            !ZeroFreeNumber::decode(payload, end, file) || !ZeroFreeNumber::decode(payload, end, line) || !ZeroFreeNumber::decode(payload, end, willRun)) break;
+        result_.setTimeInMillis(time);
+        delete currentTest_;
+        currentTest_ = new ReplayedUtestShell(stringWithId(group), name, stringWithId(file), line, willRun != 0);
+        result_.currentTestStarted(currentTest_);
+        testInProgress_ = true;
+        break;
+    case ResultLogTestOutput::OUTPUT:
+        if (decodeText(payload, end, value)) result_.print(value.asCharString());
+        break;
+    case ResultLogTestOutput::PROPERTY:
+        if (currentTest_ && decodeText(payload, end, name) && decodeText(payload, end, value))
+            result_.addTestProperty(*currentTest_, name, value);
+        break;
+    case ResultLogTestOutput::FAILURE:
+        if (decodeText(payload, end, testName) && decodeText(payload, end, name) && decodeText(payload, end, testFile) &&
+            ZeroFreeNumber::decode(payload, end, testLine) && decodeText(payload, end, failureFile) && ZeroFreeNumber::decode(payload, end, line) &&
+            decodeText(payload, end, value)) {
+            ReplayedUtestShell test("", name, testFile, testLine, true);
+            result_.addFailure(ReplayedTestFailure(&test, testName, failureFile, line, value));
+        }
+        break;
+    case ResultLogTestOutput::TEST_ENDED:
+        if (!testInProgress_ || !ZeroFreeNumber::decode(payload, end, time) || !readCounts(payload, end)) break;
+        result_.setTimeInMillis(time);
+        result_.currentTestEnded(currentTest_);
+        testInProgress_ = false;
+        break;
+    case ResultLogTestOutput::GROUP_ENDED:
+        if (!currentGroup_ || !ZeroFreeNumber::decode(payload, end, time) || !readCounts(payload, end)) break;
+        result_.setTimeInMillis(time);
+        result_.currentGroupEnded(currentGroup_);
+        delete currentGroup_;
+        currentGroup_ = NULLPTR;
+        break;
+    case ResultLogTestOutput::TESTS_ENDED:
+        if (!ZeroFreeNumber::decode(payload, end, time) || !readCounts(payload, end)) break;
+        result_.setTimeInMillis(time);
+        result_.testsEnded();
+        complete_ = true;
+        break;
+    default:
+        /* Records added by later versions are skipped */
+        break;
+    }
+}
+
+bool ResultLogReader::readCounts(const char*& payload, const char* end)
+{
+    unsigned long tests, runs, checks, ignored, filteredOut;
+    if (!ZeroFreeNumber::decode(payload, end, tests) || !ZeroFreeNumber::decode(payload, end, runs) || !ZeroFreeNumber::decode(payload, end, checks) ||
+        !ZeroFreeNumber::decode(payload, end, ignored) || !ZeroFreeNumber::decode(payload, end, filteredOut)) return false;
+
+    while (result_.getTestCount() < tests) result_.countTest();
+    while (result_.getRunCount() < runs) result_.countRun();
+    while (result_.getCheckCount() < checks) result_.countCheck();
+    while (result_.getIgnoredCount() < ignored) result_.countIgnored();
+    while (result_.getFilteredOutCount() < filteredOut) result_.countFilteredOut();
+    return true;
+}
+
+SimpleString ResultLogReader::stringWithId(unsigned long id) const
+{
+    return (id < strings_.size()) ? strings_[id] : "";
+}
@@ -180,6 +180,20 @@ size_t SimpleString::StrLen(const char* str)
     return n;
 }
 
+size_t SimpleString::Hash(const char* str, size_t hash)
+{
+    for (; *str; str++)
+        hash = (hash ^ (unsigned char) *str) * 16777619u;
+    return hash;
+}
+
+size_t SimpleString::Hash(const char* str, size_t length, size_t hash)
+{
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ (unsigned char) str[i]) * 16777619u;
+    return hash;
+}
+
 int SimpleString::StrNCmp(const char* s1, const char* s2, size_t n)
 {
     while (n && *s1 && *s1 == *s2) {
@@ -1080,3 +1094,76 @@ SimpleString& SimpleStringCollection::operator[](size_t index)
 
     return collection_[index];
 }
+
+SimpleStringIndex::SimpleStringIndex()
+    : strings_(NULLPTR), size_(0), capacity_(0), buckets_(NULLPTR), bucketMask_(0)
+{
+}
+
+SimpleStringIndex::~SimpleStringIndex()
+{
+    delete [] strings_;
+    delete [] buckets_;
+}
+
+/* Buckets hold a number + 1, zero marks an empty bucket. */
+size_t* SimpleStringIndex::findBucket(const SimpleString& string) const
+{
+    size_t bucket = SimpleString::Hash(string.asCharString()) & bucketMask_;
+    while (buckets_[bucket] && strings_[buckets_[bucket] - 1] != string)
+        bucket = (bucket + 1) & bucketMask_;
+    return &buckets_[bucket];
+}
+
+void SimpleStringIndex::grow()
+{
+    capacity_ = (capacity_ == 0) ? 16 : capacity_ * 2;
+    SimpleString* strings = new SimpleString[capacity_];
+    for (size_t i = 0; i < size_; i++)
+        strings[i] = strings_[i];
+    delete [] strings_;
+    strings_ = strings;
+
+    delete [] buckets_;
+    bucketMask_ = capacity_ * 2 - 1;
+    buckets_ = new size_t[capacity_ * 2];
+    for (size_t i = 0; i <= bucketMask_; i++)
+        buckets_[i] = 0;
+    for (size_t i = 0; i < size_; i++)
+        *findBucket(strings_[i]) = i + 1;
+}
+
+size_t SimpleStringIndex::add(const SimpleString& string)
+{
+    size_t index = find(string);
+    if (index != SimpleString::npos) return index;
+
+    if (size_ == capacity_) grow();
+    strings_[size_] = string;
+    *findBucket(string) = size_ + 1;
+    return size_++;
+}
+
+size_t SimpleStringIndex::find(const SimpleString& string) const
+{
+    if (size_ == 0) return SimpleString::npos;
+    size_t number = *findBucket(string);
+    return (number) ? number - 1 : SimpleString::npos;
+}
+
+void SimpleStringIndex::clear()
+{
+    for (size_t i = 0; i <= bucketMask_ && buckets_; i++)
+        buckets_[i] = 0;
+    size_ = 0;
+}
+
+size_t SimpleStringIndex::size() const
+{
+    return size_;
+}
+
+const SimpleString& SimpleStringIndex::operator[](size_t index) const
+{
+    return strings_[index];
+}
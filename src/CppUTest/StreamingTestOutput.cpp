@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/StreamingTestOutput.h"
+
+StreamingTestOutput::StreamingTestOutput()
+    : test_(NULLPTR), testNumber_(0), duration_(0), checks_(0), failureCount_(0), failureLine_(0), checksBeforeTest_(0), phaseDepth_(0)
+{
+}
+
+StreamingTestOutput::~StreamingTestOutput()
+{
+}
+
+void StreamingTestOutput::printTestsStarted()
+{
+    testNumber_ = 0;
+    checksBeforeTest_ = 0;
+    writeTestsStarted();
+}
+
+void StreamingTestOutput::printTestsEnded(const TestResult& result)
+{
+    writeTestsEnded(result);
+    ConsoleTestOutput::flush();
+}
+
+void StreamingTestOutput::printCurrentTestStarted(const UtestShell& test)
+{
+    test_ = &test;
+    testNumber_++;
+    failureCount_ = 0;
+    phaseDepth_ = 0;
+    flushWhenTheTestMayEndTheProcess(test);
+}
+
+void StreamingTestOutput::printCurrentTestEnded(const TestResult& res)
+{
+    duration_ = res.getCurrentTestTotalExecutionTime();
+    checks_ = res.getCheckCount() - checksBeforeTest_;
+    checksBeforeTest_ = res.getCheckCount();
+
+    writeTestRecord();
+
+    test_ = NULLPTR;
+    if (!output_.isEmpty()) output_ = "";
+}
+
+void StreamingTestOutput::printCurrentGroupStarted(const UtestShell&)
+{
+}
+
+void StreamingTestOutput::printCurrentGroupEnded(const TestResult&)
+{
+}
+
+void StreamingTestOutput::printCurrentTestPhaseStarted(const char* phase)
+{
+    phaseDepth_++;
+    ConsoleTestOutput::printCurrentTestPhaseStarted(phase);
+}
+
+void StreamingTestOutput::printCurrentTestPhaseEnded(const char* phase)
+{
+    if (phaseDepth_ > 0) phaseDepth_--;
+    ConsoleTestOutput::printCurrentTestPhaseEnded(phase);
+}
+
+void StreamingTestOutput::printFailure(const TestFailure& failure)
+{
+    if (!isInsideTest()) {
+        writeFailureRecord(failure);
+        ConsoleTestOutput::flush();
+        return;
+    }
+
+    if (failureCount_++ > 0) return;
+    failureFile_ = failure.getFileName();
+    failureLine_ = failure.getFailureLineNumber();
+    failureMessage_ = failure.getMessage();
+}
+
+void StreamingTestOutput::printTestProperty(const UtestShell&, const SimpleString&, const SimpleString&)
+{
+}
+
+void StreamingTestOutput::printBuffer(const char* s)
+{
+    if (isInsideTest())
+        output_ += s;
+    else
+        writeOutputRecord(s);
+}
+
+bool StreamingTestOutput::isInsideTest() const
+{
+    return test_ != NULLPTR && !isInsideChildProcess();
+}
+
+/* Phases of a test run in a separate process only happen in the child */
+bool StreamingTestOutput::isInsideChildProcess() const
+{
+    return test_ != NULLPTR && test_->isRunInSeperateProcess() && phaseDepth_ > 0;
+}
+
+void StreamingTestOutput::write(const char* text)
+{
+    ConsoleTestOutput::printBuffer(text);
+}
+
+void StreamingTestOutput::writeNumber(size_t number)
+{
+    char digits[24];
+    size_t position = sizeof(digits) - 1;
+    digits[position] = '\0';
+    do {
+        digits[--position] = (char) ('0' + number % 10);
+        number /= 10;
+    } while (number > 0);
+    write(digits + position);
+}
+
+/* A JSON string, which is also a double-quoted YAML scalar */
+void StreamingTestOutput::writeQuoted(const char* text)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    char chunk[128];
+    size_t used = 0;
+
+    chunk[used++] = '"';
+    for (; *text; text++) {
+        if (used + 8 >= sizeof(chunk)) {
+            chunk[used] = '\0';
+            write(chunk);
+            used = 0;
+        }
+
+        unsigned char ch = (unsigned char) *text;
+        if (ch == '"' || ch == '\\') {
+            chunk[used++] = '\\';
+            chunk[used++] = (char) ch;
+        }
+        else if (ch == '\n') {
+            chunk[used++] = '\\';
+            chunk[used++] = 'n';
+        }
+        else if (ch == '\r') {
+            chunk[used++] = '\\';
+            chunk[used++] = 'r';
+        }
+        else if (ch == '\t') {
+            chunk[used++] = '\\';
+            chunk[used++] = 't';
+        }
+        else if (ch < 0x20) {
+            chunk[used++] = '\\';
+            chunk[used++] = 'u';
+            chunk[used++] = '0';
+            chunk[used++] = '0';
+            chunk[used++] = hexDigits[ch >> 4];
+            chunk[used++] = hexDigits[ch & 0xF];
+        }
+        else
+            chunk[used++] = (char) ch;
+    }
+    chunk[used++] = '"';
+    chunk[used] = '\0';
+    write(chunk);
+}
+
+void StreamingTestOutput::writeTestName()
+{
+    write("TEST(");
+    write(test_->getGroup().asCharString());
+    write(", ");
+    write(test_->getName().asCharString());
+    write(")");
+}
+
+TapTestOutput::TapTestOutput()
+{
+}
+
+TapTestOutput::~TapTestOutput()
+{
+}
+
+void TapTestOutput::writeTestsStarted()
+{
+    write("TAP version 13\n");
+}
+
+void TapTestOutput::writeTestRecord()
+{
+    write((failureCount_ > 0) ? "not ok " : "ok ");
+    writeNumber(testNumber_);
+    write(" - ");
+    writeTestName();
+    if (!test_->willRun()) write(" # SKIP ignored");
+
+    write("\n  ---\n  group: ");
+    writeQuoted(test_->getGroup().asCharString());
+    write("\n  name: ");
+    writeQuoted(test_->getName().asCharString());
+    write("\n  file: ");
+    writeQuoted(test_->getFile().asCharString());
+    write("\n  line: ");
+    writeNumber(test_->getLineNumber());
+    write("\n  duration_ms: ");
+    writeNumber(duration_);
+    write("\n  checks: ");
+    writeNumber(checks_);
+    if (failureCount_ > 0) {
+        write("\n  failure:\n    file: ");
+        writeQuoted(failureFile_.asCharString());
+        write("\n    line: ");
+        writeNumber(failureLine_);
+        write("\n    message: ");
+        writeQuoted(failureMessage_.asCharString());
+    }
+    if (!output_.isEmpty()) {
+        write("\n  output: ");
+        writeQuoted(output_.asCharString());
+    }
+    write("\n  ...\n");
+}
+
+void TapTestOutput::writeTestsEnded(const TestResult& result)
+{
+    write("1..");
+    writeNumber(testNumber_);
+    write("\n# failures: ");
+    writeNumber(result.getFailureCount());
+    write(", checks: ");
+    writeNumber(result.getCheckCount());
+    write(", ignored: ");
+    writeNumber(result.getIgnoredCount());
+    write(", filtered out: ");
+    writeNumber(result.getFilteredOutCount());
+    write(", duration_ms: ");
+    writeNumber(result.getTotalExecutionTime());
+    write("\n");
+}
+
+void TapTestOutput::writeFailureRecord(const TestFailure& failure)
+{
+    write("# failure in ");
+    write(failure.getTestName().asCharString());
+    write(" at ");
+    write(failure.getFileName().asCharString());
+    write(":");
+    writeNumber(failure.getFailureLineNumber());
+    write(": ");
+    writeQuoted(failure.getMessage().asCharString());
+    write("\n");
+}
+
+void TapTestOutput::writeOutputRecord(const char* text)
+{
+    write("# output: ");
+    writeQuoted(text);
+    write("\n");
+}
+
+JsonLinesTestOutput::JsonLinesTestOutput()
+{
+}
+
+JsonLinesTestOutput::~JsonLinesTestOutput()
+{
+}
+
+void JsonLinesTestOutput::writeTestsStarted()
+{
+}
+
+void JsonLinesTestOutput::writeField(const char* name, const char* value)
+{
+    write(",\"");
+    write(name);
+    write("\":");
+    writeQuoted(value);
+}
+
+void JsonLinesTestOutput::writeField(const char* name, size_t value)
+{
+    write(",\"");
+    write(name);
+    write("\":");
+    writeNumber(value);
+}
+
+void JsonLinesTestOutput::writeTestRecord()
+{
+    write("{\"type\":\"test\"");
+    writeField("group", test_->getGroup().asCharString());
+    writeField("name", test_->getName().asCharString());
+    writeField("file", test_->getFile().asCharString());
+    writeField("line", test_->getLineNumber());
+    writeField("status", (failureCount_ > 0) ? "failed" : (test_->willRun() ? "passed" : "ignored"));
+    writeField("duration_ms", duration_);
+    writeField("checks", checks_);
+    if (failureCount_ > 0) {
+        write(",\"failure\":{\"file\":");
+        writeQuoted(failureFile_.asCharString());
+        writeField("line", failureLine_);
+        writeField("message", failureMessage_.asCharString());
+        write("}");
+    }
+    if (!output_.isEmpty()) writeField("output", output_.asCharString());
+    write("}\n");
+}
+
+void JsonLinesTestOutput::writeTestsEnded(const TestResult& result)
+{
+    write("{\"type\":\"summary\"");
+    writeField("tests", result.getTestCount());
+    writeField("ran", result.getRunCount());
+    writeField("failures", result.getFailureCount());
+    writeField("checks", result.getCheckCount());
+    writeField("ignored", result.getIgnoredCount());
+    writeField("filtered_out", result.getFilteredOutCount());
+    writeField("duration_ms", result.getTotalExecutionTime());
+    write("}\n");
+}
+
+void JsonLinesTestOutput::writeFailureRecord(const TestFailure& failure)
+{
+    write("{\"type\":\"failure\"");
+    writeField("test", failure.getTestName().asCharString());
+    writeField("file", failure.getFileName().asCharString());
+    writeField("line", failure.getFailureLineNumber());
+    writeField("message", failure.getMessage().asCharString());
+    write("}\n");
+}
+
+void JsonLinesTestOutput::writeOutputRecord(const char* text)
+{
+    write("{\"type\":\"output\"");
+    writeField("text", text);
+    write("}\n");
+}
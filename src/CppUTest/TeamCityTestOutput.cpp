@@ -20,6 +20,7 @@ void TeamCityTestOutput::printCurrentTestStarted(const UtestShell& test)
         print("']\n");
     }
     currtest_ = &test;
+    flushWhenTheTestMayEndTheProcess(test);
 }
 
 void TeamCityTestOutput::printCurrentTestEnded(const TestResult& res)
@@ -97,4 +98,18 @@ void TeamCityTestOutput::printFailure(const TestFailure& failure)
     print("' details='");
     printEscaped(failure.getMessage().asCharString());
     print("']\n");
+    ConsoleTestOutput::flush();
+}
+
+void TeamCityTestOutput::printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value)
+{
+    print("##teamcity[buildStatisticValue key='");
+    printEscaped(test.getGroup().asCharString());
+    print(".");
+    printEscaped(test.getName().asCharString());
+    print(".");
+    printEscaped(name.asCharString());
+    print("' value='");
+    printEscaped(value.asCharString());
+    print("']\n");
 }
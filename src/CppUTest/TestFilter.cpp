@@ -67,7 +67,9 @@ bool TestFilter::match(const SimpleString& name) const
 {
     bool matches = false;
 
-    if(strictMatching_)
+    if(isGlob(filter_.asCharString()))
+        matches = globMatch(filter_.asCharString(), name.asCharString(), strictMatching_);
+    else if(strictMatching_)
         matches = name == filter_;
     else
         matches = name.contains(filter_);
@@ -100,8 +102,354 @@ SimpleString TestFilter::asString() const
     return textFilter;
 }
 
+bool TestFilter::isGlob(const char* filter)
+{
+    for (; *filter; filter++)
+        if (*filter == '*' || *filter == '?') return true;
+    return false;
+}
+
+/*
+ * '*' matches any run of characters and '?' any single character. A
+ * non-strict pattern may match anywhere in the name, like contains() does.
+ */
+bool TestFilter::globMatch(const char* pattern, const char* name, bool strict)
+{
+    const char* retryPattern = strict ? NULLPTR : pattern;
+    const char* retryName = name;
+
+    while (*name) {
+        if (*pattern == '\0' && !strict) return true;
+
+        if (*pattern == '*') {
+            retryPattern = ++pattern;
+            retryName = name;
+        }
+        else if (*pattern == '?' || *pattern == *name) {
+            pattern++;
+            name++;
+        }
+        else if (retryPattern) {
+            pattern = retryPattern;
+            name = ++retryName;
+        }
+        else return false;
+    }
+
+    while (*pattern == '*') pattern++;
+    return *pattern == '\0';
+}
+
 SimpleString StringFrom(const TestFilter& filter)
 {
     return filter.asString();
 }
 
+//////////////////// TestFilterMatcher
+
+static size_t tableSizeFor(size_t count)
+{
+    size_t size = 4;
+    while (size < count * 2)
+        size *= 2;
+    return size;
+}
+
+template <typename T>
+static T* newZeroedArray(size_t count)
+{
+    T* array = new T[count];
+    for (size_t i = 0; i < count; i++)
+        array[i] = 0;
+    return array;
+}
+
+TestFilterMatcher::TestFilterMatcher()
+    : hasFilters_(false), patterns_(NULLPTR), patternsSize_(0),
+      nodeCount_(0), nodeFlags_(NULLPTR), nodeFail_(NULLPTR), nodeOutput_(NULLPTR), nodeFirstChild_(NULLPTR),
+      nodeNextSibling_(NULLPTR), nodeChar_(NULLPTR), edgeKeys_(NULLPTR), edgeTargets_(NULLPTR), edgeMask_(0),
+      excludeSubstringCount_(0), seen_(NULLPTR), generation_(0),
+      exactNames_(NULLPTR), exactFlags_(NULLPTR), exactCount_(0), exactBuckets_(NULLPTR), exactMask_(0), excludeExactCount_(0),
+      globs_(NULLPTR), globCount_(0)
+{
+}
+
+TestFilterMatcher::TestFilterMatcher(const TestFilter* filters)
+    : hasFilters_(false), patterns_(NULLPTR), patternsSize_(0),
+      nodeCount_(0), nodeFlags_(NULLPTR), nodeFail_(NULLPTR), nodeOutput_(NULLPTR), nodeFirstChild_(NULLPTR),
+      nodeNextSibling_(NULLPTR), nodeChar_(NULLPTR), edgeKeys_(NULLPTR), edgeTargets_(NULLPTR), edgeMask_(0),
+      excludeSubstringCount_(0), seen_(NULLPTR), generation_(0),
+      exactNames_(NULLPTR), exactFlags_(NULLPTR), exactCount_(0), exactBuckets_(NULLPTR), exactMask_(0), excludeExactCount_(0),
+      globs_(NULLPTR), globCount_(0)
+{
+    compile(filters);
+}
+
+TestFilterMatcher::~TestFilterMatcher()
+{
+    clear();
+}
+
+void TestFilterMatcher::clear()
+{
+    delete [] patterns_;
+    delete [] nodeFlags_;
+    delete [] nodeFail_;
+    delete [] nodeOutput_;
+    delete [] nodeFirstChild_;
+    delete [] nodeNextSibling_;
+    delete [] nodeChar_;
+    delete [] edgeKeys_;
+    delete [] edgeTargets_;
+    delete [] seen_;
+    delete [] exactNames_;
+    delete [] exactFlags_;
+    delete [] exactBuckets_;
+    delete [] globs_;
+
+    hasFilters_ = false;
+    patterns_ = NULLPTR;
+    patternsSize_ = 0;
+    nodeCount_ = 0;
+    nodeFlags_ = NULLPTR;
+    nodeFail_ = NULLPTR;
+    nodeOutput_ = NULLPTR;
+    nodeFirstChild_ = NULLPTR;
+    nodeNextSibling_ = NULLPTR;
+    nodeChar_ = NULLPTR;
+    edgeKeys_ = NULLPTR;
+    edgeTargets_ = NULLPTR;
+    edgeMask_ = 0;
+    excludeSubstringCount_ = 0;
+    seen_ = NULLPTR;
+    generation_ = 0;
+    exactNames_ = NULLPTR;
+    exactFlags_ = NULLPTR;
+    exactCount_ = 0;
+    exactBuckets_ = NULLPTR;
+    exactMask_ = 0;
+    excludeExactCount_ = 0;
+    globs_ = NULLPTR;
+    globCount_ = 0;
+}
+
+void TestFilterMatcher::compile(const TestFilter* filters)
+{
+    clear();
+    if (filters == NULLPTR) return;
+    hasFilters_ = true;
+
+    size_t filterCount = 0;
+    size_t totalSize = 0;
+    for (const TestFilter* filter = filters; filter != NULLPTR; filter = filter->getNext()) {
+        filterCount++;
+        totalSize += filter->filter_.size() + 1;
+    }
+
+    patterns_ = new char[totalSize];
+
+    size_t maxNodes = totalSize + 1;
+    nodeFlags_ = newZeroedArray<unsigned char>(maxNodes);
+    nodeFail_ = newZeroedArray<size_t>(maxNodes);
+    nodeOutput_ = newZeroedArray<size_t>(maxNodes);
+    nodeFirstChild_ = newZeroedArray<size_t>(maxNodes);
+    nodeNextSibling_ = newZeroedArray<size_t>(maxNodes);
+    nodeChar_ = newZeroedArray<unsigned char>(maxNodes);
+    seen_ = newZeroedArray<size_t>(maxNodes);
+    nodeCount_ = 1;
+
+    size_t edgeTableSize = tableSizeFor(maxNodes);
+    edgeMask_ = edgeTableSize - 1;
+    edgeKeys_ = newZeroedArray<size_t>(edgeTableSize);
+    edgeTargets_ = newZeroedArray<size_t>(edgeTableSize);
+
+    size_t exactTableSize = tableSizeFor(filterCount);
+    exactMask_ = exactTableSize - 1;
+    exactBuckets_ = newZeroedArray<size_t>(exactTableSize);
+    exactNames_ = new const char*[filterCount];
+    exactFlags_ = newZeroedArray<unsigned char>(filterCount);
+
+    globs_ = new Glob[filterCount];
+
+    for (const TestFilter* filter = filters; filter != NULLPTR; filter = filter->getNext()) {
+        const char* pattern = addPattern(filter->filter_);
+        unsigned char flag = filter->invertMatching_ ? MATCH_EXCLUDE : MATCH_INCLUDE;
+
+        if (TestFilter::isGlob(pattern)) {
+            Glob& glob = globs_[globCount_++];
+            glob.pattern = pattern;
+            glob.strict = filter->strictMatching_;
+            glob.invert = filter->invertMatching_;
+        }
+        else if (filter->strictMatching_)
+            addExact(pattern, flag);
+        else
+            addSubstring(pattern, flag);
+    }
+
+    buildFailureLinks();
+}
+
+char* TestFilterMatcher::addPattern(const SimpleString& pattern)
+{
+    char* copy = patterns_ + patternsSize_;
+    SimpleString::StrNCpy(copy, pattern.asCharString(), pattern.size() + 1);
+    patternsSize_ += pattern.size() + 1;
+    return copy;
+}
+
+/* Edge keys hold node * 256 + ch + 1, zero marks an empty bucket. */
+size_t TestFilterMatcher::findEdge(size_t node, unsigned char ch) const
+{
+    size_t key = node * 256 + ch + 1;
+    size_t bucket = (key * 2654435761u) & edgeMask_;
+    while (edgeKeys_[bucket]) {
+        if (edgeKeys_[bucket] == key) return edgeTargets_[bucket];
+        bucket = (bucket + 1) & edgeMask_;
+    }
+    return 0;
+}
+
+void TestFilterMatcher::addEdge(size_t node, unsigned char ch, size_t target)
+{
+    size_t key = node * 256 + ch + 1;
+    size_t bucket = (key * 2654435761u) & edgeMask_;
+    while (edgeKeys_[bucket])
+        bucket = (bucket + 1) & edgeMask_;
+    edgeKeys_[bucket] = key;
+    edgeTargets_[bucket] = target;
+
+    nodeChar_[target] = ch;
+    nodeNextSibling_[target] = nodeFirstChild_[node];
+    nodeFirstChild_[node] = target;
+}
+
+void TestFilterMatcher::addSubstring(const char* pattern, unsigned char flag)
+{
+    size_t node = 0;
+    for (; *pattern; pattern++) {
+        unsigned char ch = (unsigned char) *pattern;
+        size_t next = findEdge(node, ch);
+        if (next == 0) {
+            next = nodeCount_++;
+            addEdge(node, ch, next);
+        }
+        node = next;
+    }
+
+    if ((flag == MATCH_EXCLUDE) && !(nodeFlags_[node] & MATCH_EXCLUDE))
+        excludeSubstringCount_++;
+    nodeFlags_[node] |= flag;
+}
+
+/*
+ * Breadth first, so the failure node of a node is always done before its
+ * children. nodeOutput_ links each node to the nearest node on its failure
+ * chain where a pattern ends.
+ */
+void TestFilterMatcher::buildFailureLinks()
+{
+    size_t* queue = new size_t[nodeCount_];
+    size_t head = 0;
+    size_t tail = 0;
+
+    for (size_t child = nodeFirstChild_[0]; child; child = nodeNextSibling_[child])
+        queue[tail++] = child;
+
+    while (head < tail) {
+        size_t node = queue[head++];
+        for (size_t child = nodeFirstChild_[node]; child; child = nodeNextSibling_[child]) {
+            size_t fail = nodeFail_[node];
+            size_t target = findEdge(fail, nodeChar_[child]);
+            while (target == 0 && fail != 0) {
+                fail = nodeFail_[fail];
+                target = findEdge(fail, nodeChar_[child]);
+            }
+            nodeFail_[child] = target;
+            nodeOutput_[child] = (nodeFlags_[target] && target != 0) ? target : nodeOutput_[target];
+            queue[tail++] = child;
+        }
+    }
+
+    delete [] queue;
+}
+
+size_t* TestFilterMatcher::findExactBucket(const char* name) const
+{
+    size_t bucket = SimpleString::Hash(name) & exactMask_;
+    while (exactBuckets_[bucket] && SimpleString::StrCmp(exactNames_[exactBuckets_[bucket] - 1], name) != 0)
+        bucket = (bucket + 1) & exactMask_;
+    return &exactBuckets_[bucket];
+}
+
+void TestFilterMatcher::addExact(const char* pattern, unsigned char flag)
+{
+    size_t* bucket = findExactBucket(pattern);
+    if (*bucket == 0) {
+        exactNames_[exactCount_] = pattern;
+        *bucket = ++exactCount_;
+    }
+
+    unsigned char& flags = exactFlags_[*bucket - 1];
+    if ((flag == MATCH_EXCLUDE) && !(flags & MATCH_EXCLUDE))
+        excludeExactCount_++;
+    flags |= flag;
+}
+
+bool TestFilterMatcher::match(const char* name) const
+{
+    if (!hasFilters_) return true;
+
+    return matchExact(name) || matchSubstrings(name) || matchGlobs(name);
+}
+
+/* An excluding filter matches every name but its own, so two distinct ones match everything. */
+bool TestFilterMatcher::matchExact(const char* name) const
+{
+    size_t index = *findExactBucket(name);
+    unsigned char flags = (index) ? exactFlags_[index - 1] : 0;
+
+    if (flags & MATCH_INCLUDE) return true;
+    if (excludeExactCount_ > 1) return true;
+    return excludeExactCount_ == 1 && !(flags & MATCH_EXCLUDE);
+}
+
+/* Excluding substring filters match unless the name contains every one of them. */
+bool TestFilterMatcher::matchSubstrings(const char* name) const
+{
+    size_t excludesFound = 0;
+    generation_++;
+
+    if (nodeFlags_[0] & MATCH_INCLUDE) return true;
+    if (nodeFlags_[0] & MATCH_EXCLUDE) excludesFound++;
+
+    size_t node = 0;
+    for (; *name; name++) {
+        unsigned char ch = (unsigned char) *name;
+        size_t next = findEdge(node, ch);
+        while (next == 0 && node != 0) {
+            node = nodeFail_[node];
+            next = findEdge(node, ch);
+        }
+        node = next;
+
+        for (size_t output = (nodeFlags_[node] && node != 0) ? node : nodeOutput_[node]; output; output = nodeOutput_[output]) {
+            if (nodeFlags_[output] & MATCH_INCLUDE) return true;
+            if (seen_[output] != generation_) {
+                seen_[output] = generation_;
+                excludesFound++;
+            }
+        }
+    }
+    return excludesFound < excludeSubstringCount_;
+}
+
+bool TestFilterMatcher::matchGlobs(const char* name) const
+{
+    for (size_t i = 0; i < globCount_; i++) {
+        const Glob& glob = globs_[i];
+        if (TestFilter::globMatch(glob.pattern, name, glob.strict) != glob.invert) return true;
+    }
+    return false;
+}
+
@@ -141,6 +141,14 @@ void TestOutput::printCurrentGroupEnded(const TestResult& /*res*/)
 {
 }
 
+void TestOutput::printCurrentTestPhaseStarted(const char* /*phase*/)
+{
+}
+
+void TestOutput::printCurrentTestPhaseEnded(const char* /*phase*/)
+{
+}
+
 void TestOutput::printTestsEnded(const TestResult& result)
 {
     print("\n");
@@ -210,6 +218,32 @@ void TestOutput::printFailure(const TestFailure& failure)
     printFailureMessage(failure.getMessage());
 }
 
+void TestOutput::printBenchmark(const UtestShell& test, const BenchmarkResult& result)
+{
+    print("\nBENCHMARK(");
+    print(test.getGroup().asCharString());
+    print(", ");
+    print(test.getName().asCharString());
+    print("): ");
+    if (result.samples == 0) {
+        print("unmeasurable, the clock does not advance\n");
+        return;
+    }
+    print(StringFromFormat("%.2f ns/op +/- %.2f (95%% CI), min %.2f, %d x %lu iterations\n",
+        result.nanosecondsPerOperation, result.confidenceInterval, result.minNanosecondsPerOperation,
+        (int) result.samples, (unsigned long) result.iterations).asCharString());
+}
+
+void TestOutput::printTestProperty(const UtestShell&, const SimpleString& name, const SimpleString& value)
+{
+    if (verbose_ > level_quiet) {
+        print(" ");
+        print(name.asCharString());
+        print("=");
+        print(value.asCharString());
+    }
+}
+
 void TestOutput::printFileAndLineForTestAndFailure(const TestFailure& failure)
 {
     printErrorInFileOnLineFormattedForWorkingEnvironment(failure.getTestFileName(), failure.getTestLineNumber());
@@ -272,15 +306,92 @@ void TestOutput::printVeryVerbose(const char* str)
 }
 
 
+ConsoleTestOutput::ConsoleTestOutput()
+    : bufferUsed_(0), flushIntervalInMillis_(100), lastFlushTime_(GetPlatformSpecificTimeInMillis()), currentTestMayEndTheProcess_(false)
+{
+}
+
+ConsoleTestOutput::~ConsoleTestOutput()
+{
+    ConsoleTestOutput::flush();
+}
+
+void ConsoleTestOutput::setFlushIntervalInMillis(unsigned long interval)
+{
+    flushIntervalInMillis_ = interval;
+}
+
+void ConsoleTestOutput::printTestsEnded(const TestResult& result)
+{
+    TestOutput::printTestsEnded(result);
+    ConsoleTestOutput::flush();
+}
+
+void ConsoleTestOutput::printCurrentTestStarted(const UtestShell& test)
+{
+    TestOutput::printCurrentTestStarted(test);
+    flushWhenTheTestMayEndTheProcess(test);
+}
+
+void ConsoleTestOutput::printCurrentTestPhaseStarted(const char*)
+{
+    if (currentTestMayEndTheProcess_) ConsoleTestOutput::flush();
+    else writeBufferedOutput();
+}
+
+void ConsoleTestOutput::printCurrentTestPhaseEnded(const char*)
+{
+    if (currentTestMayEndTheProcess_) ConsoleTestOutput::flush();
+}
+
+void ConsoleTestOutput::printFailure(const TestFailure& failure)
+{
+    TestOutput::printFailure(failure);
+    ConsoleTestOutput::flush();
+}
+
+/*
+ * A child process of -p inherits everything that is still buffered and leaves with _exit,
+ * and so does the process when the watchdog of a test with a timeout expires. For those
+ * tests the output is flushed before the test (the fork, the arming of the watchdog) and
+ * around every phase.
+ */
+void ConsoleTestOutput::flushWhenTheTestMayEndTheProcess(const UtestShell& test)
+{
+    currentTestMayEndTheProcess_ = test.isRunInSeperateProcess() || test.getTimeout() > 0;
+    if (currentTestMayEndTheProcess_) ConsoleTestOutput::flush();
+}
+
 void ConsoleTestOutput::printBuffer(const char* s)
 {
-    PlatformSpecificFPuts(s, PlatformSpecificStdOut);
-    flush();
+    size_t length = SimpleString::StrLen(s);
+    if (bufferUsed_ + length >= OUTPUT_BUFFER_SIZE) writeBufferedOutput();
+
+    if (flushIntervalInMillis_ == 0 || length >= OUTPUT_BUFFER_SIZE) {
+        PlatformSpecificFPuts(s, PlatformSpecificStdOut);
+    }
+    else {
+        PlatformSpecificMemCpy(buffer_ + bufferUsed_, s, length);
+        bufferUsed_ += length;
+    }
+
+    if (GetPlatformSpecificTimeInMillis() - lastFlushTime_ >= flushIntervalInMillis_) ConsoleTestOutput::flush();
+}
+
+void ConsoleTestOutput::writeBufferedOutput()
+{
+    if (bufferUsed_ == 0) return;
+
+    buffer_[bufferUsed_] = '\0';
+    PlatformSpecificFPuts(buffer_, PlatformSpecificStdOut);
+    bufferUsed_ = 0;
 }
 
 void ConsoleTestOutput::flush()
 {
+    writeBufferedOutput();
     PlatformSpecificFlush();
+    lastFlushTime_ = GetPlatformSpecificTimeInMillis();
 }
 
 StringBufferTestOutput::~StringBufferTestOutput()
@@ -346,6 +457,18 @@ void CompositeTestOutput::printCurrentGroupEnded(const TestResult& res)
   if (outputTwo_) outputTwo_->printCurrentGroupEnded(res);
 }
 
+void CompositeTestOutput::printCurrentTestPhaseStarted(const char* phase)
+{
+  if (outputOne_) outputOne_->printCurrentTestPhaseStarted(phase);
+  if (outputTwo_) outputTwo_->printCurrentTestPhaseStarted(phase);
+}
+
+void CompositeTestOutput::printCurrentTestPhaseEnded(const char* phase)
+{
+  if (outputOne_) outputOne_->printCurrentTestPhaseEnded(phase);
+  if (outputTwo_) outputTwo_->printCurrentTestPhaseEnded(phase);
+}
+
 void CompositeTestOutput::verbose(VerbosityLevel level)
 {
   if (outputOne_) outputOne_->verbose(level);
@@ -394,6 +517,18 @@ void CompositeTestOutput::printFailure(const TestFailure& failure)
   if (outputTwo_) outputTwo_->printFailure(failure);
 }
 
+void CompositeTestOutput::printBenchmark(const UtestShell& test, const BenchmarkResult& result)
+{
+  if (outputOne_) outputOne_->printBenchmark(test, result);
+  if (outputTwo_) outputTwo_->printBenchmark(test, result);
+}
+
+void CompositeTestOutput::printTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value)
+{
+  if (outputOne_) outputOne_->printTestProperty(test, name, value);
+  if (outputTwo_) outputTwo_->printTestProperty(test, name, value);
+}
+
 void CompositeTestOutput::setProgressIndicator(const char* indicator)
 {
   if (outputOne_) outputOne_->setProgressIndicator(indicator);
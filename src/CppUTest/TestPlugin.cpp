@@ -60,6 +60,12 @@ void TestPlugin::runAllPostTestAction(UtestShell& test, TestResult& result)
     if (enabled_) postTestAction(test, result);
 }
 
+void TestPlugin::runAllPostRunAction(TestResult& result)
+{
+    next_->runAllPostRunAction(result);
+    if (enabled_) postRunAction(result);
+}
+
 bool TestPlugin::parseAllArguments(int ac, char** av, int index)
 {
     return parseAllArguments(ac, const_cast<const char *const *> (av), index);
@@ -167,3 +173,7 @@ void NullTestPlugin::runAllPreTestAction(UtestShell&, TestResult&)
 void NullTestPlugin::runAllPostTestAction(UtestShell&, TestResult&)
 {
 }
+
+void NullTestPlugin::runAllPostRunAction(TestResult&)
+{
+}
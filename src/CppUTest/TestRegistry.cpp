@@ -29,8 +29,218 @@
 #include "CppUTest/TestRegistry.h"
 #include "CppUTest/PlatformSpecificFunctions.h"
 
+//////////////////// TestRegistryIndex
+
+/*
+ * The index is registry bookkeeping, not test memory, so it bypasses the
+ * leak detector. It can then be built or dropped from inside a test.
+ */
+template <typename T>
+static T* newIndexArray(size_t count)
+{
+    return (T*) PlatformSpecificMalloc(sizeof(T) * (count + 1));
+}
+
+static void deleteIndexArray(void* array)
+{
+    PlatformSpecificFree(array);
+}
+
+static size_t* newEmptyBuckets(size_t size)
+{
+    size_t* buckets = newIndexArray<size_t>(size);
+    for (size_t i = 0; i < size; i++)
+        buckets[i] = 0;
+    return buckets;
+}
+
+TestRegistryIndex::TestRegistryIndex()
+    : built_(false), entries_(NULLPTR), count_(0), names_(NULLPTR), namesEnd_(NULLPTR), groupNames_(NULLPTR), groupFirstTest_(NULLPTR), groupCount_(0),
+      groupBuckets_(NULLPTR), nameBuckets_(NULLPTR), groupAndNameBuckets_(NULLPTR), bucketMask_(0)
+{
+}
+
+TestRegistryIndex::~TestRegistryIndex()
+{
+    clear();
+}
+
+void TestRegistryIndex::build(UtestShell* firstTest)
+{
+    clear();
+
+    size_t testCount = 0;
+    size_t namesLength = 0;
+    for (UtestShell *test = firstTest; test != NULLPTR; test = test->getNext()) {
+        testCount++;
+        namesLength += SimpleString::StrLen(test->getGroupCharString()) + SimpleString::StrLen(test->getNameCharString()) + 2;
+    }
+
+    size_t bucketCount = 4;
+    while (bucketCount < testCount * 2)
+        bucketCount *= 2;
+    bucketMask_ = bucketCount - 1;
+
+    entries_ = newIndexArray<Entry>(testCount);
+    names_ = newIndexArray<char>(namesLength);
+    namesEnd_ = names_;
+    groupNames_ = newIndexArray<const char*>(testCount);
+    groupFirstTest_ = newIndexArray<size_t>(testCount);
+    groupBuckets_ = newEmptyBuckets(bucketCount);
+    nameBuckets_ = newEmptyBuckets(bucketCount);
+    groupAndNameBuckets_ = newEmptyBuckets(bucketCount);
+
+    for (UtestShell *test = firstTest; test != NULLPTR; test = test->getNext())
+        add(test, test->getGroupCharString(), test->getNameCharString());
+
+    built_ = true;
+}
+
+void TestRegistryIndex::clear()
+{
+    deleteIndexArray(entries_);
+    deleteIndexArray(names_);
+    deleteIndexArray(groupNames_);
+    deleteIndexArray(groupFirstTest_);
+    deleteIndexArray(groupBuckets_);
+    deleteIndexArray(nameBuckets_);
+    deleteIndexArray(groupAndNameBuckets_);
+
+    entries_ = NULLPTR;
+    names_ = NULLPTR;
+    namesEnd_ = NULLPTR;
+    groupNames_ = NULLPTR;
+    groupFirstTest_ = NULLPTR;
+    groupBuckets_ = NULLPTR;
+    nameBuckets_ = NULLPTR;
+    groupAndNameBuckets_ = NULLPTR;
+    count_ = 0;
+    groupCount_ = 0;
+    built_ = false;
+}
+
+bool TestRegistryIndex::isBuilt() const
+{
+    return built_;
+}
+
+bool TestRegistryIndex::equal(const char* s1, const char* s2)
+{
+    return SimpleString::StrCmp(s1, s2) == 0;
+}
+
+/* Buckets hold an index + 1, zero marks an empty bucket. */
+size_t* TestRegistryIndex::findGroupBucket(const char* group) const
+{
+    size_t bucket = SimpleString::Hash(group) & bucketMask_;
+    while (groupBuckets_[bucket] && !equal(groupNames_[groupBuckets_[bucket] - 1], group))
+        bucket = (bucket + 1) & bucketMask_;
+    return &groupBuckets_[bucket];
+}
+
+size_t* TestRegistryIndex::findNameBucket(const char* name) const
+{
+    size_t bucket = SimpleString::Hash(name) & bucketMask_;
+    while (nameBuckets_[bucket] && !equal(entries_[nameBuckets_[bucket] - 1].name, name))
+        bucket = (bucket + 1) & bucketMask_;
+    return &nameBuckets_[bucket];
+}
+
+size_t* TestRegistryIndex::findGroupAndNameBucket(size_t group, const char* name) const
+{
+    size_t bucket = SimpleString::Hash(name, SimpleString::hashStart ^ group) & bucketMask_;
+    while (groupAndNameBuckets_[bucket]) {
+        const Entry& entry = entries_[groupAndNameBuckets_[bucket] - 1];
+        if (entry.group == group && equal(entry.name, name)) break;
+        bucket = (bucket + 1) & bucketMask_;
+    }
+    return &groupAndNameBuckets_[bucket];
+}
+
+const char* TestRegistryIndex::copyName(const char* name)
+{
+    char* copy = namesEnd_;
+    do *namesEnd_++ = *name; while (*name++);
+    return copy;
+}
+
+void TestRegistryIndex::add(UtestShell* test, const char* group, const char* name)
+{
+    size_t index = count_++;
+    Entry& entry = entries_[index];
+    entry.test = test;
+    entry.name = copyName(name);
+
+    size_t* groupBucket = findGroupBucket(group);
+    if (*groupBucket == 0) {
+        groupNames_[groupCount_] = copyName(group);
+        groupFirstTest_[groupCount_] = index;
+        *groupBucket = ++groupCount_;
+    }
+    entry.group = *groupBucket - 1;
+
+    size_t* nameBucket = findNameBucket(name);
+    if (*nameBucket == 0)
+        *nameBucket = index + 1;
+
+    size_t* groupAndNameBucket = findGroupAndNameBucket(entry.group, name);
+    entry.firstWithGroupAndName = (*groupAndNameBucket == 0);
+    if (entry.firstWithGroupAndName)
+        *groupAndNameBucket = index + 1;
+}
+
+size_t TestRegistryIndex::count() const
+{
+    return count_;
+}
+
+UtestShell* TestRegistryIndex::get(size_t index) const
+{
+    return entries_[index].test;
+}
+
+bool TestRegistryIndex::isFirstWithGroupAndName(size_t index) const
+{
+    return entries_[index].firstWithGroupAndName;
+}
+
+size_t TestRegistryIndex::countGroups() const
+{
+    return groupCount_;
+}
+
+const char* TestRegistryIndex::getGroupName(size_t groupIndex) const
+{
+    return groupNames_[groupIndex];
+}
+
+UtestShell* TestRegistryIndex::findTestWithName(const char* name) const
+{
+    size_t index = *findNameBucket(name);
+    return (index) ? entries_[index - 1].test : NULLPTR;
+}
+
+UtestShell* TestRegistryIndex::findTestWithGroup(const char* group) const
+{
+    size_t groupIndex = *findGroupBucket(group);
+    return (groupIndex) ? entries_[groupFirstTest_[groupIndex - 1]].test : NULLPTR;
+}
+
+/* Returns count() when there is no such test */
+size_t TestRegistryIndex::indexOf(const char* group, const char* name) const
+{
+    size_t groupIndex = *findGroupBucket(group);
+    if (groupIndex == 0) return count_;
+
+    size_t index = *findGroupAndNameBucket(groupIndex - 1, name);
+    return (index) ? index - 1 : count_;
+}
+
+//////////////////// TestRegistry
+
 TestRegistry::TestRegistry() :
-    tests_(NULLPTR), nameFilters_(NULLPTR), groupFilters_(NULLPTR), firstPlugin_(NullTestPlugin::instance()), runInSeperateProcess_(false), currentRepetition_(0), runIgnored_(false)
+    tests_(NULLPTR), firstPlugin_(NullTestPlugin::instance()), runInSeperateProcess_(false), currentRepetition_(0), runIgnored_(false), runBenchmarks_(false), failFast_(false),
+    timeout_(0), groupTimeouts_(NULLPTR)
 {
 }
 
@@ -40,9 +250,22 @@ TestRegistry::~TestRegistry()
 
 void TestRegistry::addTest(UtestShell *test)
 {
+    invalidateIndex();
     tests_ = test->addTest(tests_);
 }
 
+TestRegistryIndex& TestRegistry::getIndex()
+{
+    if (!index_.isBuilt())
+        index_.build(tests_);
+    return index_;
+}
+
+void TestRegistry::invalidateIndex()
+{
+    index_.clear();
+}
+
 void TestRegistry::runAllTests(TestResult& result)
 {
     bool groupStart = true;
@@ -51,6 +274,8 @@ void TestRegistry::runAllTests(TestResult& result)
     for (UtestShell *test = tests_; test != NULLPTR; test = test->getNext()) {
         if (runInSeperateProcess_) test->setRunInSeperateProcess();
         if (runIgnored_) test->setRunIgnored();
+        if (runBenchmarks_) test->setRunBenchmarks();
+        if (timeout_ > 0 || groupTimeouts_) test->setTimeout(getTimeoutFor(test));
 
         if (groupStart) {
             result.currentGroupStarted(test);
@@ -64,63 +289,79 @@ void TestRegistry::runAllTests(TestResult& result)
             result.currentTestEnded(test);
         }
 
-        if (endOfGroup(test)) {
+        bool stopRun = failFast_ && result.getFailureCount() > 0;
+        if (endOfGroup(test) || stopRun) {
             groupStart = true;
             result.currentGroupEnded(test);
         }
+        if (stopRun) break;
     }
     result.testsEnded();
     currentRepetition_++;
 }
 
-void TestRegistry::listTestGroupNames(TestResult& result)
+static void appendName(char*& end, const char* name)
 {
-    SimpleString groupList;
+    while (*name)
+        *end++ = *name++;
+}
 
-    for (UtestShell *test = tests_; test != NULLPTR; test = test->getNext()) {
-        SimpleString gname;
-        gname += "#";
-        gname += test->getGroup();
-        gname += "#";
-
-        if (!groupList.contains(gname)) {
-            groupList += gname;
-            groupList += " ";
+/* Prints "group[.name] group[.name] ..." with a single allocation */
+static void printNameList(TestResult& result, const char* const* groups, const char* const* names, size_t count)
+{
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) {
+        length += SimpleString::StrLen(groups[i]) + 1;
+        if (names) length += SimpleString::StrLen(names[i]) + 1;
+    }
+
+    char* list = new char[length + 1];
+    char* end = list;
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) *end++ = ' ';
+        appendName(end, groups[i]);
+        if (names) {
+            *end++ = '.';
+            appendName(end, names[i]);
         }
     }
+    *end = '\0';
 
-    groupList.replace("#", "");
+    result.print(list);
+    delete [] list;
+}
+
+void TestRegistry::listTestGroupNames(TestResult& result)
+{
+    TestRegistryIndex& index = getIndex();
 
-    if (groupList.endsWith(" "))
-        groupList = groupList.subString(0, groupList.size() - 1);
-    result.print(groupList.asCharString());
+    const char** groups = new const char*[index.countGroups() + 1];
+    for (size_t i = 0; i < index.countGroups(); i++)
+        groups[i] = index.getGroupName(i);
+
+    printNameList(result, groups, NULLPTR, index.countGroups());
+    delete [] groups;
 }
 
 void TestRegistry::listTestGroupAndCaseNames(TestResult& result)
 {
-    SimpleString groupAndNameList;
-
-    for (UtestShell *test = tests_; test != NULLPTR; test = test->getNext()) {
-        if (testShouldRun(test, result)) {
-            SimpleString groupAndName;
-            groupAndName += "#";
-            groupAndName += test->getGroup();
-            groupAndName += ".";
-            groupAndName += test->getName();
-            groupAndName += "#";
-
-            if (!groupAndNameList.contains(groupAndName)) {
-                groupAndNameList += groupAndName;
-                groupAndNameList += " ";
-            }
+    TestRegistryIndex& index = getIndex();
+
+    size_t count = 0;
+    const char** groups = new const char*[index.count() + 1];
+    const char** names = new const char*[index.count() + 1];
+    for (size_t i = 0; i < index.count(); i++) {
+        UtestShell* test = index.get(i);
+        if (testShouldRun(test, result) && index.isFirstWithGroupAndName(i)) {
+            groups[count] = test->getGroupCharString();
+            names[count] = test->getNameCharString();
+            count++;
         }
     }
 
-    groupAndNameList.replace("#", "");
-
-    if (groupAndNameList.endsWith(" "))
-        groupAndNameList = groupAndNameList.subString(0, groupAndNameList.size() - 1);
-    result.print(groupAndNameList.asCharString());
+    printNameList(result, groups, names, count);
+    delete [] names;
+    delete [] groups;
 }
 
 void TestRegistry::listTestLocations(TestResult& result)
@@ -145,12 +386,16 @@ void TestRegistry::listTestLocations(TestResult& result)
 
 bool TestRegistry::endOfGroup(UtestShell* test)
 {
-    return (!test || !test->getNext() || test->getGroup() != test->getNext()->getGroup());
+    if (!test || !test->getNext()) return true;
+
+    const char* group = test->getGroupCharString();
+    const char* nextGroup = test->getNext()->getGroupCharString();
+    return group != nextGroup && SimpleString::StrCmp(group, nextGroup) != 0;
 }
 
 size_t TestRegistry::countTests()
 {
-    return tests_ ? tests_->countTests() : 0;
+    return getIndex().count();
 }
 
 TestRegistry* TestRegistry::currentRegistry_ = NULLPTR;
@@ -168,18 +413,18 @@ void TestRegistry::setCurrentRegistry(TestRegistry* registry)
 
 void TestRegistry::unDoLastAddTest()
 {
+    invalidateIndex();
     tests_ = tests_ ? tests_->getNext() : NULLPTR;
-
 }
 
 void TestRegistry::setNameFilters(const TestFilter* filters)
 {
-    nameFilters_ = filters;
+    nameMatcher_.compile(filters);
 }
 
 void TestRegistry::setGroupFilters(const TestFilter* filters)
 {
-    groupFilters_ = filters;
+    groupMatcher_.compile(filters);
 }
 
 void TestRegistry::setRunIgnored()
@@ -187,6 +432,34 @@ void TestRegistry::setRunIgnored()
     runIgnored_ = true;
 }
 
+void TestRegistry::setRunBenchmarks()
+{
+    runBenchmarks_ = true;
+}
+
+void TestRegistry::setFailFast()
+{
+    failFast_ = true;
+}
+
+void TestRegistry::setTimeout(unsigned int seconds)
+{
+    timeout_ = seconds;
+}
+
+void TestRegistry::addGroupTimeout(TestGroupTimeout* groupTimeout)
+{
+    groupTimeouts_ = groupTimeout->addGroupTimeout(groupTimeouts_);
+}
+
+unsigned int TestRegistry::getTimeoutFor(UtestShell* test)
+{
+    for (TestGroupTimeout* groupTimeout = groupTimeouts_; groupTimeout != NULLPTR; groupTimeout = groupTimeout->getNext())
+        if (SimpleString::StrCmp(groupTimeout->getGroup(), test->getGroupCharString()) == 0)
+            return groupTimeout->getTimeout();
+    return timeout_;
+}
+
 void TestRegistry::setRunTestsInSeperateProcess()
 {
     runInSeperateProcess_ = true;
@@ -199,7 +472,7 @@ int TestRegistry::getCurrentRepetition()
 
 bool TestRegistry::testShouldRun(UtestShell* test, TestResult& result)
 {
-    if (test->shouldRun(groupFilters_, nameFilters_)) return true;
+    if (test->shouldRun(groupMatcher_, nameMatcher_)) return true;
     else {
         result.countFilteredOut();
         return false;
@@ -251,6 +524,7 @@ void TestRegistry::shuffleTests(size_t seed)
 {
     UtestShellPointerArray array(getFirstTest());
     array.shuffle(seed);
+    invalidateIndex();
     tests_ = array.getFirstTest();
 }
 
@@ -258,11 +532,56 @@ void TestRegistry::reverseTests()
 {
     UtestShellPointerArray array(getFirstTest());
     array.reverse();
+    invalidateIndex();
     tests_ = array.getFirstTest();
 }
 
+/*
+ * Moves the tests named "group.name" in front of all others. Both parts keep
+ * their current relative order, so this combines with shuffle and reverse.
+ */
+void TestRegistry::moveTestsToFront(SimpleStringCollection& groupDotNames)
+{
+    TestRegistryIndex& index = getIndex();
+    size_t count = index.count();
+    if (count == 0) return;
+
+    bool* toFront = new bool[count];
+    for (size_t i = 0; i < count; i++)
+        toFront[i] = false;
+
+    for (size_t i = 0; i < groupDotNames.size(); i++) {
+        const SimpleString& groupDotName = groupDotNames[i];
+        size_t dot = groupDotName.find('.');
+        if (dot == SimpleString::npos) continue;
+
+        size_t testIndex = index.indexOf(groupDotName.subString(0, dot).asCharString(), groupDotName.subString(dot + 1).asCharString());
+        if (testIndex < count) toFront[testIndex] = true;
+    }
+
+    UtestShell** ordered = new UtestShell*[count];
+    size_t position = 0;
+    for (size_t i = 0; i < count; i++)
+        if (toFront[i]) ordered[position++] = index.get(i);
+    for (size_t i = 0; i < count; i++)
+        if (!toFront[i]) ordered[position++] = index.get(i);
+
+    UtestShell* tests = NULLPTR;
+    for (size_t i = count; i > 0; i--)
+        tests = ordered[i - 1]->addTest(tests);
+
+    delete [] ordered;
+    delete [] toFront;
+
+    invalidateIndex();
+    tests_ = tests;
+}
+
 UtestShell* TestRegistry::getTestWithNext(UtestShell* test)
 {
+    /* callers use this to splice tests into the chain */
+    invalidateIndex();
+
     UtestShell* current = tests_;
     while (current && current->getNext() != test)
         current = current->getNext();
@@ -271,23 +590,10 @@ UtestShell* TestRegistry::getTestWithNext(UtestShell* test)
 
 UtestShell* TestRegistry::findTestWithName(const SimpleString& name)
 {
-    UtestShell* current = tests_;
-    while (current) {
-        if (current->getName() == name)
-            return current;
-        current = current->getNext();
-    }
-    return NULLPTR;
+    return getIndex().findTestWithName(name.asCharString());
 }
 
 UtestShell* TestRegistry::findTestWithGroup(const SimpleString& group)
 {
-    UtestShell* current = tests_;
-    while (current) {
-        if (current->getGroup() == group)
-            return current;
-        current = current->getNext();
-    }
-    return NULLPTR;
+    return getIndex().findTestWithGroup(group.asCharString());
 }
-
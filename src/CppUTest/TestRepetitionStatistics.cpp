@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRepetitionStatistics.h"
+#include "CppUTest/TestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+static size_t hashTest(const UtestShell* test)
+{
+    size_t key = (size_t) test;
+    return (key >> 4) ^ (key >> 12);
+}
+
+static void sortSamples(size_t* samples, size_t count)
+{
+    for (size_t gap = count / 2; gap > 0; gap /= 2) {
+        for (size_t i = gap; i < count; i++) {
+            size_t sample = samples[i];
+            size_t j = i;
+            for (; j >= gap && samples[j - gap] > sample; j -= gap)
+                samples[j] = samples[j - gap];
+            samples[j] = sample;
+        }
+    }
+}
+
+static size_t percentile(const size_t* sortedSamples, size_t count, size_t percent)
+{
+    size_t rank = (count * percent + 99) / 100;
+    return sortedSamples[(rank > 0) ? rank - 1 : 0];
+}
+
+TestRepetitionStatistics::TestRepetitionStatistics() : entries_(NULLPTR), entryCount_(0), bucketMask_(0)
+{
+}
+
+TestRepetitionStatistics::~TestRepetitionStatistics()
+{
+    if (entries_ == NULLPTR) return;
+    for (size_t i = 0; i <= bucketMask_; i++)
+        delete [] entries_[i].samples;
+    delete [] entries_;
+}
+
+TestRepetitionStatistics::Entry* TestRepetitionStatistics::findEntry(UtestShell* test) const
+{
+    if (entries_ == NULLPTR) return NULLPTR;
+
+    size_t bucket = hashTest(test) & bucketMask_;
+    while (entries_[bucket].test != NULLPTR && entries_[bucket].test != test)
+        bucket = (bucket + 1) & bucketMask_;
+    return &entries_[bucket];
+}
+
+void TestRepetitionStatistics::grow()
+{
+    Entry* oldEntries = entries_;
+    size_t oldBuckets = (oldEntries) ? bucketMask_ + 1 : 0;
+    size_t buckets = (oldBuckets) ? oldBuckets * 2 : 64;
+
+    entries_ = new Entry[buckets];
+    bucketMask_ = buckets - 1;
+    for (size_t i = 0; i < buckets; i++) {
+        entries_[i].test = NULLPTR;
+        entries_[i].samples = NULLPTR;
+        entries_[i].count = 0;
+        entries_[i].capacity = 0;
+    }
+
+    for (size_t i = 0; i < oldBuckets; i++)
+        if (oldEntries[i].test)
+            *findEntry(oldEntries[i].test) = oldEntries[i];
+    delete [] oldEntries;
+}
+
+void TestRepetitionStatistics::addSample(UtestShell* test, size_t microseconds)
+{
+    if (entries_ == NULLPTR || (entryCount_ + 1) * 2 > bucketMask_ + 1)
+        grow();
+
+    Entry* entry = findEntry(test);
+    if (entry->test == NULLPTR) {
+        entry->test = test;
+        entryCount_++;
+    }
+
+    if (entry->count == entry->capacity) {
+        size_t capacity = (entry->capacity) ? entry->capacity * 2 : 4;
+        size_t* samples = new size_t[capacity];
+        for (size_t i = 0; i < entry->count; i++)
+            samples[i] = entry->samples[i];
+        delete [] entry->samples;
+        entry->samples = samples;
+        entry->capacity = capacity;
+    }
+    entry->samples[entry->count++] = microseconds;
+}
+
+bool TestRepetitionStatistics::getSummary(UtestShell* test, TestRepetitionSummary& summary) const
+{
+    Entry* entry = findEntry(test);
+    if (entry == NULLPTR || entry->test == NULLPTR) return false;
+
+    size_t count = entry->count;
+    size_t* sorted = new size_t[count];
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sorted[i] = entry->samples[i];
+        sum += (double) sorted[i];
+    }
+    sortSamples(sorted, count);
+
+    double mean = sum / (double) count;
+    double squaredDeviations = 0.0;
+    for (size_t i = 0; i < count; i++)
+        squaredDeviations += ((double) sorted[i] - mean) * ((double) sorted[i] - mean);
+
+    summary.samples = count;
+    summary.min = sorted[0];
+    summary.median = percentile(sorted, count, 50);
+    summary.p95 = percentile(sorted, count, 95);
+    summary.p99 = percentile(sorted, count, 99);
+    summary.max = sorted[count - 1];
+    summary.mean = mean;
+    summary.coefficientOfVariation = (mean > 0.0) ? PlatformSpecificSqrt(squaredDeviations / (double) count) / mean : 0.0;
+
+    delete [] sorted;
+    return true;
+}
+
+void TestRepetitionStatistics::print(TestOutput& output, UtestShell* tests, double unstableCoefficientOfVariation) const
+{
+    size_t unstableTests = 0;
+
+    output.print("\nExecution time over the repetitions (us):\n");
+    for (UtestShell* test = tests; test != NULLPTR; test = test->getNext()) {
+        TestRepetitionSummary summary;
+        if (!getSummary(test, summary)) continue;
+
+        bool unstable = unstableCoefficientOfVariation > 0.0 && summary.coefficientOfVariation > unstableCoefficientOfVariation;
+        if (unstable) unstableTests++;
+
+        output.print(test->getFormattedName().asCharString());
+        output.print(StringFromFormat(": runs %lu min %lu median %lu p95 %lu p99 %lu max %lu cv %.1f%%%s\n",
+            (unsigned long) summary.samples, (unsigned long) summary.min, (unsigned long) summary.median,
+            (unsigned long) summary.p95, (unsigned long) summary.p99, (unsigned long) summary.max,
+            summary.coefficientOfVariation * 100.0, (unstable) ? " - unstable" : "").asCharString());
+    }
+
+    if (unstableCoefficientOfVariation > 0.0) {
+        output.print(StringFromFormat("%lu unstable tests (cv above %.1f%%)\n",
+            (unsigned long) unstableTests, unstableCoefficientOfVariation * 100.0).asCharString());
+    }
+}
@@ -44,19 +44,19 @@ TestResult::~TestResult()
 void TestResult::currentGroupStarted(UtestShell* test)
 {
     output_.printCurrentGroupStarted(*test);
-    currentGroupTimeStarted_ = (size_t) GetPlatformSpecificTimeInMillis();
+    currentGroupTimeStarted_ = getTimeInMillis();
 }
 
 void TestResult::currentGroupEnded(UtestShell* /*test*/)
 {
-    currentGroupTotalExecutionTime_ = (size_t) GetPlatformSpecificTimeInMillis() - currentGroupTimeStarted_;
+    currentGroupTotalExecutionTime_ = getTimeInMillis() - currentGroupTimeStarted_;
     output_.printCurrentGroupEnded(*this);
 }
 
 void TestResult::currentTestStarted(UtestShell* test)
 {
     output_.printCurrentTestStarted(*test);
-    currentTestTimeStarted_ = (size_t) GetPlatformSpecificTimeInMillis();
+    currentTestTimeStarted_ = getTimeInMillis();
 }
 
 void TestResult::print(const char* text)
@@ -69,9 +69,19 @@ void TestResult::printVeryVerbose(const char* text)
     output_.printVeryVerbose(text);
 }
 
+void TestResult::currentTestPhaseStarted(const char* phase)
+{
+    output_.printCurrentTestPhaseStarted(phase);
+}
+
+void TestResult::currentTestPhaseEnded(const char* phase)
+{
+    output_.printCurrentTestPhaseEnded(phase);
+}
+
 void TestResult::currentTestEnded(UtestShell* /*test*/)
 {
-    currentTestTotalExecutionTime_ = (size_t) GetPlatformSpecificTimeInMillis() - currentTestTimeStarted_;
+    currentTestTotalExecutionTime_ = getTimeInMillis() - currentTestTimeStarted_;
     output_.printCurrentTestEnded(*this);
 
 }
@@ -82,6 +92,16 @@ void TestResult::addFailure(const TestFailure& failure)
     failureCount_++;
 }
 
+void TestResult::addBenchmarkResult(const UtestShell& test, const BenchmarkResult& result)
+{
+    output_.printBenchmark(test, result);
+}
+
+void TestResult::addTestProperty(const UtestShell& test, const SimpleString& name, const SimpleString& value)
+{
+    output_.printTestProperty(test, name, value);
+}
+
 void TestResult::countTest()
 {
     testCount_++;
@@ -109,17 +129,22 @@ void TestResult::countIgnored()
 
 void TestResult::testsStarted()
 {
-    timeStarted_ = (size_t) GetPlatformSpecificTimeInMillis();
+    timeStarted_ = getTimeInMillis();
     output_.printTestsStarted();
 }
 
 void TestResult::testsEnded()
 {
-    size_t timeEnded = (size_t) GetPlatformSpecificTimeInMillis();
+    size_t timeEnded = getTimeInMillis();
     totalExecutionTime_ = timeEnded - timeStarted_;
     output_.printTestsEnded(*this);
 }
 
+size_t TestResult::getTimeInMillis() const
+{
+    return (size_t) GetPlatformSpecificTimeInMillis();
+}
+
 size_t TestResult::getTotalExecutionTime() const
 {
     return totalExecutionTime_;
@@ -131,8 +131,41 @@ extern "C" {
         PlatformSpecificRunTestInASeperateProcess(shell, plugin, result);
     }
 
+    /* Filled before the watchdog is armed, the platform writes it from a signal handler */
+    static char watchdogMessage[512];
+
 }
 
+/*
+ * Arms the platform watchdog for the duration of a test run in the current process.
+ * When it expires, the platform writes the prepared message naming the test and ends
+ * the process, so a hung test does not block the whole run. Nothing is flushed after
+ * that, so stdout is flushed before arming (ConsoleTestOutput already handed over its
+ * buffer when the test started).
+ */
+class WatchdogScope
+{
+public:
+    WatchdogScope(UtestShell* shell) : armed_(shell->getTimeout() > 0)
+    {
+        if (!armed_) return;
+        SimpleString message = StringFromFormat("\n%s:%d: error: Failure in %s\n\tTimed out after %u seconds\n\n",
+                                                shell->getFile().asCharString(), (int) shell->getLineNumber(),
+                                                shell->getFormattedName().asCharString(), shell->getTimeout());
+        message.copyToBuffer(watchdogMessage, sizeof(watchdogMessage));
+        PlatformSpecificFlush();
+        PlatformSpecificSetWatchdog(shell->getTimeout(), watchdogMessage);
+    }
+
+    ~WatchdogScope()
+    {
+        if (!armed_) return;
+        PlatformSpecificSetWatchdog(0, NULLPTR);
+    }
+private:
+    bool armed_;
+};
+
 /******************************** */
 
 static const NormalTestTerminator normalTestTerminator = NormalTestTerminator();
@@ -148,17 +181,17 @@ bool UtestShell::rethrowExceptions_ = false;
 /******************************** */
 
 UtestShell::UtestShell() :
-    group_("UndefinedTestGroup"), name_("UndefinedTest"), file_("UndefinedFile"), lineNumber_(0), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false)
+    group_("UndefinedTestGroup"), name_("UndefinedTest"), file_("UndefinedFile"), lineNumber_(0), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false), timeout_(0)
 {
 }
 
 UtestShell::UtestShell(const char* groupName, const char* testName, const char* fileName, size_t lineNumber) :
-    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false)
+    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(NULLPTR), isRunAsSeperateProcess_(false), hasFailed_(false), timeout_(0)
 {
 }
 
 UtestShell::UtestShell(const char* groupName, const char* testName, const char* fileName, size_t lineNumber, UtestShell* nextTest) :
-    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(nextTest), isRunAsSeperateProcess_(false), hasFailed_(false)
+    group_(groupName), name_(testName), file_(fileName), lineNumber_(lineNumber), next_(nextTest), isRunAsSeperateProcess_(false), hasFailed_(false), timeout_(0)
 {
 }
 
@@ -180,6 +213,7 @@ void UtestShell::resetCrashMethod()
 
 void UtestShell::crash()
 {
+    PlatformSpecificFlush();
     pleaseCrashMeRightNow();
 }
 
@@ -190,8 +224,10 @@ void UtestShell::runOneTest(TestPlugin* plugin, TestResult& result)
     HelperTestRunInfo runInfo(this, plugin, &result);
     if (isRunInSeperateProcess())
         PlatformSpecificSetJmp(helperDoRunOneTestSeperateProcess, &runInfo);
-    else
+    else {
+        WatchdogScope watchdog(this);
         PlatformSpecificSetJmp(helperDoRunOneTestInCurrentProcess, &runInfo);
+    }
 }
 
 Utest* UtestShell::createTest()
@@ -207,7 +243,9 @@ void UtestShell::destroyTest(Utest* test)
 void UtestShell::runOneTestInCurrentProcess(TestPlugin* plugin, TestResult& result)
 {
     result.printVeryVerbose("\n-- before runAllPreTestAction: ");
+    result.currentTestPhaseStarted("pre-test plugins");
     plugin->runAllPreTestAction(*this, result);
+    result.currentTestPhaseEnded("pre-test plugins");
     result.printVeryVerbose("\n-- after runAllPreTestAction: ");
 
     //save test context, so that test class can be tested
@@ -247,7 +285,9 @@ void UtestShell::runOneTestInCurrentProcess(TestPlugin* plugin, TestResult& resu
     result.printVeryVerbose("\n---- after destroyTest: ");
 
     result.printVeryVerbose("\n-- before runAllPostTestAction: ");
+    result.currentTestPhaseStarted("post-test plugins");
     plugin->runAllPostTestAction(*this, result);
+    result.currentTestPhaseEnded("post-test plugins");
     result.printVeryVerbose("\n-- after runAllPostTestAction: ");
 }
 
@@ -319,12 +359,27 @@ void UtestShell::setRunInSeperateProcess()
     isRunAsSeperateProcess_ = true;
 }
 
+unsigned int UtestShell::getTimeout() const
+{
+    return timeout_;
+}
+
+void UtestShell::setTimeout(unsigned int seconds)
+{
+    timeout_ = seconds;
+}
+
 
 void UtestShell::setRunIgnored()
 {
 
 }
 
+void UtestShell::setRunBenchmarks()
+{
+
+}
+
 void UtestShell::setFileName(const char* fileName)
 {
     file_ = fileName;
@@ -345,6 +400,17 @@ void UtestShell::setTestName(const char* testName)
     name_ = testName;
 }
 
+/* The names without a copy, for the registry that walks all tests */
+const char* UtestShell::getGroupCharString() const
+{
+    return group_;
+}
+
+const char* UtestShell::getNameCharString() const
+{
+    return name_;
+}
+
 const SimpleString UtestShell::getFile() const
 {
     return SimpleString(file_);
@@ -370,6 +436,11 @@ bool UtestShell::shouldRun(const TestFilter* groupFilters, const TestFilter* nam
     return match(group_, groupFilters) && match(name_, nameFilters);
 }
 
+bool UtestShell::shouldRun(const TestFilterMatcher& groupMatcher, const TestFilterMatcher& nameMatcher) const
+{
+    return groupMatcher.match(group_) && nameMatcher.match(name_);
+}
+
 void UtestShell::failWith(const TestFailure& failure)
 {
     failWith(failure, getCurrentTestTerminator());
@@ -387,6 +458,11 @@ void UtestShell::addFailure(const TestFailure& failure)
     getTestResult()->addFailure(failure);
 }
 
+void UtestShell::addBenchmarkResult(const BenchmarkResult& result)
+{
+    getTestResult()->addBenchmarkResult(*this, result);
+}
+
 void UtestShell::exitTest(const TestTerminator& terminator)
 {
     terminator.exitCurrentTest();
@@ -576,6 +652,16 @@ void UtestShell::printVeryVerbose(const char* text)
     getTestResult()->printVeryVerbose(text);
 }
 
+void UtestShell::testPhaseStarted(const char* phase)
+{
+    getTestResult()->currentTestPhaseStarted(phase);
+}
+
+void UtestShell::testPhaseEnded(const char* phase)
+{
+    getTestResult()->currentTestPhaseEnded(phase);
+}
+
 TestResult* UtestShell::testResult_ = NULLPTR;
 UtestShell* UtestShell::currentTest_ = NULLPTR;
 
@@ -657,12 +743,16 @@ void Utest::run()
     int jumpResult = 0;
     try {
         current->printVeryVerbose("\n-------- before setup: ");
+        current->testPhaseStarted("setup");
         jumpResult = PlatformSpecificSetJmp(helperDoTestSetup, this);
+        current->testPhaseEnded("setup");
         current->printVeryVerbose("\n-------- after  setup: ");
 
         if (jumpResult) {
             current->printVeryVerbose("\n----------  before body: ");
+            current->testPhaseStarted("body");
             PlatformSpecificSetJmp(helperDoTestBody, this);
+            current->testPhaseEnded("body");
             current->printVeryVerbose("\n----------  after body: ");
         }
     }
@@ -693,7 +783,9 @@ void Utest::run()
 
     try {
         current->printVeryVerbose("\n--------  before teardown: ");
+        current->testPhaseStarted("teardown");
         PlatformSpecificSetJmp(helperDoTestTeardown, this);
+        current->testPhaseEnded("teardown");
         current->printVeryVerbose("\n--------  after teardown: ");
     }
     catch (CppUTestFailedException&)
@@ -725,10 +817,21 @@ void Utest::run()
 
 void Utest::run()
 {
-    if (PlatformSpecificSetJmp(helperDoTestSetup, this)) {
+    UtestShell* current = UtestShell::getCurrent();
+
+    current->testPhaseStarted("setup");
+    int jumpResult = PlatformSpecificSetJmp(helperDoTestSetup, this);
+    current->testPhaseEnded("setup");
+
+    if (jumpResult) {
+        current->testPhaseStarted("body");
         PlatformSpecificSetJmp(helperDoTestBody, this);
+        current->testPhaseEnded("body");
     }
+
+    current->testPhaseStarted("teardown");
     PlatformSpecificSetJmp(helperDoTestTeardown, this);
+    current->testPhaseEnded("teardown");
 }
 
 #endif
@@ -885,6 +988,49 @@ void IgnoredUtestShell::setRunIgnored()
     runIgnored_ = true;
 }
 
+//////////////////// BenchmarkUtestShell
+
+BenchmarkUtestShell::BenchmarkUtestShell(): runBenchmarks_(false)
+{
+}
+
+BenchmarkUtestShell::BenchmarkUtestShell(const char* groupName, const char* testName, const char* fileName, size_t lineNumber) :
+   UtestShell(groupName, testName, fileName, lineNumber), runBenchmarks_(false)
+{
+}
+
+BenchmarkUtestShell::~BenchmarkUtestShell()
+{
+}
+
+bool BenchmarkUtestShell::willRun() const
+{
+    if (runBenchmarks_) return UtestShell::willRun();
+
+    return false;
+}
+
+SimpleString BenchmarkUtestShell::getMacroName() const
+{
+    return "BENCHMARK";
+}
+
+void BenchmarkUtestShell::runOneTest(TestPlugin* plugin, TestResult& result)
+{
+    if (runBenchmarks_)
+    {
+        UtestShell::runOneTest(plugin, result);
+        return;
+    }
+
+    result.countIgnored();
+}
+
+void BenchmarkUtestShell::setRunBenchmarks()
+{
+    runBenchmarks_ = true;
+}
+
 //////////////////// UtestShellPointerArray
 
 UtestShellPointerArray::UtestShellPointerArray(UtestShell* firstTest)
@@ -984,3 +1130,41 @@ void TestInstaller::unDo()
 {
     TestRegistry::getCurrentRegistry()->unDoLastAddTest();
 }
+
+////////////// TestGroupTimeout ////////////
+
+TestGroupTimeout::TestGroupTimeout(const char* groupName, unsigned int seconds)
+    : group_(groupName), seconds_(seconds), next_(NULLPTR)
+{
+}
+
+TestGroupTimeout::~TestGroupTimeout()
+{
+}
+
+const char* TestGroupTimeout::getGroup() const
+{
+    return group_;
+}
+
+unsigned int TestGroupTimeout::getTimeout() const
+{
+    return seconds_;
+}
+
+TestGroupTimeout* TestGroupTimeout::getNext() const
+{
+    return next_;
+}
+
+TestGroupTimeout* TestGroupTimeout::addGroupTimeout(TestGroupTimeout* groupTimeout)
+{
+    next_ = groupTimeout;
+    return this;
+}
+
+TestGroupTimeoutInstaller::TestGroupTimeoutInstaller(const char* groupName, unsigned int seconds)
+    : TestGroupTimeout(groupName, seconds)
+{
+    TestRegistry::getCurrentRegistry()->addGroupTimeout(this);
+}
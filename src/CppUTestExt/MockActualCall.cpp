@@ -29,6 +29,7 @@
 #include "CppUTestExt/MockCheckedActualCall.h"
 #include "CppUTestExt/MockCheckedExpectedCall.h"
 #include "CppUTestExt/MockFailure.h"
+#include "CppUTestExt/MockCallRecorder.h"
 #include "CppUTest/PlatformSpecificFunctions.h"
 
 MockActualCall::MockActualCall()
@@ -39,25 +40,56 @@ MockActualCall::~MockActualCall()
 {
 }
 
+MockActualCall& MockActualCall::withArguments(const MockTypedValue&)
+{
+    return *this;
+}
+
+const MockTypedValue* MockActualCall::returnTypedValue()
+{
+    return NULLPTR;
+}
+
+/* Adds the time until it goes out of scope to the counter, when there is one */
+class MockTimeCounter
+{
+public:
+    MockTimeCounter(unsigned long* counter)
+        : counter_(counter), start_(counter ? GetPlatformSpecificTimeInMicros() : 0)
+    {
+    }
+
+    ~MockTimeCounter()
+    {
+        if (counter_) *counter_ += GetPlatformSpecificTimeInMicros() - start_;
+    }
+
+private:
+    unsigned long* counter_;
+    unsigned long start_;
+};
+
 void MockCheckedActualCall::setName(const SimpleString& name)
 {
-    functionName_ = name;
+    functionName_ = MockSymbolTable::symbolFor(name);
 }
 
 SimpleString MockCheckedActualCall::getName() const
 {
-    return functionName_;
+    return MockSymbolTable::nameOf(functionName_);
 }
 
 MockCheckedActualCall::MockCheckedActualCall(unsigned int callOrder, MockFailureReporter* reporter, const MockExpectedCallsList& allExpectations)
-    : callOrder_(callOrder), reporter_(reporter), state_(CALL_SUCCEED), expectationsChecked_(false), matchingExpectation_(NULLPTR),
-      allExpectations_(allExpectations), outputParameterExpectations_(NULLPTR)
+    : functionName_(MockSymbolTable::EMPTY), callOrder_(callOrder), reporter_(reporter), state_(CALL_SUCCEED), expectationsChecked_(false), matchingExpectation_(NULLPTR),
+      allExpectations_(allExpectations), outputParameterCount_(0), recorder_(NULLPTR), recordedScope_(MockSymbolTable::EMPTY),
+      recordedFunctionName_(MockSymbolTable::EMPTY), recordedParameterCount_(0), statistics_(NULLPTR)
 {
-    potentiallyMatchingExpectations_.addPotentiallyMatchingExpectations(allExpectations);
+    outputParameterExpectations_.next_ = NULLPTR;
 }
 
 MockCheckedActualCall::~MockCheckedActualCall()
 {
+    finishStatistics();
     cleanUpOutputParameterList();
 }
 
@@ -66,6 +98,99 @@ void MockCheckedActualCall::setMockFailureReporter(MockFailureReporter* reporter
     reporter_ = reporter;
 }
 
+void MockCheckedActualCall::reset(unsigned int callOrder, MockFailureReporter* reporter)
+{
+    finishStatistics();
+    functionName_ = MockSymbolTable::EMPTY;
+    callOrder_ = callOrder;
+    reporter_ = reporter;
+    state_ = CALL_SUCCEED;
+    expectationsChecked_ = false;
+    matchingExpectation_ = NULLPTR;
+    potentiallyMatchingExpectations_.removeAllExpectations();
+    outputParameterCount_ = 0;
+    recorder_ = NULLPTR;
+}
+
+void MockCheckedActualCall::recordTo(MockCallRecorder* recorder, MockSymbol scope, MockSymbol functionName)
+{
+    recorder_ = recorder;
+    recordedScope_ = scope;
+    recordedFunctionName_ = functionName;
+    recordedParameters_ = "";
+    recordedParameterCount_ = 0;
+    recordedReturnValue_ = "";
+}
+
+void MockCheckedActualCall::recordParameter(const SimpleString& encodedParameter)
+{
+    recordedParameters_ += encodedParameter;
+    recordedParameterCount_++;
+}
+
+template <typename T>
+static MockNamedValue defaultReturnValue(T value)
+{
+    MockNamedValue returnValue("returnValue");
+    returnValue.setValue(value);
+    return returnValue;
+}
+
+/* Encoded right away, as e.g. a default string does not need to outlive the call */
+void MockCheckedActualCall::recordDefaultReturnValue(const MockNamedValue& value)
+{
+    recordedReturnValue_ = recorder_->encodeReturnValue(value);
+}
+
+/* Called once the expectations of the call were checked, so asking for the return value cannot fail the call anymore */
+void MockCheckedActualCall::finishRecording()
+{
+    MockCallRecorder* recorder = recorder_;
+    recorder_ = NULLPTR;
+    if (recorder == NULLPTR || state_ != CALL_SUCCEED || matchingExpectation_ == NULLPTR) return;
+
+    MockNamedValue value = matchingExpectation_->returnValue();
+    recorder->recordCall(recordedScope_, recordedFunctionName_, recordedParameters_, recordedParameterCount_,
+                         value.getName().isEmpty() ? recordedReturnValue_ : recorder->encodeReturnValue(value));
+}
+
+void MockCheckedActualCall::collectStatisticsIn(MockStatistics* statistics)
+{
+    statistics_ = statistics;
+    callStatistics_ = MockFunctionStatistics();
+}
+
+unsigned long* MockCheckedActualCall::matchingTimeCounter()
+{
+    return statistics_ ? &callStatistics_.matchingTimeInMicros : NULLPTR;
+}
+
+unsigned long* MockCheckedActualCall::copyingTimeCounter()
+{
+    return (statistics_ && outputParameterCount_ > 0) ? &callStatistics_.copyingTimeInMicros : NULLPTR;
+}
+
+void MockCheckedActualCall::countScannedExpectations()
+{
+    if (statistics_) callStatistics_.expectationsScanned += potentiallyMatchingExpectations_.size();
+}
+
+void MockCheckedActualCall::finishStatistics()
+{
+    MockStatistics* statistics = statistics_;
+    statistics_ = NULLPTR;
+    if (statistics == NULLPTR) return;
+
+    /* Output parameters are copied while matching, so that time is only counted as copying */
+    if (callStatistics_.matchingTimeInMicros > callStatistics_.copyingTimeInMicros)
+        callStatistics_.matchingTimeInMicros -= callStatistics_.copyingTimeInMicros;
+    else
+        callStatistics_.matchingTimeInMicros = 0;
+    callStatistics_.calls = 1;
+    callStatistics_.failures = hasFailed() ? 1 : 0;
+    statistics->addCall(functionName_, callStatistics_);
+}
+
 UtestShell* MockCheckedActualCall::getTest() const
 {
     return reporter_->getTestToFail();
@@ -81,24 +206,29 @@ void MockCheckedActualCall::failTest(const MockFailure& failure)
 
 void MockCheckedActualCall::copyOutputParameters(MockCheckedExpectedCall* expectedCall)
 {
-    for (MockOutputParametersListNode* p = outputParameterExpectations_; p; p = p->next_)
+    MockTimeCounter copyingTime(copyingTimeCounter());
+    MockOutputParameterChunk* chunk = &outputParameterExpectations_;
+    for (unsigned int i = 0; i < outputParameterCount_; i++)
     {
+        if (i > 0 && i % MockOutputParameterChunk::SIZE == 0)
+            chunk = chunk->next_;
+        MockOutputParameter* p = &chunk->parameters_[i % MockOutputParameterChunk::SIZE];
+
         MockNamedValue outputParameter = expectedCall->getOutputParameter(p->name_);
         MockNamedValueCopier* copier = outputParameter.getCopier();
         if (copier)
         {
             copier->copy(p->ptr_, outputParameter.getConstObjectPointer());
         }
-        else if ((outputParameter.getType() == "const void*") && (p->type_ == "void*"))
+        else if ((outputParameter.getTypeSymbol() == MockSymbolTable::TYPE_CONST_VOID_POINTER) && (p->type_ == MockSymbolTable::TYPE_VOID_POINTER))
         {
             const void* data = outputParameter.getConstPointerValue();
             size_t size = outputParameter.getSize();
             PlatformSpecificMemCpy(p->ptr_, data, size);
         }
-        else if (outputParameter.getName() != "")
+        else if (outputParameter.getNameSymbol() != MockSymbolTable::EMPTY)
         {
-            SimpleString type = expectedCall->getOutputParameter(p->name_).getType();
-            MockNoWayToCopyCustomTypeFailure failure(getTest(), type);
+            MockNoWayToCopyCustomTypeFailure failure(getTest(), outputParameter.getType());
             failTest(failure);
         }
     }
@@ -137,12 +267,19 @@ void MockCheckedActualCall::discardCurrentlyMatchingExpectations()
 
 MockActualCall& MockCheckedActualCall::withName(const SimpleString& name)
 {
-    setName(name);
+    return withNameSymbol(MockSymbolTable::symbolFor(name));
+}
+
+MockActualCall& MockCheckedActualCall::withNameSymbol(MockSymbol name)
+{
+    MockTimeCounter matchingTime(matchingTimeCounter());
+    functionName_ = name;
     setState(CALL_IN_PROGRESS);
 
-    potentiallyMatchingExpectations_.onlyKeepExpectationsRelatedTo(name);
+    potentiallyMatchingExpectations_.addPotentiallyMatchingExpectationsRelatedToSymbol(name, allExpectations_);
+    countScannedExpectations();
     if (potentiallyMatchingExpectations_.isEmpty()) {
-        MockUnexpectedCallHappenedFailure failure(getTest(), name, allExpectations_);
+        MockUnexpectedCallHappenedFailure failure(getTest(), getName(), allExpectations_);
         failTest(failure);
         return *this;
     }
@@ -159,14 +296,18 @@ MockActualCall& MockCheckedActualCall::withCallOrder(unsigned int)
 
 void MockCheckedActualCall::checkInputParameter(const MockNamedValue& actualParameter)
 {
+    if (recorder_) recordParameter(recorder_->encodeParameter(actualParameter));
+
     if(hasFailed())
     {
         return;
     }
 
+    MockTimeCounter matchingTime(matchingTimeCounter());
     setState(CALL_IN_PROGRESS);
     discardCurrentlyMatchingExpectations();
 
+    countScannedExpectations();
     potentiallyMatchingExpectations_.onlyKeepExpectationsWithInputParameter(actualParameter);
 
     if (potentiallyMatchingExpectations_.isEmpty()) {
@@ -175,20 +316,51 @@ void MockCheckedActualCall::checkInputParameter(const MockNamedValue& actualPara
         return;
     }
 
-    potentiallyMatchingExpectations_.parameterWasPassed(actualParameter.getName());
+    potentiallyMatchingExpectations_.parameterWasPassed(actualParameter.getNameSymbol());
     completeCallWhenMatchIsFound();
 }
 
+MockActualCall& MockCheckedActualCall::withArguments(const MockTypedValue& arguments)
+{
+    if (recorder_) recordParameter(recorder_->encodeNotRecordedParameter(""));
+
+    if(hasFailed())
+    {
+        return *this;
+    }
+
+    MockTimeCounter matchingTime(matchingTimeCounter());
+    setState(CALL_IN_PROGRESS);
+    discardCurrentlyMatchingExpectations();
+
+    countScannedExpectations();
+    potentiallyMatchingExpectations_.onlyKeepExpectationsWithArguments(arguments);
+
+    if (potentiallyMatchingExpectations_.isEmpty()) {
+        MockUnexpectedArgumentsFailure failure(getTest(), getName(), arguments, allExpectations_);
+        failTest(failure);
+        return *this;
+    }
+
+    potentiallyMatchingExpectations_.argumentsWerePassed();
+    completeCallWhenMatchIsFound();
+    return *this;
+}
+
 void MockCheckedActualCall::checkOutputParameter(const MockNamedValue& outputParameter)
 {
+    if (recorder_) recordParameter(recorder_->encodeNotRecordedParameter(outputParameter.getName()));
+
     if(hasFailed())
     {
         return;
     }
 
+    MockTimeCounter matchingTime(matchingTimeCounter());
     setState(CALL_IN_PROGRESS);
     discardCurrentlyMatchingExpectations();
 
+    countScannedExpectations();
     potentiallyMatchingExpectations_.onlyKeepExpectationsWithOutputParameter(outputParameter);
 
     if (potentiallyMatchingExpectations_.isEmpty()) {
@@ -197,7 +369,7 @@ void MockCheckedActualCall::checkOutputParameter(const MockNamedValue& outputPar
         return;
     }
 
-    potentiallyMatchingExpectations_.outputParameterWasPassed(outputParameter.getName());
+    potentiallyMatchingExpectations_.outputParameterWasPassed(outputParameter.getNameSymbol());
     completeCallWhenMatchIsFound();
 }
 
@@ -339,7 +511,7 @@ MockActualCall& MockCheckedActualCall::withParameterOfType(const SimpleString& t
 
 MockActualCall& MockCheckedActualCall::withOutputParameter(const SimpleString& name, void* output)
 {
-    addOutputParameter(name, "void*", output);
+    addOutputParameter(MockSymbolTable::symbolFor(name), MockSymbolTable::TYPE_VOID_POINTER, output);
 
     MockNamedValue outputParameter(name);
     outputParameter.setValue(output);
@@ -376,6 +548,7 @@ void MockCheckedActualCall::checkExpectations()
     }
 
     expectationsChecked_ = true;
+    MockTimeCounter matchingTime(matchingTimeCounter());
 
     if (state_ != CALL_IN_PROGRESS) {
         if(state_ == CALL_SUCCEED) {
@@ -388,6 +561,7 @@ void MockCheckedActualCall::checkExpectations()
     if (potentiallyMatchingExpectations_.hasFinalizedMatchingExpectations())
         FAIL("Actual call is in progress, but there are finalized matching expectations when checking expectations. This cannot happen."); // LCOV_EXCL_LINE
 
+    countScannedExpectations();
     matchingExpectation_ = potentiallyMatchingExpectations_.removeFirstMatchingExpectation();
     if (matchingExpectation_) {
         matchingExpectation_->finalizeActualCallMatch();
@@ -420,9 +594,18 @@ MockNamedValue MockCheckedActualCall::returnValue()
     return MockNamedValue("no return value");
 }
 
+const MockTypedValue* MockCheckedActualCall::returnTypedValue()
+{
+    checkExpectations();
+    if (matchingExpectation_)
+        return matchingExpectation_->getTypedReturnValue();
+    return NULLPTR;
+}
+
 bool MockCheckedActualCall::returnBoolValueOrDefault(bool default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnBoolValue();
@@ -436,6 +619,7 @@ bool MockCheckedActualCall::returnBoolValue()
 int MockCheckedActualCall::returnIntValueOrDefault(int default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnIntValue();
@@ -454,6 +638,7 @@ unsigned long int MockCheckedActualCall::returnUnsignedLongIntValue()
 unsigned long int MockCheckedActualCall::returnUnsignedLongIntValueOrDefault(unsigned long int default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnUnsignedLongIntValue();
@@ -467,6 +652,7 @@ long int MockCheckedActualCall::returnLongIntValue()
 long int MockCheckedActualCall::returnLongIntValueOrDefault(long int default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnLongIntValue();
@@ -482,6 +668,7 @@ cpputest_ulonglong MockCheckedActualCall::returnUnsignedLongLongIntValue()
 cpputest_ulonglong MockCheckedActualCall::returnUnsignedLongLongIntValueOrDefault(cpputest_ulonglong default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnUnsignedLongLongIntValue();
@@ -495,6 +682,7 @@ cpputest_longlong MockCheckedActualCall::returnLongLongIntValue()
 cpputest_longlong MockCheckedActualCall::returnLongLongIntValueOrDefault(cpputest_longlong default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnLongLongIntValue();
@@ -538,6 +726,7 @@ double MockCheckedActualCall::returnDoubleValue()
 double MockCheckedActualCall::returnDoubleValueOrDefault(double default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnDoubleValue();
@@ -551,6 +740,7 @@ unsigned int MockCheckedActualCall::returnUnsignedIntValue()
 unsigned int MockCheckedActualCall::returnUnsignedIntValueOrDefault(unsigned int default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnUnsignedIntValue();
@@ -559,6 +749,7 @@ unsigned int MockCheckedActualCall::returnUnsignedIntValueOrDefault(unsigned int
 void * MockCheckedActualCall::returnPointerValueOrDefault(void * default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnPointerValue();
@@ -577,6 +768,7 @@ const void * MockCheckedActualCall::returnConstPointerValue()
 const void * MockCheckedActualCall::returnConstPointerValueOrDefault(const void * default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnConstPointerValue();
@@ -590,6 +782,7 @@ void (*MockCheckedActualCall::returnFunctionPointerValue())()
 void (*MockCheckedActualCall::returnFunctionPointerValueOrDefault(void (*default_value)()))()
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnFunctionPointerValue();
@@ -598,6 +791,7 @@ void (*MockCheckedActualCall::returnFunctionPointerValueOrDefault(void (*default
 const char * MockCheckedActualCall::returnStringValueOrDefault(const char * default_value)
 {
     if (!hasReturnValue()) {
+        if (recorder_) recordDefaultReturnValue(defaultReturnValue(default_value));
         return default_value;
     }
     return returnStringValue();
@@ -641,91 +835,184 @@ MockActualCall& MockCheckedActualCall::onObject(const void* objectPtr)
 
 void MockCheckedActualCall::addOutputParameter(const SimpleString& name, const SimpleString& type, void* ptr)
 {
-    MockOutputParametersListNode* newNode = new MockOutputParametersListNode(name, type, ptr);
+    addOutputParameter(MockSymbolTable::symbolFor(name), MockSymbolTable::symbolFor(type), ptr);
+}
 
-    if (outputParameterExpectations_ == NULLPTR)
-        outputParameterExpectations_ = newNode;
-    else {
-        MockOutputParametersListNode* lastNode = outputParameterExpectations_;
-        while (lastNode->next_) lastNode = lastNode->next_;
-        lastNode->next_ = newNode;
+void MockCheckedActualCall::addOutputParameter(MockSymbol name, MockSymbol type, void* ptr)
+{
+    MockOutputParameterChunk* chunk = &outputParameterExpectations_;
+    for (unsigned int i = MockOutputParameterChunk::SIZE; i <= outputParameterCount_; i += MockOutputParameterChunk::SIZE) {
+        if (chunk->next_ == NULLPTR) {
+            chunk->next_ = new MockOutputParameterChunk;
+            chunk->next_->next_ = NULLPTR;
+        }
+        chunk = chunk->next_;
     }
+
+    MockOutputParameter& parameter = chunk->parameters_[outputParameterCount_ % MockOutputParameterChunk::SIZE];
+    parameter.name_ = name;
+    parameter.type_ = type;
+    parameter.ptr_ = ptr;
+    outputParameterCount_++;
 }
 
 void MockCheckedActualCall::cleanUpOutputParameterList()
 {
-    MockOutputParametersListNode* current = outputParameterExpectations_;
-    MockOutputParametersListNode* toBeDeleted = NULLPTR;
-
-    while (current) {
-        toBeDeleted = current;
-        outputParameterExpectations_ = current = current->next_;
-        delete toBeDeleted;
+    while (outputParameterExpectations_.next_) {
+        MockOutputParameterChunk* next = outputParameterExpectations_.next_->next_;
+        delete outputParameterExpectations_.next_;
+        outputParameterExpectations_.next_ = next;
     }
+    outputParameterCount_ = 0;
 }
 
 
+struct MockActualCallTrace::TraceEvent
+{
+    enum Kind { NAME, CALL_ORDER, ON_OBJECT, PARAMETER, PARAMETER_OF_TYPE, ARGUMENTS };
+
+    int kind_;
+    MockSymbol name_;
+    MockSymbol type_;
+    union {
+        bool boolValue_;
+        int intValue_;
+        unsigned int unsignedIntValue_;
+        long int longIntValue_;
+        unsigned long int unsignedLongIntValue_;
+#if CPPUTEST_USE_LONG_LONG
+        cpputest_longlong longLongIntValue_;
+        cpputest_ulonglong unsignedLongLongIntValue_;
+#endif
+        double doubleValue_;
+        const void* pointerValue_;
+        void (*functionPointerValue_)();
+        char* data_;
+    } value_;
+    size_t size_;
+};
+
+/* Strings, memory buffers and typed arguments may be gone by the time the trace is formatted, so they are copied */
+static char* copyOfData(const void* data, size_t size)
+{
+    if (data == NULLPTR) return NULLPTR;
+    char* copy = new char[size + 1];
+    PlatformSpecificMemCpy(copy, data, size);
+    copy[size] = '\0';
+    return copy;
+}
+
+static size_t lengthOf(const char* text)
+{
+    size_t length = 0;
+    while (text[length] != '\0') length++;
+    return length;
+}
+
 MockActualCallTrace::MockActualCallTrace()
+    : events_(NULLPTR), capacity_(0), first_(0), count_(0), maximumEvents_(0), droppedEvents_(0),
+      output_(NULLPTR), outputSize_(0), outputCapacity_(0)
 {
 }
 
 MockActualCallTrace::~MockActualCallTrace()
 {
+    clear();
+    delete [] events_;
+    delete [] output_;
+}
+
+void MockActualCallTrace::setMaximumEvents(unsigned int maximumEvents)
+{
+    maximumEvents_ = maximumEvents;
+}
+
+void MockActualCallTrace::releaseEventData(TraceEvent& event)
+{
+    if (event.kind_ == TraceEvent::ARGUMENTS || (event.kind_ == TraceEvent::PARAMETER &&
+        (event.type_ == MockSymbolTable::TYPE_CONST_CHAR_POINTER || event.type_ == MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER)))
+        delete [] event.value_.data_;
+}
+
+MockActualCallTrace::TraceEvent& MockActualCallTrace::addEvent(int kind, MockSymbol name, MockSymbol type)
+{
+    while (maximumEvents_ != 0 && count_ >= maximumEvents_) {
+        releaseEventData(events_[first_]);
+        first_ = (first_ + 1) % capacity_;
+        count_--;
+        droppedEvents_++;
+    }
+
+    if (count_ == capacity_) {
+        unsigned int capacity = (capacity_ == 0) ? 16 : capacity_ * 2;
+        if (maximumEvents_ != 0 && capacity > maximumEvents_) capacity = maximumEvents_;
+        TraceEvent* events = new TraceEvent[capacity];
+        for (unsigned int i = 0; i < count_; i++)
+            events[i] = events_[(first_ + i) % capacity_];
+        delete [] events_;
+        events_ = events;
+        capacity_ = capacity;
+        first_ = 0;
+    }
+
+    TraceEvent& event = events_[(first_ + count_++) % capacity_];
+    event.kind_ = kind;
+    event.name_ = name;
+    event.type_ = type;
+    event.value_.data_ = NULLPTR;
+    event.size_ = 0;
+    return event;
+}
+
+MockActualCallTrace::TraceEvent& MockActualCallTrace::addParameter(const SimpleString& name, MockSymbol type)
+{
+    return addEvent(TraceEvent::PARAMETER, MockSymbolTable::symbolFor(name), type);
 }
 
 MockActualCall& MockActualCallTrace::withName(const SimpleString& name)
 {
-    traceBuffer_ += "\nFunction name:";
-    traceBuffer_ += name;
-    return *this;
+    return withNameSymbol(MockSymbolTable::symbolFor(name));
 }
 
-MockActualCall& MockActualCallTrace::withCallOrder(unsigned int callOrder)
+MockActualCall& MockActualCallTrace::withNameSymbol(MockSymbol name)
 {
-    traceBuffer_ += " withCallOrder:";
-    traceBuffer_ += StringFrom(callOrder);
+    addEvent(TraceEvent::NAME, name, MockSymbolTable::EMPTY);
     return *this;
 }
 
-void MockActualCallTrace::addParameterName(const SimpleString& name)
+MockActualCall& MockActualCallTrace::withCallOrder(unsigned int callOrder)
 {
-    traceBuffer_ += " ";
-    traceBuffer_ += name;
-    traceBuffer_ += ":";
+    addEvent(TraceEvent::CALL_ORDER, MockSymbolTable::EMPTY, MockSymbolTable::EMPTY).value_.unsignedIntValue_ = callOrder;
+    return *this;
 }
 
 MockActualCall& MockActualCallTrace::withBoolParameter(const SimpleString& name, bool value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_BOOL).value_.boolValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withUnsignedIntParameter(const SimpleString& name, unsigned int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_UNSIGNED_INT).value_.unsignedIntValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withIntParameter(const SimpleString& name, int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_INT).value_.intValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withUnsignedLongIntParameter(const SimpleString& name, unsigned long int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_UNSIGNED_LONG_INT).value_.unsignedLongIntValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withLongIntParameter(const SimpleString& name, long int value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_LONG_INT).value_.longIntValue_ = value;
     return *this;
 }
 
@@ -733,15 +1020,13 @@ MockActualCall& MockActualCallTrace::withLongIntParameter(const SimpleString& na
 
 MockActualCall& MockActualCallTrace::withUnsignedLongLongIntParameter(const SimpleString& name, cpputest_ulonglong value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT).value_.unsignedLongLongIntValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withLongLongIntParameter(const SimpleString& name, cpputest_longlong value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value) + " " + BracketsFormattedHexStringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_LONG_LONG_INT).value_.longLongIntValue_ = value;
     return *this;
 }
 
@@ -763,68 +1048,64 @@ MockActualCall& MockActualCallTrace::withLongLongIntParameter(const SimpleString
 
 MockActualCall& MockActualCallTrace::withDoubleParameter(const SimpleString& name, double value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_DOUBLE).value_.doubleValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withStringParameter(const SimpleString& name, const char* value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_CONST_CHAR_POINTER).value_.data_ = (value) ? copyOfData(value, lengthOf(value)) : NULLPTR;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withPointerParameter(const SimpleString& name, void* value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_VOID_POINTER).value_.pointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withConstPointerParameter(const SimpleString& name, const void* value)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_CONST_VOID_POINTER).value_.pointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withFunctionPointerParameter(const SimpleString& name, void (*value)())
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addParameter(name, MockSymbolTable::TYPE_FUNCTION_POINTER).value_.functionPointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withMemoryBufferParameter(const SimpleString& name, const unsigned char* value, size_t size)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFromBinaryWithSizeOrNull(value, size);
+    TraceEvent& event = addParameter(name, MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER);
+    event.value_.data_ = copyOfData(value, size);
+    event.size_ = size;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withParameterOfType(const SimpleString& typeName, const SimpleString& name, const void* value)
 {
-    traceBuffer_ += " ";
-    traceBuffer_ += typeName;
-    addParameterName(name);
-    traceBuffer_ += StringFrom(value);
+    addEvent(TraceEvent::PARAMETER_OF_TYPE, MockSymbolTable::symbolFor(name), MockSymbolTable::symbolFor(typeName)).value_.pointerValue_ = value;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withOutputParameter(const SimpleString& name, void* output)
 {
-    addParameterName(name);
-    traceBuffer_ += StringFrom(output);
+    addParameter(name, MockSymbolTable::TYPE_VOID_POINTER).value_.pointerValue_ = output;
     return *this;
 }
 
 MockActualCall& MockActualCallTrace::withOutputParameterOfType(const SimpleString& typeName, const SimpleString& name, void* output)
 {
-    traceBuffer_ += " ";
-    traceBuffer_ += typeName;
-    addParameterName(name);
-    traceBuffer_ += StringFrom(output);
+    addEvent(TraceEvent::PARAMETER_OF_TYPE, MockSymbolTable::symbolFor(name), MockSymbolTable::symbolFor(typeName)).value_.pointerValue_ = output;
+    return *this;
+}
+
+MockActualCall& MockActualCallTrace::withArguments(const MockTypedValue& arguments)
+{
+    SimpleString text = arguments.toString();
+    addEvent(TraceEvent::ARGUMENTS, MockSymbolTable::EMPTY, MockSymbolTable::EMPTY).value_.data_ = copyOfData(text.asCharString(), text.size());
     return *this;
 }
 
@@ -838,6 +1119,11 @@ MockNamedValue MockActualCallTrace::returnValue()
     return MockNamedValue("");
 }
 
+const MockTypedValue* MockActualCallTrace::returnTypedValue()
+{
+    return NULLPTR;
+}
+
 long int MockActualCallTrace::returnLongIntValue()
 {
     return 0;
@@ -994,30 +1280,142 @@ unsigned int MockActualCallTrace::returnUnsignedIntValueOrDefault(unsigned int)
 
 MockActualCall& MockActualCallTrace::onObject(const void* objectPtr)
 {
-    traceBuffer_ += " onObject:";
-    traceBuffer_ += StringFrom(objectPtr);
+    addEvent(TraceEvent::ON_OBJECT, MockSymbolTable::EMPTY, MockSymbolTable::EMPTY).value_.pointerValue_ = objectPtr;
     return *this;
 }
 
 void MockActualCallTrace::clear()
 {
-    traceBuffer_ = "";
+    for (unsigned int i = 0; i < count_; i++)
+        releaseEventData(events_[(first_ + i) % capacity_]);
+    first_ = 0;
+    count_ = 0;
+    droppedEvents_ = 0;
+}
+
+void MockActualCallTrace::appendOutput(const SimpleString& text)
+{
+    size_t length = text.size();
+    if (outputSize_ + length + 1 > outputCapacity_) {
+        size_t capacity = (outputCapacity_ == 0) ? 256 : outputCapacity_;
+        while (capacity < outputSize_ + length + 1) capacity *= 2;
+        char* output = new char[capacity];
+        if (outputSize_ > 0) PlatformSpecificMemCpy(output, output_, outputSize_);
+        delete [] output_;
+        output_ = output;
+        outputCapacity_ = capacity;
+    }
+    PlatformSpecificMemCpy(output_ + outputSize_, text.asCharString(), length + 1);
+    outputSize_ += length;
+}
+
+void MockActualCallTrace::formatEvent(const TraceEvent& event)
+{
+    switch (event.kind_) {
+    case TraceEvent::NAME:
+        appendOutput("\nFunction name:");
+        appendOutput(MockSymbolTable::nameOf(event.name_));
+        return;
+    case TraceEvent::CALL_ORDER:
+        appendOutput(" withCallOrder:");
+        appendOutput(StringFrom(event.value_.unsignedIntValue_));
+        return;
+    case TraceEvent::ON_OBJECT:
+        appendOutput(" onObject:");
+        appendOutput(StringFrom(event.value_.pointerValue_));
+        return;
+    case TraceEvent::ARGUMENTS:
+        appendOutput(" arguments:");
+        appendOutput(event.value_.data_);
+        return;
+    case TraceEvent::PARAMETER_OF_TYPE:
+        appendOutput(" ");
+        appendOutput(MockSymbolTable::nameOf(event.type_));
+        break;
+    default:
+        break;
+    }
+
+    appendOutput(" ");
+    appendOutput(MockSymbolTable::nameOf(event.name_));
+    appendOutput(":");
+
+    if (event.kind_ == TraceEvent::PARAMETER_OF_TYPE) {
+        appendOutput(StringFrom(event.value_.pointerValue_));
+        return;
+    }
+
+    switch (event.type_) {
+    case MockSymbolTable::TYPE_BOOL:
+        appendOutput(StringFrom(event.value_.boolValue_));
+        break;
+    case MockSymbolTable::TYPE_INT:
+        appendOutput(StringFrom(event.value_.intValue_) + " " + BracketsFormattedHexStringFrom(event.value_.intValue_));
+        break;
+    case MockSymbolTable::TYPE_UNSIGNED_INT:
+        appendOutput(StringFrom(event.value_.unsignedIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.unsignedIntValue_));
+        break;
+    case MockSymbolTable::TYPE_LONG_INT:
+        appendOutput(StringFrom(event.value_.longIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.longIntValue_));
+        break;
+    case MockSymbolTable::TYPE_UNSIGNED_LONG_INT:
+        appendOutput(StringFrom(event.value_.unsignedLongIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.unsignedLongIntValue_));
+        break;
+#if CPPUTEST_USE_LONG_LONG
+    case MockSymbolTable::TYPE_LONG_LONG_INT:
+        appendOutput(StringFrom(event.value_.longLongIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.longLongIntValue_));
+        break;
+    case MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT:
+        appendOutput(StringFrom(event.value_.unsignedLongLongIntValue_) + " " + BracketsFormattedHexStringFrom(event.value_.unsignedLongLongIntValue_));
+        break;
+#endif
+    case MockSymbolTable::TYPE_DOUBLE:
+        appendOutput(StringFrom(event.value_.doubleValue_));
+        break;
+    case MockSymbolTable::TYPE_CONST_CHAR_POINTER:
+        appendOutput(StringFrom((const char*) event.value_.data_));
+        break;
+    case MockSymbolTable::TYPE_FUNCTION_POINTER:
+        appendOutput(StringFrom(event.value_.functionPointerValue_));
+        break;
+    case MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER:
+        appendOutput(StringFromBinaryWithSizeOrNull((const unsigned char*) event.value_.data_, event.size_));
+        break;
+    default:
+        appendOutput(StringFrom(event.value_.pointerValue_));
+        break;
+    }
 }
 
 const char* MockActualCallTrace::getTraceOutput()
 {
-    return traceBuffer_.asCharString();
+    outputSize_ = 0;
+    appendOutput("");
+    if (droppedEvents_ != 0)
+        appendOutput(StringFromFormat("\n(%lu earlier trace events were dropped)", droppedEvents_));
+    for (unsigned int i = 0; i < count_; i++)
+        formatEvent(events_[(first_ + i) % capacity_]);
+    return output_;
 }
 
 MockActualCallTrace* MockActualCallTrace::instance_ = NULLPTR;
+unsigned int MockActualCallTrace::instanceMaximumEvents_ = 0;
 
 MockActualCallTrace& MockActualCallTrace::instance()
 {
-    if (instance_ == NULLPTR)
+    if (instance_ == NULLPTR) {
         instance_ = new MockActualCallTrace;
+        instance_->setMaximumEvents(instanceMaximumEvents_);
+    }
     return *instance_;
 }
 
+void MockActualCallTrace::setInstanceMaximumEvents(unsigned int maximumEvents)
+{
+    instanceMaximumEvents_ = maximumEvents;
+    if (instance_) instance_->setMaximumEvents(maximumEvents);
+}
+
 void MockActualCallTrace::clearInstance()
 {
     delete instance_;
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockCallRecorder.h"
+#include "CppUTestExt/MockSupport.h"
+#include "CppUTest/ZeroFreeNumber.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+static SimpleString encodeSignedNumber(long value)
+{
+    return ZeroFreeNumber::encode((value < 0) ? ((unsigned long) -(value + 1)) * 2 + 1 : ((unsigned long) value) * 2);
+}
+
+static SimpleString encodeText(const SimpleString& text)
+{
+    return ZeroFreeNumber::encode((unsigned long) text.size()) + text + "\n";
+}
+
+static const char hexDigits[] = "0123456789abcdef";
+
+/* Two hex digits per byte: fixed width and never a zero byte */
+static SimpleString encodeBytes(const void* data, size_t size)
+{
+    SimpleString bytes;
+    char chunk[129];
+    size_t length = 0;
+    const unsigned char* byte = (const unsigned char*) data;
+    for (size_t i = 0; i < size; i++) {
+        chunk[length++] = hexDigits[byte[i] >> 4];
+        chunk[length++] = hexDigits[byte[i] & 0xF];
+        if (length == sizeof(chunk) - 1 || i + 1 == size) {
+            chunk[length] = '\0';
+            bytes += chunk;
+            length = 0;
+        }
+    }
+    return bytes;
+}
+
+static bool decodeSignedNumber(char*& position, const char* end, long& value)
+{
+    unsigned long number;
+    if (!ZeroFreeNumber::decode(position, end, number)) return false;
+    value = (number & 1) ? -(long) (number / 2) - 1 : (long) (number / 2);
+    return true;
+}
+
+static int hexDigitValue(char digit)
+{
+    if (digit >= '0' && digit <= '9') return digit - '0';
+    if (digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+    return -1;
+}
+
+/* The decoded bytes are half as long as their encoding, so they can be written over it */
+static bool decodeBytes(char*& position, const char* end, void* data, size_t size)
+{
+    if (size > (size_t) (end - position) / 2) return false;
+
+    unsigned char* byte = (unsigned char*) data;
+    for (size_t i = 0; i < size; i++) {
+        int high = hexDigitValue(position[0]);
+        int low = hexDigitValue(position[1]);
+        if (high < 0 || low < 0) return false;
+        byte[i] = (unsigned char) ((high << 4) | low);
+        position += 2;
+    }
+    return true;
+}
+
+MockCallRecorder::MockCallRecorder(const SimpleString& fileName)
+    : fileName_(fileName), file_(NULLPTR), signatureWritten_(false), stringIds_(NULLPTR), stringIdCapacity_(0), stringCount_(0)
+{
+}
+
+MockCallRecorder::~MockCallRecorder()
+{
+    closeFile();
+    delete [] stringIds_;
+}
+
+const char* MockCallRecorder::signature()
+{
+    return "CppUTest mock calls 2\n";
+}
+
+SimpleString MockCallRecorder::encodeParameter(const MockNamedValue& parameter)
+{
+    return ZeroFreeNumber::encode(internSymbol(parameter.getNameSymbol())) + encodeValue(parameter);
+}
+
+SimpleString MockCallRecorder::encodeNotRecordedParameter(const SimpleString& name)
+{
+    char type[2] = { (char) NOT_RECORDED, '\0' };
+    return ZeroFreeNumber::encode(internSymbol(MockSymbolTable::symbolFor(name))) + type;
+}
+
+SimpleString MockCallRecorder::encodeReturnValue(const MockNamedValue& returnValue)
+{
+    return ZeroFreeNumber::encode(1) + encodeValue(returnValue);
+}
+
+void MockCallRecorder::recordCall(MockSymbol scope, MockSymbol functionName, const SimpleString& parameters, unsigned int parameterCount,
+                                  const SimpleString& returnValue)
+{
+    unsigned long scopeId = internSymbol(scope);
+    unsigned long functionNameId = internSymbol(functionName);
+    SimpleString payload = ZeroFreeNumber::encode(scopeId) + ZeroFreeNumber::encode(functionNameId) + ZeroFreeNumber::encode(parameterCount) + parameters;
+    payload += returnValue.isEmpty() ? ZeroFreeNumber::encode(0) : returnValue;
+    writeRecord(CALL, payload);
+}
+
+SimpleString MockCallRecorder::encodeValue(const MockNamedValue& value)
+{
+    char typeText[2] = { (char) NOT_RECORDED, '\0' };
+    SimpleString data;
+    double doubleValue;
+
+    switch (value.getTypeSymbol()) {
+    case MockSymbolTable::TYPE_BOOL:
+        typeText[0] = (char) BOOL;
+        data = ZeroFreeNumber::encode(value.getBoolValue() ? 1 : 0);
+        break;
+    case MockSymbolTable::TYPE_INT:
+        typeText[0] = (char) INT;
+        data = encodeSignedNumber(value.getIntValue());
+        break;
+    case MockSymbolTable::TYPE_UNSIGNED_INT:
+        typeText[0] = (char) UNSIGNED_INT;
+        data = ZeroFreeNumber::encode(value.getUnsignedIntValue());
+        break;
+    case MockSymbolTable::TYPE_LONG_INT:
+        typeText[0] = (char) LONG_INT;
+        data = encodeSignedNumber(value.getLongIntValue());
+        break;
+    case MockSymbolTable::TYPE_UNSIGNED_LONG_INT:
+        typeText[0] = (char) UNSIGNED_LONG_INT;
+        data = ZeroFreeNumber::encode(value.getUnsignedLongIntValue());
+        break;
+#if CPPUTEST_USE_LONG_LONG
+    case MockSymbolTable::TYPE_LONG_LONG_INT: {
+        cpputest_longlong longLongValue = value.getLongLongIntValue();
+        typeText[0] = (char) LONG_LONG_INT;
+        data = encodeBytes(&longLongValue, sizeof(longLongValue));
+        break;
+    }
+    case MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT: {
+        cpputest_ulonglong unsignedLongLongValue = value.getUnsignedLongLongIntValue();
+        typeText[0] = (char) UNSIGNED_LONG_LONG_INT;
+        data = encodeBytes(&unsignedLongLongValue, sizeof(unsignedLongLongValue));
+        break;
+    }
+#endif
+    case MockSymbolTable::TYPE_DOUBLE:
+        doubleValue = value.getDoubleValue();
+        typeText[0] = (char) DOUBLE;
+        data = encodeBytes(&doubleValue, sizeof(doubleValue));
+        break;
+    case MockSymbolTable::TYPE_CONST_CHAR_POINTER:
+        typeText[0] = (char) STRING_VALUE;
+        data = encodeText(value.getStringValue());
+        break;
+    case MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER:
+        typeText[0] = (char) MEMORY_BUFFER;
+        data = ZeroFreeNumber::encode((unsigned long) value.getSize()) + encodeBytes(value.getMemoryBuffer(), value.getSize());
+        break;
+    default:
+        break;
+    }
+    return SimpleString(typeText) + data;
+}
+
+void MockCallRecorder::writeRecord(RecordType type, const SimpleString& payload)
+{
+    char typeText[2] = { (char) type, '\0' };
+    writeToFile(SimpleString(typeText) + ZeroFreeNumber::encode((unsigned long) payload.size()) + payload);
+}
+
+unsigned long MockCallRecorder::internSymbol(MockSymbol symbol)
+{
+    if (symbol >= stringIdCapacity_) {
+        MockSymbol capacity = (stringIdCapacity_ == 0) ? 64 : stringIdCapacity_;
+        while (capacity <= symbol) capacity *= 2;
+        unsigned long* stringIds = new unsigned long[capacity];
+        for (MockSymbol i = 0; i < capacity; i++)
+            stringIds[i] = (i < stringIdCapacity_) ? stringIds_[i] : 0;
+        delete [] stringIds_;
+        stringIds_ = stringIds;
+        stringIdCapacity_ = capacity;
+    }
+
+    /* Ids are stored plus one, so zero means the name was not written yet */
+    if (stringIds_[symbol] == 0) {
+        writeRecord(STRING, SimpleString(MockSymbolTable::nameOf(symbol)) + "\n");
+        stringIds_[symbol] = ++stringCount_;
+    }
+    return stringIds_[symbol] - 1;
+}
+
+void MockCallRecorder::openFile(const char* mode)
+{
+    file_ = PlatformSpecificFOpen(fileName_.asCharString(), mode);
+}
+
+void MockCallRecorder::writeToFile(const SimpleString& buffer)
+{
+    if (!signatureWritten_) {
+        openFile("wb");
+        signatureWritten_ = true;
+        writeToFile(signature());
+    }
+    if (file_ == NULLPTR) return;
+    PlatformSpecificFPuts(buffer.asCharString(), file_);
+}
+
+void MockCallRecorder::closeFile()
+{
+    if (file_ == NULLPTR) return;
+    PlatformSpecificFClose(file_);
+    file_ = NULLPTR;
+}
+
+struct MockRecordedValue
+{
+    char type_;
+    union {
+        bool boolValue_;
+        int intValue_;
+        unsigned int unsignedIntValue_;
+        long int longIntValue_;
+        unsigned long int unsignedLongIntValue_;
+#if CPPUTEST_USE_LONG_LONG
+        cpputest_longlong longLongIntValue_;
+        cpputest_ulonglong unsignedLongLongIntValue_;
+#endif
+        double doubleValue_;
+        const char* stringValue_;
+        const unsigned char* memoryBufferValue_;
+    } value_;
+    size_t size_;
+};
+
+static void withRecordedParameter(MockExpectedCall& call, const SimpleString& name, const MockRecordedValue& value)
+{
+    switch (value.type_) {
+    case MockCallRecorder::BOOL: call.withParameter(name, value.value_.boolValue_); break;
+    case MockCallRecorder::INT: call.withParameter(name, value.value_.intValue_); break;
+    case MockCallRecorder::UNSIGNED_INT: call.withParameter(name, value.value_.unsignedIntValue_); break;
+    case MockCallRecorder::LONG_INT: call.withParameter(name, value.value_.longIntValue_); break;
+    case MockCallRecorder::UNSIGNED_LONG_INT: call.withParameter(name, value.value_.unsignedLongIntValue_); break;
+#if CPPUTEST_USE_LONG_LONG
+    case MockCallRecorder::LONG_LONG_INT: call.withParameter(name, value.value_.longLongIntValue_); break;
+    case MockCallRecorder::UNSIGNED_LONG_LONG_INT: call.withParameter(name, value.value_.unsignedLongLongIntValue_); break;
+#endif
+    case MockCallRecorder::DOUBLE: call.withParameter(name, value.value_.doubleValue_); break;
+    case MockCallRecorder::STRING_VALUE: call.withParameter(name, value.value_.stringValue_); break;
+    case MockCallRecorder::MEMORY_BUFFER: call.withParameter(name, value.value_.memoryBufferValue_, value.size_); break;
+    default: call.ignoreOtherParameters(); break;
+    }
+}
+
+static void andRecordedReturnValue(MockExpectedCall& call, const MockRecordedValue& value)
+{
+    switch (value.type_) {
+    case MockCallRecorder::BOOL: call.andReturnValue(value.value_.boolValue_); break;
+    case MockCallRecorder::INT: call.andReturnValue(value.value_.intValue_); break;
+    case MockCallRecorder::UNSIGNED_INT: call.andReturnValue(value.value_.unsignedIntValue_); break;
+    case MockCallRecorder::LONG_INT: call.andReturnValue(value.value_.longIntValue_); break;
+    case MockCallRecorder::UNSIGNED_LONG_INT: call.andReturnValue(value.value_.unsignedLongIntValue_); break;
+#if CPPUTEST_USE_LONG_LONG
+    case MockCallRecorder::LONG_LONG_INT: call.andReturnValue(value.value_.longLongIntValue_); break;
+    case MockCallRecorder::UNSIGNED_LONG_LONG_INT: call.andReturnValue(value.value_.unsignedLongLongIntValue_); break;
+#endif
+    case MockCallRecorder::DOUBLE: call.andReturnValue(value.value_.doubleValue_); break;
+    case MockCallRecorder::STRING_VALUE: call.andReturnValue(value.value_.stringValue_); break;
+    default: break;
+    }
+}
+
+MockCallReplayer::MockCallReplayer()
+    : buffer_(NULLPTR), size_(0), capacity_(0), decoded_(false), strings_(NULLPTR), stringCount_(0), stringCapacity_(0), next_(NULLPTR)
+{
+}
+
+MockCallReplayer::~MockCallReplayer()
+{
+    delete [] buffer_;
+    delete [] strings_;
+}
+
+MockCallReplayer* MockCallReplayer::next() const
+{
+    return next_;
+}
+
+void MockCallReplayer::setNext(MockCallReplayer* next)
+{
+    next_ = next;
+}
+
+bool MockCallReplayer::readFile(const char* fileName)
+{
+    PlatformSpecificFile file = PlatformSpecificFOpen(fileName, "rb");
+    if (file == NULLPTR) return false;
+
+    char chunk[4096];
+    while (PlatformSpecificFGets(chunk, sizeof(chunk), file) != NULLPTR)
+        read(chunk);
+    PlatformSpecificFClose(file);
+    return true;
+}
+
+void MockCallReplayer::read(const char* data)
+{
+    size_t length = 0;
+    while (data[length] != '\0') length++;
+
+    if (size_ + length > capacity_) {
+        capacity_ = (capacity_ == 0) ? 4096 : capacity_;
+        while (capacity_ < size_ + length) capacity_ *= 2;
+        char* buffer = new char[capacity_];
+        if (size_ > 0) PlatformSpecificMemCpy(buffer, buffer_, size_);
+        delete [] buffer_;
+        buffer_ = buffer;
+    }
+    PlatformSpecificMemCpy(buffer_ + size_, data, length);
+    size_ += length;
+}
+
+bool MockCallReplayer::expectRecordedCalls(MockSupport& support)
+{
+    if (decoded_) return false;
+    decoded_ = true;
+
+    const char* signature = MockCallRecorder::signature();
+    size_t signatureLength = 0;
+    for (; signature[signatureLength] != '\0'; signatureLength++)
+        if (signatureLength >= size_ || buffer_[signatureLength] != signature[signatureLength]) return false;
+
+    char* position = buffer_ + signatureLength;
+    const char* end = buffer_ + size_;
+    while (position < end) {
+        char type = *position;
+        char* payload = position + 1;
+        unsigned long length;
+        if (!ZeroFreeNumber::decode(payload, end, length) || length > (unsigned long) (end - payload)) return false;
+
+        char* payloadEnd = payload + length;
+        if (type == MockCallRecorder::STRING) {
+            if (length == 0) return false;
+            payloadEnd[-1] = '\0';
+            addString(payload);
+        }
+        else if (type == MockCallRecorder::CALL && !replayCall(support, payload, payloadEnd))
+            return false;
+        position = payloadEnd;
+    }
+    return true;
+}
+
+bool MockCallReplayer::replayCall(MockSupport& support, char*& position, const char* end)
+{
+    unsigned long scope, functionName, parameterCount, hasReturnValue;
+    if (!ZeroFreeNumber::decode(position, end, scope) || !ZeroFreeNumber::decode(position, end, functionName) || !ZeroFreeNumber::decode(position, end, parameterCount) ||
+        scope >= stringCount_ || functionName >= stringCount_) return false;
+
+    MockSupport& scopeSupport = (*strings_[scope] == '\0') ? support : *support.getMockSupportScope(strings_[scope]);
+    scopeSupport.strictOrder();
+    MockExpectedCall& call = scopeSupport.expectOneCall(strings_[functionName]);
+
+    MockRecordedValue value;
+    for (unsigned long i = 0; i < parameterCount; i++) {
+        unsigned long name;
+        if (!ZeroFreeNumber::decode(position, end, name) || name >= stringCount_ || !decodeValue(position, end, value)) return false;
+        withRecordedParameter(call, strings_[name], value);
+    }
+
+    if (!ZeroFreeNumber::decode(position, end, hasReturnValue)) return false;
+    if (hasReturnValue) {
+        if (!decodeValue(position, end, value)) return false;
+        andRecordedReturnValue(call, value);
+    }
+    return true;
+}
+
+bool MockCallReplayer::decodeValue(char*& position, const char* end, MockRecordedValue& value)
+{
+    unsigned long number;
+    long signedNumber;
+
+    if (position >= end) return false;
+    value.type_ = *position++;
+
+    switch (value.type_) {
+    case MockCallRecorder::BOOL:
+        if (!ZeroFreeNumber::decode(position, end, number)) return false;
+        value.value_.boolValue_ = (number != 0);
+        return true;
+    case MockCallRecorder::INT:
+        if (!decodeSignedNumber(position, end, signedNumber)) return false;
+        value.value_.intValue_ = (int) signedNumber;
+        return true;
+    case MockCallRecorder::UNSIGNED_INT:
+        if (!ZeroFreeNumber::decode(position, end, number)) return false;
+        value.value_.unsignedIntValue_ = (unsigned int) number;
+        return true;
+    case MockCallRecorder::LONG_INT:
+        return decodeSignedNumber(position, end, value.value_.longIntValue_);
+    case MockCallRecorder::UNSIGNED_LONG_INT:
+        return ZeroFreeNumber::decode(position, end, value.value_.unsignedLongIntValue_);
+#if CPPUTEST_USE_LONG_LONG
+    case MockCallRecorder::LONG_LONG_INT:
+        return decodeBytes(position, end, &value.value_.longLongIntValue_, sizeof(value.value_.longLongIntValue_));
+    case MockCallRecorder::UNSIGNED_LONG_LONG_INT:
+        return decodeBytes(position, end, &value.value_.unsignedLongLongIntValue_, sizeof(value.value_.unsignedLongLongIntValue_));
+#endif
+    case MockCallRecorder::DOUBLE:
+        return decodeBytes(position, end, &value.value_.doubleValue_, sizeof(value.value_.doubleValue_));
+    case MockCallRecorder::STRING_VALUE:
+        if (!ZeroFreeNumber::decode(position, end, number) || number >= (unsigned long) (end - position)) return false;
+        position[number] = '\0';
+        value.value_.stringValue_ = position;
+        position += number + 1;
+        return true;
+    case MockCallRecorder::MEMORY_BUFFER:
+        if (!ZeroFreeNumber::decode(position, end, number)) return false;
+        value.value_.memoryBufferValue_ = (const unsigned char*) position;
+        value.size_ = (size_t) number;
+        return decodeBytes(position, end, position, value.size_);
+    case MockCallRecorder::NOT_RECORDED:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void MockCallReplayer::addString(const char* text)
+{
+    if (stringCount_ == stringCapacity_) {
+        stringCapacity_ = (stringCapacity_ == 0) ? 16 : stringCapacity_ * 2;
+        const char** strings = new const char*[stringCapacity_];
+        for (unsigned long i = 0; i < stringCount_; i++)
+            strings[i] = strings_[i];
+        delete [] strings_;
+        strings_ = strings;
+    }
+    strings_[stringCount_++] = text;
+}
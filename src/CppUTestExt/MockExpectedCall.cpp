@@ -36,6 +36,21 @@ MockExpectedCall::~MockExpectedCall()
 {
 }
 
+MockExpectedCall& MockExpectedCall::withParameterSequenceOfType(const SimpleString&, const SimpleString&, const void*)
+{
+    return *this;
+}
+
+MockExpectedCall& MockExpectedCall::withArguments(const MockTypedValue&)
+{
+    return *this;
+}
+
+MockExpectedCall& MockExpectedCall::andReturnTypedValue(const MockTypedValue&)
+{
+    return *this;
+}
+
 SimpleString StringFrom(const MockNamedValue& parameter)
 {
     return parameter.toString();
@@ -43,40 +58,76 @@ SimpleString StringFrom(const MockNamedValue& parameter)
 
 void MockCheckedExpectedCall::setName(const SimpleString& name)
 {
-    functionName_ = name;
+    functionName_ = MockSymbolTable::symbolFor(name);
 }
 
 SimpleString MockCheckedExpectedCall::getName() const
+{
+    return MockSymbolTable::nameOf(functionName_);
+}
+
+MockSymbol MockCheckedExpectedCall::getFunctionNameSymbol() const
 {
     return functionName_;
 }
 
 MockCheckedExpectedCall::MockCheckedExpectedCall()
-    : ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
+    : functionName_(MockSymbolTable::EMPTY), parameterSequences_(NULLPTR), ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
       initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER), finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
-      outOfOrder_(false), returnValue_(""), objectPtr_(NULLPTR), isSpecificObjectExpected_(false), wasPassedToObject_(true),
-      actualCalls_(0), expectedCalls_(1)
+      outOfOrder_(false), returnValue_(""), arguments_(NULLPTR), argumentsMatchActualCall_(false), typedReturnValue_(NULLPTR),
+      objectPtr_(NULLPTR), isSpecificObjectExpected_(false), wasPassedToObject_(true), actualCalls_(0), expectedCalls_(1)
 {
     inputParameters_ = new MockNamedValueList();
     outputParameters_ = new MockNamedValueList();
 }
 
 MockCheckedExpectedCall::MockCheckedExpectedCall(unsigned int numCalls)
-    : ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
+    : functionName_(MockSymbolTable::EMPTY), parameterSequences_(NULLPTR), ignoreOtherParameters_(false), isActualCallMatchFinalized_(false),
       initialExpectedCallOrder_(NO_EXPECTED_CALL_ORDER), finalExpectedCallOrder_(NO_EXPECTED_CALL_ORDER),
-      outOfOrder_(false), returnValue_(""), objectPtr_(NULLPTR), isSpecificObjectExpected_(false), wasPassedToObject_(true),
-      actualCalls_(0), expectedCalls_(numCalls)
+      outOfOrder_(false), returnValue_(""), arguments_(NULLPTR), argumentsMatchActualCall_(false), typedReturnValue_(NULLPTR),
+      objectPtr_(NULLPTR), isSpecificObjectExpected_(false), wasPassedToObject_(true), actualCalls_(0), expectedCalls_(numCalls)
 {
     inputParameters_ = new MockNamedValueList();
     outputParameters_ = new MockNamedValueList();
 }
 
+struct MockCheckedExpectedCall::MockParameterSequence
+{
+    MockParameterSequence(MockNamedValue* parameter, MockSymbol type, const void* values, MockParameterSequence* next)
+        : parameter_(parameter), type_(type), values_(values), next_(next) {}
+
+    void moveTo(unsigned int index)
+    {
+        switch (type_) {
+        case MockSymbolTable::TYPE_INT: parameter_->setValue(((const int*) values_)[index]); break;
+        case MockSymbolTable::TYPE_UNSIGNED_INT: parameter_->setValue(((const unsigned int*) values_)[index]); break;
+        case MockSymbolTable::TYPE_LONG_INT: parameter_->setValue(((const long int*) values_)[index]); break;
+        case MockSymbolTable::TYPE_UNSIGNED_LONG_INT: parameter_->setValue(((const unsigned long int*) values_)[index]); break;
+        case MockSymbolTable::TYPE_DOUBLE: parameter_->setValue(((const double*) values_)[index]); break;
+        case MockSymbolTable::TYPE_CONST_CHAR_POINTER: parameter_->setValue(((const char* const*) values_)[index]); break;
+        default: parameter_->setValue(((const void* const*) values_)[index]); break;
+        }
+    }
+
+    MockNamedValue* parameter_;
+    MockSymbol type_;
+    const void* values_;
+    MockParameterSequence* next_;
+};
+
 MockCheckedExpectedCall::~MockCheckedExpectedCall()
 {
+    while (parameterSequences_) {
+        MockParameterSequence* next = parameterSequences_->next_;
+        delete parameterSequences_;
+        parameterSequences_ = next;
+    }
     inputParameters_->clear();
     delete inputParameters_;
     outputParameters_->clear();
     delete outputParameters_;
+    delete arguments_;
+    delete typedReturnValue_;
 }
 
 MockExpectedCall& MockCheckedExpectedCall::withName(const SimpleString& name)
@@ -85,6 +136,12 @@ MockExpectedCall& MockCheckedExpectedCall::withName(const SimpleString& name)
     return *this;
 }
 
+MockExpectedCall& MockCheckedExpectedCall::withNameSymbol(MockSymbol name)
+{
+    functionName_ = name;
+    return *this;
+}
+
 MockExpectedCall& MockCheckedExpectedCall::withBoolParameter(const SimpleString& name, bool value)
 {
     MockNamedValue* newParameter = new MockExpectedFunctionParameter(name);
@@ -223,6 +280,21 @@ MockExpectedCall& MockCheckedExpectedCall::withParameterOfType(const SimpleStrin
     return *this;
 }
 
+MockExpectedCall& MockCheckedExpectedCall::withParameterSequenceOfType(const SimpleString& typeName, const SimpleString& name, const void* values)
+{
+    MockNamedValue* newParameter = new MockExpectedFunctionParameter(name);
+    inputParameters_->add(newParameter);
+    parameterSequences_ = new MockParameterSequence(newParameter, MockSymbolTable::symbolFor(typeName), values, parameterSequences_);
+    parameterSequences_->moveTo(actualCalls_);
+    return *this;
+}
+
+void MockCheckedExpectedCall::moveParameterSequencesTo(unsigned int index)
+{
+    for (MockParameterSequence* p = parameterSequences_; p; p = p->next_)
+        p->moveTo(index);
+}
+
 MockExpectedCall& MockCheckedExpectedCall::withOutputParameterReturning(const SimpleString& name, const void* value, size_t size)
 {
     MockNamedValue* newParameter = new MockExpectedFunctionParameter(name);
@@ -275,6 +347,12 @@ MockNamedValue MockCheckedExpectedCall::getOutputParameter(const SimpleString& n
     return (p) ? *p : MockNamedValue("");
 }
 
+MockNamedValue MockCheckedExpectedCall::getOutputParameter(MockSymbol name)
+{
+    MockNamedValue * p = outputParameters_->getValueBySymbol(name);
+    return (p) ? *p : MockNamedValue("");
+}
+
 bool MockCheckedExpectedCall::areParametersMatchingActualCall()
 {
     MockNamedValueListNode* p;
@@ -284,9 +362,18 @@ bool MockCheckedExpectedCall::areParametersMatchingActualCall()
     for (p = outputParameters_->begin(); p; p = p->next())
         if (! item(p)->isMatchingActualCall())
             return false;
+    if (arguments_ && !argumentsMatchActualCall_)
+        return false;
     return true;
 }
 
+MockExpectedCall& MockCheckedExpectedCall::withArguments(const MockTypedValue& arguments)
+{
+    delete arguments_;
+    arguments_ = arguments.clone();
+    return *this;
+}
+
 MockExpectedCall& MockCheckedExpectedCall::ignoreOtherParameters()
 {
     ignoreOtherParameters_ = true;
@@ -317,6 +404,9 @@ void MockCheckedExpectedCall::callWasMade(unsigned int callOrder)
 {
     actualCalls_++;
 
+    if (actualCalls_ < expectedCalls_)
+        moveParameterSequencesTo(actualCalls_);
+
     if ( (initialExpectedCallOrder_ != NO_EXPECTED_CALL_ORDER) &&
          ((callOrder < initialExpectedCallOrder_) || (callOrder > finalExpectedCallOrder_)) ) {
         outOfOrder_ = true;
@@ -340,6 +430,7 @@ void MockCheckedExpectedCall::resetActualCallMatchingState()
 {
     wasPassedToObject_ = !isSpecificObjectExpected_;
     isActualCallMatchFinalized_ = false;
+    argumentsMatchActualCall_ = false;
 
     MockNamedValueListNode* p;
 
@@ -350,17 +441,32 @@ void MockCheckedExpectedCall::resetActualCallMatchingState()
 }
 
 void MockCheckedExpectedCall::inputParameterWasPassed(const SimpleString& name)
+{
+    inputParameterWasPassed(MockSymbolTable::symbolFor(name));
+}
+
+void MockCheckedExpectedCall::inputParameterWasPassed(MockSymbol name)
 {
     for (MockNamedValueListNode* p = inputParameters_->begin(); p; p = p->next()) {
-        if (p->getName() == name)
+        if (p->item()->getNameSymbol() == name)
             item(p)->setMatchesActualCall(true);
     }
 }
 
+void MockCheckedExpectedCall::argumentsWerePassed()
+{
+    argumentsMatchActualCall_ = true;
+}
+
 void MockCheckedExpectedCall::outputParameterWasPassed(const SimpleString& name)
+{
+    outputParameterWasPassed(MockSymbolTable::symbolFor(name));
+}
+
+void MockCheckedExpectedCall::outputParameterWasPassed(MockSymbol name)
 {
     for (MockNamedValueListNode* p = outputParameters_->begin(); p; p = p->next()) {
-        if (p->getName() == name)
+        if (p->item()->getNameSymbol() == name)
             item(p)->setMatchesActualCall(true);
     }
 }
@@ -373,16 +479,23 @@ SimpleString MockCheckedExpectedCall::getInputParameterValueString(const SimpleS
 
 bool MockCheckedExpectedCall::hasInputParameter(const MockNamedValue& parameter)
 {
-    MockNamedValue * p = inputParameters_->getValueByName(parameter.getName());
+    MockNamedValue * p = inputParameters_->getValueBySymbol(parameter.getNameSymbol());
     return (p) ? p->equals(parameter) : ignoreOtherParameters_;
 }
 
 bool MockCheckedExpectedCall::hasOutputParameter(const MockNamedValue& parameter)
 {
-    MockNamedValue * p = outputParameters_->getValueByName(parameter.getName());
+    MockNamedValue * p = outputParameters_->getValueBySymbol(parameter.getNameSymbol());
     return (p) ? p->compatibleForCopying(parameter) : ignoreOtherParameters_;
 }
 
+bool MockCheckedExpectedCall::hasArguments(const MockTypedValue& arguments)
+{
+    if (arguments_ == NULLPTR)
+        return ignoreOtherParameters_;
+    return (arguments_->signature() == arguments.signature()) && arguments_->equals(arguments);
+}
+
 SimpleString MockCheckedExpectedCall::callToString()
 {
     SimpleString str;
@@ -399,11 +512,16 @@ SimpleString MockCheckedExpectedCall::callToString()
         }
     }
 
-    if (inputParameters_->begin() == NULLPTR && outputParameters_->begin() == NULLPTR) {
+    if (inputParameters_->begin() == NULLPTR && outputParameters_->begin() == NULLPTR && arguments_ == NULLPTR) {
         str += (ignoreOtherParameters_) ? "all parameters ignored" : "no parameters";
     } else {
         MockNamedValueListNode* p;
 
+        if (arguments_) {
+            str += StringFromFormat("arguments: <%s>", arguments_->toString().asCharString());
+            if (inputParameters_->begin() || outputParameters_->begin()) str += ", ";
+        }
+
         for (p = inputParameters_->begin(); p; p = p->next()) {
             str += StringFromFormat("%s %s: <%s>", p->getType().asCharString(), p->getName().asCharString(), getInputParameterValueString(p->getName()).asCharString());
             if (p->next()) str += ", ";
@@ -423,6 +541,9 @@ SimpleString MockCheckedExpectedCall::callToString()
             str += ", other parameters are ignored";
     }
 
+    if (parameterSequences_ && actualCalls_ < expectedCalls_)
+        str += StringFromFormat(", sequence index <%u>", actualCalls_);
+
     str += StringFromFormat(" (expected %u call%s, called %u time%s)",
                             expectedCalls_, (expectedCalls_ == 1) ? "" : "s", actualCalls_, (actualCalls_ == 1) ? "" : "s" );
 
@@ -434,6 +555,9 @@ SimpleString MockCheckedExpectedCall::missingParametersToString()
     SimpleString str;
 	MockNamedValueListNode* p;
 
+    if (arguments_ && !argumentsMatchActualCall_)
+        str += "arguments";
+
     for (p = inputParameters_->begin(); p; p = p->next()) {
         if (! item(p)->isMatchingActualCall()) {
             if (str != "") str += ", ";
@@ -451,7 +575,7 @@ SimpleString MockCheckedExpectedCall::missingParametersToString()
 
 bool MockCheckedExpectedCall::relatesTo(const SimpleString& functionName)
 {
-    return functionName == getName();
+    return MockSymbolTable::symbolFor(functionName) == functionName_;
 }
 
 bool MockCheckedExpectedCall::relatesToObject(const void* objectPtr) const
@@ -581,6 +705,13 @@ MockExpectedCall& MockCheckedExpectedCall::andReturnValue(void (*value)())
     return *this;
 }
 
+MockExpectedCall& MockCheckedExpectedCall::andReturnTypedValue(const MockTypedValue& value)
+{
+    delete typedReturnValue_;
+    typedReturnValue_ = value.clone();
+    return *this;
+}
+
 MockExpectedCall& MockCheckedExpectedCall::onObject(void* objectPtr)
 {
     isSpecificObjectExpected_ = true;
@@ -594,6 +725,11 @@ MockNamedValue MockCheckedExpectedCall::returnValue()
     return returnValue_;
 }
 
+const MockTypedValue* MockCheckedExpectedCall::getTypedReturnValue() const
+{
+    return typedReturnValue_;
+}
+
 MockExpectedCall& MockCheckedExpectedCall::withCallOrder(unsigned int initialCallOrder, unsigned int finalCallOrder)
 {
     initialExpectedCallOrder_ = initialCallOrder;
@@ -29,19 +29,97 @@
 #include "CppUTestExt/MockExpectedCallsList.h"
 #include "CppUTestExt/MockCheckedExpectedCall.h"
 
-MockExpectedCallsList::MockExpectedCallsList() : head_(NULLPTR)
+struct MockExpectedCallsList::NameIndexEntry
+{
+    NameIndexEntry(MockSymbol name)
+        : name_(name), first_(NULLPTR), last_(NULLPTR), firstPending_(NULLPTR), nextInBucket_(NULLPTR) {}
+
+    MockSymbol name_;
+    MockExpectedCallsListNode* first_;
+    MockExpectedCallsListNode* last_;
+
+    /* Expectations never get matchable again, so the ones before this can be skipped */
+    MockExpectedCallsListNode* firstPending_;
+    NameIndexEntry* nextInBucket_;
+};
+
+struct MockExpectedCallsList::NameIndex : public MockSymbolBucketTable<NameIndexEntry, 64>
+{
+};
+
+MockExpectedCallsList::MockExpectedCallsList() : head_(NULLPTR), tail_(NULLPTR), unusedNodes_(NULLPTR), nameIndex_(NULLPTR)
 {
 }
 
 MockExpectedCallsList::~MockExpectedCallsList()
 {
-    while (head_) {
-        MockExpectedCallsListNode* next = head_->next_;
-        delete head_;
-        head_ = next;
+    removeAllExpectations();
+    deleteUnusedNodes();
+}
+
+MockExpectedCallsList::MockExpectedCallsListNode* MockExpectedCallsList::createNode(MockCheckedExpectedCall* call)
+{
+    if (unusedNodes_ == NULLPTR)
+        return new MockExpectedCallsListNode(call);
+
+    MockExpectedCallsListNode* node = unusedNodes_;
+    unusedNodes_ = node->next_;
+    node->expectedCall_ = call;
+    node->next_ = NULLPTR;
+    node->nextWithSameName_ = NULLPTR;
+    return node;
+}
+
+void MockExpectedCallsList::releaseNode(MockExpectedCallsListNode* node)
+{
+    node->next_ = unusedNodes_;
+    unusedNodes_ = node;
+}
+
+void MockExpectedCallsList::deleteUnusedNodes()
+{
+    while (unusedNodes_) {
+        MockExpectedCallsListNode* next = unusedNodes_->next_;
+        delete unusedNodes_;
+        unusedNodes_ = next;
     }
 }
 
+void MockExpectedCallsList::clearNameIndex() const
+{
+    delete nameIndex_;
+    nameIndex_ = NULLPTR;
+}
+
+void MockExpectedCallsList::addToNameIndex(MockExpectedCallsListNode* node) const
+{
+    MockSymbol name = node->expectedCall_->getFunctionNameSymbol();
+
+    NameIndexEntry* entry = nameIndex_->find(name);
+    if (entry == NULLPTR)
+        entry = nameIndex_->add(new NameIndexEntry(name));
+
+    node->nextWithSameName_ = NULLPTR;
+    if (entry->last_)
+        entry->last_->nextWithSameName_ = node;
+    else
+        entry->first_ = node;
+    entry->last_ = node;
+    if (entry->firstPending_ == NULLPTR)
+        entry->firstPending_ = node;
+}
+
+MockExpectedCallsList::NameIndexEntry* MockExpectedCallsList::findNameIndexEntry(MockSymbol name) const
+{
+    if (nameIndex_ == NULLPTR) {
+        nameIndex_ = new NameIndex;
+        for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
+            addToNameIndex(p);
+    }
+
+    return nameIndex_->find(name);
+}
+
 bool MockExpectedCallsList::hasCallsOutOfOrder() const
 {
     for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
@@ -66,11 +144,9 @@ bool MockExpectedCallsList::isEmpty() const
 unsigned int MockExpectedCallsList::amountOfActualCallsFulfilledFor(const SimpleString& name) const
 {
     unsigned int count = 0;
-    for (MockExpectedCallsListNode* p = head_; p; p = p->next_) {
-        if (p->expectedCall_->relatesTo(name)) {
-            count += p->expectedCall_->getActualCallsFulfilled();
-        }
-    }
+    NameIndexEntry* entry = findNameIndexEntry(MockSymbolTable::symbolFor(name));
+    for (MockExpectedCallsListNode* p = entry ? entry->first_ : NULLPTR; p; p = p->nextWithSameName_)
+        count += p->expectedCall_->getActualCallsFulfilled();
     return count;
 }
 
@@ -104,23 +180,35 @@ bool MockExpectedCallsList::hasUnfulfilledExpectations() const
 
 bool MockExpectedCallsList::hasExpectationWithName(const SimpleString& name) const
 {
-        for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
-            if (p->expectedCall_->relatesTo(name))
-                return true;
+    return hasExpectationWithSymbol(MockSymbolTable::symbolFor(name));
+}
+
+bool MockExpectedCallsList::hasExpectationWithSymbol(MockSymbol name) const
+{
+    return findNameIndexEntry(name) != NULLPTR;
+}
+
+bool MockExpectedCallsList::hasExpectationThatCanMatchSymbol(MockSymbol name) const
+{
+    NameIndexEntry* entry = findNameIndexEntry(name);
+    for (MockExpectedCallsListNode* p = entry ? entry->firstPending_ : NULLPTR; p; p = p->nextWithSameName_)
+        if (p->expectedCall_->canMatchActualCalls())
+            return true;
     return false;
 }
 
 void MockExpectedCallsList::addExpectedCall(MockCheckedExpectedCall* call)
 {
-    MockExpectedCallsListNode* newCall = new MockExpectedCallsListNode(call);
+    MockExpectedCallsListNode* newCall = createNode(call);
 
     if (head_ == NULLPTR)
         head_ = newCall;
-    else {
-        MockExpectedCallsListNode* lastCall = head_;
-        while (lastCall->next_) lastCall = lastCall->next_;
-        lastCall->next_ = newCall;
-    }
+    else
+        tail_->next_ = newCall;
+    tail_ = newCall;
+
+    if (nameIndex_)
+        addToNameIndex(newCall);
 }
 
 void MockExpectedCallsList::addPotentiallyMatchingExpectations(const MockExpectedCallsList& list)
@@ -130,13 +218,31 @@ void MockExpectedCallsList::addPotentiallyMatchingExpectations(const MockExpecte
             addExpectedCall(p->expectedCall_);
 }
 
-void MockExpectedCallsList::addExpectationsRelatedTo(const SimpleString& name, const MockExpectedCallsList& list)
+void MockExpectedCallsList::addPotentiallyMatchingExpectationsRelatedTo(const SimpleString& name, const MockExpectedCallsList& list)
 {
-    for (MockExpectedCallsListNode* p = list.head_; p; p = p->next_)
-        if (p->expectedCall_->relatesTo(name))
+    addPotentiallyMatchingExpectationsRelatedToSymbol(MockSymbolTable::symbolFor(name), list);
+}
+
+void MockExpectedCallsList::addPotentiallyMatchingExpectationsRelatedToSymbol(MockSymbol name, const MockExpectedCallsList& list)
+{
+    NameIndexEntry* entry = list.findNameIndexEntry(name);
+    if (entry == NULLPTR) return;
+
+    while (entry->firstPending_ && !entry->firstPending_->expectedCall_->canMatchActualCalls())
+        entry->firstPending_ = entry->firstPending_->nextWithSameName_;
+
+    for (MockExpectedCallsListNode* p = entry->firstPending_; p; p = p->nextWithSameName_)
+        if (p->expectedCall_->canMatchActualCalls())
             addExpectedCall(p->expectedCall_);
 }
 
+void MockExpectedCallsList::addExpectationsRelatedTo(const SimpleString& name, const MockExpectedCallsList& list)
+{
+    NameIndexEntry* entry = list.findNameIndexEntry(MockSymbolTable::symbolFor(name));
+    for (MockExpectedCallsListNode* p = entry ? entry->first_ : NULLPTR; p; p = p->nextWithSameName_)
+        addExpectedCall(p->expectedCall_);
+}
+
 void MockExpectedCallsList::addExpectations(const MockExpectedCallsList& list)
 {
     for (MockExpectedCallsListNode* p = list.head_; p; p = p->next_)
@@ -196,6 +302,14 @@ void MockExpectedCallsList::onlyKeepExpectationsWithInputParameter(const MockNam
     pruneEmptyNodeFromList();
 }
 
+void MockExpectedCallsList::onlyKeepExpectationsWithArguments(const MockTypedValue& arguments)
+{
+    for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
+        if (! p->expectedCall_->hasArguments(arguments))
+            p->expectedCall_ = NULLPTR;
+    pruneEmptyNodeFromList();
+}
+
 void MockExpectedCallsList::onlyKeepExpectationsWithOutputParameter(const MockNamedValue& parameter)
 {
     for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
@@ -256,28 +370,44 @@ void MockExpectedCallsList::pruneEmptyNodeFromList()
 
     while (current) {
         if (current->expectedCall_ == NULLPTR) {
+            clearNameIndex();
             toBeDeleted = current;
             if (previous == NULLPTR)
                 head_ = current = current->next_;
             else
                 current = previous->next_ = current->next_;
-            delete toBeDeleted;
+            releaseNode(toBeDeleted);
         }
         else {
             previous = current;
             current = current->next_;
         }
     }
+    tail_ = previous;
 }
 
 void MockExpectedCallsList::deleteAllExpectationsAndClearList()
 {
+    clearNameIndex();
+    tail_ = NULLPTR;
     while (head_) {
         MockExpectedCallsListNode* next = head_->next_;
         delete head_->expectedCall_;
         delete head_;
         head_ = next;
     }
+    deleteUnusedNodes();
+}
+
+void MockExpectedCallsList::removeAllExpectations()
+{
+    clearNameIndex();
+    tail_ = NULLPTR;
+    while (head_) {
+        MockExpectedCallsListNode* next = head_->next_;
+        releaseNode(head_);
+        head_ = next;
+    }
 }
 
 void MockExpectedCallsList::resetActualCallMatchingState()
@@ -293,18 +423,24 @@ void MockExpectedCallsList::wasPassedToObject()
 }
 
 
-void MockExpectedCallsList::parameterWasPassed(const SimpleString& parameterName)
+void MockExpectedCallsList::parameterWasPassed(MockSymbol parameterName)
 {
     for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
         p->expectedCall_->inputParameterWasPassed(parameterName);
 }
 
-void MockExpectedCallsList::outputParameterWasPassed(const SimpleString& parameterName)
+void MockExpectedCallsList::outputParameterWasPassed(MockSymbol parameterName)
 {
     for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
         p->expectedCall_->outputParameterWasPassed(parameterName);
 }
 
+void MockExpectedCallsList::argumentsWerePassed()
+{
+    for (MockExpectedCallsListNode* p = head_; p; p = p->next_)
+        p->expectedCall_->argumentsWerePassed();
+}
+
 static SimpleString stringOrNoneTextWhenEmpty(const SimpleString& inputString, const SimpleString& linePrefix)
 {
     SimpleString str = inputString;
@@ -164,6 +164,26 @@ MockUnexpectedInputParameterFailure::MockUnexpectedInputParameterFailure(UtestSh
     message_ += ">";
 }
 
+MockUnexpectedArgumentsFailure::MockUnexpectedArgumentsFailure(UtestShell* test, const SimpleString& functionName, const MockTypedValue& arguments, const MockExpectedCallsList& expectations)  : MockFailure(test)
+{
+    message_ = "Mock Failure: Unexpected arguments to function \"";
+    message_ += functionName;
+    message_ += "\": <";
+    message_ += arguments.toString();
+    message_ += ">";
+
+    message_ += "\n";
+    addExpectationsAndCallHistoryRelatedTo(functionName, expectations);
+
+    message_ += "\n\tACTUAL unexpected arguments passed to function: ";
+    message_ += functionName;
+    message_ += "\n";
+
+    message_ += "\t\t<";
+    message_ += arguments.toString();
+    message_ += ">";
+}
+
 MockUnexpectedOutputParameterFailure::MockUnexpectedOutputParameterFailure(UtestShell* test, const SimpleString& functionName, const MockNamedValue& parameter, const MockExpectedCallsList& expectations)  : MockFailure(test)
 {
     MockExpectedCallsList expectationsForFunctionWithParameterName;
@@ -43,7 +43,7 @@ MockNamedValueComparatorsAndCopiersRepository* MockNamedValue::getDefaultCompara
     return defaultRepository_;
 }
 
-MockNamedValue::MockNamedValue(const SimpleString& name) : name_(name), type_("int"), size_(0), comparator_(NULLPTR), copier_(NULLPTR)
+MockNamedValue::MockNamedValue(const SimpleString& name) : nameSymbol_(MockSymbolTable::symbolFor(name)), typeSymbol_(MockSymbolTable::TYPE_INT), size_(0), comparator_(NULLPTR), copier_(NULLPTR)
 {
     value_.intValue_ = 0;
 }
@@ -54,31 +54,31 @@ MockNamedValue::~MockNamedValue()
 
 void MockNamedValue::setValue(bool value)
 {
-    type_ = "bool";
+    typeSymbol_ = MockSymbolTable::TYPE_BOOL;
     value_.boolValue_ = value;
 }
 
 void MockNamedValue::setValue(unsigned int value)
 {
-    type_ = "unsigned int";
+    typeSymbol_ = MockSymbolTable::TYPE_UNSIGNED_INT;
     value_.unsignedIntValue_ = value;
 }
 
 void MockNamedValue::setValue(int value)
 {
-    type_ = "int";
+    typeSymbol_ = MockSymbolTable::TYPE_INT;
     value_.intValue_ = value;
 }
 
 void MockNamedValue::setValue(long int value)
 {
-    type_ = "long int";
+    typeSymbol_ = MockSymbolTable::TYPE_LONG_INT;
     value_.longIntValue_ = value;
 }
 
 void MockNamedValue::setValue(unsigned long int value)
 {
-    type_ = "unsigned long int";
+    typeSymbol_ = MockSymbolTable::TYPE_UNSIGNED_LONG_INT;
     value_.unsignedLongIntValue_ = value;
 }
 
@@ -86,13 +86,13 @@ void MockNamedValue::setValue(unsigned long int value)
 
 void MockNamedValue::setValue(cpputest_longlong value)
 {
-    type_ = "long long int";
+    typeSymbol_ = MockSymbolTable::TYPE_LONG_LONG_INT;
     value_.longLongIntValue_ = value;
 }
 
 void MockNamedValue::setValue(cpputest_ulonglong value)
 {
-    type_ = "unsigned long long int";
+    typeSymbol_ = MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT;
     value_.unsignedLongLongIntValue_ = value;
 }
 
@@ -117,61 +117,61 @@ void MockNamedValue::setValue(double value)
 
 void MockNamedValue::setValue(double value, double tolerance)
 {
-    type_ = "double";
+    typeSymbol_ = MockSymbolTable::TYPE_DOUBLE;
     value_.doubleValue_.value = value;
     value_.doubleValue_.tolerance = tolerance;
 }
 
 void MockNamedValue::setValue(void* value)
 {
-    type_ = "void*";
+    typeSymbol_ = MockSymbolTable::TYPE_VOID_POINTER;
     value_.pointerValue_ = value;
 }
 
 void MockNamedValue::setValue(const void* value)
 {
-    type_ = "const void*";
+    typeSymbol_ = MockSymbolTable::TYPE_CONST_VOID_POINTER;
     value_.constPointerValue_ = value;
 }
 
 void MockNamedValue::setValue(void (*value)())
 {
-    type_ = "void (*)()";
+    typeSymbol_ = MockSymbolTable::TYPE_FUNCTION_POINTER;
     value_.functionPointerValue_ = value;
 }
 
 void MockNamedValue::setValue(const char* value)
 {
-    type_ = "const char*";
+    typeSymbol_ = MockSymbolTable::TYPE_CONST_CHAR_POINTER;
     value_.stringValue_ = value;
 }
 
 void MockNamedValue::setMemoryBuffer(const unsigned char* value, size_t size)
 {
-    type_ = "const unsigned char*";
+    typeSymbol_ = MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER;
     value_.memoryBufferValue_ = value;
     size_ = size;
 }
 
 void MockNamedValue::setConstObjectPointer(const SimpleString& type, const void* objectPtr)
 {
-    type_ = type;
+    typeSymbol_ = MockSymbolTable::symbolFor(type);
     value_.constObjectPointerValue_ = objectPtr;
     if (defaultRepository_)
     {
-        comparator_ = defaultRepository_->getComparatorForType(type);
-        copier_ = defaultRepository_->getCopierForType(type);
+        comparator_ = defaultRepository_->getComparatorForSymbol(typeSymbol_);
+        copier_ = defaultRepository_->getCopierForSymbol(typeSymbol_);
     }
 }
 
 void MockNamedValue::setObjectPointer(const SimpleString& type, void* objectPtr)
 {
-    type_ = type;
+    typeSymbol_ = MockSymbolTable::symbolFor(type);
     value_.objectPointerValue_ = objectPtr;
     if (defaultRepository_)
     {
-        comparator_ = defaultRepository_->getComparatorForType(type);
-        copier_ = defaultRepository_->getCopierForType(type);
+        comparator_ = defaultRepository_->getComparatorForSymbol(typeSymbol_);
+        copier_ = defaultRepository_->getCopierForSymbol(typeSymbol_);
     }
 }
 
@@ -182,66 +182,76 @@ void MockNamedValue::setSize(size_t size)
 
 void MockNamedValue::setName(const char* name)
 {
-    name_ = name;
+    nameSymbol_ = MockSymbolTable::symbolFor(name);
 }
 
 SimpleString MockNamedValue::getName() const
 {
-    return name_;
+    return MockSymbolTable::nameOf(nameSymbol_);
 }
 
 SimpleString MockNamedValue::getType() const
 {
-    return type_;
+    return MockSymbolTable::nameOf(typeSymbol_);
+}
+
+MockSymbol MockNamedValue::getNameSymbol() const
+{
+    return nameSymbol_;
+}
+
+MockSymbol MockNamedValue::getTypeSymbol() const
+{
+    return typeSymbol_;
 }
 
 bool MockNamedValue::getBoolValue() const
 {
-    STRCMP_EQUAL("bool", type_.asCharString());
+    STRCMP_EQUAL("bool", MockSymbolTable::nameOf(typeSymbol_));
     return value_.boolValue_;
 }
 
 unsigned int MockNamedValue::getUnsignedIntValue() const
 {
-    if(type_ == "int" && value_.intValue_ >= 0)
+    if(typeSymbol_ == MockSymbolTable::TYPE_INT && value_.intValue_ >= 0)
         return (unsigned int)value_.intValue_;
     else
     {
-        STRCMP_EQUAL("unsigned int", type_.asCharString());
+        STRCMP_EQUAL("unsigned int", MockSymbolTable::nameOf(typeSymbol_));
         return value_.unsignedIntValue_;
     }
 }
 
 int MockNamedValue::getIntValue() const
 {
-    STRCMP_EQUAL("int", type_.asCharString());
+    STRCMP_EQUAL("int", MockSymbolTable::nameOf(typeSymbol_));
     return value_.intValue_;
 }
 
 long int MockNamedValue::getLongIntValue() const
 {
-    if(type_ == "int")
+    if(typeSymbol_ == MockSymbolTable::TYPE_INT)
         return value_.intValue_;
-    else if(type_ == "unsigned int")
+    else if(typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT)
         return (long int)value_.unsignedIntValue_;
     else
     {
-        STRCMP_EQUAL("long int", type_.asCharString());
+        STRCMP_EQUAL("long int", MockSymbolTable::nameOf(typeSymbol_));
         return value_.longIntValue_;
     }
 }
 
 unsigned long int MockNamedValue::getUnsignedLongIntValue() const
 {
-    if(type_ == "unsigned int")
+    if(typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT)
         return value_.unsignedIntValue_;
-    else if(type_ == "int" && value_.intValue_ >= 0)
+    else if(typeSymbol_ == MockSymbolTable::TYPE_INT && value_.intValue_ >= 0)
         return (unsigned long int)value_.intValue_;
-    else if(type_ == "long int" && value_.longIntValue_ >= 0)
+    else if(typeSymbol_ == MockSymbolTable::TYPE_LONG_INT && value_.longIntValue_ >= 0)
         return (unsigned long int)value_.longIntValue_;
     else
     {
-        STRCMP_EQUAL("unsigned long int", type_.asCharString());
+        STRCMP_EQUAL("unsigned long int", MockSymbolTable::nameOf(typeSymbol_));
         return value_.unsignedLongIntValue_;
     }
 }
@@ -250,36 +260,36 @@ unsigned long int MockNamedValue::getUnsignedLongIntValue() const
 
 cpputest_longlong MockNamedValue::getLongLongIntValue() const
 {
-    if(type_ == "int")
+    if(typeSymbol_ == MockSymbolTable::TYPE_INT)
         return value_.intValue_;
-    else if(type_ == "unsigned int")
+    else if(typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT)
         return (long long int)value_.unsignedIntValue_;
-    else if(type_ == "long int")
+    else if(typeSymbol_ == MockSymbolTable::TYPE_LONG_INT)
         return value_.longIntValue_;
-    else if(type_ == "unsigned long int")
+    else if(typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT)
         return (long long int)value_.unsignedLongIntValue_;
     else
     {
-        STRCMP_EQUAL("long long int", type_.asCharString());
+        STRCMP_EQUAL("long long int", MockSymbolTable::nameOf(typeSymbol_));
         return value_.longLongIntValue_;
     }
 }
 
 cpputest_ulonglong MockNamedValue::getUnsignedLongLongIntValue() const
 {
-    if(type_ == "unsigned int")
+    if(typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT)
         return value_.unsignedIntValue_;
-    else if(type_ == "int" && value_.intValue_ >= 0)
+    else if(typeSymbol_ == MockSymbolTable::TYPE_INT && value_.intValue_ >= 0)
         return (unsigned long long int)value_.intValue_;
-    else if(type_ == "long int" && value_.longIntValue_ >= 0)
+    else if(typeSymbol_ == MockSymbolTable::TYPE_LONG_INT && value_.longIntValue_ >= 0)
         return (unsigned long long int)value_.longIntValue_;
-    else if(type_ == "unsigned long int")
+    else if(typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT)
         return value_.unsignedLongIntValue_;
-    else if(type_ == "long long int" && value_.longLongIntValue_ >= 0)
+    else if(typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT && value_.longLongIntValue_ >= 0)
         return (unsigned long long int)value_.longLongIntValue_;
     else
     {
-        STRCMP_EQUAL("unsigned long long int", type_.asCharString());
+        STRCMP_EQUAL("unsigned long long int", MockSymbolTable::nameOf(typeSymbol_));
         return value_.unsignedLongLongIntValue_;
     }
 }
@@ -304,43 +314,43 @@ cpputest_ulonglong MockNamedValue::getUnsignedLongLongIntValue() const
 
 double MockNamedValue::getDoubleValue() const
 {
-    STRCMP_EQUAL("double", type_.asCharString());
+    STRCMP_EQUAL("double", MockSymbolTable::nameOf(typeSymbol_));
     return value_.doubleValue_.value;
 }
 
 double MockNamedValue::getDoubleTolerance() const
 {
-    STRCMP_EQUAL("double", type_.asCharString());
+    STRCMP_EQUAL("double", MockSymbolTable::nameOf(typeSymbol_));
     return value_.doubleValue_.tolerance;
 }
 
 const char* MockNamedValue::getStringValue() const
 {
-    STRCMP_EQUAL("const char*", type_.asCharString());
+    STRCMP_EQUAL("const char*", MockSymbolTable::nameOf(typeSymbol_));
     return value_.stringValue_;
 }
 
 void* MockNamedValue::getPointerValue() const
 {
-    STRCMP_EQUAL("void*", type_.asCharString());
+    STRCMP_EQUAL("void*", MockSymbolTable::nameOf(typeSymbol_));
     return value_.pointerValue_;
 }
 
 const void* MockNamedValue::getConstPointerValue() const
 {
-    STRCMP_EQUAL("const void*", type_.asCharString());
+    STRCMP_EQUAL("const void*", MockSymbolTable::nameOf(typeSymbol_));
     return value_.pointerValue_;
 }
 
 void (*MockNamedValue::getFunctionPointerValue() const)()
 {
-    STRCMP_EQUAL("void (*)()", type_.asCharString());
+    STRCMP_EQUAL("void (*)()", MockSymbolTable::nameOf(typeSymbol_));
     return value_.functionPointerValue_;
 }
 
 const unsigned char* MockNamedValue::getMemoryBuffer() const
 {
-    STRCMP_EQUAL("const unsigned char*", type_.asCharString());
+    STRCMP_EQUAL("const unsigned char*", MockSymbolTable::nameOf(typeSymbol_));
     return value_.memoryBufferValue_;
 }
 
@@ -371,98 +381,98 @@ MockNamedValueCopier* MockNamedValue::getCopier() const
 
 bool MockNamedValue::equals(const MockNamedValue& p) const
 {
-    if((type_ == "long int") && (p.type_ == "int"))
+    if((typeSymbol_ == MockSymbolTable::TYPE_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_INT))
         return value_.longIntValue_ == p.value_.intValue_;
-    else if((type_ == "int") && (p.type_ == "long int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_INT))
         return value_.intValue_ == p.value_.longIntValue_;
-    else if((type_ == "unsigned int") && (p.type_ == "int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_INT))
         return (p.value_.intValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned int)p.value_.intValue_);
-    else if((type_ == "int") && (p.type_ == "unsigned int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT))
         return (value_.intValue_ >= 0) && ((unsigned int)value_.intValue_ == p.value_.unsignedIntValue_);
-    else if((type_ == "unsigned long int") && (p.type_ == "int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_INT))
         return (p.value_.intValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long)p.value_.intValue_);
-    else if((type_ == "int") && (p.type_ == "unsigned long int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT))
         return (value_.intValue_ >= 0) && ((unsigned long)value_.intValue_ == p.value_.unsignedLongIntValue_);
-    else if((type_ == "unsigned int") && (p.type_ == "long int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_INT))
         return (p.value_.longIntValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned long)p.value_.longIntValue_);
-    else if((type_ == "long int") && (p.type_ == "unsigned int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT))
         return (value_.longIntValue_ >= 0) && ((unsigned long)value_.longIntValue_ == p.value_.unsignedIntValue_);
-    else if((type_ == "unsigned int") && (p.type_ == "unsigned long int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT))
         return value_.unsignedIntValue_ == p.value_.unsignedLongIntValue_;
-    else if((type_ == "unsigned long int") && (p.type_ == "unsigned int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT))
         return value_.unsignedLongIntValue_ == p.value_.unsignedIntValue_;
-    else if((type_ == "long int") && (p.type_ == "unsigned long int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT))
         return (value_.longIntValue_ >= 0) && ((unsigned long)value_.longIntValue_ == p.value_.unsignedLongIntValue_);
-    else if((type_ == "unsigned long int") && (p.type_ == "long int"))
+    else if((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_INT))
         return (p.value_.longIntValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long) p.value_.longIntValue_);
 #if CPPUTEST_USE_LONG_LONG
-    else if ((type_ == "long long int") && (p.type_ == "int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_INT))
         return value_.longLongIntValue_ == p.value_.intValue_;
-    else if ((type_ == "int") && (p.type_ == "long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT))
         return value_.intValue_ == p.value_.longLongIntValue_;
-    else if ((type_ == "long long int") && (p.type_ == "long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_INT))
         return value_.longLongIntValue_ == p.value_.longIntValue_;
-    else if ((type_ == "long int") && (p.type_ == "long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT))
         return value_.longIntValue_ == p.value_.longLongIntValue_;
-    else if ((type_ == "long long int") && (p.type_ == "unsigned int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT))
         return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedIntValue_);
-    else if ((type_ == "unsigned int") && (p.type_ == "long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT))
         return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
-    else if ((type_ == "long long int") && (p.type_ == "unsigned long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT))
         return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedLongIntValue_);
-    else if ((type_ == "unsigned long int") && (p.type_ == "long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT))
         return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedLongIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
-    else if ((type_ == "long long int") && (p.type_ == "unsigned long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT))
         return (value_.longLongIntValue_ >= 0) && ((unsigned long long)value_.longLongIntValue_ == p.value_.unsignedLongLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT))
         return (p.value_.longLongIntValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.longLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_INT))
         return (p.value_.intValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.intValue_);
-    else if ((type_ == "int") && (p.type_ == "unsigned long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT))
         return (value_.intValue_ >= 0) && ((unsigned long long)value_.intValue_ == p.value_.unsignedLongLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "unsigned int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT))
         return value_.unsignedLongLongIntValue_ == p.value_.unsignedIntValue_;
-    else if ((type_ == "unsigned int") && (p.type_ == "unsigned long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT))
         return value_.unsignedIntValue_ == p.value_.unsignedLongLongIntValue_;
-    else if ((type_ == "unsigned long long int") && (p.type_ == "long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_LONG_INT))
         return (p.value_.longIntValue_ >= 0) && (value_.unsignedLongLongIntValue_ == (unsigned long long)p.value_.longIntValue_);
-    else if ((type_ == "long int") && (p.type_ == "unsigned long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT))
         return (value_.longIntValue_ >= 0) && ((unsigned long long)value_.longIntValue_ == p.value_.unsignedLongLongIntValue_);
-    else if ((type_ == "unsigned long long int") && (p.type_ == "unsigned long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT))
         return value_.unsignedLongLongIntValue_ == p.value_.unsignedLongIntValue_;
-    else if ((type_ == "unsigned long int") && (p.type_ == "unsigned long long int"))
+    else if ((typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT) && (p.typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT))
         return value_.unsignedLongIntValue_ == p.value_.unsignedLongLongIntValue_;
 #endif
 
-    if (type_ != p.type_) return false;
+    if (typeSymbol_ != p.typeSymbol_) return false;
 
-    if (type_ == "bool")
+    if (typeSymbol_ == MockSymbolTable::TYPE_BOOL)
         return value_.boolValue_ == p.value_.boolValue_;
-    else if (type_ == "int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_INT)
         return value_.intValue_ == p.value_.intValue_;
-    else if (type_ == "unsigned int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT)
         return value_.unsignedIntValue_ == p.value_.unsignedIntValue_;
-    else if (type_ == "long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_LONG_INT)
         return value_.longIntValue_ == p.value_.longIntValue_;
-    else if (type_ == "unsigned long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT)
         return value_.unsignedLongIntValue_ == p.value_.unsignedLongIntValue_;
 #if CPPUTEST_USE_LONG_LONG
-    else if (type_ == "long long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT)
         return value_.longLongIntValue_ == p.value_.longLongIntValue_;
-    else if (type_ == "unsigned long long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT)
         return value_.unsignedLongLongIntValue_ == p.value_.unsignedLongLongIntValue_;
 #endif
-    else if (type_ == "const char*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_CONST_CHAR_POINTER)
         return SimpleString(value_.stringValue_) == SimpleString(p.value_.stringValue_);
-    else if (type_ == "void*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_VOID_POINTER)
         return value_.pointerValue_ == p.value_.pointerValue_;
-    else if (type_ == "const void*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_CONST_VOID_POINTER)
         return value_.constPointerValue_ == p.value_.constPointerValue_;
-    else if (type_ == "void (*)()")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_FUNCTION_POINTER)
         return value_.functionPointerValue_ == p.value_.functionPointerValue_;
-    else if (type_ == "double")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_DOUBLE)
         return (doubles_equal(value_.doubleValue_.value, p.value_.doubleValue_.value, value_.doubleValue_.tolerance));
-    else if (type_ == "const unsigned char*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER)
     {
         if (size_ != p.size_) {
             return false;
@@ -478,9 +488,9 @@ bool MockNamedValue::equals(const MockNamedValue& p) const
 
 bool MockNamedValue::compatibleForCopying(const MockNamedValue& p) const
 {
-    if (type_ == p.type_) return true;
+    if (typeSymbol_ == p.typeSymbol_) return true;
 
-    if ((type_ == "const void*") && (p.type_ == "void*"))
+    if ((typeSymbol_ == MockSymbolTable::TYPE_CONST_VOID_POINTER) && (p.typeSymbol_ == MockSymbolTable::TYPE_VOID_POINTER))
         return true;
 
     return false;
@@ -488,39 +498,39 @@ bool MockNamedValue::compatibleForCopying(const MockNamedValue& p) const
 
 SimpleString MockNamedValue::toString() const
 {
-    if (type_ == "bool")
+    if (typeSymbol_ == MockSymbolTable::TYPE_BOOL)
         return StringFrom(value_.boolValue_);
-    else if (type_ == "int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_INT)
         return StringFrom(value_.intValue_) + " " + BracketsFormattedHexStringFrom(value_.intValue_);
-    else if (type_ == "unsigned int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_INT)
         return StringFrom(value_.unsignedIntValue_) + " " + BracketsFormattedHexStringFrom(value_.unsignedIntValue_);
-    else if (type_ == "long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_LONG_INT)
         return StringFrom(value_.longIntValue_) + " " + BracketsFormattedHexStringFrom(value_.longIntValue_);
-    else if (type_ == "unsigned long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_INT)
         return StringFrom(value_.unsignedLongIntValue_) + " " + BracketsFormattedHexStringFrom(value_.unsignedLongIntValue_);
 #if CPPUTEST_USE_LONG_LONG
-    else if (type_ == "long long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_LONG_LONG_INT)
         return StringFrom(value_.longLongIntValue_) + " " + BracketsFormattedHexStringFrom(value_.longLongIntValue_);
-    else if (type_ == "unsigned long long int")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_UNSIGNED_LONG_LONG_INT)
         return StringFrom(value_.unsignedLongLongIntValue_) + " " + BracketsFormattedHexStringFrom(value_.unsignedLongLongIntValue_);
 #endif
-    else if (type_ == "const char*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_CONST_CHAR_POINTER)
         return value_.stringValue_;
-    else if (type_ == "void*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_VOID_POINTER)
         return StringFrom(value_.pointerValue_);
-    else if (type_ == "void (*)()")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_FUNCTION_POINTER)
         return StringFrom(value_.functionPointerValue_);
-    else if (type_ == "const void*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_CONST_VOID_POINTER)
         return StringFrom(value_.constPointerValue_);
-    else if (type_ == "double")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_DOUBLE)
         return StringFrom(value_.doubleValue_.value);
-    else if (type_ == "const unsigned char*")
+    else if (typeSymbol_ == MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER)
         return StringFromBinaryWithSizeOrNull(value_.memoryBufferValue_, size_);
 
     if (comparator_)
         return comparator_->valueToString(value_.constObjectPointerValue_);
 
-    return StringFromFormat("No comparator found for type: \"%s\"", type_.asCharString());
+    return StringFromFormat("No comparator found for type: \"%s\"", MockSymbolTable::nameOf(typeSymbol_));
 
 }
 
@@ -586,9 +596,14 @@ void MockNamedValueList::add(MockNamedValue* newValue)
 }
 
 MockNamedValue* MockNamedValueList::getValueByName(const SimpleString& name)
+{
+    return getValueBySymbol(MockSymbolTable::symbolFor(name));
+}
+
+MockNamedValue* MockNamedValueList::getValueBySymbol(MockSymbol name)
 {
     for (MockNamedValueListNode * p = head_; p; p = p->next())
-        if (p->getName() == name)
+        if (p->item()->getNameSymbol() == name)
             return p->item();
     return NULLPTR;
 }
@@ -600,21 +615,16 @@ MockNamedValueListNode* MockNamedValueList::begin()
 
 struct MockNamedValueComparatorsAndCopiersRepositoryNode
 {
-    MockNamedValueComparatorsAndCopiersRepositoryNode(const SimpleString& name, MockNamedValueComparator* comparator, MockNamedValueComparatorsAndCopiersRepositoryNode* next)
-        : name_(name), comparator_(comparator), copier_(NULLPTR), next_(next) {}
-    MockNamedValueComparatorsAndCopiersRepositoryNode(const SimpleString& name, MockNamedValueCopier* copier, MockNamedValueComparatorsAndCopiersRepositoryNode* next)
-        : name_(name), comparator_(NULLPTR), copier_(copier), next_(next) {}
-    MockNamedValueComparatorsAndCopiersRepositoryNode(const SimpleString& name, MockNamedValueComparator* comparator, MockNamedValueCopier* copier, MockNamedValueComparatorsAndCopiersRepositoryNode* next)
-        : name_(name), comparator_(comparator), copier_(copier), next_(next) {}
-    SimpleString name_;
+    MockNamedValueComparatorsAndCopiersRepositoryNode(MockSymbol type)
+        : name_(type), comparator_(NULLPTR), copier_(NULLPTR), nextInBucket_(NULLPTR) {}
+    MockSymbol name_;
     MockNamedValueComparator* comparator_;
     MockNamedValueCopier* copier_;
-    MockNamedValueComparatorsAndCopiersRepositoryNode* next_;
+    MockNamedValueComparatorsAndCopiersRepositoryNode* nextInBucket_;
 };
 
-MockNamedValueComparatorsAndCopiersRepository::MockNamedValueComparatorsAndCopiersRepository() : head_(NULLPTR)
+MockNamedValueComparatorsAndCopiersRepository::MockNamedValueComparatorsAndCopiersRepository()
 {
-
 }
 
 MockNamedValueComparatorsAndCopiersRepository::~MockNamedValueComparatorsAndCopiersRepository()
@@ -624,39 +634,61 @@ MockNamedValueComparatorsAndCopiersRepository::~MockNamedValueComparatorsAndCopi
 
 void MockNamedValueComparatorsAndCopiersRepository::clear()
 {
-    while (head_) {
-        MockNamedValueComparatorsAndCopiersRepositoryNode* next = head_->next_;
-        delete head_;
-        head_ = next;
-    }
+    nodes_.clear();
+}
+
+MockNamedValueComparatorsAndCopiersRepositoryNode* MockNamedValueComparatorsAndCopiersRepository::findNode(MockSymbol type) const
+{
+    return nodes_.find(type);
+}
+
+MockNamedValueComparatorsAndCopiersRepositoryNode* MockNamedValueComparatorsAndCopiersRepository::findOrCreateNode(MockSymbol type)
+{
+    MockNamedValueComparatorsAndCopiersRepositoryNode* node = findNode(type);
+    if (node == NULLPTR)
+        node = nodes_.add(new MockNamedValueComparatorsAndCopiersRepositoryNode(type));
+    return node;
 }
 
 void MockNamedValueComparatorsAndCopiersRepository::installComparator(const SimpleString& name, MockNamedValueComparator& comparator)
 {
-    head_ = new MockNamedValueComparatorsAndCopiersRepositoryNode(name, &comparator, head_);
+    findOrCreateNode(MockSymbolTable::symbolFor(name))->comparator_ = &comparator;
 }
 
 void MockNamedValueComparatorsAndCopiersRepository::installCopier(const SimpleString& name, MockNamedValueCopier& copier)
 {
-    head_ = new MockNamedValueComparatorsAndCopiersRepositoryNode(name, &copier, head_);
+    findOrCreateNode(MockSymbolTable::symbolFor(name))->copier_ = &copier;
 }
 
 MockNamedValueComparator* MockNamedValueComparatorsAndCopiersRepository::getComparatorForType(const SimpleString& name)
 {
-    for (MockNamedValueComparatorsAndCopiersRepositoryNode* p = head_; p; p = p->next_)
-            if (p->name_ == name && p->comparator_) return p->comparator_;
-    return NULLPTR;
+    return getComparatorForSymbol(MockSymbolTable::symbolFor(name));
 }
 
 MockNamedValueCopier* MockNamedValueComparatorsAndCopiersRepository::getCopierForType(const SimpleString& name)
 {
-    for (MockNamedValueComparatorsAndCopiersRepositoryNode* p = head_; p; p = p->next_)
-            if (p->name_ == name && p->copier_) return p->copier_;
-    return NULLPTR;
+    return getCopierForSymbol(MockSymbolTable::symbolFor(name));
+}
+
+MockNamedValueComparator* MockNamedValueComparatorsAndCopiersRepository::getComparatorForSymbol(MockSymbol type) const
+{
+    MockNamedValueComparatorsAndCopiersRepositoryNode* node = findNode(type);
+    return (node) ? node->comparator_ : NULLPTR;
+}
+
+MockNamedValueCopier* MockNamedValueComparatorsAndCopiersRepository::getCopierForSymbol(MockSymbol type) const
+{
+    MockNamedValueComparatorsAndCopiersRepositoryNode* node = findNode(type);
+    return (node) ? node->copier_ : NULLPTR;
 }
 
 void MockNamedValueComparatorsAndCopiersRepository::installComparatorsAndCopiers(const MockNamedValueComparatorsAndCopiersRepository& repository)
 {
-    for (MockNamedValueComparatorsAndCopiersRepositoryNode* p = repository.head_; p; p = p->next_)
-      head_ = new MockNamedValueComparatorsAndCopiersRepositoryNode(p->name_, p->comparator_, p->copier_, head_);
+    for (unsigned int i = 0; i < repository.nodes_.bucketCount(); i++) {
+        for (MockNamedValueComparatorsAndCopiersRepositoryNode* p = repository.nodes_.firstInBucket(i); p; p = p->nextInBucket_) {
+            MockNamedValueComparatorsAndCopiersRepositoryNode* node = findOrCreateNode(p->name_);
+            if (p->comparator_) node->comparator_ = p->comparator_;
+            if (p->copier_) node->copier_ = p->copier_;
+        }
+    }
 }
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockStatistics.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+MockFunctionStatistics::MockFunctionStatistics()
+    : calls(0), expectationsScanned(0), matchingTimeInMicros(0), copyingTimeInMicros(0), failures(0)
+{
+}
+
+static bool isMoreExpensive(const MockFunctionStatistics& function, const MockFunctionStatistics& other)
+{
+    unsigned long time = function.matchingTimeInMicros + function.copyingTimeInMicros;
+    unsigned long otherTime = other.matchingTimeInMicros + other.copyingTimeInMicros;
+    if (time != otherTime) return time > otherTime;
+    if (function.expectationsScanned != other.expectationsScanned) return function.expectationsScanned > other.expectationsScanned;
+    return function.calls > other.calls;
+}
+
+MockStatistics::MockStatistics()
+    : functions_(NULLPTR), capacity_(0)
+{
+}
+
+MockStatistics::~MockStatistics()
+{
+    PlatformSpecificFree(functions_);
+}
+
+void MockStatistics::addCall(MockSymbol functionName, const MockFunctionStatistics& call)
+{
+    if (functionName >= capacity_) {
+        /* Calls are added while a test runs (up to its mock().clear()), so stay out of the memory leak detection */
+        MockSymbol capacity = (capacity_ == 0) ? 64 : capacity_;
+        while (capacity <= functionName) capacity *= 2;
+        MockFunctionStatistics* functions = (MockFunctionStatistics*) PlatformSpecificRealloc(functions_, capacity * sizeof(MockFunctionStatistics));
+        if (functions == NULLPTR) return;
+        PlatformSpecificMemset(functions + capacity_, 0, (capacity - capacity_) * sizeof(MockFunctionStatistics));
+        functions_ = functions;
+        capacity_ = capacity;
+    }
+
+    MockFunctionStatistics& function = functions_[functionName];
+    function.calls += call.calls;
+    function.expectationsScanned += call.expectationsScanned;
+    function.matchingTimeInMicros += call.matchingTimeInMicros;
+    function.copyingTimeInMicros += call.copyingTimeInMicros;
+    function.failures += call.failures;
+}
+
+MockFunctionStatistics MockStatistics::getStatisticsFor(MockSymbol functionName) const
+{
+    if (functionName >= capacity_) return MockFunctionStatistics();
+    return functions_[functionName];
+}
+
+MockFunctionStatistics MockStatistics::getStatisticsFor(const SimpleString& functionName) const
+{
+    return getStatisticsFor(MockSymbolTable::symbolFor(functionName));
+}
+
+SimpleString MockStatistics::report() const
+{
+    MockSymbol count = 0;
+    for (MockSymbol i = 0; i < capacity_; i++)
+        if (functions_[i].calls) count++;
+    if (count == 0) return "";
+
+    /* Insertion sort, the report is made once per run */
+    MockSymbol* order = new MockSymbol[count];
+    MockSymbol sorted = 0;
+    for (MockSymbol i = 0; i < capacity_; i++) {
+        if (functions_[i].calls == 0) continue;
+        MockSymbol position = sorted++;
+        while (position > 0 && isMoreExpensive(functions_[i], functions_[order[position - 1]])) {
+            order[position] = order[position - 1];
+            position--;
+        }
+        order[position] = i;
+    }
+
+    SimpleString report = "\nMock statistics (most expensive first):\n";
+    report += "  matching (us)  copying (us)     calls   scanned  failed  function\n";
+    for (MockSymbol i = 0; i < count; i++) {
+        const MockFunctionStatistics& function = functions_[order[i]];
+        report += StringFromFormat("  %13lu  %12lu  %8lu  %8lu  %6lu  %s\n", function.matchingTimeInMicros, function.copyingTimeInMicros,
+                                   function.calls, function.expectationsScanned, function.failures, MockSymbolTable::nameOf(order[i]));
+    }
+    delete [] order;
+    return report;
+}
+
+void MockStatistics::clear()
+{
+    PlatformSpecificFree(functions_);
+    functions_ = NULLPTR;
+    capacity_ = 0;
+}
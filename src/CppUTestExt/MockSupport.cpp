@@ -31,8 +31,6 @@
 #include "CppUTestExt/MockExpectedCall.h"
 #include "CppUTestExt/MockFailure.h"
 
-#define MOCK_SUPPORT_SCOPE_PREFIX "!!!$$$MockingSupportScope$$$!!!"
-
 static MockSupport global_mock;
 
 MockSupport& mock(const SimpleString& mockName, MockFailureReporter* failureReporterForThisCall)
@@ -43,6 +41,43 @@ MockSupport& mock(const SimpleString& mockName, MockFailureReporter* failureRepo
     return mock_support;
 }
 
+struct MockSupport::ScopeEntry
+{
+    ScopeEntry(MockSymbol name, MockSupport* support) : name_(name), support_(support), next_(NULLPTR), nextInBucket_(NULLPTR) {}
+
+    MockSymbol name_;
+    MockSupport* support_;
+    ScopeEntry* next_;
+    ScopeEntry* nextInBucket_;
+};
+
+/* Scopes by name, and in creation order for the recursive functions */
+struct MockSupport::ScopeTable
+{
+    ScopeTable() : first_(NULLPTR), last_(NULLPTR) {}
+
+    MockSupport* find(MockSymbol name) const
+    {
+        ScopeEntry* entry = entries_.find(name);
+        return (entry) ? entry->support_ : NULLPTR;
+    }
+
+    void add(MockSymbol name, MockSupport* support)
+    {
+        ScopeEntry* entry = entries_.add(new ScopeEntry(name, support));
+        if (last_) last_->next_ = entry;
+        else first_ = entry;
+        last_ = entry;
+    }
+
+    MockSymbolBucketTable<ScopeEntry> entries_;
+    ScopeEntry* first_;
+    ScopeEntry* last_;
+};
+
+/* Changes whenever scopes get deleted, so MockScope handles know when to look their scope up again */
+static unsigned int scopesGeneration = 0;
+
 MockSupport::MockSupport(const SimpleString& mockName)
     :
         actualCallOrder_(0),
@@ -53,13 +88,23 @@ MockSupport::MockSupport(const SimpleString& mockName)
         ignoreOtherCalls_(false),
         enabled_(true),
         lastActualFunctionCall_(NULLPTR),
+        unusedActualCall_(NULLPTR),
         mockName_(mockName),
-        tracing_(false)
+        scopes_(NULLPTR),
+        tracing_(false),
+        recorder_(NULLPTR),
+        recordingAllCalls_(false),
+        replayers_(NULLPTR),
+        statistics_(NULLPTR)
 {
 }
 
 MockSupport::~MockSupport()
 {
+    deleteAllScopes();
+    delete lastActualFunctionCall_;
+    delete unusedActualCall_;
+    deleteAllReplayers();
 }
 
 void MockSupport::crashOnFailure(bool shouldCrash)
@@ -74,8 +119,8 @@ void MockSupport::setMockFailureStandardReporter(MockFailureReporter* reporter)
     if (lastActualFunctionCall_)
         lastActualFunctionCall_->setMockFailureReporter(standardReporter_);
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->setMockFailureStandardReporter(standardReporter_);
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->setMockFailureStandardReporter(standardReporter_);
 }
 
 void MockSupport::setActiveReporter(MockFailureReporter* reporter)
@@ -92,40 +137,45 @@ void MockSupport::installComparator(const SimpleString& typeName, MockNamedValue
 {
     comparatorsAndCopiersRepository_.installComparator(typeName, comparator);
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->installComparator(typeName, comparator);
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->installComparator(typeName, comparator);
 }
 
 void MockSupport::installCopier(const SimpleString& typeName, MockNamedValueCopier& copier)
 {
     comparatorsAndCopiersRepository_.installCopier(typeName, copier);
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->installCopier(typeName, copier);
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->installCopier(typeName, copier);
 }
 
 void MockSupport::installComparatorsAndCopiers(const MockNamedValueComparatorsAndCopiersRepository& repository)
 {
     comparatorsAndCopiersRepository_.installComparatorsAndCopiers(repository);
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->installComparatorsAndCopiers(repository);
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->installComparatorsAndCopiers(repository);
 }
 
 void MockSupport::removeAllComparatorsAndCopiers()
 {
     comparatorsAndCopiersRepository_.clear();
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->removeAllComparatorsAndCopiers();
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->removeAllComparatorsAndCopiers();
 }
 
 void MockSupport::clear()
 {
     delete lastActualFunctionCall_;
     lastActualFunctionCall_ = NULLPTR;
+    delete unusedActualCall_;
+    unusedActualCall_ = NULLPTR;
 
     tracing_ = false;
     MockActualCallTrace::clearInstance();
+    recorder_ = NULLPTR;
+    recordingAllCalls_ = false;
+    statistics_ = NULLPTR;
 
     expectations_.deleteAllExpectationsAndClearList();
     ignoreOtherCalls_ = false;
@@ -134,14 +184,11 @@ void MockSupport::clear()
     expectedCallOrder_ = 0;
     strictOrdering_ = false;
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next()) {
-        MockSupport* support = getMockSupport(p);
-        if (support) {
-            support->clear();
-            delete support;
-        }
-    }
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->clear();
+    deleteAllScopes();
     data_.clear();
+    deleteAllReplayers();
 }
 
 void MockSupport::strictOrder()
@@ -149,12 +196,6 @@ void MockSupport::strictOrder()
     strictOrdering_ = true;
 }
 
-SimpleString MockSupport::appendScopeToName(const SimpleString& functionName)
-{
-    if (mockName_.isEmpty()) return functionName;
-    return mockName_ + "::" + functionName;
-}
-
 MockExpectedCall& MockSupport::expectOneCall(const SimpleString& functionName)
 {
     return expectNCalls(1, functionName);
@@ -172,7 +213,7 @@ MockExpectedCall& MockSupport::expectNCalls(unsigned int amount, const SimpleStr
     countCheck();
 
     MockCheckedExpectedCall* call = new MockCheckedExpectedCall(amount);
-    call->withName(appendScopeToName(functionName));
+    call->withNameSymbol(MockSymbolTable::symbolFor(mockName_, functionName));
     if (strictOrdering_) {
         call->withCallOrder(expectedCallOrder_ + 1, expectedCallOrder_ + amount);
         expectedCallOrder_ += amount;
@@ -183,35 +224,54 @@ MockExpectedCall& MockSupport::expectNCalls(unsigned int amount, const SimpleStr
 
 MockCheckedActualCall* MockSupport::createActualCall()
 {
-    lastActualFunctionCall_ = new MockCheckedActualCall(++actualCallOrder_, activeReporter_, expectations_);
+    if (unusedActualCall_) {
+        lastActualFunctionCall_ = unusedActualCall_;
+        unusedActualCall_ = NULLPTR;
+        lastActualFunctionCall_->reset(++actualCallOrder_, activeReporter_);
+    }
+    else
+        lastActualFunctionCall_ = new MockCheckedActualCall(++actualCallOrder_, activeReporter_, expectations_);
     return lastActualFunctionCall_;
 }
 
-bool MockSupport::callIsIgnored(const SimpleString& functionName)
+void MockSupport::releaseLastActualCall()
+{
+    if (unusedActualCall_ == NULLPTR)
+        unusedActualCall_ = lastActualFunctionCall_;
+    else
+        delete lastActualFunctionCall_;
+    lastActualFunctionCall_ = NULLPTR;
+}
+
+bool MockSupport::callIsIgnored(MockSymbol functionName)
 {
-    return ignoreOtherCalls_ && !expectations_.hasExpectationWithName(functionName);
+    return ignoreOtherCalls_ && !expectations_.hasExpectationWithSymbol(functionName);
 }
 
 MockActualCall& MockSupport::actualCall(const SimpleString& functionName)
 {
-    const SimpleString scopeFunctionName = appendScopeToName(functionName);
+    MockSymbol scopeFunctionName = MockSymbolTable::symbolFor(mockName_, functionName);
 
     if (lastActualFunctionCall_) {
         lastActualFunctionCall_->checkExpectations();
-        delete lastActualFunctionCall_;
-        lastActualFunctionCall_ = NULLPTR;
+        lastActualFunctionCall_->finishRecording();
+        releaseLastActualCall();
     }
 
     if (!enabled_) return MockIgnoredActualCall::instance();
-    if (tracing_) return MockActualCallTrace::instance().withName(scopeFunctionName);
+    if (tracing_) return MockActualCallTrace::instance().withNameSymbol(scopeFunctionName);
 
+    if (recordingAllCalls_ && !expectations_.hasExpectationThatCanMatchSymbol(scopeFunctionName))
+        expectCallToRecord(scopeFunctionName);
 
     if (callIsIgnored(scopeFunctionName)) {
         return MockIgnoredActualCall::instance();
     }
 
     MockCheckedActualCall* call = createActualCall();
-    call->withName(scopeFunctionName);
+    if (recorder_) call->recordTo(recorder_, MockSymbolTable::symbolFor(mockName_), MockSymbolTable::symbolFor(functionName));
+    if (statistics_) call->collectStatisticsIn(statistics_);
+    call->withNameSymbol(scopeFunctionName);
     return *call;
 }
 
@@ -219,32 +279,58 @@ void MockSupport::ignoreOtherCalls()
 {
     ignoreOtherCalls_ = true;
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->ignoreOtherCalls();
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->ignoreOtherCalls();
 }
 
 void MockSupport::disable()
 {
     enabled_ = false;
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->disable();
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->disable();
 }
 
 void MockSupport::enable()
 {
     enabled_ = true;
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->enable();
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->enable();
 }
 
 void MockSupport::tracing(bool enabled)
 {
     tracing_ = enabled;
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) getMockSupport(p)->tracing(enabled);
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->tracing(enabled);
+}
+
+void MockSupport::recordCalls(MockCallRecorder* recorder, bool acceptAllCalls)
+{
+    recorder_ = recorder;
+    recordingAllCalls_ = (recorder != NULLPTR) && acceptAllCalls;
+
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->recordCalls(recorder, acceptAllCalls);
+}
+
+/* Not in the strict order, as the call is accepted whenever it happens */
+void MockSupport::expectCallToRecord(MockSymbol scopeFunctionName)
+{
+    MockCheckedExpectedCall* call = new MockCheckedExpectedCall(1);
+    call->withNameSymbol(scopeFunctionName);
+    call->ignoreOtherParameters();
+    expectations_.addExpectedCall(call);
+}
+
+void MockSupport::collectStatistics(MockStatistics* statistics)
+{
+    statistics_ = statistics;
+
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        p->support_->collectStatistics(statistics);
 }
 
 const char* MockSupport::getTraceOutput()
@@ -252,13 +338,35 @@ const char* MockSupport::getTraceOutput()
     return MockActualCallTrace::instance().getTraceOutput();
 }
 
+void MockSupport::setTraceLimit(unsigned int maximumEvents)
+{
+    MockActualCallTrace::setInstanceMaximumEvents(maximumEvents);
+}
+
+bool MockSupport::expectRecordedCalls(const SimpleString& fileName)
+{
+    MockCallReplayer* replayer = new MockCallReplayer;
+    replayer->setNext(replayers_);
+    replayers_ = replayer;
+    return replayer->readFile(fileName.asCharString()) && replayer->expectRecordedCalls(*this);
+}
+
+void MockSupport::deleteAllReplayers()
+{
+    while (replayers_) {
+        MockCallReplayer* next = replayers_->next();
+        delete replayers_;
+        replayers_ = next;
+    }
+}
+
 bool MockSupport::expectedCallsLeft()
 {
     checkExpectationsOfLastActualCall();
     int callsLeft = expectations_.hasUnfulfilledExpectations();
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p)) callsLeft += getMockSupport(p)->expectedCallsLeft();
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        callsLeft += p->support_->expectedCallsLeft();
 
     return callsLeft != 0;
 }
@@ -268,8 +376,8 @@ bool MockSupport::wasLastActualCallFulfilled()
     if (lastActualFunctionCall_ && !lastActualFunctionCall_->isFulfilled())
         return false;
 
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p) && !getMockSupport(p)->wasLastActualCallFulfilled())
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        if (!p->support_->wasLastActualCallFulfilled())
                 return false;
 
     return true;
@@ -280,9 +388,8 @@ void MockSupport::failTestWithExpectedCallsNotFulfilled()
     MockExpectedCallsList expectationsList;
     expectationsList.addExpectations(expectations_);
 
-    for(MockNamedValueListNode *p = data_.begin();p;p = p->next())
-        if(getMockSupport(p))
-            expectationsList.addExpectations(getMockSupport(p)->expectations_);
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        expectationsList.addExpectations(p->support_->expectations_);
 
     MockExpectedCallsDidntHappenFailure failure(activeReporter_->getTestToFail(), expectationsList);
     failTest(failure);
@@ -293,9 +400,8 @@ void MockSupport::failTestWithOutOfOrderCalls()
     MockExpectedCallsList expectationsList;
     expectationsList.addExpectations(expectations_);
 
-    for(MockNamedValueListNode *p = data_.begin();p;p = p->next())
-        if(getMockSupport(p))
-            expectationsList.addExpectations(getMockSupport(p)->expectations_);
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        expectationsList.addExpectations(p->support_->expectations_);
 
     MockCallOrderFailure failure(activeReporter_->getTestToFail(), expectationsList);
     failTest(failure);
@@ -314,12 +420,16 @@ void MockSupport::countCheck()
 
 void MockSupport::checkExpectationsOfLastActualCall()
 {
-    if(lastActualFunctionCall_)
+    if(lastActualFunctionCall_) {
         lastActualFunctionCall_->checkExpectations();
+        lastActualFunctionCall_->finishRecording();
+    }
 
-    for(MockNamedValueListNode *p = data_.begin();p;p = p->next())
-        if(getMockSupport(p) && getMockSupport(p)->lastActualFunctionCall_)
-            getMockSupport(p)->lastActualFunctionCall_->checkExpectations();
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        if (p->support_->lastActualFunctionCall_) {
+            p->support_->lastActualFunctionCall_->checkExpectations();
+            p->support_->lastActualFunctionCall_->finishRecording();
+        }
 }
 
 bool MockSupport::hasCallsOutOfOrder()
@@ -328,8 +438,8 @@ bool MockSupport::hasCallsOutOfOrder()
     {
         return true;
     }
-    for (MockNamedValueListNode* p = data_.begin(); p; p = p->next())
-        if (getMockSupport(p) && getMockSupport(p)->hasCallsOutOfOrder())
+    for (ScopeEntry* p = firstScope(); p; p = p->next_)
+        if (p->support_->hasCallsOutOfOrder())
         {
             return true;
         }
@@ -454,31 +564,65 @@ MockSupport* MockSupport::clone(const SimpleString& mockName)
     if (strictOrdering_) newMock->strictOrder();
 
     newMock->tracing(tracing_);
+    newMock->recordCalls(recorder_, recordingAllCalls_);
+    newMock->collectStatistics(statistics_);
     newMock->installComparatorsAndCopiers(comparatorsAndCopiersRepository_);
     return newMock;
 }
 
+MockSupport::ScopeEntry* MockSupport::firstScope() const
+{
+    return (scopes_) ? scopes_->first_ : NULLPTR;
+}
+
+void MockSupport::deleteAllScopes()
+{
+    if (scopes_ == NULLPTR)
+        return;
+
+    for (ScopeEntry* p = scopes_->first_; p; p = p->next_)
+        delete p->support_;
+    delete scopes_;
+    scopes_ = NULLPTR;
+    scopesGeneration++;
+}
+
 MockSupport* MockSupport::getMockSupportScope(const SimpleString& name)
 {
-    SimpleString mockingSupportName = MOCK_SUPPORT_SCOPE_PREFIX;
-    mockingSupportName += name;
+    return getMockSupportScope(MockSymbolTable::symbolFor(name));
+}
 
-    if (hasData(mockingSupportName)) {
-        STRCMP_EQUAL("MockSupport", getData(mockingSupportName).getType().asCharString());
-        return (MockSupport*) getData(mockingSupportName).getObjectPointer();
-    }
+MockSupport* MockSupport::getMockSupportScope(MockSymbol name)
+{
+    MockSupport* support = (scopes_) ? scopes_->find(name) : NULLPTR;
+    if (support)
+        return support;
 
-    MockSupport *newMock = clone(name);
+    if (scopes_ == NULLPTR)
+        scopes_ = new ScopeTable;
 
-    setDataObject(mockingSupportName, "MockSupport", newMock);
-    return newMock;
+    support = clone(MockSymbolTable::nameOf(name));
+    scopes_->add(name, support);
+    return support;
+}
+
+MockScope::MockScope(const SimpleString& mockName)
+    : mockName_(MockSymbolTable::symbolFor(mockName)), support_(NULLPTR), scopesGeneration_(0)
+{
 }
 
-MockSupport* MockSupport::getMockSupport(MockNamedValueListNode* node)
+MockSupport& MockScope::operator()(MockFailureReporter* failureReporterForThisCall)
 {
-    if (node->getType() == "MockSupport" && node->getName().contains(MOCK_SUPPORT_SCOPE_PREFIX))
-        return (MockSupport*) node->item()->getObjectPointer();
-    return NULLPTR;
+    if (mockName_ == MockSymbolTable::EMPTY)
+        return mock("", failureReporterForThisCall);
+
+    if (support_ == NULLPTR || scopesGeneration_ != scopesGeneration) {
+        support_ = global_mock.getMockSupportScope(mockName_);
+        scopesGeneration_ = scopesGeneration;
+    }
+    support_->setActiveReporter(failureReporterForThisCall);
+    support_->setDefaultComparatorsAndCopiersRepository();
+    return *support_;
 }
 
 MockNamedValue MockSupport::returnValue()
@@ -504,56 +648,56 @@ int MockSupport::intReturnValue()
 
 const char * MockSupport::returnStringValueOrDefault(const char * defaultValue)
 {
-    if (hasReturnValue()) {
-        return stringReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnStringValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 double MockSupport::returnDoubleValueOrDefault(double defaultValue)
 {
-    if (hasReturnValue()) {
-        return doubleReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnDoubleValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 long int MockSupport::returnLongIntValueOrDefault(long int defaultValue)
 {
-    if (hasReturnValue()) {
-        return longIntReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnLongIntValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 bool MockSupport::returnBoolValueOrDefault(bool defaultValue)
 {
-    if (hasReturnValue()) {
-        return boolReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnBoolValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 int MockSupport::returnIntValueOrDefault(int defaultValue)
 {
-    if (hasReturnValue()) {
-        return intReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnIntValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 unsigned int MockSupport::returnUnsignedIntValueOrDefault(unsigned int defaultValue)
 {
-    if (hasReturnValue()) {
-        return unsignedIntReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnUnsignedIntValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 unsigned long int MockSupport::returnUnsignedLongIntValueOrDefault(unsigned long int defaultValue)
 {
-    if (hasReturnValue()) {
-        return unsignedLongIntReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnUnsignedLongIntValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
@@ -582,16 +726,16 @@ cpputest_ulonglong MockSupport::unsignedLongLongIntReturnValue()
 
 cpputest_longlong MockSupport::returnLongLongIntValueOrDefault(cpputest_longlong defaultValue)
 {
-    if (hasReturnValue()) {
-        return longLongIntReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnLongLongIntValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 cpputest_ulonglong MockSupport::returnUnsignedLongLongIntValueOrDefault(cpputest_ulonglong defaultValue)
 {
-    if (hasReturnValue()) {
-        return unsignedLongLongIntReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnUnsignedLongLongIntValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
@@ -638,24 +782,24 @@ double MockSupport::doubleReturnValue()
 
 void * MockSupport::returnPointerValueOrDefault(void * defaultValue)
 {
-    if (hasReturnValue()) {
-        return pointerReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnPointerValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 const void* MockSupport::returnConstPointerValueOrDefault(const void * defaultValue)
 {
-    if (hasReturnValue()) {
-        return constPointerReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnConstPointerValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
 
 void (*MockSupport::returnFunctionPointerValueOrDefault(void (*defaultValue)()))()
 {
-    if (hasReturnValue()) {
-        return functionPointerReturnValue();
+    if (lastActualFunctionCall_) {
+        return lastActualFunctionCall_->returnFunctionPointerValueOrDefault(defaultValue);
     }
     return defaultValue;
 }
@@ -51,7 +51,7 @@ public:
 };
 
 MockSupportPlugin::MockSupportPlugin(const SimpleString& name)
-    : TestPlugin(name)
+    : TestPlugin(name), collectingStatistics_(false)
 {
 }
 
@@ -68,6 +68,8 @@ void MockSupportPlugin::clear()
 void MockSupportPlugin::preTestAction(UtestShell&, TestResult&)
 {
     mock().installComparatorsAndCopiers(repository_);
+    if (collectingStatistics_)
+        mock().collectStatistics(&statistics_);
 }
 
 void MockSupportPlugin::postTestAction(UtestShell& test, TestResult& result)
@@ -81,6 +83,33 @@ void MockSupportPlugin::postTestAction(UtestShell& test, TestResult& result)
     mock().removeAllComparatorsAndCopiers();
 }
 
+void MockSupportPlugin::postRunAction(TestResult& result)
+{
+    if (!collectingStatistics_) return;
+    SimpleString report = statistics_.report();
+    if (report.isEmpty())
+        report = "\nMock statistics: no mocked calls were made (with -p they are made in the separate processes)\n";
+    result.print(report.asCharString());
+    statistics_.clear();
+}
+
+bool MockSupportPlugin::parseArguments(int /* ac */, const char *const *av, int index)
+{
+    if (SimpleString(av[index]) != "-pmockstats") return false;
+    collectStatistics();
+    return true;
+}
+
+void MockSupportPlugin::collectStatistics(bool enabled)
+{
+    collectingStatistics_ = enabled;
+}
+
+const MockStatistics& MockSupportPlugin::getStatistics() const
+{
+    return statistics_;
+}
+
 void MockSupportPlugin::installComparator(const SimpleString& name, MockNamedValueComparator& comparator)
 {
     repository_.installComparator(name, comparator);
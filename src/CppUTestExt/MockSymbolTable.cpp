@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSymbolTable.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+/*
+ * The table is allocated with the platform functions instead of new, so it does not show up as a leak
+ * of whichever test happened to use a name first. It lives until the end of the program and is freed
+ * at exit. A failed allocation fails the test and leaves the table as it was.
+ */
+
+struct MockSymbolTableEntry
+{
+    char* name_;
+    size_t length_;
+    size_t hash_;
+};
+
+struct MockSymbolNamePart
+{
+    const char* text_;
+    size_t length_;
+};
+
+static MockSymbolTableEntry* entries_ = NULLPTR;
+static MockSymbol entryCount_ = 0;
+static MockSymbol entryCapacity_ = 0;
+static MockSymbol* buckets_ = NULLPTR;
+static size_t bucketCount_ = 0;
+
+static const char* const builtinNames_[MockSymbolTable::BUILTIN_SYMBOL_COUNT] = {
+    "",
+    "bool",
+    "int",
+    "unsigned int",
+    "long int",
+    "unsigned long int",
+    "long long int",
+    "unsigned long long int",
+    "double",
+    "void*",
+    "const void*",
+    "void (*)()",
+    "const char*",
+    "const unsigned char*"
+};
+
+static size_t hashNameParts(const MockSymbolNamePart* parts, size_t count)
+{
+    size_t hash = SimpleString::hashStart;
+    for (size_t i = 0; i < count; i++)
+        hash = SimpleString::Hash(parts[i].text_, parts[i].length_, hash);
+    return hash;
+}
+
+static bool entryHasName(const MockSymbolTableEntry& entry, const MockSymbolNamePart* parts, size_t count)
+{
+    const char* name = entry.name_;
+    for (size_t i = 0; i < count; i++) {
+        if (SimpleString::StrNCmp(name, parts[i].text_, parts[i].length_) != 0)
+            return false;
+        name += parts[i].length_;
+    }
+    return true;
+}
+
+static void insertIntoBuckets(MockSymbol symbol)
+{
+    size_t mask = bucketCount_ - 1;
+    size_t i = entries_[symbol].hash_ & mask;
+    while (buckets_[i] != MockSymbolTable::EMPTY)
+        i = (i + 1) & mask;
+    buckets_[i] = symbol;
+}
+
+static void growBuckets()
+{
+    size_t bucketCount = (bucketCount_ == 0) ? 256 : bucketCount_ * 2;
+    MockSymbol* buckets = (MockSymbol*) PlatformSpecificMalloc(bucketCount * sizeof(MockSymbol));
+    if (buckets == NULLPTR)
+        FAIL("MockSymbolTable: malloc returned null pointer");
+    PlatformSpecificMemset(buckets, 0, bucketCount * sizeof(MockSymbol));
+
+    PlatformSpecificFree(buckets_);
+    buckets_ = buckets;
+    bucketCount_ = bucketCount;
+
+    /* Symbol 0 is the empty name, which is never looked up, so 0 marks a free bucket */
+    for (MockSymbol symbol = 1; symbol < entryCount_; symbol++)
+        insertIntoBuckets(symbol);
+}
+
+static void growEntries()
+{
+    MockSymbol entryCapacity = (entryCapacity_ == 0) ? 64 : entryCapacity_ * 2;
+    MockSymbolTableEntry* entries = (MockSymbolTableEntry*) PlatformSpecificRealloc(entries_, entryCapacity * sizeof(MockSymbolTableEntry));
+    if (entries == NULLPTR)
+        FAIL("MockSymbolTable: realloc returned null pointer");
+
+    entries_ = entries;
+    entryCapacity_ = entryCapacity;
+}
+
+static MockSymbol addEntry(const MockSymbolNamePart* parts, size_t count, size_t length, size_t hash)
+{
+    /* Everything is allocated before the entry is added, so a failure leaves the table as it was */
+    MockSymbol symbol = entryCount_;
+    if (entryCount_ == entryCapacity_)
+        growEntries();
+    if (symbol != MockSymbolTable::EMPTY && (size_t) (entryCount_ + 1) * 2 > bucketCount_)
+        growBuckets();
+
+    char* name = (char*) PlatformSpecificMalloc(length + 1);
+    if (name == NULLPTR)
+        FAIL("MockSymbolTable: malloc returned null pointer");
+
+    char* end = name;
+    for (size_t i = 0; i < count; i++) {
+        PlatformSpecificMemCpy(end, parts[i].text_, parts[i].length_);
+        end += parts[i].length_;
+    }
+    *end = '\0';
+
+    MockSymbolTableEntry& entry = entries_[symbol];
+    entry.name_ = name;
+    entry.length_ = length;
+    entry.hash_ = hash;
+    entryCount_++;
+
+    if (symbol != MockSymbolTable::EMPTY)
+        insertIntoBuckets(symbol);
+    return symbol;
+}
+
+static void freeTable()
+{
+    for (MockSymbol symbol = 0; symbol < entryCount_; symbol++)
+        PlatformSpecificFree(entries_[symbol].name_);
+    PlatformSpecificFree(entries_);
+    PlatformSpecificFree(buckets_);
+    entries_ = NULLPTR;
+    buckets_ = NULLPTR;
+    entryCount_ = 0;
+    entryCapacity_ = 0;
+    bucketCount_ = 0;
+}
+
+static void addBuiltinSymbols()
+{
+    static bool freedAtExit = false;
+    if (!freedAtExit && PlatformSpecificAtExit) {
+        PlatformSpecificAtExit(freeTable);
+        freedAtExit = true;
+    }
+
+    for (size_t i = 0; i < MockSymbolTable::BUILTIN_SYMBOL_COUNT; i++) {
+        MockSymbolNamePart part = { builtinNames_[i], SimpleString::StrLen(builtinNames_[i]) };
+        addEntry(&part, 1, part.length_, hashNameParts(&part, 1));
+    }
+}
+
+static MockSymbol intern(const MockSymbolNamePart* parts, size_t count)
+{
+    if (entryCount_ == 0)
+        addBuiltinSymbols();
+
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++)
+        length += parts[i].length_;
+    if (length == 0)
+        return MockSymbolTable::EMPTY;
+
+    size_t hash = hashNameParts(parts, count);
+    size_t mask = bucketCount_ - 1;
+    for (size_t i = hash & mask; buckets_[i] != MockSymbolTable::EMPTY; i = (i + 1) & mask) {
+        const MockSymbolTableEntry& entry = entries_[buckets_[i]];
+        if (entry.hash_ == hash && entry.length_ == length && entryHasName(entry, parts, count))
+            return buckets_[i];
+    }
+    return addEntry(parts, count, length, hash);
+}
+
+MockSymbol MockSymbolTable::symbolFor(const char* name)
+{
+    MockSymbolNamePart part = { name, SimpleString::StrLen(name) };
+    return intern(&part, 1);
+}
+
+MockSymbol MockSymbolTable::symbolFor(const SimpleString& name)
+{
+    MockSymbolNamePart part = { name.asCharString(), name.size() };
+    return intern(&part, 1);
+}
+
+MockSymbol MockSymbolTable::symbolFor(const SimpleString& scope, const SimpleString& name)
+{
+    if (scope.isEmpty())
+        return symbolFor(name);
+
+    MockSymbolNamePart parts[3] = {
+        { scope.asCharString(), scope.size() },
+        { "::", 2 },
+        { name.asCharString(), name.size() }
+    };
+    return intern(parts, 3);
+}
+
+const char* MockSymbolTable::nameOf(MockSymbol symbol)
+{
+    if (entryCount_ == 0)
+        addBuiltinSymbols();
+    if (symbol >= entryCount_)
+        return "";
+    return entries_[symbol].name_;
+}
+
+MockSymbol MockSymbolTable::size()
+{
+    if (entryCount_ == 0)
+        addBuiltinSymbols();
+    return entryCount_;
+}
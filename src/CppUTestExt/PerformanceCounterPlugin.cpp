@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/PerformanceCounterPlugin.h"
+
+#if CPPUTEST_HAVE_PERF_EVENT && CPPUTEST_USE_LONG_LONG
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <string.h>
+
+#endif
+
+static const char* const counterNames[PerformanceCounterPlugin::NUMBER_OF_COUNTERS] = {
+    "cycles", "instructions", "branch-misses", "L1-dcache-load-misses", "LLC-load-misses", "page-faults"
+};
+
+PerformanceCounterPlugin::PerformanceCounterPlugin(const SimpleString& name)
+    : TestPlugin(name), opened_(false), groupLeader_(-1), numberOfMembers_(0), timeEnabled_(), timeRunning_()
+{
+    for (int i = 0; i < NUMBER_OF_COUNTERS; i++)
+        handles_[i] = -1;
+}
+
+PerformanceCounterPlugin::~PerformanceCounterPlugin()
+{
+    closeCounters();
+}
+
+const char* PerformanceCounterPlugin::getCounterName(Counter counter)
+{
+    return counterNames[counter];
+}
+
+void PerformanceCounterPlugin::openCounters()
+{
+    opened_ = true;
+    for (int i = 0; i < NUMBER_OF_COUNTERS; i++) {
+        int handle = openCounter((Counter) i, groupLeader_);
+        if (handle < 0) continue;
+
+        if (groupLeader_ < 0) groupLeader_ = handle;
+        handles_[numberOfMembers_] = handle;
+        members_[numberOfMembers_++] = (Counter) i;
+    }
+}
+
+void PerformanceCounterPlugin::closeCounters()
+{
+    for (int i = numberOfMembers_ - 1; i >= 0; i--) {
+        closeCounter(handles_[i]);
+        handles_[i] = -1;
+    }
+    numberOfMembers_ = 0;
+    groupLeader_ = -1;
+    opened_ = false;
+}
+
+void PerformanceCounterPlugin::preTestAction(UtestShell& test, TestResult&)
+{
+    /* The counters of the runner count the runner, not the forked test process */
+    if (test.isRunInSeperateProcess()) closeCounters();
+    if (!opened_) openCounters();
+    if (groupLeader_ < 0) return;
+
+    cpputest_ulonglong values[NUMBER_OF_COUNTERS];
+    if (!readCounters(groupLeader_, values, numberOfMembers_, timeEnabled_, timeRunning_))
+        timeEnabled_ = timeRunning_ = cpputest_ulonglong();
+    startCounters(groupLeader_);
+}
+
+#if CPPUTEST_USE_LONG_LONG
+
+static bool scaleCounts(cpputest_ulonglong values[], int numberOfValues, cpputest_ulonglong timeEnabled, cpputest_ulonglong timeRunning)
+{
+    if (timeRunning == 0) return false;
+    if (timeRunning == timeEnabled) return true;
+
+    for (int i = 0; i < numberOfValues; i++)
+        values[i] = (cpputest_ulonglong) ((double) values[i] * (double) timeEnabled / (double) timeRunning);
+    return true;
+}
+
+#endif
+
+void PerformanceCounterPlugin::postTestAction(UtestShell& test, TestResult& result)
+{
+    if (groupLeader_ < 0) return;
+    stopCounters(groupLeader_);
+
+    cpputest_ulonglong values[NUMBER_OF_COUNTERS];
+    cpputest_ulonglong timeEnabled, timeRunning;
+    if (!readCounters(groupLeader_, values, numberOfMembers_, timeEnabled, timeRunning)) return;
+#if CPPUTEST_USE_LONG_LONG
+    /* The times add up over the tests, the counts are reset when the test starts */
+    if (!scaleCounts(values, numberOfMembers_, timeEnabled - timeEnabled_, timeRunning - timeRunning_)) return;
+#endif
+
+    for (int i = 0; i < numberOfMembers_; i++)
+        result.addTestProperty(test, counterNames[members_[i]], StringFrom(values[i]));
+}
+
+#if CPPUTEST_HAVE_PERF_EVENT && CPPUTEST_USE_LONG_LONG
+
+static void configureCounter(PerformanceCounterPlugin::Counter counter, struct perf_event_attr& attr)
+{
+    switch (counter) {
+    case PerformanceCounterPlugin::CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case PerformanceCounterPlugin::INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case PerformanceCounterPlugin::BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case PerformanceCounterPlugin::L1D_LOAD_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case PerformanceCounterPlugin::LLC_LOAD_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case PerformanceCounterPlugin::PAGE_FAULTS:
+    case PerformanceCounterPlugin::NUMBER_OF_COUNTERS:
+    default:
+        attr.type = PERF_TYPE_SOFTWARE;
+        attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+        break;
+    }
+}
+
+int PerformanceCounterPlugin::openCounter(Counter counter, int groupLeader)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    configureCounter(counter, attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    if (groupLeader < 0) {
+        attr.disabled = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    }
+
+    return (int) syscall(__NR_perf_event_open, &attr, 0, -1, groupLeader, 0);
+}
+
+void PerformanceCounterPlugin::startCounters(int groupLeader)
+{
+    ioctl(groupLeader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(groupLeader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerformanceCounterPlugin::stopCounters(int groupLeader)
+{
+    ioctl(groupLeader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+bool PerformanceCounterPlugin::readCounters(int groupLeader, cpputest_ulonglong values[], int numberOfValues,
+                                            cpputest_ulonglong& timeEnabled, cpputest_ulonglong& timeRunning)
+{
+    /* PERF_FORMAT_GROUP: the number of counters, the two times and the counts */
+    unsigned long long data[3 + NUMBER_OF_COUNTERS];
+    ssize_t expectedSize = (ssize_t) ((size_t) (3 + numberOfValues) * sizeof(data[0]));
+    if (::read(groupLeader, data, sizeof(data)) != expectedSize || data[0] != (unsigned long long) numberOfValues) return false;
+
+    timeEnabled = data[1];
+    timeRunning = data[2];
+    for (int i = 0; i < numberOfValues; i++)
+        values[i] = data[3 + i];
+    return true;
+}
+
+void PerformanceCounterPlugin::closeCounter(int handle)
+{
+    close(handle);
+}
+
+#else
+
+int PerformanceCounterPlugin::openCounter(Counter, int)
+{
+    return -1;
+}
+
+void PerformanceCounterPlugin::startCounters(int)
+{
+}
+
+void PerformanceCounterPlugin::stopCounters(int)
+{
+}
+
+bool PerformanceCounterPlugin::readCounters(int, cpputest_ulonglong[], int, cpputest_ulonglong&, cpputest_ulonglong&)
+{
+    return false;
+}
+
+void PerformanceCounterPlugin::closeCounter(int)
+{
+}
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/ResourceUsagePlugin.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+#if CPPUTEST_HAVE_GETRUSAGE
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#endif
+
+static const char* const limitArguments[ResourceUsagePlugin::NUMBER_OF_LIMITS] = {
+    "-pcpulimit=", "-prsslimit=", "-pfaultlimit=", "-pswitchlimit="
+};
+
+static const char* const limitDescriptions[ResourceUsagePlugin::NUMBER_OF_LIMITS] = {
+    "ms of CPU time", "kB of resident set growth", "page faults", "context switches"
+};
+
+static unsigned long increase(unsigned long before, unsigned long after)
+{
+    return (after > before) ? after - before : 0;
+}
+
+ResourceUsage::ResourceUsage()
+    : userTimeInMicros(0), systemTimeInMicros(0), maximumResidentSetInKilobytes(0), residentSetInKilobytes(0),
+      minorPageFaults(0), majorPageFaults(0), voluntaryContextSwitches(0), involuntaryContextSwitches(0)
+{
+}
+
+ResourceUsagePlugin::ResourceUsagePlugin(const SimpleString& name)
+    : TestPlugin(name), sampled_(false)
+{
+    for (int i = 0; i < NUMBER_OF_LIMITS; i++)
+        limits_[i] = 0;
+}
+
+ResourceUsagePlugin::~ResourceUsagePlugin()
+{
+}
+
+void ResourceUsagePlugin::setLimit(Limit limit, unsigned long value)
+{
+    limits_[limit] = value;
+}
+
+unsigned long ResourceUsagePlugin::getLimit(Limit limit) const
+{
+    return limits_[limit];
+}
+
+static bool isNumber(const SimpleString& text)
+{
+    if (text.isEmpty()) return false;
+    for (const char* c = text.asCharString(); *c; c++)
+        if (*c < '0' || *c > '9') return false;
+    return true;
+}
+
+bool ResourceUsagePlugin::parseArguments(int /* ac */, const char *const *av, int index)
+{
+    SimpleString argument(av[index]);
+    for (int i = 0; i < NUMBER_OF_LIMITS; i++) {
+        if (argument.startsWith(limitArguments[i])) {
+            SimpleString value = argument.subString(SimpleString::StrLen(limitArguments[i]));
+            if (!isNumber(value)) return false;
+            limits_[i] = SimpleString::AtoU(value.asCharString());
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResourceUsagePlugin::preTestAction(UtestShell&, TestResult&)
+{
+    sampled_ = sampleResourceUsage(before_);
+}
+
+void ResourceUsagePlugin::postTestAction(UtestShell& test, TestResult& result)
+{
+    if (!sampled_) return;
+    sampled_ = false;
+
+    ResourceUsage after;
+    if (!sampleResourceUsage(after)) return;
+
+    addProperties(test, result, after);
+
+    unsigned long cpuTimeInMicros = increase(before_.userTimeInMicros, after.userTimeInMicros)
+                                  + increase(before_.systemTimeInMicros, after.systemTimeInMicros);
+    checkLimit(test, result, CPU_TIME_IN_MILLIS, cpuTimeInMicros / 1000);
+    checkLimit(test, result, RESIDENT_SET_GROWTH_IN_KILOBYTES,
+               increase(before_.maximumResidentSetInKilobytes, after.maximumResidentSetInKilobytes));
+    checkLimit(test, result, PAGE_FAULTS, increase(before_.minorPageFaults, after.minorPageFaults)
+                                        + increase(before_.majorPageFaults, after.majorPageFaults));
+    checkLimit(test, result, CONTEXT_SWITCHES, increase(before_.voluntaryContextSwitches, after.voluntaryContextSwitches)
+                                             + increase(before_.involuntaryContextSwitches, after.involuntaryContextSwitches));
+}
+
+void ResourceUsagePlugin::addProperties(UtestShell& test, TestResult& result, const ResourceUsage& after)
+{
+    long residentSetGrowth = (long) after.residentSetInKilobytes - (long) before_.residentSetInKilobytes;
+
+    result.addTestProperty(test, "user-time-us", StringFrom(increase(before_.userTimeInMicros, after.userTimeInMicros)));
+    result.addTestProperty(test, "system-time-us", StringFrom(increase(before_.systemTimeInMicros, after.systemTimeInMicros)));
+    result.addTestProperty(test, "max-rss-growth-kB", StringFrom(increase(before_.maximumResidentSetInKilobytes, after.maximumResidentSetInKilobytes)));
+    result.addTestProperty(test, "rss-growth-kB", StringFrom(residentSetGrowth));
+    result.addTestProperty(test, "minor-faults", StringFrom(increase(before_.minorPageFaults, after.minorPageFaults)));
+    result.addTestProperty(test, "major-faults", StringFrom(increase(before_.majorPageFaults, after.majorPageFaults)));
+    result.addTestProperty(test, "voluntary-switches", StringFrom(increase(before_.voluntaryContextSwitches, after.voluntaryContextSwitches)));
+    result.addTestProperty(test, "involuntary-switches", StringFrom(increase(before_.involuntaryContextSwitches, after.involuntaryContextSwitches)));
+}
+
+void ResourceUsagePlugin::checkLimit(UtestShell& test, TestResult& result, Limit limit, unsigned long used)
+{
+    if (limits_[limit] == 0 || used <= limits_[limit]) return;
+
+    result.addFailure(TestFailure(&test, StringFromFormat("Test used %lu %s, the limit is %lu",
+                                                          used, limitDescriptions[limit], limits_[limit])));
+}
+
+#if CPPUTEST_HAVE_GETRUSAGE
+
+static unsigned long residentSetInKilobytes()
+{
+#ifdef __linux__
+    PlatformSpecificFile file = PlatformSpecificFOpen("/proc/self/statm", "r");
+    if (file == NULLPTR) return 0;
+
+    char line[128];
+    char* read = PlatformSpecificFGets(line, sizeof(line), file);
+    PlatformSpecificFClose(file);
+    if (read == NULLPTR) return 0;
+
+    const char* resident = line;
+    while (*resident && *resident != ' ') resident++;
+    return SimpleString::AtoU(resident) * ((unsigned long) sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return 0;
+#endif
+}
+
+static unsigned long timevalInMicros(const struct timeval& tv)
+{
+    return (unsigned long) tv.tv_sec * 1000000 + (unsigned long) tv.tv_usec;
+}
+
+bool ResourceUsagePlugin::sampleResourceUsage(ResourceUsage& usage)
+{
+    struct rusage rusage;
+    if (getrusage(RUSAGE_SELF, &rusage) != 0) return false;
+
+    usage.userTimeInMicros = timevalInMicros(rusage.ru_utime);
+    usage.systemTimeInMicros = timevalInMicros(rusage.ru_stime);
+#ifdef __APPLE__
+    usage.maximumResidentSetInKilobytes = (unsigned long) rusage.ru_maxrss / 1024;
+#else
+    usage.maximumResidentSetInKilobytes = (unsigned long) rusage.ru_maxrss;
+#endif
+    usage.residentSetInKilobytes = residentSetInKilobytes();
+    usage.minorPageFaults = (unsigned long) rusage.ru_minflt;
+    usage.majorPageFaults = (unsigned long) rusage.ru_majflt;
+    usage.voluntaryContextSwitches = (unsigned long) rusage.ru_nvcsw;
+    usage.involuntaryContextSwitches = (unsigned long) rusage.ru_nivcsw;
+    return true;
+}
+
+#else
+
+bool ResourceUsagePlugin::sampleResourceUsage(ResourceUsage&)
+{
+    return false;
+}
+
+#endif
@@ -214,8 +214,21 @@ static const char* TimeStringImplementation()
 }
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = TimeInMillisImplementation;
+
+static unsigned long TimeInMicrosImplementation()
+{
+    return TimeInMillisImplementation() * 1000;
+}
+
+unsigned long (*GetPlatformSpecificTimeInMicros)() = TimeInMicrosImplementation;
 const char* (*GetPlatformSpecificTimeString)() = TimeStringImplementation;
 
+static void PlatformSpecificSetWatchdogImplementation(unsigned int, const char*)
+{
+}
+
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = PlatformSpecificSetWatchdogImplementation;
+
 static int BorlandVSNprintf(char *str, size_t size, const char* format, va_list args)
 {
     int result = vsnprintf( str, size, format, args);
@@ -235,11 +248,21 @@ static void PlatformSpecificFPutsImplementation(const char* str, PlatformSpecifi
    fputs(str, (FILE*)file);
 }
 
+static char* PlatformSpecificFGetsImplementation(char* str, int size, PlatformSpecificFile file)
+{
+   return fgets(str, size, (FILE*)file);
+}
+
 static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
 {
    fclose((FILE*)file);
 }
 
+static void PlatformSpecificFFlushImplementation(PlatformSpecificFile file)
+{
+   fflush((FILE*)file);
+}
+
 static void PlatformSpecificFlushImplementation()
 {
   fflush(stdout);
@@ -248,7 +271,9 @@ static void PlatformSpecificFlushImplementation()
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
 void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+char* (*PlatformSpecificFGets)(char*, int, PlatformSpecificFile) = PlatformSpecificFGetsImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile) = PlatformSpecificFFlushImplementation;
 
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
 
@@ -269,6 +294,7 @@ static int IsInfImplementation(double d)
 }
 
 double (*PlatformSpecificFabs)(double) = fabs;
+double (*PlatformSpecificSqrt)(double) = sqrt;
 void (*PlatformSpecificSrand)(unsigned int) = srand;
 int (*PlatformSpecificRand)(void) = rand;
 int (*PlatformSpecificIsNan)(double) = IsNanImplementation;
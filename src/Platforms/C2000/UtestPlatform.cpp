@@ -124,8 +124,21 @@ static const char* TimeStringImplementation()
 }
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = C2000TimeInMillis;
+
+static unsigned long C2000TimeInMicros()
+{
+    return C2000TimeInMillis() * 1000;
+}
+
+unsigned long (*GetPlatformSpecificTimeInMicros)() = C2000TimeInMicros;
 const char* (*GetPlatformSpecificTimeString)() = TimeStringImplementation;
 
+static void C2000SetWatchdog(unsigned int, const char*)
+{
+}
+
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = C2000SetWatchdog;
+
 extern int vsnprintf(char*, size_t, const char*, va_list); // not std::vsnprintf()
 
 extern int (*PlatformSpecificVSNprintf)(char *, size_t, const char*, va_list) = vsnprintf;
@@ -150,15 +163,27 @@ static void C2000FPuts(const char* str, PlatformSpecificFile file)
     }
 }
 
+static char* C2000FGets(char* str, int size, PlatformSpecificFile file)
+{
+    return fgets(str, size, (FILE*)file);
+}
+
 static void C2000FClose(PlatformSpecificFile file)
 {
    fclose((FILE*)file);
 }
 
+static void C2000FFlush(PlatformSpecificFile file)
+{
+   fflush((FILE*)file);
+}
+
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = C2000FOpen;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = C2000FPuts;
+char* (*PlatformSpecificFGets)(char* str, int size, PlatformSpecificFile file) = C2000FGets;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = C2000FClose;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile file) = C2000FFlush;
 
 static void CL2000Flush()
 {
@@ -208,6 +233,7 @@ double PlatformSpecificFabs(double d)
 }
 */
 double (*PlatformSpecificFabs)(double) = fabs;
+double (*PlatformSpecificSqrt)(double) = sqrt;
 
 static int IsNanImplementation(double d)
 {
@@ -120,7 +120,20 @@ static int DosVSNprintf(char* str, size_t size, const char* format, va_list args
 }
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = DosTimeInMillis;
+
+static unsigned long DosTimeInMicros()
+{
+    return DosTimeInMillis() * 1000;
+}
+
+unsigned long (*GetPlatformSpecificTimeInMicros)() = DosTimeInMicros;
 const char* (*GetPlatformSpecificTimeString)() = DosTimeString;
+
+static void DosSetWatchdog(unsigned int, const char*)
+{
+}
+
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = DosSetWatchdog;
 int (*PlatformSpecificVSNprintf)(char *, size_t, const char*, va_list) = DosVSNprintf;
 
 PlatformSpecificFile DosFOpen(const char* filename, const char* flag)
@@ -133,15 +146,27 @@ static void DosFPuts(const char* str, PlatformSpecificFile file)
    fputs(str, (FILE*)file);
 }
 
+static char* DosFGets(char* str, int size, PlatformSpecificFile file)
+{
+    return fgets(str, size, (FILE*)file);
+}
+
 static void DosFClose(PlatformSpecificFile file)
 {
    fclose((FILE*)file);
 }
 
+static void DosFFlush(PlatformSpecificFile file)
+{
+   fflush((FILE*)file);
+}
+
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = DosFOpen;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = DosFPuts;
+char* (*PlatformSpecificFGets)(char* str, int size, PlatformSpecificFile file) = DosFGets;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = DosFClose;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile file) = DosFFlush;
 
 static void DosFlush()
 {
@@ -196,6 +221,11 @@ static double DosFabs(double d)
     return fabs(d);
 }
 
+static double DosSqrt(double d)
+{
+    return sqrt(d);
+}
+
 static int DosIsNan(double d)
 {
     return isnan(d);
@@ -209,6 +239,7 @@ static int DosIsInf(double d)
 void (*PlatformSpecificSrand)(unsigned int) = DosSrand;
 int (*PlatformSpecificRand)(void) = DosRand;
 double (*PlatformSpecificFabs)(double) = DosFabs;
+double (*PlatformSpecificSqrt)(double) = DosSqrt;
 int (*PlatformSpecificIsNan)(double d) = DosIsNan;
 int (*PlatformSpecificIsInf)(double d) = DosIsInf;
 
@@ -43,6 +43,10 @@
 #include <errno.h>
 #include <signal.h>
 #endif
+#ifdef CPPUTEST_HAVE_ALARM
+#include <unistd.h>
+#include <signal.h>
+#endif
 
 #include <time.h>
 #include <stdio.h>
@@ -94,12 +98,33 @@ static void SetTestFailureByStatusCode(UtestShell* shell, TestResult* result, in
     }
 }
 
+static bool KillChildWhenTimedOut(UtestShell* shell, TestResult* result, pid_t cpid, unsigned long startTime, long& pollDelayInNanos)
+{
+    const unsigned long elapsed = GetPlatformSpecificTimeInMillis() - startTime;
+    if (elapsed < (unsigned long) shell->getTimeout() * 1000) {
+        struct timespec delay = { 0, pollDelayInNanos };
+        nanosleep(&delay, NULLPTR);
+        if (pollDelayInNanos < 10000000) pollDelayInNanos *= 2;
+        return false;
+    }
+
+    int status = 0;
+    kill(cpid, SIGKILL);
+    PlatformSpecificWaitPid(cpid, &status, 0);
+    result->addFailure(TestFailure(shell, StringFromFormat("Timed out in separate process after %lu ms - killed", elapsed)));
+    return true;
+}
+
 static void GccPlatformSpecificRunTestInASeperateProcess(UtestShell* shell, TestPlugin* plugin, TestResult* result)
 {
     const pid_t syscallError = -1;
+    const pid_t stillRunning = 0;
     pid_t cpid;
     pid_t w;
     int status = 0;
+    const int options = (shell->getTimeout() > 0) ? (WUNTRACED | WNOHANG) : WUNTRACED;
+    const unsigned long startTime = GetPlatformSpecificTimeInMillis();
+    long pollDelayInNanos = 100000;
 
     cpid = PlatformSpecificFork();
 
@@ -115,8 +140,10 @@ static void GccPlatformSpecificRunTestInASeperateProcess(UtestShell* shell, Test
     } else {                    /* Code executed by parent */
         size_t amountOfRetries = 0;
         do {
-            w = PlatformSpecificWaitPid(cpid, &status, WUNTRACED);
-            if (w == syscallError) {
+            w = PlatformSpecificWaitPid(cpid, &status, options);
+            if (w == stillRunning) {
+                if (KillChildWhenTimedOut(shell, result, cpid, startTime, pollDelayInNanos)) return;
+            } else if (w == syscallError) {
                 // OS X debugger causes EINTR
                 if (EINTR == errno) {
                   if (amountOfRetries > 30) {
@@ -133,7 +160,7 @@ static void GccPlatformSpecificRunTestInASeperateProcess(UtestShell* shell, Test
                 SetTestFailureByStatusCode(shell, result, status);
                 if (WIFSTOPPED(status)) kill(w, SIGCONT);
             }
-        } while ((w == syscallError) || (!WIFEXITED(status) && !WIFSIGNALED(status)));
+        } while ((w == syscallError) || (w == stillRunning) || (!WIFEXITED(status) && !WIFSIGNALED(status)));
     }
 }
 
@@ -209,6 +236,17 @@ static unsigned long TimeInMillisImplementation()
 #endif
 }
 
+static unsigned long TimeInMicrosImplementation()
+{
+#ifdef CPPUTEST_HAVE_GETTIMEOFDAY
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (((unsigned long)tv.tv_sec * 1000000) + (unsigned long)tv.tv_usec);
+#else
+    return 0;
+#endif
+}
+
 static const char* TimeStringImplementation()
 {
     time_t theTime = time(NULLPTR);
@@ -225,8 +263,49 @@ static const char* TimeStringImplementation()
 }
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = TimeInMillisImplementation;
+unsigned long (*GetPlatformSpecificTimeInMicros)() = TimeInMicrosImplementation;
 const char* (*GetPlatformSpecificTimeString)() = TimeStringImplementation;
 
+///////////// Watchdog
+
+#ifdef CPPUTEST_HAVE_ALARM
+
+static const char* watchdogMessage = NULLPTR;
+
+/* The test can be interrupted anywhere, e.g. within malloc or stdio, so only async-signal-safe calls here */
+static void WatchdogSignalHandler(int)
+{
+    if (watchdogMessage) {
+        size_t length = 0;
+        while (watchdogMessage[length]) length++;
+        ssize_t written = write(STDOUT_FILENO, watchdogMessage, length);
+        (void) written;
+    }
+    _exit(1);
+}
+
+static void PlatformSpecificSetWatchdogImplementation(unsigned int seconds, const char* message)
+{
+    alarm(0);
+    watchdogMessage = message;
+    if (seconds == 0) {
+        signal(SIGALRM, SIG_DFL);
+        return;
+    }
+    signal(SIGALRM, WatchdogSignalHandler);
+    alarm(seconds);
+}
+
+#else
+
+static void PlatformSpecificSetWatchdogImplementation(unsigned int, const char*)
+{
+}
+
+#endif
+
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = PlatformSpecificSetWatchdogImplementation;
+
 /* Wish we could add an attribute to the format for discovering mis-use... but the __attribute__(format) seems to not work on va_list */
 #ifdef __clang__
 #pragma clang diagnostic ignored "-Wformat-nonliteral"
@@ -253,11 +332,21 @@ static void PlatformSpecificFPutsImplementation(const char* str, PlatformSpecifi
    fputs(str, (FILE*)file);
 }
 
+static char* PlatformSpecificFGetsImplementation(char* str, int size, PlatformSpecificFile file)
+{
+   return fgets(str, size, (FILE*)file);
+}
+
 static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
 {
    fclose((FILE*)file);
 }
 
+static void PlatformSpecificFFlushImplementation(PlatformSpecificFile file)
+{
+   fflush((FILE*)file);
+}
+
 static void PlatformSpecificFlushImplementation()
 {
   fflush(stdout);
@@ -267,7 +356,9 @@ PlatformSpecificFile PlatformSpecificStdOut = stdout;
 
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
 void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+char* (*PlatformSpecificFGets)(char*, int, PlatformSpecificFile) = PlatformSpecificFGetsImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile) = PlatformSpecificFFlushImplementation;
 
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
 
@@ -295,6 +386,7 @@ static int IsInfImplementation(double d)
 }
 
 double (*PlatformSpecificFabs)(double) = fabs;
+double (*PlatformSpecificSqrt)(double) = sqrt;
 void (*PlatformSpecificSrand)(unsigned int) = srand;
 int (*PlatformSpecificRand)(void) = rand;
 int (*PlatformSpecificIsNan)(double) = IsNanImplementation;
@@ -49,13 +49,17 @@ int (*PlatformSpecificSetJmp)(void (*)(void*), void*) = NULLPTR;
 void (*PlatformSpecificRestoreJumpBuffer)() = NULLPTR;
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = NULLPTR;
+unsigned long (*GetPlatformSpecificTimeInMicros)() = NULLPTR;
 const char* (*GetPlatformSpecificTimeString)() = NULLPTR;
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = NULLPTR;
 
 /* IO operations */
 PlatformSpecificFile PlatformSpecificStdOut = NULLPTR;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = NULLPTR;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = NULLPTR;
+char* (*PlatformSpecificFGets)(char* str, int size, PlatformSpecificFile file) = NULLPTR;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = NULLPTR;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile file) = NULLPTR;
 
 void (*PlatformSpecificFlush)(void) = NULLPTR;
 
@@ -69,6 +73,7 @@ void* (*PlatformSpecificMemCpy)(void*, const void*, size_t) = NULLPTR;
 void* (*PlatformSpecificMemset)(void*, int, size_t) = NULLPTR;
 
 double (*PlatformSpecificFabs)(double) = NULLPTR;
+double (*PlatformSpecificSqrt)(double) = NULLPTR;
 int (*PlatformSpecificIsNan)(double) = NULLPTR;
 int (*PlatformSpecificIsInf)(double) = NULLPTR;
 int (*PlatformSpecificAtExit)(void(*func)(void)) = NULLPTR;
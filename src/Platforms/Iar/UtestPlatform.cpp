@@ -122,8 +122,21 @@ static const char* TimeStringImplementation()
 }
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = TimeInMillisImplementation;
+
+static unsigned long TimeInMicrosImplementation()
+{
+    return TimeInMillisImplementation() * 1000;
+}
+
+unsigned long (*GetPlatformSpecificTimeInMicros)() = TimeInMicrosImplementation;
 const char* (*GetPlatformSpecificTimeString)() = TimeStringImplementation;
 
+static void PlatformSpecificSetWatchdogImplementation(unsigned int, const char*)
+{
+}
+
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = PlatformSpecificSetWatchdogImplementation;
+
 int (*PlatformSpecificVSNprintf)(char *str, size_t size, const char* format, va_list args) = vsnprintf;
 
 static PlatformSpecificFile PlatformSpecificFOpenImplementation(const char* filename, const char* flag)
@@ -142,11 +155,24 @@ static void PlatformSpecificFPutsImplementation(const char* str, PlatformSpecifi
     printf("FILE%d:%s",(int)file, str);
 }
 
+static char* PlatformSpecificFGetsImplementation(char* str, int size, PlatformSpecificFile file)
+{
+    (void)str;
+    (void)size;
+    (void)file;
+    return NULL;
+}
+
 static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
 {
     (void)file;
 }
 
+static void PlatformSpecificFFlushImplementation(PlatformSpecificFile file)
+{
+    (void)file;
+}
+
 static void PlatformSpecificFlushImplementation()
 {
 }
@@ -154,7 +180,9 @@ static void PlatformSpecificFlushImplementation()
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
 void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+char* (*PlatformSpecificFGets)(char*, int, PlatformSpecificFile) = PlatformSpecificFGetsImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile) = PlatformSpecificFFlushImplementation;
 
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
 
@@ -175,6 +203,7 @@ static int IsInfImplementation(double d)
 }
 
 double (*PlatformSpecificFabs)(double) = fabs;
+double (*PlatformSpecificSqrt)(double) = sqrt;
 int (*PlatformSpecificIsNan)(double) = IsNanImplementation;
 int (*PlatformSpecificIsInf)(double) = IsInfImplementation;
 int (*PlatformSpecificAtExit)(void(*func)(void)) = atexit;  /// this was undefined before
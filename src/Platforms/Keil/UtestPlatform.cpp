@@ -119,6 +119,13 @@ extern "C"
 
     unsigned long (*GetPlatformSpecificTimeInMillis)() = TimeInMillisImplementation;
 
+    static unsigned long TimeInMicrosImplementation()
+    {
+        return TimeInMillisImplementation() * 1000;
+    }
+
+    unsigned long (*GetPlatformSpecificTimeInMicros)() = TimeInMicrosImplementation;
+
     static const char* TimeStringImplementation()
     {
         time_t tm = 0;//time(NULL); // todo
@@ -127,6 +134,12 @@ extern "C"
 
     const char* (*GetPlatformSpecificTimeString)() = TimeStringImplementation;
 
+    static void PlatformSpecificSetWatchdogImplementation(unsigned int, const char*)
+    {
+    }
+
+    void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = PlatformSpecificSetWatchdogImplementation;
+
     int PlatformSpecificAtoI(const char* str)
     {
         return atoi(str);
@@ -147,10 +160,19 @@ extern "C"
         printf("%s", str);
     }
 
+    static char* PlatformSpecificFGetsImplementation(char* str, int size, PlatformSpecificFile file)
+    {
+        return 0;
+    }
+
     static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
     {
     }
 
+    static void PlatformSpecificFFlushImplementation(PlatformSpecificFile file)
+    {
+    }
+
     static void PlatformSpecificFlushImplementation()
     {
     }
@@ -158,7 +180,9 @@ extern "C"
     PlatformSpecificFile PlatformSpecificStdOut = stdout;
     PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
     void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+    char* (*PlatformSpecificFGets)(char*, int, PlatformSpecificFile) = PlatformSpecificFGetsImplementation;
     void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
+    void (*PlatformSpecificFFlush)(PlatformSpecificFile) = PlatformSpecificFFlushImplementation;
 
     void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
     void* (*PlatformSpecificMalloc)(size_t) = malloc;
@@ -191,6 +215,7 @@ extern "C"
     }
 
     double (*PlatformSpecificFabs)(double) = abs;
+    double (*PlatformSpecificSqrt)(double) = sqrt;
     int (*PlatformSpecificIsNan)(double) = IsNanImplementation;
     int (*PlatformSpecificIsInf)(double) = IsInfImplementation;
     int (*PlatformSpecificAtExit)(void(*func)(void)) = DummyAtExit;
@@ -76,6 +76,12 @@ static unsigned long TimeInMillisImplementation() {
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = TimeInMillisImplementation;
 
+static unsigned long TimeInMicrosImplementation() {
+    return TimeInMillisImplementation() * 1000;
+}
+
+unsigned long (*GetPlatformSpecificTimeInMicros)() = TimeInMicrosImplementation;
+
 TestOutput::WorkingEnvironment PlatformSpecificGetWorkingEnvironment()
 {
     return TestOutput::eclipse;
@@ -88,6 +94,9 @@ static SimpleString TimeStringImplementation() {
 
 SimpleString GetPlatformSpecificTimeString() = TimeStringImplementation;
 
+void PlatformSpecificSetWatchdog(unsigned int, const char*) {
+}
+
 int PlatformSpecificVSNprintf(char* str, size_t size, const char* format, va_list args) {
     return vsnprintf(str, size, format, args);
 }
@@ -100,6 +109,10 @@ double PlatformSpecificFabs(double d) {
     return fabs(d);
 }
 
+double PlatformSpecificSqrt(double d) {
+    return sqrt(d);
+}
+
 void* PlatformSpecificMalloc(size_t size) {
     return malloc(size);
 }
@@ -131,10 +144,18 @@ void PlatformSpecificFPuts(const char* str, PlatformSpecificFile file) {
     fputs(str, (FILE*)file);
 }
 
+char* PlatformSpecificFGets(char* str, int size, PlatformSpecificFile file) {
+    return fgets(str, size, (FILE*)file);
+}
+
 void PlatformSpecificFClose(PlatformSpecificFile file) {
     fclose((FILE*)file);
 }
 
+void PlatformSpecificFFlush(PlatformSpecificFile file) {
+    fflush((FILE*)file);
+}
+
 extern "C" {
 
 static int IsNanImplementation(double d)
@@ -101,6 +101,13 @@ static unsigned long VisualCppTimeInMillis()
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = VisualCppTimeInMillis;
 
+static unsigned long VisualCppTimeInMicros()
+{
+    return VisualCppTimeInMillis() * 1000;
+}
+
+unsigned long (*GetPlatformSpecificTimeInMicros)() = VisualCppTimeInMicros;
+
 ///////////// Time in String
 
 static const char* VisualCppTimeString()
@@ -115,6 +122,12 @@ static const char* VisualCppTimeString()
 
 const char* (*GetPlatformSpecificTimeString)() = VisualCppTimeString;
 
+static void VisualCppSetWatchdog(unsigned int, const char*)
+{
+}
+
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = VisualCppSetWatchdog;
+
 ////// taken from gcc
 
 static int VisualCppVSNprintf(char *str, size_t size, const char* format, va_list args)
@@ -153,15 +166,27 @@ static void VisualCppFPuts(const char* str, PlatformSpecificFile file)
     fputs(str, (FILE*)file);
 }
 
+static char* VisualCppFGets(char* str, int size, PlatformSpecificFile file)
+{
+    return fgets(str, size, (FILE*)file);
+}
+
 static void VisualCppFClose(PlatformSpecificFile file)
 {
     fclose((FILE*)file);
 }
 
+static void VisualCppFFlush(PlatformSpecificFile file)
+{
+    fflush((FILE*)file);
+}
+
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char* filename, const char* flag) = VisualCppFOpen;
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = VisualCppFPuts;
+char* (*PlatformSpecificFGets)(char* str, int size, PlatformSpecificFile file) = VisualCppFGets;
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = VisualCppFClose;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile file) = VisualCppFFlush;
 
 static void VisualCppFlush()
 {
@@ -199,6 +224,7 @@ static int IsInfImplementation(double d)
 }
 
 double (*PlatformSpecificFabs)(double d) = fabs;
+double (*PlatformSpecificSqrt)(double d) = sqrt;
 extern "C" int (*PlatformSpecificIsNan)(double) = _isnan;
 extern "C" int (*PlatformSpecificIsInf)(double) = IsInfImplementation;
 int (*PlatformSpecificAtExit)(void(*func)(void)) = atexit;
@@ -122,8 +122,21 @@ static const char* DummyTimeStringImplementation()
 }
 
 unsigned long (*GetPlatformSpecificTimeInMillis)() = TimeInMillisImplementation;
+
+static unsigned long TimeInMicrosImplementation()
+{
+    return TimeInMillisImplementation() * 1000;
+}
+
+unsigned long (*GetPlatformSpecificTimeInMicros)() = TimeInMicrosImplementation;
 const char* (*GetPlatformSpecificTimeString)() = DummyTimeStringImplementation;
 
+static void PlatformSpecificSetWatchdogImplementation(unsigned int, const char*)
+{
+}
+
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = PlatformSpecificSetWatchdogImplementation;
+
 int (*PlatformSpecificVSNprintf)(char *str, size_t size, const char* format, va_list args) = vsnprintf;
 
 static PlatformSpecificFile PlatformSpecificFOpenImplementation(const char* filename, const char* flag)
@@ -136,11 +149,21 @@ static void PlatformSpecificFPutsImplementation(const char* str, PlatformSpecifi
     fputs(str, (FILE*)file);
 }
 
+static char* PlatformSpecificFGetsImplementation(char* str, int size, PlatformSpecificFile file)
+{
+    return fgets(str, size, (FILE*)file);
+}
+
 static void PlatformSpecificFCloseImplementation(PlatformSpecificFile file)
 {
     fclose((FILE*)file);
 }
 
+static void PlatformSpecificFFlushImplementation(PlatformSpecificFile file)
+{
+    fflush((FILE*)file);
+}
+
 static void PlatformSpecificFlushImplementation()
 {
     fflush(stdout);
@@ -149,7 +172,9 @@ static void PlatformSpecificFlushImplementation()
 PlatformSpecificFile PlatformSpecificStdOut = stdout;
 PlatformSpecificFile (*PlatformSpecificFOpen)(const char*, const char*) = PlatformSpecificFOpenImplementation;
 void (*PlatformSpecificFPuts)(const char*, PlatformSpecificFile) = PlatformSpecificFPutsImplementation;
+char* (*PlatformSpecificFGets)(char*, int, PlatformSpecificFile) = PlatformSpecificFGetsImplementation;
 void (*PlatformSpecificFClose)(PlatformSpecificFile) = PlatformSpecificFCloseImplementation;
+void (*PlatformSpecificFFlush)(PlatformSpecificFile) = PlatformSpecificFFlushImplementation;
 
 void (*PlatformSpecificFlush)() = PlatformSpecificFlushImplementation;
 
@@ -178,6 +203,7 @@ static int AtExitImplementation(void(*func)(void))
 }
 
 double (*PlatformSpecificFabs)(double) = fabs;
+double (*PlatformSpecificSqrt)(double) = sqrt;
 int (*PlatformSpecificIsNan)(double) = IsNanImplementation;
 int (*PlatformSpecificIsInf)(double) = IsInfImplementation;
 int (*PlatformSpecificAtExit)(void(*func)(void)) = AtExitImplementation;
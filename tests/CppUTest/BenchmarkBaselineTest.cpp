@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/BenchmarkBaseline.h"
+#include "CppUTest/TestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+static SimpleString* fakeFileContents;
+static bool fakeFileExists;
+static size_t fakeReadPosition;
+static int fakeFileHandle;
+
+static PlatformSpecificFile fakeFOpen(const char*, const char* mode)
+{
+    if (SimpleString(mode) == "w") {
+        fakeFileExists = true;
+        *fakeFileContents = "";
+    }
+    else if (!fakeFileExists)
+        return NULLPTR;
+    fakeReadPosition = 0;
+    return &fakeFileHandle;
+}
+
+static char* fakeFGets(char* str, int size, PlatformSpecificFile)
+{
+    const char* source = fakeFileContents->asCharString();
+    if (source[fakeReadPosition] == '\0') return NULLPTR;
+
+    int length = 0;
+    while (length < size - 1 && source[fakeReadPosition] != '\0') {
+        str[length++] = source[fakeReadPosition];
+        if (source[fakeReadPosition++] == '\n') break;
+    }
+    str[length] = '\0';
+    return str;
+}
+
+static void fakeFPuts(const char* str, PlatformSpecificFile)
+{
+    *fakeFileContents += str;
+}
+
+static void fakeFClose(PlatformSpecificFile)
+{
+}
+
+TEST_GROUP(BenchmarkBaseline)
+{
+    BenchmarkBaseline benchmarks;
+    BenchmarkBaseline baseline;
+    StringBufferTestOutput output;
+    SimpleString fileContents;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        fakeFileContents = &fileContents;
+        fakeFileExists = false;
+        UT_PTR_SET(PlatformSpecificFOpen, fakeFOpen);
+        UT_PTR_SET(PlatformSpecificFGets, fakeFGets);
+        UT_PTR_SET(PlatformSpecificFPuts, fakeFPuts);
+        UT_PTR_SET(PlatformSpecificFClose, fakeFClose);
+    }
+
+    void addSamples(BenchmarkBaseline& to, const char* name, const double* samples, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            to.addSample(name, samples[i]);
+    }
+};
+
+TEST(BenchmarkBaseline, addsTheSamplesOfAResult)
+{
+    BenchmarkResult result;
+    result.samples = 2;
+    result.sampleNanosecondsPerOperation[0] = 1.5;
+    result.sampleNanosecondsPerOperation[1] = 2.0;
+
+    benchmarks.addResult("group.name", result);
+    benchmarks.addResult("group.name", result);
+    benchmarks.addResult("group.other", result);
+
+    LONGS_EQUAL(2, benchmarks.size());
+    CHECK(benchmarks.write("baseline.txt"));
+    STRCMP_CONTAINS("group.name 1.500 2.000 1.500 2.000\ngroup.other 1.500 2.000\n", fileContents.asCharString());
+}
+
+TEST(BenchmarkBaseline, writesACommentFirst)
+{
+    benchmarks.addSample("group.name", 3.0);
+    CHECK(benchmarks.write("baseline.txt"));
+    CHECK(fileContents.startsWith("# "));
+}
+
+TEST(BenchmarkBaseline, readFailsWhenThereIsNoFile)
+{
+    CHECK_FALSE(baseline.read("baseline.txt"));
+}
+
+TEST(BenchmarkBaseline, readsWhatWasWritten)
+{
+    const double samples[] = { 12.5, 1000.125, 0.25 };
+    addSamples(benchmarks, "group.name", samples, 3);
+    benchmarks.write("baseline.txt");
+    CHECK(baseline.read("baseline.txt"));
+
+    CHECK(baseline.write("again.txt"));
+    STRCMP_CONTAINS("group.name 12.500 1000.125 0.250\n", fileContents.asCharString());
+    LONGS_EQUAL(1, baseline.size());
+}
+
+TEST(BenchmarkBaseline, readsLinesLongerThanTheReadBuffer)
+{
+    SimpleString line = "group.name";
+    for (size_t i = 0; i < 100; i++)
+        line += " 1.000";
+    fakeFileExists = true;
+    fileContents = line + "\n";
+    CHECK(baseline.read("baseline.txt"));
+
+    fileContents = "";
+    baseline.write("again.txt");
+    STRCMP_CONTAINS(line.asCharString(), fileContents.asCharString());
+}
+
+TEST(BenchmarkBaseline, mannWhitneyZIsZeroForTheSameSamples)
+{
+    const double samples[] = { 1.0, 2.0, 3.0 };
+    DOUBLES_EQUAL(0.0, BenchmarkBaseline::mannWhitneyZ(samples, 3, samples, 3), 0.0001);
+}
+
+TEST(BenchmarkBaseline, mannWhitneyZIsPositiveWhenTheSamplesAreSlower)
+{
+    const double slower[] = { 4.0, 5.0, 6.0 };
+    const double faster[] = { 1.0, 2.0, 3.0 };
+    DOUBLES_EQUAL(1.9640, BenchmarkBaseline::mannWhitneyZ(slower, 3, faster, 3), 0.0001);
+    DOUBLES_EQUAL(-1.9640, BenchmarkBaseline::mannWhitneyZ(faster, 3, slower, 3), 0.0001);
+}
+
+TEST(BenchmarkBaseline, mannWhitneyZIsZeroWhenAllSamplesAreEqual)
+{
+    const double samples[] = { 1.0, 1.0 };
+    DOUBLES_EQUAL(0.0, BenchmarkBaseline::mannWhitneyZ(samples, 2, samples, 2), 0.0001);
+}
+
+TEST(BenchmarkBaseline, reportsARegression)
+{
+    const double slower[] = { 120.0, 121.0, 122.0, 123.0, 124.0 };
+    const double faster[] = { 100.0, 101.0, 102.0, 103.0, 104.0 };
+    addSamples(benchmarks, "group.name", slower, 5);
+    addSamples(baseline, "group.name", faster, 5);
+
+    LONGS_EQUAL(1, benchmarks.compare(baseline, output, 0.10));
+    STRCMP_CONTAINS("group.name: baseline 102.00, now 122.00, delta +19.6%, z 2.61 - regression\n", output.getOutput().asCharString());
+    STRCMP_CONTAINS("1 benchmark regressions (significantly slower by more than 10.0%)\n", output.getOutput().asCharString());
+}
+
+TEST(BenchmarkBaseline, aSlowdownWithinTheMaximumIsNoRegression)
+{
+    const double slower[] = { 105.0, 106.0, 107.0, 108.0, 109.0 };
+    const double faster[] = { 100.0, 101.0, 102.0, 103.0, 104.0 };
+    addSamples(benchmarks, "group.name", slower, 5);
+    addSamples(baseline, "group.name", faster, 5);
+
+    LONGS_EQUAL(0, benchmarks.compare(baseline, output, 0.10));
+    STRCMP_CONTAINS("delta +4.9%", output.getOutput().asCharString());
+}
+
+TEST(BenchmarkBaseline, anInsignificantSlowdownIsNoRegression)
+{
+    const double now[] = { 50.0, 300.0, 80.0 };
+    const double before[] = { 60.0, 100.0, 70.0 };
+    addSamples(benchmarks, "group.name", now, 3);
+    addSamples(baseline, "group.name", before, 3);
+
+    LONGS_EQUAL(0, benchmarks.compare(baseline, output, 0.10));
+    STRCMP_CONTAINS("delta +14.3%", output.getOutput().asCharString());
+}
+
+TEST(BenchmarkBaseline, reportsBenchmarksThatAreNotInTheBaseline)
+{
+    benchmarks.addSample("group.new", 5.0);
+
+    LONGS_EQUAL(0, benchmarks.compare(baseline, output, 0.10));
+    STRCMP_CONTAINS("group.new: now 5.00, not in the baseline\n", output.getOutput().asCharString());
+}
+
+TEST(BenchmarkBaseline, reportsBenchmarksOfTheBaselineThatDidNotRun)
+{
+    baseline.addSample("group.old", 5.0);
+
+    LONGS_EQUAL(0, benchmarks.compare(baseline, output, 0.10));
+    STRCMP_CONTAINS("group.old: baseline 5.00, not run\n", output.getOutput().asCharString());
+}
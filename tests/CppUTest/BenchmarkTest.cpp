@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestTestingFixture.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+static unsigned long fakeTimeInMicros = 0;
+
+static unsigned long getFakeTimeInMicros()
+{
+    return fakeTimeInMicros;
+}
+
+class FakeBenchmarkOperation : public BenchmarkOperation
+{
+public:
+    FakeBenchmarkOperation() : calls(0), sampleCosts(NULLPTR), calibrationCalls(0)
+    {
+    }
+
+    virtual void run(size_t iterations) CPPUTEST_OVERRIDE
+    {
+        unsigned long cost = 1;
+        if (sampleCosts && calls >= calibrationCalls)
+            cost = sampleCosts[calls - calibrationCalls];
+        fakeTimeInMicros += (unsigned long) iterations * cost;
+        calls++;
+    }
+
+    size_t calls;
+    const unsigned long* sampleCosts;
+    size_t calibrationCalls;
+};
+
+TEST_GROUP(BenchmarkRunner)
+{
+    FakeBenchmarkOperation operation;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        fakeTimeInMicros = 0;
+        UT_PTR_SET(GetPlatformSpecificTimeInMicros, getFakeTimeInMicros);
+    }
+};
+
+TEST(BenchmarkRunner, calibratesTheIterationsUntilASampleTakesTheSampleTime)
+{
+    BenchmarkResult result = BenchmarkRunner::measure(operation, 1000, 5);
+
+    LONGS_EQUAL(1000, result.iterations);
+    LONGS_EQUAL(5, result.samples);
+    LONGS_EQUAL(4 + 5, operation.calls);
+}
+
+TEST(BenchmarkRunner, reportsTheTimePerOperationInNanoseconds)
+{
+    BenchmarkResult result = BenchmarkRunner::measure(operation, 1000, 5);
+
+    DOUBLES_EQUAL(1000.0, result.nanosecondsPerOperation, 0.001);
+    DOUBLES_EQUAL(1000.0, result.minNanosecondsPerOperation, 0.001);
+    DOUBLES_EQUAL(0.0, result.confidenceInterval, 0.001);
+}
+
+TEST(BenchmarkRunner, reportsTheMeanMinimumAndConfidenceIntervalOverTheSamples)
+{
+    const unsigned long sampleCosts[] = { 1, 3 };
+    operation.sampleCosts = sampleCosts;
+    operation.calibrationCalls = 4;
+
+    BenchmarkResult result = BenchmarkRunner::measure(operation, 1000, 2);
+
+    DOUBLES_EQUAL(2000.0, result.nanosecondsPerOperation, 0.001);
+    DOUBLES_EQUAL(1000.0, result.minNanosecondsPerOperation, 0.001);
+    DOUBLES_EQUAL(12706.0, result.confidenceInterval, 0.1);
+}
+
+TEST(BenchmarkRunner, aSingleSampleHasNoConfidenceInterval)
+{
+    BenchmarkResult result = BenchmarkRunner::measure(operation, 1000, 0);
+
+    LONGS_EQUAL(1, result.samples);
+    DOUBLES_EQUAL(0.0, result.confidenceInterval, 0.001);
+}
+
+class FreeBenchmarkOperation : public BenchmarkOperation
+{
+public:
+    FreeBenchmarkOperation() : calls(0) {}
+
+    virtual void run(size_t) CPPUTEST_OVERRIDE
+    {
+        calls++;
+    }
+
+    size_t calls;
+};
+
+TEST(BenchmarkRunner, isUnmeasurableWhenTheClockDoesNotAdvance)
+{
+    FreeBenchmarkOperation freeOperation;
+
+    BenchmarkResult result = BenchmarkRunner::measure(freeOperation, 1000, 5);
+
+    LONGS_EQUAL(0, result.iterations);
+    LONGS_EQUAL(0, result.samples);
+    LONGS_EQUAL(8, freeOperation.calls);
+}
+
+static FakeBenchmarkOperation* benchmarkOperation;
+
+static void runBenchmark()
+{
+    BenchmarkRunner::run(*benchmarkOperation);
+}
+
+TEST(BenchmarkRunner, runReportsTheResultToTheCurrentTest)
+{
+    TestTestingFixture fixture;
+    benchmarkOperation = &operation;
+    fixture.setTestFunction(runBenchmark);
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("BENCHMARK(ExecFunction, ExecFunction): 1000.00 ns/op +/- 0.00 (95% CI), min 1000.00, 10 x 10000 iterations");
+}
+
+static void runUnmeasurableBenchmark()
+{
+    FreeBenchmarkOperation freeOperation;
+    BenchmarkRunner::run(freeOperation);
+}
+
+TEST(BenchmarkRunner, runReportsAnUnmeasurableBenchmark)
+{
+    TestTestingFixture fixture;
+    fixture.setTestFunction(runUnmeasurableBenchmark);
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("BENCHMARK(ExecFunction, ExecFunction): unmeasurable, the clock does not advance");
+}
+
+TEST_GROUP(Benchmark)
+{
+    SimpleString text;
+};
+
+BENCHMARK(Benchmark, StringFromLong)
+{
+    text = StringFrom(12345L);
+    BENCHMARK_DO_NOT_OPTIMIZE(text);
+}
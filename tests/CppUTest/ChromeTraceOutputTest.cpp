@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+#include "CppUTest/ChromeTraceTestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+class ChromeTraceOutputToBuffer : public ChromeTraceTestOutput
+{
+public:
+    ChromeTraceOutputToBuffer() : openCount(0), closeCount(0), isOpen(false)
+    {
+    }
+
+    SimpleString contents;
+    SimpleString lastMode;
+    int openCount;
+    int closeCount;
+    bool isOpen;
+
+protected:
+    virtual void openFile(const char* mode) CPPUTEST_OVERRIDE
+    {
+        lastMode = mode;
+        openCount++;
+        isOpen = true;
+    }
+
+    virtual void writeToFile(const SimpleString& buffer) CPPUTEST_OVERRIDE
+    {
+        if (!isOpen) openFile("a");
+        contents += buffer;
+    }
+
+    virtual void closeFile() CPPUTEST_OVERRIDE
+    {
+        if (isOpen) closeCount++;
+        isOpen = false;
+    }
+};
+
+static unsigned long microsTime;
+
+extern "C" {
+
+    static unsigned long MockGetPlatformSpecificTimeInMicros()
+    {
+        microsTime += 10;
+        return microsTime;
+    }
+
+}
+
+TEST_GROUP(ChromeTraceOutputTest)
+{
+    ChromeTraceOutputToBuffer* output;
+    UtestShell* tst;
+    TestResult* result;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        output = new ChromeTraceOutputToBuffer;
+        tst = new UtestShell("group", "test", "file", 10);
+        result = new TestResult(*output);
+        microsTime = 0;
+        UT_PTR_SET(GetPlatformSpecificTimeInMicros, MockGetPlatformSpecificTimeInMicros);
+    }
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        delete result;
+        delete tst;
+        delete output;
+    }
+};
+
+TEST(ChromeTraceOutputTest, StartsAJsonArrayWithTheTrackNames)
+{
+    result->testsStarted();
+
+    STRCMP_EQUAL("w", output->lastMode.asCharString());
+    STRCMP_EQUAL("[\n"
+                 "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"CppUTest\"}},\n"
+                 "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"tests\"}},\n"
+                 "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"separate processes\"}}",
+                 output->contents.asCharString());
+}
+
+TEST(ChromeTraceOutputTest, EndsTheArrayAndClosesTheFile)
+{
+    result->testsStarted();
+    output->contents = "";
+    result->testsEnded();
+
+    STRCMP_EQUAL("\n]\n", output->contents.asCharString());
+    LONGS_EQUAL(1, output->closeCount);
+}
+
+TEST(ChromeTraceOutputTest, TestIsACompleteSlice)
+{
+    result->currentTestStarted(tst);
+    result->currentTestEnded(tst);
+
+    STRCMP_EQUAL(",\n{\"name\":\"TEST(group, test)\",\"cat\":\"test\",\"ph\":\"X\",\"ts\":10,\"dur\":10,\"pid\":1,\"tid\":1}",
+                 output->contents.asCharString());
+}
+
+TEST(ChromeTraceOutputTest, GroupIsACompleteSlice)
+{
+    result->currentGroupStarted(tst);
+    result->currentTestStarted(tst);
+    result->currentTestEnded(tst);
+    result->currentGroupEnded(tst);
+
+    STRCMP_CONTAINS(",\n{\"name\":\"group\",\"cat\":\"group\",\"ph\":\"X\",\"ts\":10,\"dur\":30,\"pid\":1,\"tid\":1}",
+                    output->contents.asCharString());
+}
+
+TEST(ChromeTraceOutputTest, GroupWithoutTestsThatRanIsLeftOut)
+{
+    result->currentGroupStarted(tst);
+    result->currentGroupEnded(tst);
+
+    STRCMP_EQUAL("", output->contents.asCharString());
+}
+
+TEST(ChromeTraceOutputTest, PhasesAreWrittenWhenTheyEnd)
+{
+    result->currentTestStarted(tst);
+    result->currentTestPhaseStarted("setup");
+    result->currentTestPhaseEnded("setup");
+
+    STRCMP_EQUAL(",\n{\"name\":\"setup\",\"cat\":\"phase\",\"ph\":\"X\",\"ts\":20,\"dur\":10,\"pid\":1,\"tid\":1}",
+                 output->contents.asCharString());
+}
+
+TEST(ChromeTraceOutputTest, PhaseThatDidNotEndIsLeftOut)
+{
+    result->currentTestStarted(tst);
+    result->currentTestPhaseStarted("pre-test plugins");
+    result->currentTestPhaseStarted("body");
+    result->currentTestPhaseEnded("pre-test plugins");
+
+    STRCMP_CONTAINS("\"name\":\"pre-test plugins\"", output->contents.asCharString());
+    CHECK_FALSE(output->contents.contains("\"name\":\"body\""));
+}
+
+TEST(ChromeTraceOutputTest, PhaseEndWithoutStartIsIgnored)
+{
+    result->currentTestStarted(tst);
+    result->currentTestPhaseEnded("teardown");
+
+    STRCMP_EQUAL("", output->contents.asCharString());
+}
+
+TEST(ChromeTraceOutputTest, NamesAreJsonEscaped)
+{
+    UtestShell weird("group", "\"quoted\"\\\n", "file", 10);
+    result->currentTestStarted(&weird);
+    result->currentTestEnded(&weird);
+
+    STRCMP_CONTAINS("\"name\":\"TEST(group, \\\"quoted\\\"\\\\\\n)\"", output->contents.asCharString());
+}
+
+TEST(ChromeTraceOutputTest, PhasesOfTestsInASeparateProcessGoToTheirOwnTrackAndCloseTheFile)
+{
+    tst->setRunInSeperateProcess();
+    result->testsStarted();
+    output->contents = "";
+
+    result->currentTestStarted(tst);
+    LONGS_EQUAL(1, output->closeCount);
+
+    result->currentTestPhaseStarted("body");
+    result->currentTestPhaseEnded("body");
+
+    STRCMP_CONTAINS("\"name\":\"body\",\"cat\":\"phase\",\"ph\":\"X\",\"ts\":20,\"dur\":10,\"pid\":1,\"tid\":2}", output->contents.asCharString());
+    STRCMP_EQUAL("a", output->lastMode.asCharString());
+    LONGS_EQUAL(2, output->closeCount);
+}
+
+TEST(ChromeTraceOutputTest, RunningATestWritesNestedPhases)
+{
+    TestRegistry registry;
+    UtestShell shell("group", "test", "file", 1);
+    registry.addTest(&shell);
+
+    registry.runAllTests(*result);
+
+    const char* contents = output->contents.asCharString();
+    STRCMP_CONTAINS("\"name\":\"pre-test plugins\"", contents);
+    STRCMP_CONTAINS("\"name\":\"setup\"", contents);
+    STRCMP_CONTAINS("\"name\":\"body\"", contents);
+    STRCMP_CONTAINS("\"name\":\"teardown\"", contents);
+    STRCMP_CONTAINS("\"name\":\"post-test plugins\"", contents);
+    STRCMP_CONTAINS("\"name\":\"TEST(group, test)\"", contents);
+    STRCMP_CONTAINS("\"name\":\"group\",\"cat\":\"group\"", contents);
+}
+
+/* What fputs wrote is only in the file once it is flushed */
+static SimpleString* openedFileName;
+static SimpleString* writtenToFile;
+static SimpleString* flushedToFile;
+
+static PlatformSpecificFile fakeFOpen(const char* fileName, const char*)
+{
+    *openedFileName = fileName;
+    return (PlatformSpecificFile) flushedToFile;
+}
+
+static void fakeFPuts(const char* str, PlatformSpecificFile)
+{
+    *writtenToFile += str;
+}
+
+static void fakeFFlush(PlatformSpecificFile)
+{
+    *flushedToFile += *writtenToFile;
+    *writtenToFile = "";
+}
+
+static void fakeFClose(PlatformSpecificFile file)
+{
+    fakeFFlush(file);
+}
+
+TEST_GROUP(ChromeTraceOutputFileTest)
+{
+    SimpleString fileName;
+    SimpleString written;
+    SimpleString flushed;
+    UtestShell* tst;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        openedFileName = &fileName;
+        writtenToFile = &written;
+        flushedToFile = &flushed;
+        UT_PTR_SET(PlatformSpecificFOpen, fakeFOpen);
+        UT_PTR_SET(PlatformSpecificFPuts, fakeFPuts);
+        UT_PTR_SET(PlatformSpecificFFlush, fakeFFlush);
+        UT_PTR_SET(PlatformSpecificFClose, fakeFClose);
+        tst = new UtestShell("group", "test", "file", 10);
+    }
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        delete tst;
+    }
+};
+
+TEST(ChromeTraceOutputFileTest, FileIsFlushedAfterEveryTestAndGroup)
+{
+    ChromeTraceTestOutput output;
+    TestResult result(output);
+    result.testsStarted();
+    result.currentGroupStarted(tst);
+    result.currentTestStarted(tst);
+    result.currentTestEnded(tst);
+    STRCMP_CONTAINS("\"cat\":\"test\"", flushed.asCharString());
+
+    result.currentGroupEnded(tst);
+    STRCMP_CONTAINS("\"cat\":\"group\"", flushed.asCharString());
+    STRCMP_EQUAL("", written.asCharString());
+}
+
+TEST(ChromeTraceOutputFileTest, FileNameIsTheDefaultWithoutAPackageName)
+{
+    ChromeTraceTestOutput output;
+    output.setPackageName("");
+    output.printTestsStarted();
+
+    STRCMP_EQUAL("cpputest_trace.json", fileName.asCharString());
+}
+
+TEST(ChromeTraceOutputFileTest, PackageNameGoesIntoTheFileName)
+{
+    ChromeTraceTestOutput output;
+    output.setPackageName("pack/age");
+    output.printTestsStarted();
+
+    STRCMP_EQUAL("cpputest_trace_pack_age.json", fileName.asCharString());
+}
@@ -494,6 +494,47 @@ TEST(CommandLineArguments, setTeamCityOutputDifferentParameter)
     CHECK(args->isTeamCityOutput());
 }
 
+TEST(CommandLineArguments, setJUnitSingleFileOutput)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "-ojunitsingle" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isJUnitSingleFileOutput());
+    CHECK_FALSE(args->isJUnitOutput());
+}
+
+TEST(CommandLineArguments, setChromeTraceOutput)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "-ochrometrace" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isChromeTraceOutput());
+}
+
+TEST(CommandLineArguments, setResultLogOutput)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "-oresultlog" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isResultLogOutput());
+}
+
+TEST(CommandLineArguments, setTapOutput)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "-otap" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isTapOutput());
+}
+
+TEST(CommandLineArguments, setJsonLinesOutput)
+{
+    int argc = 3;
+    const char* argv[] = { "tests.exe", "-o", "jsonl" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isJsonLinesOutput());
+}
+
 TEST(CommandLineArguments, setOutputToGarbage)
 {
     int argc = 3;
@@ -531,7 +572,9 @@ TEST(CommandLineArguments, printUsage)
             "usage [-h] [-v] [-vv] [-c] [-p] [-lg] [-ln] [-ll] [-ri] [-r[<#>]] [-f] [-e] [-ci]\n"
             "      [-g|sg|xg|xsg <groupName>]... [-n|sn|xn|xsn <testName>]... [-t|st|xt|xst <groupName>.<testName>]...\n"
             "      [-b] [-s [<seed>]] [\"[IGNORE_]TEST(<groupName>, <testName>)\"]...\n"
-            "      [-o{normal|eclipse|junit|teamcity}] [-k <packageName>]\n",
+            "      [-o{normal|eclipse|junit|junitsingle|teamcity|chrometrace|resultlog|tap|jsonl}] [-k <packageName>]\n"
+            "      [--fail-fast] [--failed-first[=<file>]] [--timeout=<seconds>] [--stats[=<cv%>]]\n"
+            "      [--benchmarks] [--save-baseline=<file>] [--compare-baseline=<file>] [--max-slowdown=<percent>]\n",
             args->usage());
 }
 
@@ -582,6 +625,10 @@ TEST(CommandLineArguments, checkContinuousIntegrationMode)
     CHECK(SimpleString("") == args->getPackageName());
     CHECK(!args->isCrashingOnFail());
     CHECK_FALSE(args->isRethrowingExceptions());
+    CHECK_FALSE(args->isFailFast());
+    CHECK_FALSE(args->isRunningFailedTestsFirst());
+    LONGS_EQUAL(0, args->getTimeout());
+    CHECK_FALSE(args->isReportingStatistics());
 }
 
 TEST(CommandLineArguments, setPackageName)
@@ -592,6 +639,86 @@ TEST(CommandLineArguments, setPackageName)
     CHECK_EQUAL(SimpleString("package"), args->getPackageName());
 }
 
+TEST(CommandLineArguments, setFailFast)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--fail-fast" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isFailFast());
+}
+
+TEST(CommandLineArguments, setFailedFirstUsesDefaultFile)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--failed-first" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isRunningFailedTestsFirst());
+    STRCMP_EQUAL("cpputest_failed_tests.txt", args->getFailedTestsFile().asCharString());
+}
+
+TEST(CommandLineArguments, setFailedFirstWithFile)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--failed-first=last_run.txt" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isRunningFailedTestsFirst());
+    STRCMP_EQUAL("last_run.txt", args->getFailedTestsFile().asCharString());
+}
+
+TEST(CommandLineArguments, setTimeout)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--timeout=30" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(30, args->getTimeout());
+}
+
+TEST(CommandLineArguments, setTimeoutWithoutSecondsReturnsFalse)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--timeout=" };
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, setTimeoutOfZeroReturnsFalse)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--timeout=0" };
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, setStatistics)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--stats" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isReportingStatistics());
+    LONGS_EQUAL(0, args->getUnstablePercentage());
+}
+
+TEST(CommandLineArguments, setStatisticsWithUnstablePercentage)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--stats=15" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isReportingStatistics());
+    LONGS_EQUAL(15, args->getUnstablePercentage());
+}
+
+TEST(CommandLineArguments, setStatisticsWithInvalidPercentageReturnsFalse)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--stats=x" };
+    CHECK(!newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, unknownLongOptionReturnsFalse)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--failed-firstly" };
+    CHECK(!newArgumentParser(argc, argv));
+}
+
 TEST(CommandLineArguments, lotsOfGroupsAndTests)
 {
     int argc = 10;
@@ -621,6 +748,74 @@ TEST(CommandLineArguments, setOptRun)
     CHECK(args->isRunIgnored());
 }
 
+TEST(CommandLineArguments, runBenchmarks)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--benchmarks"};
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isRunningBenchmarks());
+}
+
+TEST(CommandLineArguments, benchmarksAreNotRunByDefault)
+{
+    int argc = 1;
+    const char* argv[] = { "tests.exe" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK_FALSE(args->isRunningBenchmarks());
+}
+
+TEST(CommandLineArguments, saveBaselineRunsTheBenchmarks)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--save-baseline=baseline.txt" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isRunningBenchmarks());
+    CHECK(args->isSavingBenchmarkBaseline());
+    STRCMP_EQUAL("baseline.txt", args->getSaveBaselineFile().asCharString());
+    CHECK_FALSE(args->isComparingBenchmarkBaseline());
+}
+
+TEST(CommandLineArguments, compareBaselineRunsTheBenchmarks)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--compare-baseline=baseline.txt" };
+    CHECK(newArgumentParser(argc, argv));
+    CHECK(args->isRunningBenchmarks());
+    CHECK(args->isComparingBenchmarkBaseline());
+    STRCMP_EQUAL("baseline.txt", args->getCompareBaselineFile().asCharString());
+    CHECK_FALSE(args->isSavingBenchmarkBaseline());
+}
+
+TEST(CommandLineArguments, baselineNeedsAFile)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--save-baseline=" };
+    CHECK_FALSE(newArgumentParser(argc, argv));
+}
+
+TEST(CommandLineArguments, maximumSlowdownIsTenPercentByDefault)
+{
+    int argc = 1;
+    const char* argv[] = { "tests.exe" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(10, args->getMaximumSlowdownPercentage());
+}
+
+TEST(CommandLineArguments, setMaximumSlowdown)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--max-slowdown=0" };
+    CHECK(newArgumentParser(argc, argv));
+    LONGS_EQUAL(0, args->getMaximumSlowdownPercentage());
+}
+
+TEST(CommandLineArguments, maximumSlowdownNeedsANumber)
+{
+    int argc = 2;
+    const char* argv[] = { "tests.exe", "--max-slowdown=x" };
+    CHECK_FALSE(newArgumentParser(argc, argv));
+}
+
 TEST(CommandLineArguments, setOptCrashOnFail)
 {
     int argc = 2;
@@ -40,12 +40,18 @@ public:
 
     bool returnValue;
     int amountOfPlugins;
+    int postRuns;
 
     DummyPluginWhichCountsThePlugins(const SimpleString& name, TestRegistry* registry) :
-        TestPlugin(name), returnValue(true), amountOfPlugins(0), registry_(registry)
+        TestPlugin(name), returnValue(true), amountOfPlugins(0), postRuns(0), registry_(registry)
     {
     }
 
+    virtual void postRunAction(TestResult&) CPPUTEST_OVERRIDE
+    {
+        postRuns++;
+    }
+
     virtual bool parseArguments(int, const char *const *, int) CPPUTEST_OVERRIDE
     {
         /* Remove ourselves from the count */
@@ -62,10 +68,15 @@ public:
   StringBufferTestOutput* fakeJUnitOutputWhichIsReallyABuffer_;
   StringBufferTestOutput* fakeConsoleOutputWhichIsReallyABuffer;
   StringBufferTestOutput* fakeTCOutputWhichIsReallyABuffer;
+  StringBufferTestOutput* fakeChromeTraceOutputWhichIsReallyABuffer;
+  StringBufferTestOutput* fakeResultLogOutputWhichIsReallyABuffer;
+  StringBufferTestOutput* fakeStreamingOutputWhichIsReallyABuffer;
 
   CommandLineTestRunnerWithStringBufferOutput(int argc, const char *const *argv, TestRegistry* registry)
     : CommandLineTestRunner(argc, argv, registry), fakeJUnitOutputWhichIsReallyABuffer_(NULLPTR),
-    fakeConsoleOutputWhichIsReallyABuffer(NULLPTR), fakeTCOutputWhichIsReallyABuffer(NULLPTR)
+    fakeConsoleOutputWhichIsReallyABuffer(NULLPTR), fakeTCOutputWhichIsReallyABuffer(NULLPTR),
+    fakeChromeTraceOutputWhichIsReallyABuffer(NULLPTR), fakeResultLogOutputWhichIsReallyABuffer(NULLPTR),
+    fakeStreamingOutputWhichIsReallyABuffer(NULLPTR)
   {}
 
   TestOutput* createConsoleOutput() CPPUTEST_OVERRIDE
@@ -80,11 +91,41 @@ public:
     return fakeJUnitOutputWhichIsReallyABuffer_;
   }
 
+  TestOutput* createJUnitSingleFileOutput(const SimpleString&) CPPUTEST_OVERRIDE
+  {
+    fakeJUnitOutputWhichIsReallyABuffer_ = new StringBufferTestOutput;
+    return fakeJUnitOutputWhichIsReallyABuffer_;
+  }
+
   TestOutput* createTeamCityOutput() CPPUTEST_OVERRIDE
   {
     fakeTCOutputWhichIsReallyABuffer = new StringBufferTestOutput;
     return fakeTCOutputWhichIsReallyABuffer;
   }
+
+  TestOutput* createChromeTraceOutput(const SimpleString&) CPPUTEST_OVERRIDE
+  {
+    fakeChromeTraceOutputWhichIsReallyABuffer = new StringBufferTestOutput;
+    return fakeChromeTraceOutputWhichIsReallyABuffer;
+  }
+
+  TestOutput* createResultLogOutput() CPPUTEST_OVERRIDE
+  {
+    fakeResultLogOutputWhichIsReallyABuffer = new StringBufferTestOutput;
+    return fakeResultLogOutputWhichIsReallyABuffer;
+  }
+
+  TestOutput* createTapOutput() CPPUTEST_OVERRIDE
+  {
+    fakeStreamingOutputWhichIsReallyABuffer = new StringBufferTestOutput;
+    return fakeStreamingOutputWhichIsReallyABuffer;
+  }
+
+  TestOutput* createJsonLinesOutput() CPPUTEST_OVERRIDE
+  {
+    fakeStreamingOutputWhichIsReallyABuffer = new StringBufferTestOutput;
+    return fakeStreamingOutputWhichIsReallyABuffer;
+  }
 };
 
 TEST_GROUP(CommandLineTestRunner)
@@ -130,6 +171,17 @@ TEST(CommandLineTestRunner, OnePluginGetsInstalledDuringTheRunningTheTests)
     LONGS_EQUAL(1, pluginCountingPlugin->amountOfPlugins);
 }
 
+TEST(CommandLineTestRunner, PostRunActionRunsOnceOverTheRepetitions)
+{
+    const char* argv[] = { "tests.exe", "-r3" };
+
+    registry.installPlugin(pluginCountingPlugin);
+    runAndGetOutput(2, argv);
+    registry.removePluginByName("PluginCountingPlugin");
+
+    LONGS_EQUAL(1, pluginCountingPlugin->postRuns);
+}
+
 TEST(CommandLineTestRunner, NoPluginsAreInstalledAtTheEndOfARunWhenTheArgumentsAreInvalid)
 {
     const char* argv[] = { "tests.exe", "-fdskjnfkds"};
@@ -191,6 +243,51 @@ TEST(CommandLineTestRunner, TeamcityOutputEnabled)
     CHECK(commandLineTestRunner.fakeTCOutputWhichIsReallyABuffer != NULLPTR);
 }
 
+TEST(CommandLineTestRunner, ChromeTraceOutputEnabledNextToTheConsoleOutput)
+{
+    const char* argv[] = {"tests.exe", "-ochrometrace"};
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+    CHECK(commandLineTestRunner.fakeChromeTraceOutputWhichIsReallyABuffer != NULLPTR);
+    STRCMP_CONTAINS("OK (1 tests", commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
+}
+
+TEST(CommandLineTestRunner, ResultLogOutputEnabledNextToTheConsoleOutput)
+{
+    const char* argv[] = {"tests.exe", "-oresultlog"};
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+    CHECK(commandLineTestRunner.fakeResultLogOutputWhichIsReallyABuffer != NULLPTR);
+    STRCMP_CONTAINS("OK (1 tests", commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
+}
+
+TEST(CommandLineTestRunner, TapOutputEnabledInsteadOfTheConsoleOutput)
+{
+    const char* argv[] = {"tests.exe", "-otap"};
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+    CHECK(commandLineTestRunner.fakeStreamingOutputWhichIsReallyABuffer != NULLPTR);
+    POINTERS_EQUAL(NULLPTR, commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer);
+}
+
+TEST(CommandLineTestRunner, JsonLinesOutputEnabledInsteadOfTheConsoleOutput)
+{
+    const char* argv[] = {"tests.exe", "-ojsonl"};
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+    CHECK(commandLineTestRunner.fakeStreamingOutputWhichIsReallyABuffer != NULLPTR);
+    POINTERS_EQUAL(NULLPTR, commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer);
+}
+
+TEST(CommandLineTestRunner, JunitSingleFileOutputEnabled)
+{
+    const char* argv[] = { "tests.exe", "-ojunitsingle"};
+
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    commandLineTestRunner.runAllTestsMain();
+    CHECK(commandLineTestRunner.fakeJUnitOutputWhichIsReallyABuffer_ != NULLPTR);
+}
+
 TEST(CommandLineTestRunner, JunitOutputEnabled)
 {
     const char* argv[] = { "tests.exe", "-ojunit"};
@@ -397,6 +494,303 @@ TEST(CommandLineTestRunner, realTeamCityOutputShouldBeCreatedAndWorkProperly)
     STRCMP_CONTAINS("##teamcity[testSuiteFinished name='group1'", fakeOutput.console.asCharString());
 }
 
+extern "C" {
+    typedef char* (*FGetsFunc)(char*, int, PlatformSpecificFile);
+}
+
+struct FakeFailedTestsFile
+{
+    FakeFailedTestsFile(const char* initialContents) : exists(initialContents != NULLPTR),
+        contents(initialContents ? initialContents : ""), readPosition(0),
+        SaveFOpen(PlatformSpecificFOpen), SaveFGets(PlatformSpecificFGets),
+        SaveFPuts(PlatformSpecificFPuts), SaveFClose(PlatformSpecificFClose)
+    {
+        currentFake = this;
+        PlatformSpecificFOpen = (FOpenFunc)fopen_fake;
+        PlatformSpecificFGets = (FGetsFunc)fgets_fake;
+        PlatformSpecificFPuts = (FPutsFunc)fputs_fake;
+        PlatformSpecificFClose = (FCloseFunc)fclose_fake;
+    }
+
+    ~FakeFailedTestsFile()
+    {
+        restoreOriginals();
+        currentFake = NULLPTR;
+    }
+
+    void restoreOriginals()
+    {
+        PlatformSpecificFOpen = SaveFOpen;
+        PlatformSpecificFGets = SaveFGets;
+        PlatformSpecificFPuts = SaveFPuts;
+        PlatformSpecificFClose = SaveFClose;
+    }
+
+    static PlatformSpecificFile fopen_fake(const char* name, const char* mode)
+    {
+        currentFake->fileName = name;
+        if (SimpleString(mode) == "w") {
+            currentFake->exists = true;
+            currentFake->contents = "";
+        }
+        else if (!currentFake->exists)
+            return (PlatformSpecificFile) NULLPTR;
+        currentFake->readPosition = 0;
+        return (PlatformSpecificFile) currentFake;
+    }
+
+    static char* fgets_fake(char* str, int size, PlatformSpecificFile)
+    {
+        const char* source = currentFake->contents.asCharString();
+        size_t& position = currentFake->readPosition;
+        if (source[position] == '\0') return NULLPTR;
+
+        int length = 0;
+        while (length < size - 1 && source[position] != '\0') {
+            str[length++] = source[position];
+            if (source[position++] == '\n') break;
+        }
+        str[length] = '\0';
+        return str;
+    }
+
+    static void fputs_fake(const char* str, PlatformSpecificFile)
+    {
+        currentFake->contents += str;
+    }
+
+    static void fclose_fake(PlatformSpecificFile)
+    {
+    }
+
+    bool exists;
+    SimpleString contents;
+    SimpleString fileName;
+    size_t readPosition;
+
+    static FakeFailedTestsFile* currentFake;
+private:
+    FOpenFunc SaveFOpen;
+    FGetsFunc SaveFGets;
+    FPutsFunc SaveFPuts;
+    FCloseFunc SaveFClose;
+};
+
+FakeFailedTestsFile* FakeFailedTestsFile::currentFake = NULLPTR;
+
+class FailingUtest : public Utest
+{
+public:
+    void testBody() CPPUTEST_OVERRIDE
+    {
+        FAIL("fails on purpose");
+    }
+};
+
+class FailingUtestShell : public UtestShell
+{
+public:
+    FailingUtestShell(const char* groupName, const char* testName)
+        : UtestShell(groupName, testName, "file", 1) {}
+    virtual Utest* createTest() CPPUTEST_OVERRIDE { return new FailingUtest; }
+};
+
+TEST(CommandLineTestRunner, failedFirstRunsThePreviouslyFailedTestsFirst)
+{
+    const char* argv[] = { "tests.exe", "-v", "--failed-first=failed.txt" };
+    registry.addTest(test2);
+
+    FakeFailedTestsFile fakeFile("group1.test1\n");
+    SimpleString text = runAndGetOutput(3, argv);
+    fakeFile.restoreOriginals();
+
+    const char* firstTest = SimpleString::StrStr(text.asCharString(), "TEST(group1, test1)");
+    const char* secondTest = SimpleString::StrStr(text.asCharString(), "TEST(group2, test2)");
+    CHECK(firstTest != NULLPTR && secondTest != NULLPTR);
+    CHECK(firstTest < secondTest);
+    STRCMP_EQUAL("failed.txt", fakeFile.fileName.asCharString());
+    STRCMP_EQUAL("", fakeFile.contents.asCharString());
+}
+
+TEST(CommandLineTestRunner, failedFirstRecordsTheFailingTests)
+{
+    const char* argv[] = { "tests.exe", "--failed-first" };
+    FailingUtestShell failing("failing", "test");
+    registry.addTest(&failing);
+
+    FakeFailedTestsFile fakeFile(NULLPTR);
+    runAndGetOutput(2, argv);
+    fakeFile.restoreOriginals();
+
+    STRCMP_EQUAL("cpputest_failed_tests.txt", fakeFile.fileName.asCharString());
+    STRCMP_EQUAL("failing.test\n", fakeFile.contents.asCharString());
+}
+
+TEST(CommandLineTestRunner, failFastKeepsPreviouslyFailedTestsThatDidNotRun)
+{
+    const char* argv[] = { "tests.exe", "--fail-fast", "--failed-first" };
+    FailingUtestShell failing("failing", "test");
+    registry.addTest(&failing);
+
+    FakeFailedTestsFile fakeFile("failing.test\ngroup1.test1\n");
+    SimpleString text = runAndGetOutput(3, argv);
+    fakeFile.restoreOriginals();
+
+    STRCMP_CONTAINS(" tests, 1 ran,", text.asCharString());
+    STRCMP_EQUAL("failing.test\ngroup1.test1\n", fakeFile.contents.asCharString());
+}
+
+TEST(CommandLineTestRunner, failFastStopsRepeatingAfterAFailingRun)
+{
+    const char* argv[] = { "tests.exe", "-r3", "--fail-fast" };
+    FailingUtestShell failing("failing", "test");
+    registry.addTest(&failing);
+
+    SimpleString text = runAndGetOutput(3, argv);
+
+    STRCMP_CONTAINS("Test run 1 of 3", text.asCharString());
+    STRCMP_CONTAINS("Errors (1 failures", text.asCharString());
+    CHECK(SimpleString::StrStr(text.asCharString(), "Test run 2 of 3") == NULLPTR);
+}
+
+TEST(CommandLineTestRunner, statisticsAreReportedOverTheRepetitions)
+{
+    const char* argv[] = { "tests.exe", "-r3", "--stats=10" };
+    SimpleString text = runAndGetOutput(3, argv);
+
+    STRCMP_CONTAINS("Execution time over the repetitions (us):\n", text.asCharString());
+    STRCMP_CONTAINS("TEST(group1, test1): runs 3 ", text.asCharString());
+    STRCMP_CONTAINS("0 unstable tests (cv above 10.0%)\n", text.asCharString());
+}
+
+static unsigned long fakeTimeInMicros = 0;
+
+static unsigned long getFakeTimeInMicrosAdvancing250()
+{
+    return fakeTimeInMicros += 250;
+}
+
+TEST(CommandLineTestRunner, statisticsAreTimedInMicroseconds)
+{
+    const char* argv[] = { "tests.exe", "-r2", "--stats" };
+    UT_PTR_SET(GetPlatformSpecificTimeInMicros, getFakeTimeInMicrosAdvancing250);
+
+    SimpleString text = runAndGetOutput(3, argv);
+
+    STRCMP_CONTAINS("TEST(group1, test1): runs 2 min 250 median 250", text.asCharString());
+}
+
+TEST(CommandLineTestRunner, noStatisticsWithoutOption)
+{
+    const char* argv[] = { "tests.exe", "-r3" };
+    SimpleString text = runAndGetOutput(2, argv);
+
+    CHECK(SimpleString::StrStr(text.asCharString(), "Execution time over the repetitions") == NULLPTR);
+}
+
+class FixedBenchmarkUtest : public Utest
+{
+public:
+    void testBody() CPPUTEST_OVERRIDE
+    {
+        BenchmarkResult result;
+        result.iterations = 1000;
+        result.samples = 3;
+        result.sampleNanosecondsPerOperation[0] = 100.0;
+        result.sampleNanosecondsPerOperation[1] = 101.0;
+        result.sampleNanosecondsPerOperation[2] = 102.0;
+        result.nanosecondsPerOperation = 101.0;
+        result.minNanosecondsPerOperation = 100.0;
+        result.confidenceInterval = 2.5;
+        UtestShell::getCurrent()->addBenchmarkResult(result);
+    }
+};
+
+class FixedBenchmarkUtestShell : public BenchmarkUtestShell
+{
+public:
+    FixedBenchmarkUtestShell(const char* groupName, const char* testName)
+        : BenchmarkUtestShell(groupName, testName, "file", 1) {}
+    virtual Utest* createTest() CPPUTEST_OVERRIDE { return new FixedBenchmarkUtest; }
+};
+
+TEST(CommandLineTestRunner, saveBaselineWritesTheSamplesOfTheBenchmarks)
+{
+    const char* argv[] = { "tests.exe", "--save-baseline=baseline.txt" };
+    FixedBenchmarkUtestShell benchmark("bench", "mark");
+    registry.addTest(&benchmark);
+
+    FakeFailedTestsFile fakeFile(NULLPTR);
+    SimpleString text = runAndGetOutput(2, argv);
+    fakeFile.restoreOriginals();
+
+    STRCMP_CONTAINS("BENCHMARK(bench, mark): 101.00 ns/op", text.asCharString());
+    STRCMP_EQUAL("baseline.txt", fakeFile.fileName.asCharString());
+    STRCMP_CONTAINS("\nbench.mark 100.000 101.000 102.000\n", fakeFile.contents.asCharString());
+}
+
+TEST(CommandLineTestRunner, compareBaselineFailsTheRunWhenABenchmarkRegressed)
+{
+    const char* argv[] = { "tests.exe", "--compare-baseline=baseline.txt" };
+    FixedBenchmarkUtestShell benchmark("bench", "mark");
+    registry.addTest(&benchmark);
+
+    FakeFailedTestsFile fakeFile("bench.mark 10.000 11.000 12.000\n");
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    int returnValue = commandLineTestRunner.runAllTestsMain();
+    fakeFile.restoreOriginals();
+
+    LONGS_EQUAL(1, returnValue);
+    STRCMP_CONTAINS("bench.mark: baseline 11.00, now 101.00, delta +818.2%, z 1.96 - regression\n",
+                    commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
+}
+
+TEST(CommandLineTestRunner, compareBaselinePassesWithinTheMaximumSlowdown)
+{
+    const char* argv[] = { "tests.exe", "--compare-baseline=baseline.txt", "--max-slowdown=900" };
+    FixedBenchmarkUtestShell benchmark("bench", "mark");
+    registry.addTest(&benchmark);
+
+    FakeFailedTestsFile fakeFile("bench.mark 10.000 11.000 12.000\n");
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(3, argv, &registry);
+    int returnValue = commandLineTestRunner.runAllTestsMain();
+    fakeFile.restoreOriginals();
+
+    LONGS_EQUAL(0, returnValue);
+    STRCMP_CONTAINS("0 benchmark regressions (significantly slower by more than 900.0%)\n",
+                    commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
+}
+
+TEST(CommandLineTestRunner, compareBaselineFailsTheRunWithoutABaseline)
+{
+    const char* argv[] = { "tests.exe", "--compare-baseline=baseline.txt" };
+
+    FakeFailedTestsFile fakeFile(NULLPTR);
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(2, argv, &registry);
+    int returnValue = commandLineTestRunner.runAllTestsMain();
+    fakeFile.restoreOriginals();
+
+    LONGS_EQUAL(1, returnValue);
+    STRCMP_CONTAINS("Could not read the benchmark baseline baseline.txt\n",
+                    commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
+}
+
+TEST(CommandLineTestRunner, baselinesCannotBeUsedWithSeparateProcesses)
+{
+    const char* argv[] = { "tests.exe", "-p", "--save-baseline=baseline.txt" };
+    FixedBenchmarkUtestShell benchmark("bench", "mark");
+    registry.addTest(&benchmark);
+
+    FakeFailedTestsFile fakeFile(NULLPTR);
+    CommandLineTestRunnerWithStringBufferOutput commandLineTestRunner(3, argv, &registry);
+    int returnValue = commandLineTestRunner.runAllTestsMain();
+    fakeFile.restoreOriginals();
+
+    LONGS_EQUAL(1, returnValue);
+    STRCMP_EQUAL("", fakeFile.fileName.asCharString());
+    STRCMP_CONTAINS("--save-baseline and --compare-baseline cannot be used with -p",
+                    commandLineTestRunner.fakeConsoleOutputWhichIsReallyABuffer->getOutput().asCharString());
+}
 
 class RunIgnoredUtest : public Utest
 {
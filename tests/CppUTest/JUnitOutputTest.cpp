@@ -159,11 +159,13 @@ class JUnitTestOutputTestRunner
     unsigned int timeTheTestTakes_;
     unsigned int numberOfChecksInTest_;
     TestFailure* testFailure_;
+    const char* propertyName_;
+    const char* propertyValue_;
 
 public:
 
     explicit JUnitTestOutputTestRunner(const TestResult& result) :
-        result_(result), currentGroupName_(NULLPTR), currentTest_(NULLPTR), firstTestInGroup_(true), timeTheTestTakes_(0), numberOfChecksInTest_(0), testFailure_(NULLPTR)
+        result_(result), currentGroupName_(NULLPTR), currentTest_(NULLPTR), firstTestInGroup_(true), timeTheTestTakes_(0), numberOfChecksInTest_(0), testFailure_(NULLPTR), propertyName_(NULLPTR), propertyValue_(NULLPTR)
     {
         millisTime = 0;
         theTime =  "1978-10-03T00:00:00";
@@ -270,6 +272,11 @@ public:
             testFailure_ = NULLPTR;
         }
 
+        if (propertyName_) {
+            result_.addTestProperty(*currentTest_, propertyName_, propertyValue_);
+            propertyName_ = NULLPTR;
+        }
+
         result_.currentTestEnded(currentTest_);
     }
 
@@ -296,6 +303,13 @@ public:
         return *this;
     }
 
+    JUnitTestOutputTestRunner& thatHasProperty(const char* name, const char* value)
+    {
+        propertyName_ = name;
+        propertyValue_ = value;
+        return *this;
+    }
+
     JUnitTestOutputTestRunner& atTime(const char* newTime)
     {
         theTime = newTime;
@@ -746,6 +760,44 @@ TEST(JUnitOutputTest, MultipleTestCasesInDifferentGroupsWithAssertions)
     STRCMP_EQUAL("<testcase classname=\"groupTwo\" name=\"testB\" assertions=\"678\" time=\"0.000\" file=\"file\" line=\"1\">\n", outputFile->line(5));
 }
 
+TEST(JUnitOutputTest, TestCaseBlockWithProperties)
+{
+    testCaseRunner->start()
+            .withGroup("groupname")
+            .withTest("testname").thatHasProperty("cycles", "<1000>")
+            .end();
+
+    outputFile = fileSystem.file("cpputest_groupname.xml");
+    STRCMP_EQUAL("<testcase classname=\"groupname\" name=\"testname\" assertions=\"0\" time=\"0.000\" file=\"file\" line=\"1\">\n", outputFile->line(5));
+    STRCMP_EQUAL("<properties>\n", outputFile->line(6));
+    STRCMP_EQUAL("<property name=\"cycles\" value=\"&lt;1000&gt;\"/>\n", outputFile->line(7));
+    STRCMP_EQUAL("</properties>\n", outputFile->line(8));
+    STRCMP_EQUAL("</testcase>\n", outputFile->line(9));
+}
+
+TEST(JUnitOutputTest, FailingTestCaseBlockWithPropertiesWritesThePropertiesFirst)
+{
+    testCaseRunner->start()
+            .withGroup("groupname")
+            .withTest("testname").thatFails("Test failed", "thisfile", 10).thatHasProperty("cycles", "1000")
+            .end();
+
+    outputFile = fileSystem.file("cpputest_groupname.xml");
+    STRCMP_EQUAL("<property name=\"cycles\" value=\"1000\"/>\n", outputFile->line(7));
+    STRCMP_EQUAL("</properties>\n", outputFile->line(8));
+    STRCMP_EQUAL("<failure message=\"thisfile:10: Test failed\" type=\"AssertionFailedError\">\n", outputFile->line(9));
+}
+
+TEST(JUnitOutputTest, PropertyOutsideOfATestCaseIsIgnored)
+{
+    UtestShell test("groupname", "testname", "file", 1);
+    junitOutput->printTestsStarted();
+    junitOutput->printTestProperty(test, "cycles", "1000");
+    junitOutput->printTestsEnded(*result);
+
+    LONGS_EQUAL(0, fileSystem.amountOfFiles());
+}
+
 TEST(JUnitOutputTest, UTPRINTOutputInJUnitOutput)
 {
     testCaseRunner->start()
@@ -767,3 +819,147 @@ TEST(JUnitOutputTest, UTPRINTOutputInJUnitOutputWithSpecials)
     outputFile = fileSystem.file("cpputest_groupname.xml");
     STRCMP_EQUAL("<system-out>The &lt;rain&gt; in &quot;Spain&quot;&#10;Goes&#13; \\mainly\\ down the Dr&amp;in&#10;</system-out>\n", outputFile->lineFromTheBack(3));
 }
+
+TEST_GROUP(JUnitSingleFileOutputTest)
+{
+    JUnitSingleFileTestOutput *junitOutput;
+    TestResult *result;
+    JUnitTestOutputTestRunner *testCaseRunner;
+    FileForJUnitOutputTests* outputFile;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        UT_PTR_SET(PlatformSpecificFOpen, mockFOpen);
+        originalFPuts = PlatformSpecificFPuts;
+        UT_PTR_SET(PlatformSpecificFPuts, mockFPuts);
+        UT_PTR_SET(PlatformSpecificFClose, mockFClose);
+        junitOutput = new JUnitSingleFileTestOutput();
+        result = new TestResult(*junitOutput);
+        testCaseRunner = new JUnitTestOutputTestRunner(*result);
+    }
+
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        delete testCaseRunner;
+        delete result;
+        delete junitOutput;
+        fileSystem.clear();
+    }
+};
+
+TEST(JUnitSingleFileOutputTest, allGroupsGoToOneFile)
+{
+    testCaseRunner->start()
+            .withGroup("groupOne").withTest("testA")
+            .withGroup("groupTwo").withTest("testB")
+            .end();
+
+    LONGS_EQUAL(1, fileSystem.amountOfFiles());
+    CHECK(fileSystem.fileExists("cpputest.xml"));
+}
+
+TEST(JUnitSingleFileOutputTest, fileNameContainsThePackageName)
+{
+    junitOutput->setPackageName("pack/age");
+    testCaseRunner->start()
+            .withGroup("groupname").withTest("testname")
+            .end();
+
+    CHECK(fileSystem.fileExists("cpputest_pack_age.xml"));
+}
+
+TEST(JUnitSingleFileOutputTest, writesATestSuitePerGroupInsideTestSuites)
+{
+    testCaseRunner->start()
+            .withGroup("groupOne").withTest("testA").thatHasChecks(3).endGroupAndClearTest()
+            .withGroup("groupTwo").withTest("testB").thatTakes(1234).seconds()
+            .end();
+
+    outputFile = fileSystem.file("cpputest.xml");
+    STRCMP_EQUAL("<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n", outputFile->line(1));
+    STRCMP_EQUAL("<testsuites>\n", outputFile->line(2));
+    STRCMP_EQUAL("<testsuite hostname=\"localhost\" name=\"groupOne\" timestamp=\"1978-10-03T00:00:00\">\n", outputFile->line(3));
+    STRCMP_EQUAL("<testcase classname=\"groupOne\" name=\"testA\" assertions=\"3\" time=\"0.000\" file=\"file\" line=\"1\">\n", outputFile->line(4));
+    STRCMP_EQUAL("</testcase>\n", outputFile->line(5));
+    STRCMP_EQUAL("</testsuite>\n", outputFile->line(6));
+    STRCMP_EQUAL("<testsuite hostname=\"localhost\" name=\"groupTwo\" timestamp=\"1978-10-03T00:00:00\">\n", outputFile->line(7));
+    STRCMP_EQUAL("<testcase classname=\"groupTwo\" name=\"testB\" assertions=\"0\" time=\"1.234\" file=\"file\" line=\"1\">\n", outputFile->line(8));
+    STRCMP_EQUAL("</testcase>\n", outputFile->line(9));
+    STRCMP_EQUAL("</testsuite>\n", outputFile->line(10));
+    STRCMP_EQUAL("</testsuites>\n", outputFile->line(11));
+}
+
+TEST(JUnitSingleFileOutputTest, failingTestCase)
+{
+    testCaseRunner->start()
+            .withGroup("groupname")
+                .withTest("testname").thatFails("Test <failed>", "thisfile", 10).thatHasProperty("cycles", "1000")
+            .end();
+
+    outputFile = fileSystem.file("cpputest.xml");
+    STRCMP_EQUAL("<properties>\n", outputFile->line(5));
+    STRCMP_EQUAL("<property name=\"cycles\" value=\"1000\"/>\n", outputFile->line(6));
+    STRCMP_EQUAL("</properties>\n", outputFile->line(7));
+    STRCMP_EQUAL("<failure message=\"thisfile:10: Test &lt;failed&gt;\" type=\"AssertionFailedError\">\n", outputFile->line(8));
+    STRCMP_EQUAL("</failure>\n", outputFile->line(9));
+    STRCMP_EQUAL("</testcase>\n", outputFile->line(10));
+}
+
+TEST(JUnitSingleFileOutputTest, ignoredTestCase)
+{
+    testCaseRunner->start()
+            .withGroup("groupname").withIgnoredTest("testname")
+            .end();
+
+    outputFile = fileSystem.file("cpputest.xml");
+    STRCMP_EQUAL("<skipped />\n", outputFile->line(5));
+}
+
+TEST(JUnitSingleFileOutputTest, outputOfATestIsWrittenToItsTestCase)
+{
+    UtestShell test("groupname", "testname", "file", 1);
+    result->testsStarted();
+    result->currentGroupStarted(&test);
+    result->currentTestStarted(&test);
+    result->print("some <output>");
+    result->currentTestEnded(&test);
+    result->currentGroupEnded(&test);
+    result->testsEnded();
+
+    outputFile = fileSystem.file("cpputest.xml");
+    STRCMP_EQUAL("<system-out>some &lt;output&gt;</system-out>\n", outputFile->lineFromTheBack(4));
+    STRCMP_EQUAL("</testcase>\n", outputFile->lineFromTheBack(3));
+}
+
+TEST(JUnitSingleFileOutputTest, manyTestsAreWrittenThroughTheBufferInOrder)
+{
+    SimpleString names[200];
+    testCaseRunner->start().withGroup("groupname");
+    for (int i = 0; i < 200; i++) {
+        names[i] = StringFromFormat("test%d", i);
+        testCaseRunner->withTest(names[i].asCharString());
+    }
+    testCaseRunner->end();
+
+    outputFile = fileSystem.file("cpputest.xml");
+    LONGS_EQUAL(2 + 1 + 2 * 200 + 2, outputFile->amountOfLines());
+    STRCMP_CONTAINS("name=\"test0\"", outputFile->line(4));
+    STRCMP_CONTAINS("name=\"test199\"", outputFile->lineFromTheBack(4));
+}
+
+TEST(JUnitSingleFileOutputTest, textLargerThanTheWriteBufferIsWritten)
+{
+    SimpleString largeOutput("x", 10000);
+    UtestShell test("groupname", "testname", "file", 1);
+    result->testsStarted();
+    result->currentGroupStarted(&test);
+    result->currentTestStarted(&test);
+    result->print(largeOutput.asCharString());
+    result->currentTestEnded(&test);
+    result->currentGroupEnded(&test);
+    result->testsEnded();
+
+    outputFile = fileSystem.file("cpputest.xml");
+    LONGS_EQUAL(sizeof("<system-out></system-out>\n") - 1 + 10000, SimpleString(outputFile->lineFromTheBack(4)).size());
+    STRCMP_EQUAL("</testcase>\n", outputFile->lineFromTheBack(3));
+}
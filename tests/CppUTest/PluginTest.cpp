@@ -40,7 +40,7 @@ class DummyPlugin: public TestPlugin
 {
 public:
     DummyPlugin(const SimpleString& name) :
-        TestPlugin(name), preAction(0), preActionSequence(0), postAction(0), postActionSequence(0)
+        TestPlugin(name), preAction(0), preActionSequence(0), postAction(0), postActionSequence(0), postRun(0), postRunSequence(0)
     {
     }
 
@@ -56,10 +56,18 @@ public:
         postActionSequence = sequenceNumber++;
     }
 
+    virtual void postRunAction(TestResult&) CPPUTEST_OVERRIDE
+    {
+        postRun++;
+        postRunSequence = sequenceNumber++;
+    }
+
     int preAction;
     int preActionSequence;
     int postAction;
     int postActionSequence;
+    int postRun;
+    int postRunSequence;
 };
 
 class DummyPluginWhichAcceptsParameters: public DummyPlugin
@@ -149,6 +157,21 @@ TEST(PluginTest, Sequence)
     LONGS_EQUAL(2, registry->countPlugins());
 }
 
+TEST(PluginTest, PostRunActionRunsAfterAllPostTestActionsInReverseOrder)
+{
+    registry->installPlugin(thirdPlugin);
+    genFixture->runAllTests();
+    CHECK_EQUAL(0, firstPlugin->postRun);
+
+    StringBufferTestOutput output;
+    TestResult result(output);
+    registry->getFirstPlugin()->runAllPostRunAction(result);
+    CHECK_EQUAL(1, firstPlugin->postRun);
+    CHECK_EQUAL(1, thirdPlugin->postRun);
+    CHECK_EQUAL(5, firstPlugin->postRunSequence);
+    CHECK_EQUAL(6, thirdPlugin->postRunSequence);
+}
+
 TEST(PluginTest, RemovePluginByName)
 {
     registry->installPlugin(secondPlugin);
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/ResultLogTestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+class ResultLogOutputToBuffer : public ResultLogTestOutput
+{
+public:
+    ResultLogOutputToBuffer() : openCount(0), closeCount(0), isOpen(false)
+    {
+    }
+
+    SimpleString contents;
+    SimpleString lastMode;
+    int openCount;
+    int closeCount;
+    bool isOpen;
+
+protected:
+    virtual void openFile(const char* mode) CPPUTEST_OVERRIDE
+    {
+        lastMode = mode;
+        openCount++;
+        isOpen = true;
+    }
+
+    virtual void writeToFile(const SimpleString& buffer) CPPUTEST_OVERRIDE
+    {
+        if (!isOpen) openFile("ab");
+        contents += buffer;
+    }
+
+    virtual void closeFile() CPPUTEST_OVERRIDE
+    {
+        if (isOpen) closeCount++;
+        isOpen = false;
+    }
+};
+
+static unsigned long millisTime;
+
+extern "C" {
+
+    static unsigned long MockGetPlatformSpecificTimeInMillis()
+    {
+        return millisTime;
+    }
+
+}
+
+static void runTwoTestsInOneGroup(TestResult& result, UtestShell& test, UtestShell& failingTest)
+{
+    millisTime = 1000;
+    result.testsStarted();
+    result.currentGroupStarted(&test);
+    result.currentTestStarted(&test);
+    result.countTest();
+    result.countRun();
+    result.countCheck();
+    result.print("some output");
+    millisTime = 1015;
+    result.currentTestEnded(&test);
+    result.currentTestStarted(&failingTest);
+    result.countTest();
+    result.countRun();
+    result.countCheck();
+    result.countCheck();
+    result.addFailure(TestFailure(&failingTest, "failingFile", 300000, "failure message"));
+    millisTime = 1040;
+    result.currentTestEnded(&failingTest);
+    result.countFilteredOut();
+    result.currentGroupEnded(&failingTest);
+    millisTime = 1050;
+    result.testsEnded();
+}
+
+TEST_GROUP(ResultLogOutputTest)
+{
+    ResultLogOutputToBuffer* output;
+    UtestShell* tst;
+    UtestShell* failingTest;
+    TestResult* result;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        output = new ResultLogOutputToBuffer;
+        tst = new UtestShell("group", "test", "file.cpp", 10);
+        failingTest = new UtestShell("group", "failingTest", "file.cpp", 200);
+        result = new TestResult(*output);
+        millisTime = 0;
+        UT_PTR_SET(GetPlatformSpecificTimeInMillis, MockGetPlatformSpecificTimeInMillis);
+    }
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        delete result;
+        delete failingTest;
+        delete tst;
+        delete output;
+    }
+
+    SimpleString expectedOutputOfTheRun()
+    {
+        StringBufferTestOutput expected;
+        expected.verbose(TestOutput::level_verbose);
+        TestResult expectedResult(expected);
+        runTwoTestsInOneGroup(expectedResult, *tst, *failingTest);
+        return expected.getOutput();
+    }
+};
+
+TEST(ResultLogOutputTest, StartsWithTheSignature)
+{
+    result->testsStarted();
+
+    STRCMP_EQUAL("wb", output->lastMode.asCharString());
+    STRCMP_EQUAL("CppUTest result log 1\nB\x01", output->contents.asCharString());
+}
+
+TEST(ResultLogOutputTest, GroupAndFileNamesAreWrittenOnlyOnce)
+{
+    runTwoTestsInOneGroup(*result, *tst, *failingTest);
+
+    LONGS_EQUAL(1, output->contents.count("S\x09" "file.cpp"));
+    LONGS_EQUAL(1, output->contents.count("S\x06group"));
+}
+
+TEST(ResultLogOutputTest, FileStaysOpenUntilTheRunEnds)
+{
+    runTwoTestsInOneGroup(*result, *tst, *failingTest);
+
+    LONGS_EQUAL(1, output->openCount);
+    LONGS_EQUAL(1, output->closeCount);
+    CHECK_FALSE(output->isOpen);
+}
+
+TEST(ResultLogOutputTest, RecordsAreWrittenAfterEveryGroup)
+{
+    result->testsStarted();
+    result->currentGroupStarted(tst);
+    result->currentTestStarted(tst);
+    result->currentTestEnded(tst);
+    STRCMP_EQUAL("CppUTest result log 1\nB\x01", output->contents.asCharString());
+
+    result->currentGroupEnded(tst);
+    STRCMP_CONTAINS("g", output->contents.asCharString());
+    CHECK(output->isOpen);
+}
+
+/* What fputs wrote is only in the file once it is flushed */
+static SimpleString* writtenToFile;
+static SimpleString* flushedToFile;
+
+static PlatformSpecificFile fakeFOpen(const char*, const char*)
+{
+    return (PlatformSpecificFile) flushedToFile;
+}
+
+static void fakeFPuts(const char* str, PlatformSpecificFile)
+{
+    *writtenToFile += str;
+}
+
+static void fakeFFlush(PlatformSpecificFile)
+{
+    *flushedToFile += *writtenToFile;
+    *writtenToFile = "";
+}
+
+static void fakeFClose(PlatformSpecificFile file)
+{
+    fakeFFlush(file);
+}
+
+TEST(ResultLogOutputTest, FileIsFlushedAfterEveryFailureAndGroup)
+{
+    SimpleString written;
+    SimpleString flushed;
+    writtenToFile = &written;
+    flushedToFile = &flushed;
+    UT_PTR_SET(PlatformSpecificFOpen, fakeFOpen);
+    UT_PTR_SET(PlatformSpecificFPuts, fakeFPuts);
+    UT_PTR_SET(PlatformSpecificFFlush, fakeFFlush);
+    UT_PTR_SET(PlatformSpecificFClose, fakeFClose);
+
+    ResultLogTestOutput fileOutput("cpputest_results.log");
+    TestResult fileResult(fileOutput);
+    fileResult.testsStarted();
+    fileResult.currentGroupStarted(failingTest);
+    fileResult.currentTestStarted(failingTest);
+    fileResult.addFailure(TestFailure(failingTest, "failingFile", 300000, "failure message"));
+    STRCMP_CONTAINS("failure message", flushed.asCharString());
+
+    fileResult.currentTestEnded(failingTest);
+    fileResult.currentGroupEnded(failingTest);
+    STRCMP_CONTAINS("g", flushed.asCharString());
+    STRCMP_EQUAL("", written.asCharString());
+}
+
+TEST(ResultLogOutputTest, ConsecutiveOutputIsWrittenAsOneRecord)
+{
+    result->testsStarted();
+    result->currentTestStarted(tst);
+    result->print("some ");
+    result->print("output");
+    output->flush();
+
+    STRCMP_CONTAINS("O\x0d\x0c" "some output", output->contents.asCharString());
+}
+
+TEST(ResultLogOutputTest, FileIsClosedBeforeATestInASeparateProcessAndAfterItsLastPhase)
+{
+    tst->setRunInSeperateProcess();
+    result->testsStarted();
+    result->currentTestStarted(tst);
+    LONGS_EQUAL(1, output->closeCount);
+
+    result->currentTestPhaseStarted("setup");
+    result->addTestProperty(*tst, "name", "value");
+    result->currentTestPhaseStarted("body");
+    result->currentTestPhaseEnded("body");
+    result->currentTestPhaseEnded("setup");
+    LONGS_EQUAL(2, output->closeCount);
+}
+
+TEST(ResultLogOutputTest, ReplayedRunGivesTheSameOutputAsTheOriginal)
+{
+    runTwoTestsInOneGroup(*result, *tst, *failingTest);
+
+    StringBufferTestOutput replayed;
+    replayed.verbose(TestOutput::level_verbose);
+    ResultLogReader reader(replayed);
+    reader.replay(output->contents.asCharString());
+    reader.finish();
+
+    CHECK(reader.isValid());
+    CHECK(reader.isComplete());
+    STRCMP_EQUAL(expectedOutputOfTheRun().asCharString(), replayed.getOutput().asCharString());
+    LONGS_EQUAL(1, reader.getResult().getFailureCount());
+    LONGS_EQUAL(3, reader.getResult().getCheckCount());
+    LONGS_EQUAL(1, reader.getResult().getFilteredOutCount());
+}
+
+TEST(ResultLogOutputTest, LogCanBeReplayedInPiecesOfAnySize)
+{
+    runTwoTestsInOneGroup(*result, *tst, *failingTest);
+
+    StringBufferTestOutput replayed;
+    replayed.verbose(TestOutput::level_verbose);
+    ResultLogReader reader(replayed);
+    const char* log = output->contents.asCharString();
+    for (size_t i = 0; log[i] != '\0'; i++) {
+        char piece[2] = { log[i], '\0' };
+        reader.replay(piece);
+    }
+
+    CHECK(reader.isComplete());
+    STRCMP_EQUAL(expectedOutputOfTheRun().asCharString(), replayed.getOutput().asCharString());
+}
+
+TEST(ResultLogOutputTest, LogOfACrashedRunBlamesTheTestThatWasRunning)
+{
+    result->testsStarted();
+    result->currentGroupStarted(tst);
+    result->currentTestStarted(tst);
+    result->print("last words");
+    output->flush();
+
+    StringBufferTestOutput replayed;
+    ResultLogReader reader(replayed);
+    reader.replay(output->contents.asCharString());
+    reader.finish();
+
+    CHECK(reader.isValid());
+    CHECK_FALSE(reader.isComplete());
+    STRCMP_CONTAINS("last words", replayed.getOutput().asCharString());
+    STRCMP_CONTAINS("The result log ends during this test", replayed.getOutput().asCharString());
+    STRCMP_CONTAINS("Errors (1 failures", replayed.getOutput().asCharString());
+}
+
+TEST(ResultLogOutputTest, IgnoredTestsAreReplayedAsIgnored)
+{
+    IgnoredUtestShell ignoredTest("group", "ignored", "file.cpp", 5);
+    result->testsStarted();
+    result->currentTestStarted(&ignoredTest);
+    result->countTest();
+    result->countIgnored();
+    result->currentTestEnded(&ignoredTest);
+    output->flush();
+
+    StringBufferTestOutput replayed;
+    ResultLogReader reader(replayed);
+    reader.replay(output->contents.asCharString());
+
+    STRCMP_EQUAL("!", replayed.getOutput().asCharString());
+    LONGS_EQUAL(1, reader.getResult().getIgnoredCount());
+}
+
+TEST(ResultLogOutputTest, PropertiesAreReplayed)
+{
+    result->testsStarted();
+    result->currentTestStarted(tst);
+    result->addTestProperty(*tst, "cycles", "123");
+    output->flush();
+
+    StringBufferTestOutput replayed;
+    replayed.verbose(TestOutput::level_verbose);
+    ResultLogReader reader(replayed);
+    reader.replay(output->contents.asCharString());
+
+    STRCMP_CONTAINS("cycles=123", replayed.getOutput().asCharString());
+}
+
+TEST(ResultLogOutputTest, SomethingElseThanAResultLogIsRejected)
+{
+    StringBufferTestOutput replayed;
+    ResultLogReader reader(replayed);
+    reader.replay("<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n");
+    reader.finish();
+
+    CHECK_FALSE(reader.isValid());
+    STRCMP_EQUAL("", replayed.getOutput().asCharString());
+}
+
+TEST(ResultLogOutputTest, MissingLogFileIsRejected)
+{
+    StringBufferTestOutput replayed;
+    ResultLogReader reader(replayed);
+
+    CHECK_FALSE(reader.replayFile("there/is/no/such/cpputest_results.log"));
+    CHECK_FALSE(reader.isValid());
+}
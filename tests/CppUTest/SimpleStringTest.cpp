@@ -845,6 +845,40 @@ TEST(SimpleString, CollectionWritingToEmptyString)
     STRCMP_EQUAL("", col[3].asCharString());
 }
 
+TEST(SimpleString, IndexNumbersDistinctStringsInTheOrderTheyWereAdded)
+{
+    SimpleStringIndex index;
+    LONGS_EQUAL(0, index.add("one"));
+    LONGS_EQUAL(1, index.add("two"));
+    LONGS_EQUAL(0, index.add("one"));
+
+    LONGS_EQUAL(2, index.size());
+    STRCMP_EQUAL("two", index[1].asCharString());
+    LONGS_EQUAL(1, index.find("two"));
+    LONGS_EQUAL(SimpleString::npos, index.find("three"));
+}
+
+TEST(SimpleString, IndexFindsAllStringsAfterGrowing)
+{
+    SimpleStringIndex index;
+    for (long i = 0; i < 100; i++)
+        index.add(StringFrom(i));
+
+    LONGS_EQUAL(100, index.size());
+    for (long i = 0; i < 100; i++)
+        LONGS_EQUAL(i, index.find(StringFrom(i)));
+}
+
+TEST(SimpleString, ClearedIndexStartsNumberingAgain)
+{
+    SimpleStringIndex index;
+    index.add("one");
+    index.clear();
+
+    LONGS_EQUAL(SimpleString::npos, index.find("one"));
+    LONGS_EQUAL(0, index.add("two"));
+}
+
 #ifdef CPPUTEST_64BIT
 
 TEST(SimpleString, 64BitAddressPrintsCorrectly)
@@ -1121,6 +1155,13 @@ TEST(SimpleString, MemCmp)
     LONGS_EQUAL(0, SimpleString::MemCmp(NULLPTR, NULLPTR, 0));
 }
 
+TEST(SimpleString, HashOfPartsIsTheHashOfTheWhole)
+{
+    size_t hash = SimpleString::Hash("scope::", 7, SimpleString::hashStart);
+    UNSIGNED_LONGS_EQUAL(SimpleString::Hash("scope::name"), SimpleString::Hash("name", hash));
+    CHECK(SimpleString::Hash("name") != SimpleString::Hash("eman"));
+}
+
 TEST(SimpleString, MemCmpFirstLastNotMatching)
 {
     unsigned char base[] = { 0x00, 0x01, 0x2A, 0xFF };
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/StreamingTestOutput.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+
+static char streamedText[4096];
+static size_t streamedTextLength;
+static unsigned long millisTime;
+
+extern "C" {
+
+    static void MockFPutsToStream(const char* str, PlatformSpecificFile)
+    {
+        while (*str && streamedTextLength < sizeof(streamedText) - 1)
+            streamedText[streamedTextLength++] = *str++;
+        streamedText[streamedTextLength] = '\0';
+    }
+
+    static void MockFlushStream()
+    {
+    }
+
+    static unsigned long MockGetPlatformSpecificTimeInMillis()
+    {
+        return millisTime;
+    }
+
+}
+
+TEST_GROUP(StreamingTestOutput)
+{
+    StreamingTestOutput* output;
+    UtestShell* tst;
+    TestResult* result;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        streamedText[0] = '\0';
+        streamedTextLength = 0;
+        millisTime = 0;
+        UT_PTR_SET(PlatformSpecificFPuts, MockFPutsToStream);
+        UT_PTR_SET(PlatformSpecificFlush, MockFlushStream);
+        UT_PTR_SET(GetPlatformSpecificTimeInMillis, MockGetPlatformSpecificTimeInMillis);
+        output = NULLPTR;
+        result = NULLPTR;
+        tst = new UtestShell("group", "test", "file.cpp", 10);
+    }
+
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        delete result;
+        delete output;
+        delete tst;
+    }
+
+    void useOutput(StreamingTestOutput* newOutput)
+    {
+        output = newOutput;
+        output->setFlushIntervalInMillis(0);
+        result = new TestResult(*output);
+    }
+
+    void runTest(unsigned long duration, size_t checks)
+    {
+        result->currentTestStarted(tst);
+        result->countRun();
+        for (size_t i = 0; i < checks; i++)
+            result->countCheck();
+        millisTime += duration;
+        result->currentTestEnded(tst);
+    }
+
+    void runFailingTest(const char* message)
+    {
+        result->currentTestStarted(tst);
+        result->countCheck();
+        result->addFailure(TestFailure(tst, "file.cpp", 12, message));
+        result->currentTestEnded(tst);
+    }
+};
+
+TEST(StreamingTestOutput, tapStartsWithTheVersion)
+{
+    useOutput(new TapTestOutput);
+    output->printTestsStarted();
+    STRCMP_EQUAL("TAP version 13\n", streamedText);
+}
+
+TEST(StreamingTestOutput, tapWritesARecordAsSoonAsTheTestEnds)
+{
+    useOutput(new TapTestOutput);
+    runTest(15, 2);
+    STRCMP_EQUAL("ok 1 - TEST(group, test)\n"
+                 "  ---\n"
+                 "  group: \"group\"\n"
+                 "  name: \"test\"\n"
+                 "  file: \"file.cpp\"\n"
+                 "  line: 10\n"
+                 "  duration_ms: 15\n"
+                 "  checks: 2\n"
+                 "  ...\n", streamedText);
+}
+
+TEST(StreamingTestOutput, tapRecordOfAFailingTestHasTheFailure)
+{
+    useOutput(new TapTestOutput);
+    runFailingTest("expected <1>\n\tbut was <2>");
+    STRCMP_CONTAINS("not ok 1 - TEST(group, test)\n", streamedText);
+    STRCMP_CONTAINS("  checks: 1\n"
+                    "  failure:\n"
+                    "    file: \"file.cpp\"\n"
+                    "    line: 12\n"
+                    "    message: \"expected <1>\\n\\tbut was <2>\"\n"
+                    "  ...\n", streamedText);
+}
+
+TEST(StreamingTestOutput, tapMarksIgnoredTestsAsSkipped)
+{
+    IgnoredUtestShell ignored("group", "ignored", "file.cpp", 20);
+    useOutput(new TapTestOutput);
+    result->currentTestStarted(&ignored);
+    result->currentTestEnded(&ignored);
+    STRCMP_CONTAINS("ok 1 - TEST(group, ignored) # SKIP ignored\n", streamedText);
+}
+
+TEST(StreamingTestOutput, tapPlanAndSummaryComeAtTheEnd)
+{
+    useOutput(new TapTestOutput);
+    runTest(1, 1);
+    runFailingTest("failed");
+    result->testsEnded();
+    STRCMP_CONTAINS("not ok 2 - TEST(group, test)\n", streamedText);
+    STRCMP_CONTAINS("  ...\n1..2\n# failures: 1, checks: 2, ignored: 0, filtered out: 0, duration_ms: 1\n", streamedText);
+}
+
+TEST(StreamingTestOutput, jsonLinesWritesOneObjectPerTest)
+{
+    useOutput(new JsonLinesTestOutput);
+    runTest(3, 4);
+    STRCMP_EQUAL("{\"type\":\"test\",\"group\":\"group\",\"name\":\"test\",\"file\":\"file.cpp\",\"line\":10,"
+                 "\"status\":\"passed\",\"duration_ms\":3,\"checks\":4}\n", streamedText);
+}
+
+TEST(StreamingTestOutput, jsonLinesKeepsOnlyTheFirstFailureOfATest)
+{
+    useOutput(new JsonLinesTestOutput);
+    result->currentTestStarted(tst);
+    result->addFailure(TestFailure(tst, "file.cpp", 12, "first \"quoted\""));
+    result->addFailure(TestFailure(tst, "file.cpp", 13, "second"));
+    result->currentTestEnded(tst);
+    STRCMP_EQUAL("{\"type\":\"test\",\"group\":\"group\",\"name\":\"test\",\"file\":\"file.cpp\",\"line\":10,"
+                 "\"status\":\"failed\",\"duration_ms\":0,\"checks\":0,"
+                 "\"failure\":{\"file\":\"file.cpp\",\"line\":12,\"message\":\"first \\\"quoted\\\"\"}}\n", streamedText);
+}
+
+TEST(StreamingTestOutput, jsonLinesEscapesControlCharacters)
+{
+    useOutput(new JsonLinesTestOutput);
+    output->printTestsStarted();
+    output->print("a\\b\x01" "c");
+    STRCMP_EQUAL("{\"type\":\"output\",\"text\":\"a\\\\b\\u0001c\"}\n", streamedText);
+}
+
+TEST(StreamingTestOutput, jsonLinesEscapesTextLongerThanTheFormattingChunk)
+{
+    char text[301];
+    for (size_t i = 0; i < 300; i++)
+        text[i] = (i % 3 == 0) ? '\n' : 'x';
+    text[300] = '\0';
+    useOutput(new JsonLinesTestOutput);
+    output->print(text);
+
+    SimpleString expected("{\"type\":\"output\",\"text\":\"");
+    for (size_t i = 0; i < 100; i++)
+        expected += "\\nxx";
+    expected += "\"}\n";
+    STRCMP_EQUAL(expected.asCharString(), streamedText);
+}
+
+TEST(StreamingTestOutput, textPrintedByATestBelongsToItsRecord)
+{
+    useOutput(new JsonLinesTestOutput);
+    result->currentTestStarted(tst);
+    output->print("hello");
+    STRCMP_EQUAL("", streamedText);
+    result->currentTestEnded(tst);
+    STRCMP_CONTAINS(",\"checks\":0,\"output\":\"hello\"}\n", streamedText);
+}
+
+TEST(StreamingTestOutput, jsonLinesSummaryComesLast)
+{
+    useOutput(new JsonLinesTestOutput);
+    runTest(2, 1);
+    result->testsEnded();
+    STRCMP_CONTAINS("}\n{\"type\":\"summary\",\"tests\":0,\"ran\":1,\"failures\":0,\"checks\":1,"
+                    "\"ignored\":0,\"filtered_out\":0,\"duration_ms\":2}\n", streamedText);
+}
+
+TEST(StreamingTestOutput, failureInsideTheChildOfASeparateProcessTestIsWrittenAtOnce)
+{
+    tst->setRunInSeperateProcess();
+    useOutput(new JsonLinesTestOutput);
+    result->currentTestStarted(tst);
+    output->printCurrentTestPhaseStarted("body");
+    result->addFailure(TestFailure(tst, "file.cpp", 12, "crashed"));
+    STRCMP_EQUAL("{\"type\":\"failure\",\"test\":\"TEST(group, test)\",\"file\":\"file.cpp\",\"line\":12,\"message\":\"crashed\"}\n", streamedText);
+    output->printCurrentTestPhaseEnded("body");
+}
+
+TEST(StreamingTestOutput, failureInTheParentOfASeparateProcessTestGoesIntoTheRecord)
+{
+    tst->setRunInSeperateProcess();
+    useOutput(new TapTestOutput);
+    runFailingTest("Failed in separate process");
+    STRCMP_CONTAINS("not ok 1 - TEST(group, test)\n", streamedText);
+    STRCMP_CONTAINS("    message: \"Failed in separate process\"\n", streamedText);
+}
@@ -221,6 +221,15 @@ TEST(TeamCityOutputTest, TestNameEscaped_Fail)
 	STRCMP_EQUAL(expected, mock->getOutput().asCharString());
 }
 
+TEST(TeamCityOutputTest, PrintTestPropertyAsBuildStatistic)
+{
+	tst->setTestName("test'");
+	result->addTestProperty(*tst, "cycles", "1000");
+	const char* expected =
+		"##teamcity[buildStatisticValue key='group.test|'.cycles' value='1000']\n";
+	STRCMP_EQUAL(expected, mock->getOutput().asCharString());
+}
+
 /* Todo:
  * -Detect when running in TeamCity and switch output to -o teamcity automatically
  */
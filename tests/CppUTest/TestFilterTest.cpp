@@ -27,6 +27,7 @@
 
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/TestFilter.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
 
 TEST_GROUP(TestFilter)
 {
@@ -164,3 +165,215 @@ TEST(TestFilter, constructors)
     CHECK(filter2.match("ab"));
     CHECK(filter3.match("ab"));
 }
+
+TEST(TestFilter, globMatchesAnywhereInTheName)
+{
+    TestFilter filter("fil*er");
+    CHECK(filter.match("filter"));
+    CHECK(filter.match("my_filXXer_test"));
+    CHECK(!filter.match("fil"));
+}
+
+TEST(TestFilter, globQuestionMarkMatchesOneCharacter)
+{
+    TestFilter filter("f?lter");
+    CHECK(filter.match("falter"));
+    CHECK(filter.match("xfilterx"));
+    CHECK(!filter.match("flter"));
+}
+
+TEST(TestFilter, strictGlobMatchesTheWholeName)
+{
+    TestFilter filter("fil*");
+    filter.strictMatching();
+    CHECK(filter.match("filter"));
+    CHECK(filter.match("fil"));
+    CHECK(!filter.match("afilter"));
+}
+
+TEST(TestFilter, strictGlobBacktracks)
+{
+    TestFilter filter("*ab*ab");
+    filter.strictMatching();
+    CHECK(filter.match("xabyabab"));
+    CHECK(!filter.match("xabyaba"));
+}
+
+TEST(TestFilter, invertGlobMatching)
+{
+    TestFilter filter("fil*er");
+    filter.invertMatching();
+    CHECK(!filter.match("filter"));
+    CHECK(filter.match("notevenclose"));
+}
+
+TEST_GROUP(TestFilterMatcher)
+{
+    TestFilter* filters;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        filters = NULLPTR;
+    }
+
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        while (filters) {
+            TestFilter* current = filters;
+            filters = filters->getNext();
+            delete current;
+        }
+    }
+
+    TestFilter* addFilter(const char* text)
+    {
+        filters = (new TestFilter(text))->add(filters);
+        return filters;
+    }
+
+    void checkMatchesLikeFilterList(const char* name)
+    {
+        bool expected = false;
+        for (const TestFilter* filter = filters; filter != NULLPTR; filter = filter->getNext())
+            expected = expected || filter->match(name);
+
+        TestFilterMatcher matcher(filters);
+        CHECK_EQUAL_TEXT(expected, matcher.match(name), name);
+    }
+};
+
+TEST(TestFilterMatcher, noFiltersMatchesEverything)
+{
+    TestFilterMatcher matcher;
+    CHECK(matcher.match("anything"));
+    CHECK(matcher.match(""));
+}
+
+TEST(TestFilterMatcher, substringFiltersMatchAnyContainedPattern)
+{
+    addFilter("he");
+    addFilter("she");
+    addFilter("hers");
+    TestFilterMatcher matcher(filters);
+    CHECK(matcher.match("ushers"));
+    CHECK(matcher.match("ahe"));
+    CHECK(!matcher.match("hrs"));
+    CHECK(!matcher.match(""));
+}
+
+TEST(TestFilterMatcher, patternFoundThroughFailureLink)
+{
+    addFilter("abcd");
+    addFilter("bce");
+    TestFilterMatcher matcher(filters);
+    CHECK(matcher.match("abce"));
+    CHECK(!matcher.match("abcx"));
+}
+
+TEST(TestFilterMatcher, emptySubstringFilterMatchesEverything)
+{
+    addFilter("");
+    TestFilterMatcher matcher(filters);
+    CHECK(matcher.match("anything"));
+}
+
+TEST(TestFilterMatcher, strictFilters)
+{
+    addFilter("one")->strictMatching();
+    addFilter("two")->strictMatching();
+    TestFilterMatcher matcher(filters);
+    CHECK(matcher.match("one"));
+    CHECK(matcher.match("two"));
+    CHECK(!matcher.match("ones"));
+}
+
+TEST(TestFilterMatcher, excludedSubstringsMatchUnlessAllAreContained)
+{
+    addFilter("foo")->invertMatching();
+    addFilter("bar")->invertMatching();
+    addFilter("bar")->invertMatching();
+    checkMatchesLikeFilterList("foobar");
+    checkMatchesLikeFilterList("barfoo");
+    checkMatchesLikeFilterList("foo");
+    checkMatchesLikeFilterList("baz");
+}
+
+TEST(TestFilterMatcher, excludedStrictFilters)
+{
+    addFilter("one")->invertMatching();
+    filters->strictMatching();
+    checkMatchesLikeFilterList("one");
+    checkMatchesLikeFilterList("two");
+
+    addFilter("two")->invertMatching();
+    filters->strictMatching();
+    checkMatchesLikeFilterList("one");
+}
+
+TEST(TestFilterMatcher, mixedFiltersMatchLikeTheFilterList)
+{
+    addFilter("Mock");
+    addFilter("Test")->invertMatching();
+    addFilter("Registry")->strictMatching();
+    addFilter("Sim*String");
+    checkMatchesLikeFilterList("MockSupport");
+    checkMatchesLikeFilterList("TestRegistry");
+    checkMatchesLikeFilterList("Registry");
+    checkMatchesLikeFilterList("SimpleStringTest");
+    checkMatchesLikeFilterList("TestFilter");
+    checkMatchesLikeFilterList("");
+}
+
+TEST(TestFilterMatcher, recompileReplacesFilters)
+{
+    TestFilterMatcher matcher(addFilter("one"));
+    CHECK(!matcher.match("two"));
+    matcher.compile(addFilter("two"));
+    CHECK(matcher.match("two"));
+    matcher.compile(NULLPTR);
+    CHECK(matcher.match("three"));
+}
+
+/*
+ * Selection benchmark, 10k filters against 100k test names.
+ * Run with: CppUTestTests -ri -sg TestFilterMatcher -sn benchmarkSelection -v
+ */
+IGNORE_TEST(TestFilterMatcher, benchmarkSelection)
+{
+    const int filterCount = 10000;
+    const int testCount = 100000;
+
+    for (int i = 0; i < filterCount; i++)
+        addFilter(StringFromFormat("Group%dTest%d", i * 7, i).asCharString());
+
+    SimpleString* names = new SimpleString[testCount];
+    for (int i = 0; i < testCount; i++)
+        names[i] = StringFromFormat("Group%dTest%dShouldDoSomething", i % 20000, i);
+
+    unsigned long start = GetPlatformSpecificTimeInMillis();
+    TestFilterMatcher matcher(filters);
+    int compiledMatches = 0;
+    for (int i = 0; i < testCount; i++)
+        if (matcher.match(names[i].asCharString())) compiledMatches++;
+    unsigned long compiledTime = GetPlatformSpecificTimeInMillis() - start;
+
+    /* the filter list is too slow for all names, so time one in a hundred */
+    const int sampleStep = 100;
+    start = GetPlatformSpecificTimeInMillis();
+    int listMatches = 0;
+    int sampledCompiledMatches = 0;
+    for (int i = 0; i < testCount; i += sampleStep) {
+        if (matcher.match(names[i].asCharString())) sampledCompiledMatches++;
+        for (const TestFilter* filter = filters; filter != NULLPTR; filter = filter->getNext())
+            if (filter->match(names[i])) {
+                listMatches++;
+                break;
+            }
+    }
+    unsigned long listTime = (GetPlatformSpecificTimeInMillis() - start) * sampleStep;
+
+    delete [] names;
+
+    LONGS_EQUAL(listMatches, sampledCompiledMatches);
+    UT_PRINT(StringFromFormat("compiled matcher: %lu ms (%d selected), filter list: ~%lu ms", compiledTime, compiledMatches, listTime));
+}
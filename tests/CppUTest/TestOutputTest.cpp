@@ -178,6 +178,19 @@ TEST(TestOutput, PrintTestVerboseEnded)
     STRCMP_EQUAL("TEST(group, test) - 5 ms\n", mock->getOutput().asCharString());
 }
 
+TEST(TestOutput, PrintTestPropertyVerbose)
+{
+    mock->verbose(TestOutput::level_verbose);
+    result->addTestProperty(*tst, "cycles", "1000");
+    STRCMP_EQUAL(" cycles=1000", mock->getOutput().asCharString());
+}
+
+TEST(TestOutput, PrintTestPropertyIsSilentWhenNotVerbose)
+{
+    result->addTestProperty(*tst, "cycles", "1000");
+    STRCMP_EQUAL("", mock->getOutput().asCharString());
+}
+
 TEST(TestOutput, printColorWithSuccess)
 {
     mock->color();
@@ -282,6 +295,162 @@ TEST(TestOutput, printTestsEndedWithNoTestsRunOrIgnored)
         mock->getOutput().asCharString());
 }
 
+static char consoleText[20000];
+static size_t consoleTextLength;
+static int consoleFlushes;
+
+extern "C" {
+
+    static void MockFPutsToConsole(const char* str, PlatformSpecificFile)
+    {
+        size_t length = SimpleString::StrLen(str);
+        if (consoleTextLength + length >= sizeof(consoleText)) return;
+        PlatformSpecificMemCpy(consoleText + consoleTextLength, str, length + 1);
+        consoleTextLength += length;
+    }
+
+    static void MockFlushConsole()
+    {
+        consoleFlushes++;
+    }
+
+}
+
+TEST_GROUP(ConsoleTestOutput)
+{
+    ConsoleTestOutput* output;
+    UtestShell* tst;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        consoleText[0] = '\0';
+        consoleTextLength = 0;
+        consoleFlushes = 0;
+        millisTime = 0;
+        UT_PTR_SET(GetPlatformSpecificTimeInMillis, MockGetPlatformSpecificTimeInMillis);
+        UT_PTR_SET(PlatformSpecificFPuts, MockFPutsToConsole);
+        UT_PTR_SET(PlatformSpecificFlush, MockFlushConsole);
+        output = new ConsoleTestOutput();
+        tst = new UtestShell("group", "test", "file", 10);
+    }
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        delete output;
+        delete tst;
+    }
+};
+
+TEST(ConsoleTestOutput, printsAreCollectedUntilFlushed)
+{
+    output->print("Hello ");
+    output->print("World");
+    STRCMP_EQUAL("", consoleText);
+
+    output->flush();
+    STRCMP_EQUAL("Hello World", consoleText);
+    LONGS_EQUAL(1, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, bufferIsHandedToStdoutWhenATestPhaseStarts)
+{
+    output->print("before setup");
+    output->printCurrentTestPhaseStarted("setup");
+    STRCMP_EQUAL("before setup", consoleText);
+    LONGS_EQUAL(0, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, flushesOnceTheFlushIntervalPassed)
+{
+    output->print("a");
+    millisTime = 99;
+    output->print("b");
+    STRCMP_EQUAL("", consoleText);
+
+    millisTime = 100;
+    output->print("c");
+    STRCMP_EQUAL("abc", consoleText);
+    LONGS_EQUAL(1, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, zeroFlushIntervalWritesEveryFragment)
+{
+    output->setFlushIntervalInMillis(0);
+    output->print("a");
+    output->print("b");
+    STRCMP_EQUAL("ab", consoleText);
+    LONGS_EQUAL(2, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, fullBufferIsWrittenWithoutFlushing)
+{
+    SimpleString text("x", 5000);
+    output->print(text.asCharString());
+    output->print(text.asCharString());
+    LONGS_EQUAL(5000, consoleTextLength);
+    LONGS_EQUAL(0, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, textLargerThanTheBufferIsWrittenDirectlyAndInOrder)
+{
+    SimpleString text("x", 10000);
+    output->print("a");
+    output->print(text.asCharString());
+    LONGS_EQUAL(10001, consoleTextLength);
+    BYTES_EQUAL('a', consoleText[0]);
+}
+
+TEST(ConsoleTestOutput, failureIsFlushedRightAway)
+{
+    TestFailure failure(tst, "file", 20, "message");
+    output->printFailure(failure);
+    STRCMP_CONTAINS("message", consoleText);
+    LONGS_EQUAL(1, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, endOfTheTestsIsFlushed)
+{
+    StringBufferTestOutput dummy;
+    TestResult result(dummy);
+    output->printTestsEnded(result);
+    STRCMP_CONTAINS("ran nothing", consoleText);
+    LONGS_EQUAL(1, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, testInTheSameProcessIsNotFlushedPerPhase)
+{
+    output->print("x");
+    output->printCurrentTestStarted(*tst);
+    output->printCurrentTestPhaseEnded("setup");
+    LONGS_EQUAL(0, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, testInASeparateProcessIsFlushedBeforeForkingAndAfterEveryPhase)
+{
+    tst->setRunInSeperateProcess();
+    output->print("x");
+    output->printCurrentTestStarted(*tst);
+    STRCMP_EQUAL("x", consoleText);
+    LONGS_EQUAL(1, consoleFlushes);
+
+    output->printCurrentTestPhaseEnded("setup");
+    LONGS_EQUAL(2, consoleFlushes);
+}
+
+TEST(ConsoleTestOutput, testWithATimeoutIsFlushedBeforeItStartsAndAroundEveryPhase)
+{
+    tst->setTimeout(5);
+    output->print("x");
+    output->printCurrentTestStarted(*tst);
+    STRCMP_EQUAL("x", consoleText);
+    LONGS_EQUAL(1, consoleFlushes);
+
+    output->printCurrentTestPhaseStarted("body");
+    output->print("y");
+    output->printCurrentTestPhaseEnded("body");
+    STRCMP_CONTAINS("y", consoleText);
+    LONGS_EQUAL(3, consoleFlushes);
+}
+
 class CompositeTestOutputTestStringBufferTestOutput : public StringBufferTestOutput
 {
   public:
@@ -449,6 +618,14 @@ TEST(CompositeTestOutput, PrintTestRun)
   STRCMP_EQUAL("Test run 1 of 2\n", output2->getOutput().asCharString());
 }
 
+TEST(CompositeTestOutput, PrintTestProperty)
+{
+  compositeOutput.verbose(TestOutput::level_verbose);
+  compositeOutput.printTestProperty(*test, "cycles", "1000");
+  STRCMP_EQUAL(" cycles=1000", output1->getOutput().asCharString());
+  STRCMP_EQUAL(" cycles=1000", output2->getOutput().asCharString());
+}
+
 TEST(CompositeTestOutput, setProgressIndicator)
 {
   compositeOutput.setProgressIndicator("?");
@@ -50,6 +50,19 @@ public:
     bool hasRun_;
 };
 
+class MockFailingTest: public MockTest
+{
+public:
+    MockFailingTest(const char* group = "Group") : MockTest(group)
+    {
+    }
+    virtual void runOneTest(TestPlugin* plugin, TestResult& result) CPPUTEST_OVERRIDE
+    {
+        MockTest::runOneTest(plugin, result);
+        result.addFailure(TestFailure(this, "failed"));
+    }
+};
+
 class MockTestResult: public TestResult
 {
 public:
@@ -152,6 +165,8 @@ TEST_GROUP(TestRegistry)
     }
 };
 
+TEST_GROUP_TIMEOUT(TestRegistry, 60);
+
 TEST(TestRegistry, registryMyRegistryAndReset)
 {
     CHECK(myRegistry->getCurrentRegistry() == myRegistry);
@@ -263,6 +278,69 @@ TEST(TestRegistry, findTestWithGroup)
     CHECK(myRegistry->findTestWithGroup("GroupOfATestThatDoesExist") != NULLPTR);
 }
 
+TEST(TestRegistry, findTestWithNameReturnsFirstTestInRunOrder)
+{
+    test1->setTestName("SameName");
+    test2->setTestName("SameName");
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    CHECK(myRegistry->findTestWithName("SameName") == test2);
+}
+
+TEST(TestRegistry, findTestWithNameSeesTestsAddedAfterLookup)
+{
+    test1->setTestName("FirstTest");
+    test2->setTestName("AddedLater");
+    myRegistry->addTest(test1);
+    CHECK(myRegistry->findTestWithName("AddedLater") == NULLPTR);
+    myRegistry->addTest(test2);
+    CHECK(myRegistry->findTestWithName("AddedLater") == test2);
+}
+
+TEST(TestRegistry, findTestWithNameKeepsWorkingWhenTheNameBufferIsReused)
+{
+    char name[] = "NameInABuffer";
+    test1->setTestName(name);
+    myRegistry->addTest(test1);
+    CHECK(myRegistry->findTestWithName("NameInABuffer") == test1);
+
+    SimpleString::StrNCpy(name, "OverwrittenXX", sizeof(name));
+    CHECK(myRegistry->findTestWithName("NameInABuffer") == test1);
+}
+
+TEST(TestRegistry, findTestWithGroupForgetsUndoneTest)
+{
+    test1->setGroupName("StayingGroup");
+    test2->setGroupName("UndoneGroup");
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    CHECK(myRegistry->findTestWithGroup("UndoneGroup") == test2);
+    myRegistry->unDoLastAddTest();
+    CHECK(myRegistry->findTestWithGroup("UndoneGroup") == NULLPTR);
+    CHECK(myRegistry->findTestWithGroup("StayingGroup") == test1);
+}
+
+TEST(TestRegistry, countTestsAfterSplicingTestIntoTheMiddle)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test2);
+    LONGS_EQUAL(2, myRegistry->countTests());
+
+    myRegistry->getTestWithNext(test1)->addTest(test3);
+    test3->addTest(test1);
+    LONGS_EQUAL(3, myRegistry->countTests());
+}
+
+TEST(TestRegistry, runAllTestsStartsNewGroupForEachRunOfTheSameGroup)
+{
+    test1->setGroupName("GROUP_A");
+    test2->setGroupName("GROUP_B");
+    test3->setGroupName("GROUP_A");
+    addAndRunAllTests();
+    LONGS_EQUAL(3, mockResult->countCurrentGroupStarted);
+    LONGS_EQUAL(3, mockResult->countCurrentGroupEnded);
+}
+
 TEST(TestRegistry, nameFilterWorks)
 {
     test1->setTestName("testname");
@@ -315,6 +393,7 @@ public:
     virtual ~MyTestPluginDummy() CPPUTEST_DESTRUCTOR_OVERRIDE {}
     virtual void runAllPreTestAction(UtestShell&, TestResult&) CPPUTEST_OVERRIDE {}
     virtual void runAllPostTestAction(UtestShell&, TestResult&) CPPUTEST_OVERRIDE {}
+    virtual void runAllPostRunAction(TestResult&) CPPUTEST_OVERRIDE {}
 };
 
 TEST(TestRegistry, ResetPluginsWorks)
@@ -361,6 +440,43 @@ TEST(TestRegistry, listTestGroupAndCaseNames_shouldListBackwardsGroupATestaAfter
     STRCMP_EQUAL("GROUP_A.test_aa GROUP_B.test_b GROUP_A.test_a", s.asCharString());
 }
 
+TEST(TestRegistry, listTestGroupNames_emptyRegistryListsNothing)
+{
+    myRegistry->listTestGroupNames(*result);
+    STRCMP_EQUAL("", output->getOutput().asCharString());
+}
+
+TEST(TestRegistry, listTestGroupAndCaseNames_shouldListDuplicateTestOnlyOnce)
+{
+    test1->setGroupName("GROUP_A");
+    test1->setTestName("test_a");
+    myRegistry->addTest(test1);
+    test2->setGroupName("GROUP_A");
+    test2->setTestName("test_a");
+    myRegistry->addTest(test2);
+    test3->setGroupName("GROUP_B");
+    test3->setTestName("test_a");
+    myRegistry->addTest(test3);
+
+    myRegistry->listTestGroupAndCaseNames(*result);
+    STRCMP_EQUAL("GROUP_B.test_a GROUP_A.test_a", output->getOutput().asCharString());
+}
+
+TEST(TestRegistry, listTestGroupAndCaseNames_onlyListsTestsPassingTheFilters)
+{
+    test1->setGroupName("GROUP_A");
+    test1->setTestName("test_a");
+    myRegistry->addTest(test1);
+    test2->setGroupName("GROUP_B");
+    test2->setTestName("test_b");
+    myRegistry->addTest(test2);
+    TestFilter groupFilter("GROUP_B");
+    myRegistry->setGroupFilters(&groupFilter);
+
+    myRegistry->listTestGroupAndCaseNames(*result);
+    STRCMP_EQUAL("GROUP_B.test_b", output->getOutput().asCharString());
+}
+
 TEST(TestRegistry, listTestLocations_shouldListBackwardsGroupATestaAfterGroupAtestaa)
 {
     test1->setGroupName("GROUP_A");
@@ -448,3 +564,115 @@ TEST(TestRegistry, reverseZeroTests)
 
     CHECK(NULLPTR == myRegistry->getFirstTest());
 }
+
+TEST(TestRegistry, timeoutIsSetOnAllTests)
+{
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->setTimeout(5);
+    myRegistry->runAllTests(*result);
+    LONGS_EQUAL(5, test1->getTimeout());
+    LONGS_EQUAL(5, test3->getTimeout());
+}
+
+TEST(TestRegistry, groupTimeoutOverridesTheTimeout)
+{
+    TestGroupTimeout groupTimeout("group2", 7);
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->setTimeout(5);
+    myRegistry->addGroupTimeout(&groupTimeout);
+    myRegistry->runAllTests(*result);
+    LONGS_EQUAL(5, test1->getTimeout());
+    LONGS_EQUAL(7, test3->getTimeout());
+}
+
+TEST(TestRegistry, groupTimeoutWithoutTimeout)
+{
+    TestGroupTimeout groupTimeout("group2", 7);
+    myRegistry->addTest(test1);
+    myRegistry->addTest(test3);
+    myRegistry->addGroupTimeout(&groupTimeout);
+    myRegistry->runAllTests(*result);
+    LONGS_EQUAL(0, test1->getTimeout());
+    LONGS_EQUAL(7, test3->getTimeout());
+}
+
+TEST(TestRegistry, moveTestsToFrontKeepsTheRelativeOrder)
+{
+    UtestShell a("group", "a", "file", 1);
+    UtestShell b("group", "b", "file", 2);
+    UtestShell c("other", "c", "file", 3);
+    UtestShell d("other", "d", "file", 4);
+    myRegistry->addTest(&d);
+    myRegistry->addTest(&c);
+    myRegistry->addTest(&b);
+    myRegistry->addTest(&a);
+
+    SimpleStringCollection failed;
+    SimpleString("other.d\ngroup.b\n").split("\n", failed);
+    for (size_t i = 0; i < failed.size(); i++)
+        failed[i] = failed[i].subString(0, failed[i].size() - 1);
+
+    myRegistry->moveTestsToFront(failed);
+
+    CHECK(&b == myRegistry->getFirstTest());
+    CHECK(&d == b.getNext());
+    CHECK(&a == d.getNext());
+    CHECK(&c == a.getNext());
+    CHECK(NULLPTR == c.getNext());
+    CHECK(&c == myRegistry->findTestWithName("c"));
+}
+
+TEST(TestRegistry, moveTestsToFrontIgnoresUnknownAndMalformedNames)
+{
+    UtestShell a("group", "a", "file", 1);
+    UtestShell b("group", "b", "file", 2);
+    myRegistry->addTest(&b);
+    myRegistry->addTest(&a);
+
+    SimpleStringCollection failed;
+    SimpleString("group.gone\nnodot\n").split("\n", failed);
+
+    myRegistry->moveTestsToFront(failed);
+
+    CHECK(&a == myRegistry->getFirstTest());
+    CHECK(&b == a.getNext());
+}
+
+TEST(TestRegistry, moveTestsToFrontOnEmptyRegistryIsNoOp)
+{
+    SimpleStringCollection failed;
+    myRegistry->moveTestsToFront(failed);
+    CHECK(NULLPTR == myRegistry->getFirstTest());
+}
+
+TEST(TestRegistry, failFastStopsAfterTheFirstFailingTest)
+{
+    MockFailingTest failing;
+    myRegistry->addTest(test1);
+    myRegistry->addTest(&failing);
+    myRegistry->addTest(test2);
+    myRegistry->setFailFast();
+
+    myRegistry->runAllTests(*result);
+
+    CHECK(test2->hasRun_);
+    CHECK(failing.hasRun_);
+    CHECK_FALSE(test1->hasRun_);
+    LONGS_EQUAL(1, mockResult->countCurrentGroupStarted);
+    LONGS_EQUAL(1, mockResult->countCurrentGroupEnded);
+    LONGS_EQUAL(1, mockResult->countTestsEnded);
+}
+
+TEST(TestRegistry, withoutFailFastAllTestsRunAfterAFailure)
+{
+    MockFailingTest failing;
+    myRegistry->addTest(test1);
+    myRegistry->addTest(&failing);
+    myRegistry->addTest(test2);
+
+    myRegistry->runAllTests(*result);
+
+    CHECK(test1->hasRun_);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRepetitionStatistics.h"
+#include "CppUTest/TestOutput.h"
+
+TEST_GROUP(TestRepetitionStatistics)
+{
+    TestRepetitionStatistics statistics;
+    StringBufferTestOutput output;
+    UtestShell* test1;
+    UtestShell* test2;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        test1 = new UtestShell("group", "test1", "file", 1);
+        test2 = new UtestShell("group", "test2", "file", 2);
+        test1->addTest(test2);
+    }
+
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        delete test2;
+        delete test1;
+    }
+
+    void addSamples(UtestShell* test, const size_t* samples, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            statistics.addSample(test, samples[i]);
+    }
+};
+
+TEST(TestRepetitionStatistics, noSummaryForATestWithoutSamples)
+{
+    TestRepetitionSummary summary;
+    CHECK_FALSE(statistics.getSummary(test1, summary));
+}
+
+TEST(TestRepetitionStatistics, summaryOfASingleSample)
+{
+    TestRepetitionSummary summary;
+    statistics.addSample(test1, 7);
+    CHECK(statistics.getSummary(test1, summary));
+    LONGS_EQUAL(1, summary.samples);
+    LONGS_EQUAL(7, summary.min);
+    LONGS_EQUAL(7, summary.median);
+    LONGS_EQUAL(7, summary.p99);
+    DOUBLES_EQUAL(0.0, summary.coefficientOfVariation, 0.0001);
+}
+
+TEST(TestRepetitionStatistics, percentilesUseTheNearestRank)
+{
+    TestRepetitionSummary summary;
+    for (size_t i = 100; i > 0; i--)
+        statistics.addSample(test1, i);
+
+    statistics.getSummary(test1, summary);
+    LONGS_EQUAL(100, summary.samples);
+    LONGS_EQUAL(1, summary.min);
+    LONGS_EQUAL(50, summary.median);
+    LONGS_EQUAL(95, summary.p95);
+    LONGS_EQUAL(99, summary.p99);
+    LONGS_EQUAL(100, summary.max);
+    DOUBLES_EQUAL(50.5, summary.mean, 0.0001);
+}
+
+TEST(TestRepetitionStatistics, coefficientOfVariation)
+{
+    const size_t samples[] = { 2, 4, 4, 4, 5, 5, 7, 9 };
+    TestRepetitionSummary summary;
+    addSamples(test1, samples, 8);
+
+    statistics.getSummary(test1, summary);
+    DOUBLES_EQUAL(5.0, summary.mean, 0.0001);
+    DOUBLES_EQUAL(0.4, summary.coefficientOfVariation, 0.0001);
+}
+
+TEST(TestRepetitionStatistics, samplesAreKeptPerTest)
+{
+    TestRepetitionSummary summary;
+    statistics.addSample(test1, 1);
+    statistics.addSample(test2, 10);
+    statistics.addSample(test1, 3);
+
+    statistics.getSummary(test1, summary);
+    LONGS_EQUAL(2, summary.samples);
+    LONGS_EQUAL(3, summary.max);
+    statistics.getSummary(test2, summary);
+    LONGS_EQUAL(1, summary.samples);
+    LONGS_EQUAL(10, summary.min);
+}
+
+TEST(TestRepetitionStatistics, manyTests)
+{
+    const size_t count = 1000;
+    UtestShell* tests[count];
+    for (size_t i = 0; i < count; i++) {
+        tests[i] = new UtestShell("group", "test", "file", i);
+        statistics.addSample(tests[i], i);
+    }
+
+    TestRepetitionSummary summary;
+    for (size_t i = 0; i < count; i++) {
+        CHECK(statistics.getSummary(tests[i], summary));
+        LONGS_EQUAL(i, summary.min);
+    }
+    for (size_t i = 0; i < count; i++)
+        delete tests[i];
+}
+
+TEST(TestRepetitionStatistics, printsEveryTestInOrder)
+{
+    statistics.addSample(test2, 4);
+    statistics.addSample(test1, 2);
+    statistics.addSample(test1, 2);
+
+    statistics.print(output, test1, 0.0);
+
+    STRCMP_EQUAL("\nExecution time over the repetitions (us):\n"
+                 "TEST(group, test1): runs 2 min 2 median 2 p95 2 p99 2 max 2 cv 0.0%\n"
+                 "TEST(group, test2): runs 1 min 4 median 4 p95 4 p99 4 max 4 cv 0.0%\n",
+                 output.getOutput().asCharString());
+}
+
+TEST(TestRepetitionStatistics, flagsUnstableTests)
+{
+    const size_t samples[] = { 2, 4, 4, 4, 5, 5, 7, 9 };
+    addSamples(test1, samples, 8);
+    statistics.addSample(test2, 4);
+
+    statistics.print(output, test1, 0.25);
+
+    STRCMP_CONTAINS("TEST(group, test1): runs 8 min 2 median 4 p95 9 p99 9 max 9 cv 40.0% - unstable\n", output.getOutput().asCharString());
+    STRCMP_CONTAINS("TEST(group, test2): runs 1 min 4 median 4 p95 4 p99 4 max 4 cv 0.0%\n", output.getOutput().asCharString());
+    STRCMP_CONTAINS("1 unstable tests (cv above 25.0%)\n", output.getOutput().asCharString());
+}
@@ -194,6 +194,39 @@ TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, CallToWaitPid
     fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran");
 }
 
+static unsigned long fakeTimeInMillis = 0;
+
+static unsigned long TimeInMillisJumpingOneSecond_()
+{
+    fakeTimeInMillis += 1000;
+    return fakeTimeInMillis;
+}
+
+static void hangingTestFunction_()
+{
+    for (;;) pause();
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, TimeoutKillsTheSeparateProcess)
+{
+    fakeTimeInMillis = 0;
+    UT_PTR_SET(GetPlatformSpecificTimeInMillis, TimeInMillisJumpingOneSecond_);
+    fixture.setRunTestsInSeperateProcess();
+    fixture.getRegistry()->setTimeout(1);
+    fixture.setTestFunction(hangingTestFunction_);
+    fixture.runAllTests();
+    fixture.assertPrintContains("Timed out in separate process after 1000 ms - killed");
+    fixture.assertPrintContains("Errors (1 failures, 1 tests, 1 ran");
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, TestWithinTimeoutInSeparateProcessWorks)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.getRegistry()->setTimeout(10);
+    fixture.runAllTests();
+    fixture.assertPrintContains("OK (1 tests, 1 ran, 0 checks, 0 ignored, 0 filtered out");
+}
+
 TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, MultipleTestsInSeparateProcessAreCountedProperly)
 {
     fixture.setRunTestsInSeperateProcess();
@@ -207,5 +240,25 @@ TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, MultipleTests
     fixture.assertPrintContains("Errors (2 failures, 5 tests, 5 ran, 0 checks, 0 ignored, 0 filtered out");
 }
 
+#ifdef CPPUTEST_HAVE_ALARM
+
+/* Raising the alarm runs the real handler without waiting for the watchdog to expire */
+static void watchdogExpiringInHangingTestFunction_()
+{
+    PlatformSpecificSetWatchdog(1, "");
+    raise(SIGALRM);
+    for (;;) pause();
+}
+
+TEST(UTestPlatformsTest_PlatformSpecificRunTestInASeperateProcess, ExpiredWatchdogEndsTheProcessWithAFailure)
+{
+    fixture.setRunTestsInSeperateProcess();
+    fixture.setTestFunction(watchdogExpiringInHangingTestFunction_);
+    fixture.runAllTests();
+    fixture.assertPrintContains("Failed in separate process");
+}
+
+#endif
+
 #endif
 #endif
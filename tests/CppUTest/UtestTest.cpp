@@ -387,6 +387,81 @@ TEST(UtestShell, RunInSeparateProcessTest)
     fixture.assertPrintContains("Failed in separate process");
 }
 
+static unsigned int watchdogArmedSeconds = 0;
+static unsigned int watchdogSeconds = 0;
+static char watchdogMessage[512];
+static int stdoutFlushes = 0;
+static int stdoutFlushesWhenArmed = 0;
+
+static void StubPlatformSpecificFlush()
+{
+    stdoutFlushes++;
+}
+
+static void StubPlatformSpecificSetWatchdog(unsigned int seconds, const char* message)
+{
+    watchdogSeconds = seconds;
+    if (seconds > 0) {
+        watchdogArmedSeconds = seconds;
+        stdoutFlushesWhenArmed = stdoutFlushes;
+        SimpleString(message).copyToBuffer(watchdogMessage, sizeof(watchdogMessage));
+    }
+}
+
+TEST_GROUP(UtestShellWatchdog)
+{
+    TestTestingFixture fixture;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        watchdogArmedSeconds = 0;
+        watchdogSeconds = 0;
+        watchdogMessage[0] = '\0';
+        stdoutFlushes = 0;
+        stdoutFlushesWhenArmed = 0;
+        UT_PTR_SET(PlatformSpecificSetWatchdog, StubPlatformSpecificSetWatchdog);
+        UT_PTR_SET(PlatformSpecificFlush, StubPlatformSpecificFlush);
+    }
+};
+
+TEST(UtestShellWatchdog, isNotArmedWithoutTimeout)
+{
+    fixture.runAllTests();
+    LONGS_EQUAL(0, watchdogArmedSeconds);
+}
+
+TEST(UtestShellWatchdog, isArmedDuringTheTestAndCancelledAfterwards)
+{
+    fixture.getRegistry()->setTimeout(3);
+    fixture.runAllTests();
+    LONGS_EQUAL(3, watchdogArmedSeconds);
+    LONGS_EQUAL(0, watchdogSeconds);
+}
+
+TEST(UtestShellWatchdog, isArmedWithAMessagePreparedBeforehand)
+{
+    fixture.getRegistry()->setTimeout(3);
+    fixture.runAllTests();
+    STRCMP_CONTAINS("error: Failure in TEST(", watchdogMessage);
+    STRCMP_CONTAINS("Timed out after 3 seconds", watchdogMessage);
+}
+
+TEST(UtestShellWatchdog, stdoutIsFlushedBeforeItIsArmed)
+{
+    fixture.getRegistry()->setTimeout(3);
+    fixture.runAllTests();
+    LONGS_EQUAL(1, stdoutFlushesWhenArmed);
+}
+
+TEST(UtestShellWatchdog, isNotArmedInTheParentOfASeparateProcess)
+{
+    UT_PTR_SET(PlatformSpecificRunTestInASeperateProcess, StubPlatformSpecificRunTestInASeperateProcess);
+    fixture.getRegistry()->setRunTestsInSeperateProcess();
+    fixture.getRegistry()->setTimeout(3);
+    fixture.runAllTests();
+    LONGS_EQUAL(0, watchdogArmedSeconds);
+}
+
 // There is a possibility that a compiler provides fork but not waitpid.
 #if !defined(CPPUTEST_HAVE_FORK) || !defined(CPPUTEST_HAVE_WAITPID) || !defined(CPPUTEST_HAVE_KILL)
 
@@ -501,6 +576,51 @@ TEST(IgnoredUtestShell, runIgnoredOptionSpecifiedThenWillRunReturnTrue)
     CHECK_TRUE(ignoredTest.willRun());
 }
 
+TEST_GROUP(BenchmarkUtestShell)
+{
+    TestTestingFixture fixture;
+    BenchmarkUtestShell benchmarkTest;
+    ExecFunctionTestShell normalUtestShell;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        fixture.addTest(&benchmarkTest);
+        fixture.addTest(&normalUtestShell);
+    }
+};
+
+TEST(BenchmarkUtestShell, isIgnoredByDefault)
+{
+    fixture.runAllTests();
+    LONGS_EQUAL(2, fixture.getRunCount());
+    LONGS_EQUAL(1, fixture.getIgnoreCount());
+    CHECK_FALSE(benchmarkTest.willRun());
+}
+
+TEST(BenchmarkUtestShell, runBenchmarksOptionSpecifiedThenIncreaseRunCount)
+{
+    benchmarkTest.setRunBenchmarks();
+    fixture.runAllTests();
+    LONGS_EQUAL(3, fixture.getRunCount());
+    LONGS_EQUAL(0, fixture.getIgnoreCount());
+    CHECK_TRUE(benchmarkTest.willRun());
+}
+
+TEST(BenchmarkUtestShell, runBenchmarksOptionSpecifiedWillNotInfluenceNormalTestCount)
+{
+    normalUtestShell.setRunBenchmarks();
+    fixture.runAllTests();
+    LONGS_EQUAL(2, fixture.getRunCount());
+    LONGS_EQUAL(1, fixture.getIgnoreCount());
+}
+
+TEST(BenchmarkUtestShell, returnsBENCHMARKInFormattedName)
+{
+    benchmarkTest.setGroupName("TestGroup");
+    benchmarkTest.setTestName("TestName");
+    STRCMP_EQUAL("BENCHMARK(TestGroup, TestName)", benchmarkTest.getFormattedName().asCharString());
+}
+
 TEST_BASE(MyOwnTest)
 {
     MyOwnTest() :
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/ZeroFreeNumber.h"
+
+TEST_GROUP(ZeroFreeNumber)
+{
+    unsigned long decoded;
+    size_t length;
+
+    bool decode(const SimpleString& encoded)
+    {
+        const char* position = encoded.asCharString();
+        bool result = ZeroFreeNumber::decode(position, position + encoded.size(), decoded);
+        length = (size_t) (position - encoded.asCharString());
+        return result;
+    }
+};
+
+TEST(ZeroFreeNumber, SmallNumbersTakeOneByte)
+{
+    STRCMP_EQUAL("\x01", ZeroFreeNumber::encode(0).asCharString());
+    STRCMP_EQUAL("\x7f", ZeroFreeNumber::encode(126).asCharString());
+}
+
+TEST(ZeroFreeNumber, LargerNumbersAreWrittenLeastSignificantDigitFirst)
+{
+    STRCMP_EQUAL("\x81\x02", ZeroFreeNumber::encode(127).asCharString());
+}
+
+TEST(ZeroFreeNumber, DecodesWhatWasEncoded)
+{
+    const unsigned long values[] = { 0, 1, 126, 127, 128, 16128, 16129, 0xFFFFFFFFul };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        SimpleString encoded = ZeroFreeNumber::encode(values[i]);
+        CHECK(decode(encoded));
+        LONGS_EQUAL(encoded.size(), length);
+        LONGS_EQUAL(values[i], decoded);
+    }
+}
+
+TEST(ZeroFreeNumber, DecodesInPlace)
+{
+    char encoded[] = "\x81\x02\x05";
+    char* position = encoded;
+    CHECK(ZeroFreeNumber::decode(position, encoded + 3, decoded));
+    LONGS_EQUAL(127, decoded);
+    POINTERS_EQUAL(encoded + 2, position);
+}
+
+TEST(ZeroFreeNumber, DecodingAnUnfinishedNumberFails)
+{
+    CHECK_FALSE(decode("\x81"));
+    CHECK_FALSE(decode(""));
+}
@@ -217,6 +217,70 @@ TEST(MockExpectedCallsList, addPotentiallyMatchingExpectationsMultipleUnmatchedE
     LONGS_EQUAL(2, newList.size());
 }
 
+TEST(MockExpectedCallsList, addPotentiallyMatchingExpectationsRelatedToOnlyAddsUnmatchedExpectationsWithThatName)
+{
+    call3->withName("foo");
+    call4->withName("foo");
+    call3->callWasMade(1);
+    list->addExpectedCall(call1);
+    list->addExpectedCall(call2);
+    list->addExpectedCall(call3);
+    list->addExpectedCall(call4);
+
+    MockExpectedCallsList newList;
+    newList.addPotentiallyMatchingExpectationsRelatedTo("foo", *list);
+    LONGS_EQUAL(2, newList.size());
+    POINTERS_EQUAL(call1, newList.removeFirstMatchingExpectation());
+    POINTERS_EQUAL(call4, newList.removeFirstMatchingExpectation());
+}
+
+TEST(MockExpectedCallsList, addPotentiallyMatchingExpectationsRelatedToSkipsExpectationsThatGotFulfilled)
+{
+    call2->withName("foo");
+    list->addExpectedCall(call1);
+    list->addExpectedCall(call2);
+
+    MockExpectedCallsList firstList;
+    firstList.addPotentiallyMatchingExpectationsRelatedTo("foo", *list);
+    LONGS_EQUAL(2, firstList.size());
+
+    call1->callWasMade(1);
+    MockExpectedCallsList secondList;
+    secondList.addPotentiallyMatchingExpectationsRelatedTo("foo", *list);
+    LONGS_EQUAL(1, secondList.size());
+    CHECK(secondList.hasUnfulfilledExpectations());
+}
+
+TEST(MockExpectedCallsList, expectationsAddedAfterALookupByNameAreFound)
+{
+    list->addExpectedCall(call1);
+    CHECK(!list->hasExpectationWithName("bar"));
+
+    list->addExpectedCall(call2);
+    CHECK(list->hasExpectationWithName("bar"));
+
+    MockExpectedCallsList newList;
+    newList.addPotentiallyMatchingExpectationsRelatedTo("bar", *list);
+    LONGS_EQUAL(1, newList.size());
+}
+
+TEST(MockExpectedCallsList, lookupByNameStillWorksAfterExpectationsWereRemoved)
+{
+    call3->withName("foo");
+    list->addExpectedCall(call1);
+    list->addExpectedCall(call2);
+    list->addExpectedCall(call3);
+    CHECK(list->hasExpectationWithName("bar"));
+
+    list->onlyKeepExpectationsRelatedTo("foo");
+    CHECK(!list->hasExpectationWithName("bar"));
+    CHECK(list->hasExpectationWithName("foo"));
+
+    list->addExpectedCall(call2);
+    LONGS_EQUAL(3, list->size());
+    CHECK(list->hasExpectationWithName("bar"));
+}
+
 TEST(MockExpectedCallsList, amountOfActualCallsFulfilledFor_HasOneRelated)
 {
     call1->withName("foo");
@@ -270,3 +270,27 @@ TEST(MockCheckedActualCall, MockActualCallTraceClear)
     actual.clear();
     STRCMP_EQUAL("", actual.getTraceOutput());
 }
+
+TEST(MockCheckedActualCall, MockActualCallTraceCopiesStringsAndBuffers)
+{
+    char text[] = "abc";
+    unsigned char buffer[] = { 0x12 };
+    MockActualCallTrace actual;
+    actual.withName("func");
+    actual.withStringParameter("text", text);
+    actual.withMemoryBufferParameter("buffer", buffer, sizeof(buffer));
+    text[0] = 'x';
+    buffer[0] = 0x34;
+
+    STRCMP_EQUAL("\nFunction name:func text:abc buffer:Size = 1 | HexContents = 12", actual.getTraceOutput());
+}
+
+TEST(MockCheckedActualCall, MockActualCallTraceWithLimitKeepsTheLastEvents)
+{
+    MockActualCallTrace actual;
+    actual.setMaximumEvents(3);
+    for (int i = 0; i < 5; i++)
+        actual.withName("func").withIntParameter("i", i);
+
+    STRCMP_EQUAL("\n(7 earlier trace events were dropped) i:3 (0x3)\nFunction name:func i:4 (0x4)", actual.getTraceOutput());
+}
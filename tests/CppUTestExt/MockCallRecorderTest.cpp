@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+#include "MockFailureReporterForTest.h"
+
+class MockCallRecorderToBuffer : public MockCallRecorder
+{
+public:
+    MockCallRecorderToBuffer() : closeCount(0), isOpen(false)
+    {
+    }
+
+    SimpleString contents;
+    SimpleString lastMode;
+    int closeCount;
+    bool isOpen;
+
+protected:
+    virtual void openFile(const char* mode) CPPUTEST_OVERRIDE
+    {
+        lastMode = mode;
+        isOpen = true;
+    }
+
+    virtual void writeToFile(const SimpleString& buffer) CPPUTEST_OVERRIDE
+    {
+        if (!isOpen) {
+            openFile("wb");
+            contents += signature();
+        }
+        contents += buffer;
+    }
+
+    virtual void closeFile() CPPUTEST_OVERRIDE
+    {
+        if (isOpen) closeCount++;
+        isOpen = false;
+    }
+};
+
+static void dummyFunction()
+{
+}
+
+static int deviceData;
+
+static void callDriver(int& result, const char*& name)
+{
+    const unsigned char buffer[] = { 0, 1, 0xFF, 0x80 };
+    result = mock().actualCall("read").withParameter("register", -5).withParameter("mask", 0xFFFFFFFFUL).returnIntValue();
+    name = mock("bus").actualCall("name").withParameter("enabled", true).withParameter("speed", 2.5).withParameter("buffer", buffer, sizeof(buffer))
+                      .withParameter("callback", dummyFunction).withParameter("data", (const void*) &deviceData).returnStringValue();
+    mock().actualCall("write").withParameter("text", "hello");
+}
+
+static int callDriverWithDefaults(const char*& name)
+{
+    int result = mock().actualCall("read").withParameter("register", 3).returnIntValueOrDefault(7);
+    name = mock("bus").actualCall("name").withParameter("enabled", true).returnStringValueOrDefault("i2c");
+    mock().actualCall("write").withParameter("text", "hello");
+    return result;
+}
+
+TEST_GROUP(MockCallRecorder)
+{
+    MockCallRecorderToBuffer recorder;
+
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        mock().clear();
+    }
+
+    void recordDriverCalls()
+    {
+        int result;
+        const char* name;
+        mock().expectOneCall("read").ignoreOtherParameters().andReturnValue(42);
+        mock("bus").expectOneCall("name").ignoreOtherParameters().andReturnValue("spi");
+        mock().expectOneCall("write").ignoreOtherParameters();
+
+        mock().recordCalls(&recorder);
+        callDriver(result, name);
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+TEST(MockCallRecorder, StartsWithTheSignatureAndWritesNamesOnce)
+{
+    mock().expectNCalls(2, "foo");
+    mock().recordCalls(&recorder);
+    mock().actualCall("foo");
+    mock().actualCall("foo");
+    mock().checkExpectations();
+
+    STRCMP_EQUAL("wb", recorder.lastMode.asCharString());
+    STRCMP_EQUAL("CppUTest mock calls 2\n" "S\x02\n" "S\x05" "foo\n" "C\x05\x01\x02\x01\x01" "C\x05\x01\x02\x01\x01", recorder.contents.asCharString());
+}
+
+TEST(MockCallRecorder, RecordedCallsAreReplayedAsExpectations)
+{
+    recordDriverCalls();
+
+    MockCallReplayer replayer;
+    replayer.read(recorder.contents.asCharString());
+    CHECK(replayer.expectRecordedCalls(mock()));
+
+    int result;
+    const char* name;
+    callDriver(result, name);
+    mock().checkExpectations();
+
+    LONGS_EQUAL(42, result);
+    STRCMP_EQUAL("spi", name);
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockCallRecorder, RunWithoutExpectationsIsRecordedWhenAcceptingAllCalls)
+{
+    const char* name;
+    mock().recordCalls(&recorder, true);
+    mock().ignoreOtherCalls();
+    LONGS_EQUAL(7, callDriverWithDefaults(name));
+    mock().checkExpectations();
+    mock().clear();
+
+    MockCallReplayer replayer;
+    replayer.read(recorder.contents.asCharString());
+    CHECK(replayer.expectRecordedCalls(mock()));
+
+    int result = mock().actualCall("read").withParameter("register", 3).returnIntValue();
+    name = mock("bus").actualCall("name").withParameter("enabled", true).returnStringValue();
+    mock().actualCall("write").withParameter("text", "hello");
+    mock().checkExpectations();
+
+    LONGS_EQUAL(7, result);
+    STRCMP_EQUAL("i2c", name);
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockCallRecorder, ExpectationsStillCheckTheCallsWhenAcceptingAllCalls)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().expectOneCall("read").withParameter("register", 1);
+    mock().recordCalls(&recorder, true);
+    mock().actualCall("read").withParameter("register", 3);
+
+    STRCMP_CONTAINS("Unexpected parameter value to parameter \"register\" to function \"read\"", mockFailureString().asCharString());
+}
+
+TEST(MockCallRecorder, PointersAreNotComparedOnReplay)
+{
+    int otherData;
+    mock().expectOneCall("attach").ignoreOtherParameters();
+    mock().recordCalls(&recorder);
+    mock().actualCall("attach").withParameter("data", (void*) &deviceData).withParameter("callback", dummyFunction).withParameter("id", 1);
+    mock().checkExpectations();
+    mock().clear();
+
+    MockCallReplayer replayer;
+    replayer.read(recorder.contents.asCharString());
+    CHECK(replayer.expectRecordedCalls(mock()));
+    mock().actualCall("attach").withParameter("data", (void*) &otherData).withParameter("callback", (void (*)()) NULLPTR).withParameter("id", 1);
+    mock().checkExpectations();
+}
+
+TEST(MockCallRecorder, ReplaysARecordingWrittenByAnotherProcess)
+{
+    const unsigned char buffer[] = { 0x00, 0xFF };
+    int address;
+    MockCallReplayer replayer;
+    replayer.read("CppUTest mock calls 2\n" "S\x02\n" "S\x07write\n" "S\x09" "address\n" "S\x08" "buffer\n" "S\x07" "count\n"
+                  "C\x11\x01\x02\x04" "\x03o" "\x04m\x03" "00ff" "\x05i\x07" "\x01");
+    CHECK(replayer.expectRecordedCalls(mock()));
+
+    mock().actualCall("write").withParameter("address", (void*) &address).withParameter("buffer", buffer, sizeof(buffer)).withParameter("count", 3);
+    mock().checkExpectations();
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockCallRecorder, BytesThatAreNotHexDigitsAreRejected)
+{
+    MockCallReplayer replayer;
+    replayer.read("CppUTest mock calls 2\n" "S\x02\n" "S\x07write\n" "S\x08" "buffer\n"
+                  "C\x0c\x01\x02\x02" "\x03m\x03" "00fg" "\x01");
+
+    CHECK_FALSE(replayer.expectRecordedCalls(mock()));
+}
+
+TEST(MockCallRecorder, ReplayedCallsCheckTheRecordedParameters)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    recordDriverCalls();
+
+    MockCallReplayer replayer;
+    replayer.read(recorder.contents.asCharString());
+    CHECK(replayer.expectRecordedCalls(mock()));
+
+    mock().actualCall("read").withParameter("register", 5);
+    STRCMP_CONTAINS("Unexpected parameter value to parameter \"register\" to function \"read\"", mockFailureString().asCharString());
+}
+
+TEST(MockCallRecorder, ReplayedCallsMustHappenInTheRecordedOrder)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().expectOneCall("first");
+    mock().expectOneCall("second");
+    mock().recordCalls(&recorder);
+    mock().actualCall("first");
+    mock().actualCall("second");
+    mock().checkExpectations();
+    mock().clear();
+
+    MockCallReplayer replayer;
+    replayer.read(recorder.contents.asCharString());
+    CHECK(replayer.expectRecordedCalls(mock()));
+    mock().actualCall("second");
+    mock().actualCall("first");
+    mock().checkExpectations();
+
+    STRCMP_CONTAINS("Mock Failure: Out of order calls", mockFailureString().asCharString());
+}
+
+TEST(MockCallRecorder, ValuesThatCannotBeRecordedAreIgnoredOnReplay)
+{
+    int output = 0;
+    int object = 1;
+    mock().expectOneCall("foo").withOutputParameterReturning("output", &object, sizeof(object)).ignoreOtherParameters();
+    mock().recordCalls(&recorder);
+    mock().actualCall("foo").withOutputParameter("output", &output).withParameter("value", 3);
+    mock().checkExpectations();
+    mock().clear();
+
+    MockCallReplayer replayer;
+    replayer.read(recorder.contents.asCharString());
+    CHECK(replayer.expectRecordedCalls(mock()));
+    mock().actualCall("foo").withOutputParameter("output", &output).withParameter("value", 3);
+    mock().checkExpectations();
+}
+
+TEST(MockCallRecorder, FailedCallsAreNotRecorded)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    mock().recordCalls(&recorder);
+    mock().actualCall("unexpected");
+    mock().checkExpectations();
+
+    CHECK_FALSE(recorder.contents.contains("unexpected"));
+}
+
+TEST(MockCallRecorder, SomethingElseThanARecordingIsRejected)
+{
+    MockCallReplayer replayer;
+    replayer.read("<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n");
+
+    CHECK_FALSE(replayer.expectRecordedCalls(mock()));
+    CHECK_FALSE(mock().expectedCallsLeft());
+}
+
+TEST(MockCallRecorder, MissingRecordingIsRejected)
+{
+    CHECK_FALSE(mock().expectRecordedCalls("there/is/no/such/cpputest_mock_calls.rec"));
+}
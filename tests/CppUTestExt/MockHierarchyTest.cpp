@@ -47,6 +47,37 @@ TEST(MockHierarchyTest, getMockSupportScope)
     CHECK(mock1 != &mock());
 }
 
+TEST(MockHierarchyTest, manyScopesAreAllKeptApart)
+{
+    MockSupport* scopes[100];
+    for (int i = 0; i < 100; i++)
+        scopes[i] = mock().getMockSupportScope(StringFromFormat("scope%d", i));
+
+    for (int i = 0; i < 100; i++)
+        POINTERS_EQUAL(scopes[i], &mock(StringFromFormat("scope%d", i)));
+}
+
+TEST(MockHierarchyTest, mockScopeHandleIsTheSameAsMockWithName)
+{
+    MockScope gpio("gpio");
+
+    POINTERS_EQUAL(&mock("gpio"), &gpio());
+    POINTERS_EQUAL(&mock(), &MockScope("")());
+}
+
+TEST(MockHierarchyTest, mockScopeHandleSurvivesClear)
+{
+    MockScope gpio("gpio");
+    gpio().expectOneCall("write");
+    mock().clear();
+
+    gpio().expectOneCall("read");
+    POINTERS_EQUAL(&mock("gpio"), &gpio());
+    LONGS_EQUAL(1, mock().expectedCallsLeft());
+    gpio().actualCall("read");
+    mock().checkExpectations();
+}
+
 TEST(MockHierarchyTest, usingTwoMockSupportsByName)
 {
     mock("first").expectOneCall("boo");
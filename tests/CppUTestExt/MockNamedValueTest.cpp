@@ -93,6 +93,30 @@ TEST(ComparatorsAndCopiersRepository, InstallComparatorsAndCopiersFromRepository
   target.clear();
 }
 
+TEST(ComparatorsAndCopiersRepository, InstallingComparatorForSameTypeAgainReplacesIt)
+{
+  MyComparator comparator1, comparator2;
+  MyCopier copier;
+  MockNamedValueComparatorsAndCopiersRepository repository;
+  repository.installComparator("MyType", comparator1);
+  repository.installCopier("MyType", copier);
+  repository.installComparator("MyType", comparator2);
+  POINTERS_EQUAL(&comparator2, repository.getComparatorForType("MyType"));
+  POINTERS_EQUAL(&copier, repository.getCopierForType("MyType"));
+}
+
+TEST(ComparatorsAndCopiersRepository, ManyTypesAreFoundBySymbol)
+{
+  MyComparator comparators[100];
+  MockNamedValueComparatorsAndCopiersRepository repository;
+  for (int i = 0; i < 100; i++)
+    repository.installComparator(StringFromFormat("Type%d", i), comparators[i]);
+
+  for (int i = 0; i < 100; i++)
+    POINTERS_EQUAL(&comparators[i], repository.getComparatorForSymbol(MockSymbolTable::symbolFor(StringFromFormat("Type%d", i))));
+  POINTERS_EQUAL(NULLPTR, repository.getCopierForSymbol(MockSymbolTable::symbolFor("Type1")));
+}
+
 TEST_GROUP(MockNamedValue)
 {
   MockNamedValue * value;
@@ -726,6 +726,25 @@ TEST(MockParameterTest, twoOutputParameters)
     mock().checkExpectations();
 }
 
+TEST(MockParameterTest, manyOutputParametersInSameFunctionCallAreAllCopied)
+{
+    int params[6] = { 0, 0, 0, 0, 0, 0 };
+    int retvals[6] = { 1, 2, 3, 4, 5, 6 };
+    const char* names[6] = { "p1", "p2", "p3", "p4", "p5", "p6" };
+
+    MockExpectedCall& expectedCall = mock().expectOneCall("function");
+    for (int i = 0; i < 6; i++)
+        expectedCall.withOutputParameterReturning(names[i], &retvals[i], sizeof(retvals[i]));
+
+    MockActualCall& actualCall = mock().actualCall("function");
+    for (int i = 0; i < 6; i++)
+        actualCall.withOutputParameter(names[i], &params[i]);
+
+    for (int i = 0; i < 6; i++)
+        LONGS_EQUAL(retvals[i], params[i]);
+    mock().checkExpectations();
+}
+
 TEST(MockParameterTest, twoInterleavedOutputParameters)
 {
     int param1 = 55;
@@ -930,3 +949,61 @@ TEST(MockParameterTest, expectMultipleMultipleCallsWithParameters)
 
     mock().checkExpectations();
 }
+
+TEST(MockParameterTest, parameterSequenceIsConsumedInOrder)
+{
+    unsigned int values[100];
+    for (unsigned int i = 0; i < 100; i++)
+        values[i] = i * 3;
+
+    mock().expectNCalls(100, "writeRegister").withParameter("address", 0x40).withParameterSequence("value", values);
+    for (unsigned int i = 0; i < 100; i++)
+        mock().actualCall("writeRegister").withParameter("address", 0x40).withParameter("value", i * 3);
+
+    mock().checkExpectations();
+}
+
+TEST(MockParameterTest, multipleParameterSequencesInOneExpectation)
+{
+    const char* names[] = { "one", "two" };
+    const double levels[] = { 1.5, 2.5 };
+
+    mock().expectNCalls(2, "foo").withParameterSequence("name", names).withParameterSequence("level", levels);
+    mock().actualCall("foo").withParameter("name", "one").withParameter("level", 1.5);
+    mock().actualCall("foo").withParameter("name", "two").withParameter("level", 2.5);
+
+    mock().checkExpectations();
+}
+
+TEST(MockParameterTest, parameterSequenceOfTypeTakesTheTypeName)
+{
+    const unsigned long int values[] = { 7, 8 };
+
+    mock().expectNCalls(2, "foo").withParameterSequenceOfType("unsigned long int", "value", values);
+    mock().actualCall("foo").withParameter("value", 7ul);
+    mock().actualCall("foo").withParameter("value", 8ul);
+
+    mock().checkExpectations();
+}
+
+TEST(MockParameterTest, parameterSequenceIsIgnoredByDefault)
+{
+    const int values[] = { 1 };
+    MockIgnoredExpectedCall call;
+
+    POINTERS_EQUAL(&call, &call.MockExpectedCall::withParameterSequenceOfType("int", "value", values));
+}
+
+TEST(MockParameterTest, parameterSequenceFailureReportsTheIndex)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    const int values[] = { 1, 2, 3 };
+
+    mock().expectNCalls(3, "foo").withParameterSequence("value", values);
+    mock().actualCall("foo").withParameter("value", 1);
+    mock().actualCall("foo").withParameter("value", 2);
+    mock().actualCall("foo").withParameter("value", 4);
+
+    STRCMP_CONTAINS("Unexpected parameter value to parameter \"value\" to function \"foo\": <4 (0x4)>", mockFailureString().asCharString());
+    STRCMP_CONTAINS("foo -> int value: <3 (0x3)>, sequence index <2> (expected 3 calls, called 2 times)", mockFailureString().asCharString());
+}
@@ -26,6 +26,8 @@
  */
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/TestOutput.h"
+#include "CppUTest/MemoryLeakWarningPlugin.h"
+#include "CppUTest/MemoryLeakDetector.h"
 #include "CppUTestExt/MockSupport.h"
 #include "CppUTestExt/MockSupportPlugin.h"
 #include "MockFailureReporterForTest.h"
@@ -52,6 +54,7 @@ TEST_GROUP(MockPlugin)
         delete result;
         mock().clear();
         mock().removeAllComparatorsAndCopiers();
+        mock().setTraceLimit(0);
     }
 };
 
@@ -72,6 +75,20 @@ TEST(MockPlugin, checkExpectationsAndClearAtEnd)
     CHECK_NO_MOCK_FAILURE();
 }
 
+TEST(MockPlugin, traceLimitIsKeptForTheNextTest)
+{
+    mock().setTraceLimit(2);
+    plugin.postTestAction(*test, *result);
+
+    plugin.preTestAction(*test, *result);
+    mock().tracing(true);
+    mock().actualCall("first");
+    mock().actualCall("second");
+    mock().actualCall("third");
+
+    STRCMP_EQUAL("\n(1 earlier trace events were dropped)\nFunction name:second\nFunction name:third", mock().getTraceOutput());
+}
+
 TEST(MockPlugin, checkExpectationsWorksAlsoWithHierachicalObjects)
 {
     MockFailureReporterInstaller failureReporterInstaller;
@@ -174,3 +191,71 @@ TEST(MockPlugin, shouldNotFailAgainWhenTestAlreadyFailed)
     fixture.runAllTests();
     fixture.assertPrintContains("1 failures, 1 tests, 1 ran, 2 checks,");
 }
+
+TEST(MockPlugin, statisticsAreNotCollectedByDefault)
+{
+    plugin.preTestAction(*test, *result);
+    mock().expectOneCall("foo");
+    mock().actualCall("foo");
+    plugin.postTestAction(*test, *result);
+    plugin.postRunAction(*result);
+
+    LONGS_EQUAL(0, plugin.getStatistics().getStatisticsFor("foo").calls);
+    STRCMP_EQUAL("", output.getOutput().asCharString());
+}
+
+TEST(MockPlugin, mockstatsArgumentCollectsStatisticsAndPrintsThemAtTheEndOfTheRun)
+{
+    const char *cmd_line[] = {"-pmockstats"};
+    CHECK(plugin.parseArguments(1, cmd_line, 0));
+
+    plugin.preTestAction(*test, *result);
+    mock("scope").expectOneCall("foo");
+    mock("scope").actualCall("foo");
+    plugin.postTestAction(*test, *result);
+
+    LONGS_EQUAL(1, plugin.getStatistics().getStatisticsFor("scope::foo").calls);
+
+    plugin.postRunAction(*result);
+    STRCMP_CONTAINS("Mock statistics", output.getOutput().asCharString());
+    STRCMP_CONTAINS("scope::foo", output.getOutput().asCharString());
+    LONGS_EQUAL(0, plugin.getStatistics().getStatisticsFor("scope::foo").calls);
+}
+
+TEST(MockPlugin, mockstatsWithoutMockedCallsSaysSoAtTheEndOfTheRun)
+{
+    const char *cmd_line[] = {"-pmockstats"};
+    CHECK(plugin.parseArguments(1, cmd_line, 0));
+
+    plugin.postRunAction(*result);
+    STRCMP_CONTAINS("no mocked calls were made", output.getOutput().asCharString());
+}
+
+static void mockedCallFunction_()
+{
+    mock().expectOneCall("foo");
+    mock().actualCall("foo");
+}
+
+TEST(MockPlugin, collectingStatisticsIsNotSeenAsAMemoryLeak)
+{
+    MemoryLeakWarningPlugin memoryLeakPlugin("MemoryLeakPlugin");
+    TestTestingFixture fixture;
+    fixture.installPlugin(&plugin);
+    fixture.installPlugin(&memoryLeakPlugin);
+    fixture.setTestFunction(mockedCallFunction_);
+    plugin.collectStatistics();
+
+    /* The allocations of this test so far are not the ones of the test run by the fixture */
+    MemoryLeakWarningPlugin::getGlobalDetector()->markCheckingPeriodLeaksAsNonCheckingPeriod();
+    fixture.runAllTests();
+
+    LONGS_EQUAL(0, fixture.getFailureCount());
+    LONGS_EQUAL(1, plugin.getStatistics().getStatisticsFor("foo").calls);
+}
+
+TEST(MockPlugin, otherArgumentsAreNotParsed)
+{
+    const char *cmd_line[] = {"-pmock"};
+    CHECK_FALSE(plugin.parseArguments(1, cmd_line, 0));
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTestExt/MockSupport.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "MockFailureReporterForTest.h"
+
+static unsigned long fakeTime;
+
+static unsigned long fakeTimeInMicros(void)
+{
+    return fakeTime += 10;
+}
+
+TEST_GROUP(MockStatistics)
+{
+    MockStatistics statistics;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        fakeTime = 0;
+        UT_PTR_SET(GetPlatformSpecificTimeInMicros, fakeTimeInMicros);
+    }
+
+    void teardown() CPPUTEST_OVERRIDE
+    {
+        mock().clear();
+    }
+
+    MockFunctionStatistics call(unsigned long matchingTime, unsigned long expectationsScanned)
+    {
+        MockFunctionStatistics function;
+        function.calls = 1;
+        function.matchingTimeInMicros = matchingTime;
+        function.expectationsScanned = expectationsScanned;
+        return function;
+    }
+};
+
+TEST(MockStatistics, addsUpTheCallsOfAFunction)
+{
+    statistics.addCall(MockSymbolTable::symbolFor("foo"), call(5, 2));
+    statistics.addCall(MockSymbolTable::symbolFor("foo"), call(7, 3));
+
+    MockFunctionStatistics foo = statistics.getStatisticsFor("foo");
+    LONGS_EQUAL(2, foo.calls);
+    LONGS_EQUAL(12, foo.matchingTimeInMicros);
+    LONGS_EQUAL(5, foo.expectationsScanned);
+    LONGS_EQUAL(0, statistics.getStatisticsFor("bar").calls);
+}
+
+TEST(MockStatistics, reportIsEmptyWithoutCalls)
+{
+    STRCMP_EQUAL("", statistics.report().asCharString());
+}
+
+TEST(MockStatistics, reportListsTheMostExpensiveFunctionFirst)
+{
+    statistics.addCall(MockSymbolTable::symbolFor("cheap"), call(1, 1));
+    statistics.addCall(MockSymbolTable::symbolFor("expensive"), call(100, 1));
+    statistics.addCall(MockSymbolTable::symbolFor("scanning"), call(1, 50));
+
+    STRCMP_EQUAL("\nMock statistics (most expensive first):\n"
+                 "  matching (us)  copying (us)     calls   scanned  failed  function\n"
+                 "            100             0         1         1       0  expensive\n"
+                 "              1             0         1        50       0  scanning\n"
+                 "              1             0         1         1       0  cheap\n",
+                 statistics.report().asCharString());
+}
+
+TEST(MockStatistics, clearRemovesAllFunctions)
+{
+    statistics.addCall(MockSymbolTable::symbolFor("foo"), call(1, 1));
+    statistics.clear();
+    LONGS_EQUAL(0, statistics.getStatisticsFor("foo").calls);
+}
+
+TEST(MockStatistics, countsTheActualCallsAndScannedExpectationsOfAScopedFunction)
+{
+    mock().collectStatistics(&statistics);
+    mock("scope").expectOneCall("foo").withParameter("a", 1);
+    mock("scope").expectOneCall("foo").withParameter("a", 1);
+
+    mock("scope").actualCall("foo").withParameter("a", 1);
+    mock("scope").actualCall("foo").withParameter("a", 1);
+    mock().checkExpectations();
+    mock().clear();
+
+    MockFunctionStatistics foo = statistics.getStatisticsFor("scope::foo");
+    LONGS_EQUAL(2, foo.calls);
+    LONGS_EQUAL(6, foo.expectationsScanned);
+    CHECK(foo.matchingTimeInMicros > 0);
+    LONGS_EQUAL(0, foo.copyingTimeInMicros);
+    LONGS_EQUAL(0, foo.failures);
+}
+
+TEST(MockStatistics, copyingOutputParametersIsCountedSeparately)
+{
+    int value = 0;
+    int output = 4;
+    mock().collectStatistics(&statistics);
+    mock().expectOneCall("foo").withOutputParameterReturning("value", &output, sizeof(output));
+
+    mock().actualCall("foo").withOutputParameter("value", &value);
+    mock().clear();
+
+    MockFunctionStatistics foo = statistics.getStatisticsFor("foo");
+    LONGS_EQUAL(4, value);
+    LONGS_EQUAL(1, foo.calls);
+    CHECK(foo.copyingTimeInMicros > 0);
+    CHECK(foo.matchingTimeInMicros > 0);
+}
+
+TEST(MockStatistics, failedCallsAreCounted)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+    MockExpectedCallsListForTest emptyExpectations;
+    MockUnexpectedCallHappenedFailure expectedFailure(mockFailureTest(), "foo", emptyExpectations);
+    mock().collectStatistics(&statistics);
+
+    mock().actualCall("foo");
+    mock().clear();
+
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+    LONGS_EQUAL(1, statistics.getStatisticsFor("foo").calls);
+    LONGS_EQUAL(1, statistics.getStatisticsFor("foo").failures);
+}
+
+TEST(MockStatistics, clearStopsCollecting)
+{
+    mock().collectStatistics(&statistics);
+    mock().clear();
+
+    mock().expectOneCall("foo");
+    mock().actualCall("foo");
+    mock().clear();
+
+    LONGS_EQUAL(0, statistics.getStatisticsFor("foo").calls);
+}
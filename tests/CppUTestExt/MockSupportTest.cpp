@@ -27,6 +27,7 @@
 
 #include "CppUTest/TestHarness.h"
 #include "CppUTest/TestTestingFixture.h"
+#include "CppUTest/TestMemoryAllocator.h"
 #include "CppUTestExt/MockSupport.h"
 #include "CppUTestExt/MockExpectedCall.h"
 #include "CppUTestExt/MockFailure.h"
@@ -183,6 +184,30 @@ TEST(MockSupportTest, tracingWorksHierarchically)
     STRCMP_CONTAINS("foo", mock().getTraceOutput());
 }
 
+TEST(MockSupportTest, steadyStateActualCallDoesNotAllocate)
+{
+    const SimpleString functionName("foo");
+    const SimpleString inputName("input");
+    const SimpleString outputName("output");
+    int returned = 10;
+    int output = 0;
+    mock().expectNCalls(2, functionName).withParameter(inputName, 1).withOutputParameterReturning(outputName, &returned, sizeof(returned));
+    MockSupport& support = mock();
+    support.actualCall(functionName).withParameter(inputName, 1).withOutputParameter(outputName, &output);
+
+    GlobalMemoryAccountant accountant;
+    accountant.start();
+    TestMemoryAllocator* originalStringAllocator = SimpleString::getStringAllocator();
+    SimpleString::setStringAllocator(accountant.getNewArrayAllocator());
+    support.actualCall(functionName).withParameter(inputName, 1).withOutputParameter(outputName, &output);
+    support.checkExpectations();
+    SimpleString::setStringAllocator(originalStringAllocator);
+    accountant.stop();
+
+    STRCMP_CONTAINS("has not noticed any allocations", accountant.report().asCharString());
+    LONGS_EQUAL(10, output);
+}
+
 TEST_GROUP(MockSupportTestWithFixture)
 {
     TestTestingFixture fixture;
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestTestingFixture.h"
+#include "CppUTest/PlatformSpecificFunctions.h"
+#include "CppUTestExt/MockSymbolTable.h"
+
+TEST_GROUP(MockSymbolTable)
+{
+};
+
+TEST(MockSymbolTable, emptyNameIsTheEmptySymbol)
+{
+    LONGS_EQUAL(MockSymbolTable::EMPTY, MockSymbolTable::symbolFor(""));
+    STRCMP_EQUAL("", MockSymbolTable::nameOf(MockSymbolTable::EMPTY));
+}
+
+TEST(MockSymbolTable, builtinTypesArePreInterned)
+{
+    LONGS_EQUAL(MockSymbolTable::TYPE_INT, MockSymbolTable::symbolFor("int"));
+    LONGS_EQUAL(MockSymbolTable::TYPE_FUNCTION_POINTER, MockSymbolTable::symbolFor("void (*)()"));
+    STRCMP_EQUAL("const unsigned char*", MockSymbolTable::nameOf(MockSymbolTable::TYPE_CONST_UNSIGNED_CHAR_POINTER));
+}
+
+TEST(MockSymbolTable, sameNameGivesSameSymbol)
+{
+    MockSymbol symbol = MockSymbolTable::symbolFor("MockSymbolTableTest::foo");
+    LONGS_EQUAL(symbol, MockSymbolTable::symbolFor(SimpleString("MockSymbolTableTest::foo")));
+    STRCMP_EQUAL("MockSymbolTableTest::foo", MockSymbolTable::nameOf(symbol));
+}
+
+TEST(MockSymbolTable, differentNamesGiveDifferentSymbols)
+{
+    CHECK(MockSymbolTable::symbolFor("MockSymbolTableTest::a") != MockSymbolTable::symbolFor("MockSymbolTableTest::b"));
+}
+
+TEST(MockSymbolTable, scopedNameIsTheSameAsTheJoinedName)
+{
+    MockSymbol symbol = MockSymbolTable::symbolFor("scope", "MockSymbolTableTest::function");
+    LONGS_EQUAL(MockSymbolTable::symbolFor("scope::MockSymbolTableTest::function"), symbol);
+    STRCMP_EQUAL("scope::MockSymbolTableTest::function", MockSymbolTable::nameOf(symbol));
+}
+
+TEST(MockSymbolTable, emptyScopeIsIgnored)
+{
+    LONGS_EQUAL(MockSymbolTable::symbolFor("MockSymbolTableTest::unscoped"), MockSymbolTable::symbolFor("", "MockSymbolTableTest::unscoped"));
+}
+
+TEST(MockSymbolTable, symbolsStayValidWhenTheTableGrows)
+{
+    MockSymbol first = MockSymbolTable::symbolFor("MockSymbolTableTest::grow");
+    for (int i = 0; i < 1000; i++)
+        MockSymbolTable::symbolFor(StringFromFormat("MockSymbolTableTest::grow%d", i));
+
+    LONGS_EQUAL(first, MockSymbolTable::symbolFor("MockSymbolTableTest::grow"));
+    STRCMP_EQUAL("MockSymbolTableTest::grow", MockSymbolTable::nameOf(first));
+    STRCMP_EQUAL("MockSymbolTableTest::grow999", MockSymbolTable::nameOf(MockSymbolTable::symbolFor("MockSymbolTableTest::grow999")));
+    CHECK(MockSymbolTable::size() > 1000);
+}
+
+static const char* const unallocatableName_ = "MockSymbolTableTest::nameThatCannotBeAllocated";
+static void* (*originalMalloc_)(size_t);
+
+static void* mallocFailingForTheName_(size_t size)
+{
+    if (size == SimpleString::StrLen(unallocatableName_) + 1)
+        return NULLPTR;
+    return originalMalloc_(size);
+}
+
+static void internUnallocatableName_()
+{
+    MockSymbolTable::symbolFor(unallocatableName_);
+}
+
+TEST(MockSymbolTable, failedAllocationFailsTheTestAndKeepsTheTable)
+{
+    MockSymbol sizeBefore = MockSymbolTable::size();
+    originalMalloc_ = PlatformSpecificMalloc;
+    UT_PTR_SET(PlatformSpecificMalloc, mallocFailingForTheName_);
+
+    TestTestingFixture fixture;
+    fixture.setTestFunction(internUnallocatableName_);
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("MockSymbolTable: malloc returned null pointer");
+    LONGS_EQUAL(sizeBefore, MockSymbolTable::size());
+    STRCMP_EQUAL("int", MockSymbolTable::nameOf(MockSymbolTable::symbolFor("int")));
+}
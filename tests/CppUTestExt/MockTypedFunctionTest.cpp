@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestTestingFixture.h"
+#include "CppUTestExt/MockTypedFunction.h"
+#include "MockFailureReporterForTest.h"
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+
+static MockTypedFunction<int(int, const char*)> mockOpen("open");
+static MockTypedFunction<void(double)> mockSetLevel("setLevel");
+static MockTypedFunction<unsigned long()> mockTicks("ticks");
+static MockTypedFunction<int&(int)> mockRegister("register");
+static MockTypedFunction<const SimpleString&()> mockName("name");
+
+struct MockTypedPoint
+{
+    int x;
+    bool operator==(const MockTypedPoint& other) const { return x == other.x; }
+};
+
+static MockTypedFunction<void(MockTypedPoint)> mockMove("move");
+
+TEST_GROUP(MockTypedFunctionTest)
+{
+  void teardown() CPPUTEST_OVERRIDE
+  {
+      mock().checkExpectations();
+      mock().clear();
+  }
+};
+
+TEST(MockTypedFunctionTest, expectedCallWithMatchingArgumentsReturnsTypedValue)
+{
+    mockOpen.expectOneCall().with(3, "r").andReturn(5);
+
+    LONGS_EQUAL(5, mockOpen(3, "r"));
+}
+
+TEST(MockTypedFunctionTest, stringArgumentsAreComparedByContent)
+{
+    char mode[] = "rw";
+    mockOpen.expectOneCall().with(3, "rw").andReturn(1);
+
+    LONGS_EQUAL(1, mockOpen(3, mode));
+}
+
+TEST(MockTypedFunctionTest, doubleArgumentsAreComparedWithDefaultTolerance)
+{
+    mockSetLevel.expectOneCall().with(0.5);
+
+    mockSetLevel(0.5 + MockNamedValue::defaultDoubleTolerance / 2);
+}
+
+TEST(MockTypedFunctionTest, returnsDefaultValueWhenNoReturnValueWasSet)
+{
+    mockTicks.expectOneCall();
+
+    LONGS_EQUAL(0, mockTicks());
+}
+
+TEST(MockTypedFunctionTest, matchesTheExpectationWithTheSameArguments)
+{
+    mockOpen.expectOneCall().with(1, "r").andReturn(10);
+    mockOpen.expectOneCall().with(2, "r").andReturn(20);
+
+    LONGS_EQUAL(20, mockOpen(2, "r"));
+    LONGS_EQUAL(10, mockOpen(1, "r"));
+}
+
+TEST(MockTypedFunctionTest, expectNCallsWithAnyArguments)
+{
+    mockOpen.expectNCalls(2).withAnyArguments().andReturn(7);
+
+    LONGS_EQUAL(7, mockOpen(1, "a"));
+    LONGS_EQUAL(7, mockOpen(2, "b"));
+}
+
+TEST(MockTypedFunctionTest, typedCallsKeepTheCallOrder)
+{
+    mock().strictOrder();
+    mockTicks.expectOneCall().withCallOrder(1).andReturn(100ul);
+    mock().expectOneCall("untyped").withCallOrder(2);
+
+    LONGS_EQUAL(100, mockTicks());
+    mock().actualCall("untyped");
+}
+
+TEST(MockTypedFunctionTest, ignoredTypedCallsReturnDefaultValue)
+{
+    mock().ignoreOtherCalls();
+
+    LONGS_EQUAL(0, mockOpen(1, "r"));
+}
+
+TEST(MockTypedFunctionTest, unexpectedArgumentsFail)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+
+    MockExpectedCallsListForTest expectations;
+    expectations.addFunction("open")->withArguments(MockTypedValues<int, const char*>(3, "r"));
+    MockTypedValues<int, const char*> arguments(4, "r");
+    MockUnexpectedArgumentsFailure expectedFailure(mockFailureTest(), "open", arguments, expectations);
+
+    mockOpen.expectOneCall().with(3, "r");
+    mockOpen(4, "r");
+
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockTypedFunctionTest, unexpectedArgumentsFailureShowsTypedValues)
+{
+    MockExpectedCallsListForTest expectations;
+    expectations.addFunction("open")->withArguments(MockTypedValues<int, const char*>(3, "r"));
+    MockTypedValues<int, const char*> arguments(4, "w");
+    MockUnexpectedArgumentsFailure failure(UtestShell::getCurrent(), "open", arguments, expectations);
+
+    STRCMP_CONTAINS("Unexpected arguments to function \"open\": <4, w>", failure.getMessage().asCharString());
+    STRCMP_CONTAINS("open -> arguments: <3, r>", failure.getMessage().asCharString());
+}
+
+TEST(MockTypedFunctionTest, untypedActualCallDoesNotMatchTypedExpectation)
+{
+    MockFailureReporterInstaller failureReporterInstaller;
+
+    MockExpectedCallsListForTest expectations;
+    expectations.addFunction("open")->withArguments(MockTypedValues<int, const char*>(3, "r"));
+    MockExpectedParameterDidntHappenFailure expectedFailure(mockFailureTest(), "open", expectations, expectations);
+
+    mockOpen.expectOneCall().with(3, "r");
+    mock().actualCall("open");
+    mock().checkExpectations();
+
+    CHECK_EXPECTED_MOCK_FAILURE(expectedFailure);
+}
+
+TEST(MockTypedFunctionTest, returnsAReferenceToTheValueGivenToAndReturn)
+{
+    int registerValue = 1;
+    mockRegister.expectOneCall().with(2).andReturn(registerValue);
+
+    mockRegister(2) = 5;
+    LONGS_EQUAL(5, registerValue);
+}
+
+TEST(MockTypedFunctionTest, returnsAConstReferenceToACopyOfTheValue)
+{
+    mockName.expectOneCall().andReturn(SimpleString("sensor"));
+
+    STRCMP_EQUAL("sensor", mockName().asCharString());
+}
+
+static void callRegisterWithoutReturnValue_()
+{
+    mockRegister.expectOneCall().with(1);
+    mockRegister(1);
+}
+
+TEST(MockTypedFunctionTest, referenceReturnWithoutReturnValueFails)
+{
+    TestTestingFixture fixture;
+    fixture.setTestFunction(callRegisterWithoutReturnValue_);
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("mocked function returning a reference was called without a return value");
+}
+
+TEST(MockTypedFunctionTest, argumentsWithoutStringFromAreStillCompared)
+{
+    MockTypedPoint point = { 1 };
+    mockMove.expectOneCall().with(point);
+
+    mockMove(point);
+    STRCMP_EQUAL("(no StringFrom)", MockTypedValues<MockTypedPoint>(point).toString().asCharString());
+}
+
+TEST(MockTypedFunctionTest, typedValuesAreIgnoredByDefault)
+{
+    MockIgnoredActualCall actualCall;
+    MockIgnoredExpectedCall expectedCall;
+    MockTypedValues<int> values(1);
+
+    POINTERS_EQUAL(&actualCall, &actualCall.MockActualCall::withArguments(values));
+    POINTERS_EQUAL(NULLPTR, actualCall.MockActualCall::returnTypedValue());
+    POINTERS_EQUAL(&expectedCall, &expectedCall.MockExpectedCall::withArguments(values));
+    POINTERS_EQUAL(&expectedCall, &expectedCall.MockExpectedCall::andReturnTypedValue(values));
+}
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestTestingFixture.h"
+#include "CppUTestExt/PerformanceCounterPlugin.h"
+
+static int closedCounters;
+
+class FakePerformanceCounterPlugin : public PerformanceCounterPlugin
+{
+public:
+    FakePerformanceCounterPlugin() : openCalls(0), openCounters(0), readable(true), running(false),
+        timeEnabled(0), timeRunning(0), enabledPerTest(10), runningPerTest(10)
+    {
+        for (int i = 0; i < NUMBER_OF_COUNTERS; i++) {
+            available[i] = true;
+            groupLeaders[i] = -2;
+        }
+    }
+
+    virtual ~FakePerformanceCounterPlugin() CPPUTEST_DESTRUCTOR_OVERRIDE
+    {
+        /* The base class destructor would close the fake handles for real */
+        closeCounters();
+    }
+
+    bool available[NUMBER_OF_COUNTERS];
+    int groupLeaders[NUMBER_OF_COUNTERS];
+    Counter members[NUMBER_OF_COUNTERS];
+    int openCalls;
+    int openCounters;
+    bool readable;
+    bool running;
+    unsigned long timeEnabled;
+    unsigned long timeRunning;
+    unsigned long enabledPerTest;
+    unsigned long runningPerTest;
+
+protected:
+    virtual int openCounter(Counter counter, int groupLeader) CPPUTEST_OVERRIDE
+    {
+        openCalls++;
+        if (!available[counter]) return -1;
+        groupLeaders[counter] = groupLeader;
+        members[openCounters++] = counter;
+        return (int) counter;
+    }
+
+    virtual void startCounters(int) CPPUTEST_OVERRIDE
+    {
+        running = true;
+    }
+
+    virtual void stopCounters(int) CPPUTEST_OVERRIDE
+    {
+        running = false;
+        timeEnabled += enabledPerTest;
+        timeRunning += runningPerTest;
+    }
+
+    virtual bool readCounters(int, cpputest_ulonglong values[], int numberOfValues,
+                              cpputest_ulonglong& enabled, cpputest_ulonglong& runningTime) CPPUTEST_OVERRIDE
+    {
+        if (!readable || numberOfValues != openCounters) return false;
+        for (int i = 0; i < numberOfValues; i++)
+            values[i] = (cpputest_ulonglong) (1000 + members[i]);
+        enabled = (cpputest_ulonglong) timeEnabled;
+        runningTime = (cpputest_ulonglong) timeRunning;
+        return true;
+    }
+
+    virtual void closeCounter(int) CPPUTEST_OVERRIDE
+    {
+        openCounters--;
+        closedCounters++;
+    }
+};
+
+TEST_GROUP(PerformanceCounterPlugin)
+{
+    TestTestingFixture fixture;
+    FakePerformanceCounterPlugin plugin;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        fixture.installPlugin(&plugin);
+        fixture.setOutputVerbose();
+        closedCounters = 0;
+    }
+};
+
+TEST(PerformanceCounterPlugin, counterNames)
+{
+    STRCMP_EQUAL("cycles", PerformanceCounterPlugin::getCounterName(PerformanceCounterPlugin::CYCLES));
+    STRCMP_EQUAL("page-faults", PerformanceCounterPlugin::getCounterName(PerformanceCounterPlugin::PAGE_FAULTS));
+}
+
+#if CPPUTEST_USE_LONG_LONG
+
+TEST(PerformanceCounterPlugin, reportsEveryCounterAsATestProperty)
+{
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("TEST(ExecFunction, ExecFunction) cycles=1000 instructions=1001 branch-misses=1002 "
+                                "L1-dcache-load-misses=1003 LLC-load-misses=1004 page-faults=1005 - ");
+}
+
+TEST(PerformanceCounterPlugin, reportsNothingWhenTheCountersCannotBeRead)
+{
+    plugin.readable = false;
+    fixture.runAllTests();
+
+    fixture.assertPrintContainsNot("=");
+    LONGS_EQUAL(0, fixture.getFailureCount());
+}
+
+TEST(PerformanceCounterPlugin, scalesTheCountsWhenTheGroupWasMultiplexed)
+{
+    plugin.runningPerTest = 5;
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("cycles=2000 instructions=2002");
+}
+
+TEST(PerformanceCounterPlugin, scalesByTheTimesOfTheTestOnly)
+{
+    fixture.runAllTests();
+    plugin.runningPerTest = 5;
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("cycles=2000 instructions=2002");
+}
+
+TEST(PerformanceCounterPlugin, reportsNothingWhenTheGroupNeverRan)
+{
+    plugin.runningPerTest = 0;
+    fixture.runAllTests();
+
+    fixture.assertPrintContainsNot("cycles=");
+}
+
+#endif
+
+TEST(PerformanceCounterPlugin, opensTheCountersAsOneGroup)
+{
+    plugin.available[PerformanceCounterPlugin::CYCLES] = false;
+    fixture.runAllTests();
+
+    LONGS_EQUAL(-1, plugin.groupLeaders[PerformanceCounterPlugin::INSTRUCTIONS]);
+    LONGS_EQUAL(PerformanceCounterPlugin::INSTRUCTIONS, plugin.groupLeaders[PerformanceCounterPlugin::PAGE_FAULTS]);
+}
+
+TEST(PerformanceCounterPlugin, keepsTheCountersOpenBetweenTests)
+{
+    fixture.runAllTests();
+    fixture.runAllTests();
+
+    LONGS_EQUAL(PerformanceCounterPlugin::NUMBER_OF_COUNTERS, plugin.openCalls);
+    LONGS_EQUAL(PerformanceCounterPlugin::NUMBER_OF_COUNTERS, plugin.openCounters);
+    CHECK_FALSE(plugin.running);
+}
+
+TEST(PerformanceCounterPlugin, closesTheCountersWhenDestroyed)
+{
+    {
+        TestTestingFixture otherFixture;
+        FakePerformanceCounterPlugin otherPlugin;
+        otherFixture.installPlugin(&otherPlugin);
+        otherFixture.runAllTests();
+        LONGS_EQUAL(0, closedCounters);
+    }
+    LONGS_EQUAL(PerformanceCounterPlugin::NUMBER_OF_COUNTERS, closedCounters);
+}
+
+TEST(PerformanceCounterPlugin, leavesOutCountersThatCannotBeOpened)
+{
+    plugin.available[PerformanceCounterPlugin::CYCLES] = false;
+    fixture.runAllTests();
+
+    fixture.assertPrintContainsNot("cycles=");
+    fixture.assertPrintContains("instructions=");
+}
+
+TEST(PerformanceCounterPlugin, doesNotTryToOpenUnavailableCountersAgain)
+{
+    for (int i = 0; i < PerformanceCounterPlugin::NUMBER_OF_COUNTERS; i++)
+        plugin.available[i] = false;
+
+    fixture.runAllTests();
+    fixture.runAllTests();
+
+    LONGS_EQUAL(PerformanceCounterPlugin::NUMBER_OF_COUNTERS, plugin.openCalls);
+}
+
+TEST(PerformanceCounterPlugin, doesNothingWhenNoCounterIsAvailable)
+{
+    for (int i = 0; i < PerformanceCounterPlugin::NUMBER_OF_COUNTERS; i++)
+        plugin.available[i] = false;
+
+    fixture.runAllTests();
+
+    fixture.assertPrintContainsNot("=");
+    LONGS_EQUAL(0, fixture.getFailureCount());
+}
+
+TEST(PerformanceCounterPlugin, realCountersDoNotFailTheTest)
+{
+    PerformanceCounterPlugin realPlugin;
+    TestTestingFixture realFixture;
+    realFixture.installPlugin(&realPlugin);
+    realFixture.runAllTests();
+
+    LONGS_EQUAL(0, realFixture.getFailureCount());
+}
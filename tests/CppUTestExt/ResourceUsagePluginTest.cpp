@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestTestingFixture.h"
+#include "CppUTestExt/ResourceUsagePlugin.h"
+
+class FakeResourceUsagePlugin : public ResourceUsagePlugin
+{
+public:
+    FakeResourceUsagePlugin() : samples(0), failingSample(-1)
+    {
+        after.userTimeInMicros = 3000;
+        after.systemTimeInMicros = 1000;
+        after.maximumResidentSetInKilobytes = 200;
+        after.residentSetInKilobytes = 80;
+        after.minorPageFaults = 10;
+        after.majorPageFaults = 2;
+        after.voluntaryContextSwitches = 5;
+        after.involuntaryContextSwitches = 1;
+
+        before.maximumResidentSetInKilobytes = 100;
+        before.residentSetInKilobytes = 100;
+    }
+
+    ResourceUsage before;
+    ResourceUsage after;
+    int samples;
+    int failingSample;
+
+protected:
+    virtual bool sampleResourceUsage(ResourceUsage& usage) CPPUTEST_OVERRIDE
+    {
+        if (samples == failingSample) return false;
+        usage = (samples++ % 2 == 0) ? before : after;
+        return true;
+    }
+};
+
+TEST_GROUP(ResourceUsagePlugin)
+{
+    TestTestingFixture fixture;
+    FakeResourceUsagePlugin plugin;
+
+    void setup() CPPUTEST_OVERRIDE
+    {
+        fixture.installPlugin(&plugin);
+        fixture.setOutputVerbose();
+    }
+};
+
+TEST(ResourceUsagePlugin, reportsTheResourceUsageOfTheTestAsProperties)
+{
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("TEST(ExecFunction, ExecFunction) user-time-us=3000 system-time-us=1000 "
+                                "max-rss-growth-kB=100 rss-growth-kB=-20 minor-faults=10 major-faults=2 "
+                                "voluntary-switches=5 involuntary-switches=1 - ");
+}
+
+TEST(ResourceUsagePlugin, noLimitsByDefault)
+{
+    fixture.runAllTests();
+
+    LONGS_EQUAL(0, plugin.getLimit(ResourceUsagePlugin::CPU_TIME_IN_MILLIS));
+    LONGS_EQUAL(0, fixture.getFailureCount());
+}
+
+TEST(ResourceUsagePlugin, cpuTimeOverTheLimitFailsTheTest)
+{
+    plugin.setLimit(ResourceUsagePlugin::CPU_TIME_IN_MILLIS, 3);
+    fixture.runAllTests();
+
+    LONGS_EQUAL(1, fixture.getFailureCount());
+    fixture.assertPrintContains("Test used 4 ms of CPU time, the limit is 3");
+}
+
+TEST(ResourceUsagePlugin, usageAtTheLimitPasses)
+{
+    plugin.setLimit(ResourceUsagePlugin::CPU_TIME_IN_MILLIS, 4);
+    plugin.setLimit(ResourceUsagePlugin::RESIDENT_SET_GROWTH_IN_KILOBYTES, 100);
+    plugin.setLimit(ResourceUsagePlugin::PAGE_FAULTS, 12);
+    plugin.setLimit(ResourceUsagePlugin::CONTEXT_SWITCHES, 6);
+    fixture.runAllTests();
+
+    LONGS_EQUAL(0, fixture.getFailureCount());
+}
+
+TEST(ResourceUsagePlugin, everyLimitThatIsExceededFailsTheTest)
+{
+    plugin.setLimit(ResourceUsagePlugin::RESIDENT_SET_GROWTH_IN_KILOBYTES, 99);
+    plugin.setLimit(ResourceUsagePlugin::PAGE_FAULTS, 11);
+    plugin.setLimit(ResourceUsagePlugin::CONTEXT_SWITCHES, 5);
+    fixture.runAllTests();
+
+    fixture.assertPrintContains("Test used 100 kB of resident set growth, the limit is 99");
+    fixture.assertPrintContains("Test used 12 page faults, the limit is 11");
+    fixture.assertPrintContains("Test used 6 context switches, the limit is 5");
+}
+
+TEST(ResourceUsagePlugin, doesNothingWhenTheUsageCannotBeSampledBeforeTheTest)
+{
+    plugin.failingSample = 0;
+    plugin.setLimit(ResourceUsagePlugin::CPU_TIME_IN_MILLIS, 1);
+    fixture.runAllTests();
+
+    fixture.assertPrintContainsNot("user-time-us");
+    LONGS_EQUAL(0, fixture.getFailureCount());
+}
+
+TEST(ResourceUsagePlugin, doesNothingWhenTheUsageCannotBeSampledAfterTheTest)
+{
+    plugin.failingSample = 1;
+    fixture.runAllTests();
+
+    fixture.assertPrintContainsNot("user-time-us");
+}
+
+TEST(ResourceUsagePlugin, parseLimits)
+{
+    const char *cmd_line[] = {"-pcpulimit=100", "-prsslimit=2048", "-pfaultlimit=50", "-pswitchlimit=10"};
+
+    for (int i = 0; i < 4; i++)
+        CHECK(plugin.parseArguments(4, cmd_line, i));
+
+    LONGS_EQUAL(100, plugin.getLimit(ResourceUsagePlugin::CPU_TIME_IN_MILLIS));
+    LONGS_EQUAL(2048, plugin.getLimit(ResourceUsagePlugin::RESIDENT_SET_GROWTH_IN_KILOBYTES));
+    LONGS_EQUAL(50, plugin.getLimit(ResourceUsagePlugin::PAGE_FAULTS));
+    LONGS_EQUAL(10, plugin.getLimit(ResourceUsagePlugin::CONTEXT_SWITCHES));
+}
+
+TEST(ResourceUsagePlugin, limitsThatAreNotNumbersAreNotParsed)
+{
+    const char *cmd_line[] = {"-pcpulimit=abc", "-prsslimit=", "-pfaultlimit=-5", "-pswitchlimit=10x"};
+
+    for (int i = 0; i < 4; i++)
+        CHECK_FALSE(plugin.parseArguments(4, cmd_line, i));
+
+    LONGS_EQUAL(0, plugin.getLimit(ResourceUsagePlugin::CPU_TIME_IN_MILLIS));
+    LONGS_EQUAL(0, plugin.getLimit(ResourceUsagePlugin::RESIDENT_SET_GROWTH_IN_KILOBYTES));
+    LONGS_EQUAL(0, plugin.getLimit(ResourceUsagePlugin::PAGE_FAULTS));
+    LONGS_EQUAL(0, plugin.getLimit(ResourceUsagePlugin::CONTEXT_SWITCHES));
+}
+
+TEST(ResourceUsagePlugin, malformedLimitKeepsThePreviousLimit)
+{
+    const char *cmd_line[] = {"-pcpulimit=100", "-pcpulimit=1o0"};
+
+    CHECK(plugin.parseArguments(2, cmd_line, 0));
+    CHECK_FALSE(plugin.parseArguments(2, cmd_line, 1));
+
+    LONGS_EQUAL(100, plugin.getLimit(ResourceUsagePlugin::CPU_TIME_IN_MILLIS));
+}
+
+TEST(ResourceUsagePlugin, unknownArgumentsAreNotParsed)
+{
+    const char *cmd_line[] = {"-pmemoryreport=normal"};
+    CHECK_FALSE(plugin.parseArguments(1, cmd_line, 0));
+}
+
+TEST(ResourceUsagePlugin, realResourceUsageDoesNotFailTheTest)
+{
+    ResourceUsagePlugin realPlugin;
+    TestTestingFixture realFixture;
+    realFixture.installPlugin(&realPlugin);
+    realFixture.setOutputVerbose();
+    realFixture.runAllTests();
+
+    LONGS_EQUAL(0, realFixture.getFailureCount());
+#if CPPUTEST_HAVE_GETRUSAGE
+    realFixture.assertPrintContains("user-time-us=");
+#endif
+}
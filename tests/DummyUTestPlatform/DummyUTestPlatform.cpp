@@ -47,17 +47,30 @@ static unsigned long fakeTimeInMillis(void)
 }
 unsigned long (*GetPlatformSpecificTimeInMillis)(void) = fakeTimeInMillis;
 
+static unsigned long fakeTimeInMicros(void)
+{
+    return 0;
+}
+unsigned long (*GetPlatformSpecificTimeInMicros)(void) = fakeTimeInMicros;
+
 static const char* fakeTimeString(void)
 {
     return "";
 }
 const char* (*GetPlatformSpecificTimeString)() = fakeTimeString;
 
+static void fakeSetWatchdog(unsigned int, const char*)
+{
+}
+void (*PlatformSpecificSetWatchdog)(unsigned int, const char*) = fakeSetWatchdog;
+
 extern "C" int vsnprintf(char*, size_t, const char*, va_list);
 int (*PlatformSpecificVSNprintf)(char* str, size_t size, const char* format, va_list va_args_list) = vsnprintf;
 
 extern "C" double fabs(double);
 double (*PlatformSpecificFabs)(double d) = fabs;
+extern "C" double sqrt(double);
+double (*PlatformSpecificSqrt)(double d) = sqrt;
 
 static int fakeIsNan(double d)
 {
@@ -87,6 +100,13 @@ static void fakeFPuts(const char* str, PlatformSpecificFile file)
 }
 void (*PlatformSpecificFPuts)(const char* str, PlatformSpecificFile file) = fakeFPuts;
 
+extern "C" char* fgets(char*, int, void*);
+static char* fakeFGets(char* str, int size, PlatformSpecificFile file)
+{
+    return fgets(str, size, file);
+}
+char* (*PlatformSpecificFGets)(char* str, int size, PlatformSpecificFile file) = fakeFGets;
+
 extern "C" int fclose(void* stream);
 static void fakeFClose(PlatformSpecificFile file)
 {
@@ -95,6 +115,12 @@ static void fakeFClose(PlatformSpecificFile file)
 void (*PlatformSpecificFClose)(PlatformSpecificFile file) = fakeFClose;
 
 extern "C" int fflush(void* stream);
+static void fakeFFlush(PlatformSpecificFile file)
+{
+    fflush(file);
+}
+void (*PlatformSpecificFFlush)(PlatformSpecificFile file) = fakeFFlush;
+
 static void fakeFlush(void)
 {
     fflush(stdout);
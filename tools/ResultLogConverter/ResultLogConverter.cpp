@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2007, Michael Feathers, James Grenning and Bas Vodde
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE EARLIER MENTIONED AUTHORS ''AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <copyright holder> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/*
+ * Renders a log written with -oresultlog as console, JUnit or TeamCity output:
+ *
+ *   CppUTestResultLogConverter [-v] [-c] [-o{normal|eclipse|junit|teamcity}] [-k <packageName>] <logFile>
+ *
+ * Exits with 0 when the recorded run passed, 1 when it failed or did not
+ * finish and 2 when the log could not be read.
+ */
+
+#include "CppUTest/TestOutput.h"
+#include "CppUTest/JUnitTestOutput.h"
+#include "CppUTest/TeamCityTestOutput.h"
+#include "CppUTest/ResultLogTestOutput.h"
+
+static const char* usage =
+    "usage: CppUTestResultLogConverter [-v] [-c] [-o{normal|eclipse|junit|teamcity}] [-k <packageName>] <logFile>\n";
+
+int main(int ac, char** av)
+{
+    SimpleString outputType = "normal";
+    SimpleString packageName;
+    SimpleString logFile;
+    bool verbose = false;
+    bool color = false;
+
+    for (int i = 1; i < ac; i++) {
+        SimpleString argument = av[i];
+        if (argument == "-v") verbose = true;
+        else if (argument == "-c") color = true;
+        else if (argument.startsWith("-o")) outputType = argument.subString(2);
+        else if (argument == "-k" && i + 1 < ac) packageName = av[++i];
+        else if (argument.startsWith("-k")) packageName = argument.subString(2);
+        else if (!argument.startsWith("-") && logFile.isEmpty()) logFile = argument;
+        else logFile = "";
+    }
+
+    ConsoleTestOutput console;
+    TestOutput* output = NULLPTR;
+    if (outputType == "junit") {
+        JUnitTestOutput* junitOutput = new JUnitTestOutput;
+        junitOutput->setPackageName(packageName);
+        output = junitOutput;
+    }
+    else if (outputType == "teamcity")
+        output = new TeamCityTestOutput;
+    else if (outputType == "normal" || outputType == "eclipse") {
+        TestOutput::setWorkingEnvironment(TestOutput::eclipse);
+        output = new ConsoleTestOutput;
+    }
+
+    if (output == NULLPTR || logFile.isEmpty()) {
+        console.print(usage);
+        delete output;
+        return 2;
+    }
+
+    if (verbose) output->verbose(TestOutput::level_verbose);
+    if (color) output->color();
+
+    ResultLogReader reader(*output);
+    bool complete = reader.replayFile(logFile.asCharString());
+    int exitCode = 0;
+    if (!reader.isValid()) {
+        console.print("Cannot read ");
+        console.print(logFile.asCharString());
+        console.print(" as a CppUTest result log\n");
+        exitCode = 2;
+    }
+    else if (!complete) {
+        console.print(logFile.asCharString());
+        console.print(" ends before the end of the test run\n");
+        exitCode = 1;
+    }
+    else if (reader.getResult().isFailure())
+        exitCode = 1;
+
+    delete output;
+    return exitCode;
+}